@@ -0,0 +1,63 @@
+import pyoptinterface as poi
+from pyoptinterface import ipopt, nl
+
+import time
+
+
+def build_model(N):
+    model = ipopt.Model()
+
+    x = [model.add_variable(lb=0.1, ub=10.0, start=1.0) for _ in range(N)]
+
+    for i in range(N - 1):
+        with nl.graph():
+            model.add_nl_constraint(x[i] * x[i + 1] + nl.exp(x[i]), poi.Geq, 2.0)
+
+    model.set_objective(poi.quicksum(xi * xi for xi in x))
+
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    # stop immediately to measure the overhead outside Ipopt iterations
+    model.set_raw_parameter("max_iter", 0)
+
+    return model, x
+
+
+def bench_resolve(N, n_solves):
+    model, x = build_model(N)
+
+    t0 = time.perf_counter()
+    model.optimize()
+    t1 = time.perf_counter()
+    first = t1 - t0
+
+    # only starting points change: structure and Ipopt problem are reused
+    t0 = time.perf_counter()
+    for k in range(n_solves):
+        for xi in x:
+            model.set_variable_attribute(xi, poi.VariableAttribute.PrimalStart, 1.0 + k)
+        model.optimize()
+    t1 = time.perf_counter()
+    warm_start = (t1 - t0) / n_solves
+
+    # bounds change: structure is reused, Ipopt problem is recreated
+    t0 = time.perf_counter()
+    for k in range(n_solves):
+        for xi in x:
+            model.set_variable_attribute(xi, poi.VariableAttribute.UpperBound, 10.0 + k)
+        model.optimize()
+    t1 = time.perf_counter()
+    bounds = (t1 - t0) / n_solves
+
+    print(f"N = {N}")
+    print(f"  first optimize (analyze + JIT): {first * 1000:.2f} ms")
+    print(f"  re-solve with new starting point: {warm_start * 1000:.2f} ms")
+    print(f"  re-solve with new bounds: {bounds * 1000:.2f} ms")
+
+
+def main():
+    for N in [1000, 10000, 100000]:
+        bench_resolve(N, 10)
+
+
+if __name__ == "__main__":
+    main()
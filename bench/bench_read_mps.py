@@ -0,0 +1,81 @@
+import pyoptinterface as poi
+from pyoptinterface import highs, gurobi
+
+import numpy as np
+from scipy.sparse import random_array
+
+import os
+import tempfile
+import time
+
+
+def write_random_mps(filename, M, N, density):
+    rng = np.random.default_rng(0)
+    A = random_array((M, N), density=density, format="csr", rng=rng)
+
+    cache = poi.CacheModel()
+    cache._add_variables(N, lb=np.zeros(N), ub=rng.uniform(1.0, 10.0, N))
+    cache._add_linear_constraints(
+        A.indptr.astype(np.int32),
+        A.indices.astype(np.int32),
+        A.data,
+        poi.Leq,
+        rng.uniform(1.0, 10.0, M),
+    )
+    cache.set_objective(poi.quicksum(poi.VariableIndex(j) for j in range(N)))
+    cache.write(filename)
+
+
+def bench(name, f):
+    t0 = time.perf_counter()
+    f()
+    t1 = time.perf_counter()
+    print(f"  {name}: {(t1 - t0) * 1000:.1f} ms")
+
+
+def bench_read_mps(M, N, density):
+    with tempfile.TemporaryDirectory() as tmpdir:
+        filename = os.path.join(tmpdir, "model.mps")
+        write_random_mps(filename, M, N, density)
+        size = os.path.getsize(filename) / 1e6
+        print(f"M = {M}, N = {N}, file size = {size:.1f} MB")
+
+        if highs.is_library_loaded():
+            import highspy
+
+            def poi_highs():
+                model = highs.Model()
+                model.load_mps(filename)
+
+            def highs_read_model():
+                h = highspy.Highs()
+                h.setOptionValue("output_flag", False)
+                h.readModel(filename)
+
+            bench("PyOptInterface load_mps (HiGHS)", poi_highs)
+            bench("Highs_readModel", highs_read_model)
+
+        if gurobi.is_library_loaded():
+            import gurobipy as gp
+
+            env = gurobi.Env()
+
+            def poi_gurobi():
+                model = gurobi.Model(env)
+                model.load_mps(filename)
+
+            def grb_read_model():
+                model = gp.read(filename)
+                model.update()
+
+            bench("PyOptInterface load_mps (Gurobi)", poi_gurobi)
+            bench("GRBreadmodel", grb_read_model)
+
+
+def main():
+    for M, N in [(10000, 10000), (100000, 100000), (1000000, 1000000)]:
+        bench_read_mps(M, N, 10.0 / N)
+
+
+if __name__ == "__main__":
+    main()
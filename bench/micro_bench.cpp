@@ -0,0 +1,492 @@
+// Micro benchmarks of the solver-independent parts of PyOptInterface: expression building,
+// index containers and the evaluators of the nonlinear interface
+//
+// Usage: micro_bench [scale] [repeat]
+// Each case prints one JSON object per line to stdout, e.g.
+// {"name": "exprbuilder_accumulate", "n": 1000000, "repeat": 5, "min_ms": 1.0, ...}
+// so the results of two builds can be compared with a few lines of script
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "fmt/core.h"
+
+#include "pyoptinterface/core.hpp"
+#include "pyoptinterface/container.hpp"
+#include "pyoptinterface/nlexpr.hpp"
+#include "pyoptinterface/nleval.hpp"
+#include "pyoptinterface/hessian_pattern.hpp"
+#include "pyoptinterface/cppad_interface.hpp"
+#include "pyoptinterface/cppad_codegen.hpp"
+
+namespace
+{
+int g_repeat = 5;
+
+// the result of a case is accumulated into this variable so that the work cannot be optimized
+// away
+volatile double g_sink = 0.0;
+
+// setup runs before every repetition and is not timed
+template <typename Setup, typename F>
+void run_case(std::string_view name, size_t n, Setup &&setup, F &&f)
+{
+	std::vector<double> times;
+	times.reserve(g_repeat);
+	for (int r = 0; r < g_repeat; r++)
+	{
+		setup();
+		auto t0 = std::chrono::steady_clock::now();
+		f();
+		auto t1 = std::chrono::steady_clock::now();
+		times.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+	}
+	auto min_ms = *std::min_element(times.begin(), times.end());
+	auto mean_ms = std::accumulate(times.begin(), times.end(), 0.0) / times.size();
+	fmt::print("{{\"name\": \"{}\", \"n\": {}, \"repeat\": {}, \"min_ms\": {:.4f}, "
+	           "\"mean_ms\": {:.4f}, \"ns_per_item\": {:.3f}}}\n",
+	           name, n, g_repeat, min_ms, mean_ms, min_ms * 1e6 / n);
+}
+
+template <typename F>
+void run_case(std::string_view name, size_t n, F &&f)
+{
+	run_case(name, n, [] {}, std::forward<F>(f));
+}
+
+void bench_exprbuilder(size_t N)
+{
+	std::mt19937_64 rng(0);
+	std::uniform_int_distribution<int> var_dist(0, N / 10);
+	std::uniform_real_distribution<double> coef_dist(-1.0, 1.0);
+	std::vector<int> vars(N), vars2(N);
+	std::vector<double> coefs(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		vars[i] = var_dist(rng);
+		vars2[i] = var_dist(rng);
+		coefs[i] = coef_dist(rng);
+	}
+
+	// quicksum-like accumulation of linear terms with many duplicates
+	run_case("exprbuilder_accumulate_affine", N, [&] {
+		ExprBuilder expr;
+		for (size_t i = 0; i < N; i++)
+		{
+			expr.add_affine_term(vars[i], coefs[i]);
+		}
+		g_sink = g_sink + expr.affine_size();
+	});
+
+	run_case("exprbuilder_accumulate_affine_hash", N, [&] {
+		ExprBuilder expr;
+		expr.set_affine_accumulator(AffineAccumulator::Hash);
+		for (size_t i = 0; i < N; i++)
+		{
+			expr.add_affine_term(vars[i], coefs[i]);
+		}
+		g_sink = g_sink + expr.affine_size();
+	});
+
+	run_case("exprbuilder_accumulate_quadratic", N, [&] {
+		ExprBuilder expr;
+		for (size_t i = 0; i < N; i++)
+		{
+			expr.add_quadratic_term(vars[i], vars2[i], coefs[i]);
+		}
+		g_sink = g_sink + expr.quadratic_terms.size();
+	});
+
+	// conversion of the accumulated expression to the flat representation
+	ExprBuilder expr;
+	for (size_t i = 0; i < N; i++)
+	{
+		expr.add_affine_term(vars[i], coefs[i]);
+	}
+	run_case("exprbuilder_to_affine", expr.affine_size(), [&] {
+		ScalarAffineFunction f(expr);
+		g_sink = g_sink + f.size();
+	});
+}
+
+void bench_canonicalize(size_t N)
+{
+	std::mt19937_64 rng(1);
+	std::uniform_int_distribution<int> var_dist(0, N / 10);
+	std::uniform_real_distribution<double> coef_dist(-1.0, 1.0);
+	std::vector<double> coefs(N);
+	std::vector<int> vars(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		vars[i] = var_dist(rng);
+		coefs[i] = coef_dist(rng);
+	}
+
+	ScalarAffineFunction f;
+	run_case(
+	    "affine_canonicalize", N,
+	    [&] {
+		    f.coefficients = coefs;
+		    f.variables = vars;
+	    },
+	    [&] {
+		    f.canonicalize();
+		    g_sink = g_sink + f.size();
+	    });
+
+	// the common case of an already canonical function
+	f.canonicalize();
+	auto canonical_coefs = f.coefficients;
+	auto canonical_vars = f.variables;
+	run_case(
+	    "affine_canonicalize_sorted", canonical_vars.size(),
+	    [&] {
+		    f.coefficients = canonical_coefs;
+		    f.variables = canonical_vars;
+	    },
+	    [&] {
+		    f.canonicalize();
+		    g_sink = g_sink + f.size();
+	    });
+}
+
+void bench_indexer(size_t N)
+{
+	std::mt19937_64 rng(2);
+	// delete half of the indices in random order
+	std::vector<int> deleted(N);
+	std::iota(deleted.begin(), deleted.end(), 0);
+	std::shuffle(deleted.begin(), deleted.end(), rng);
+	deleted.resize(N / 2);
+	std::vector<int> queries(N);
+	std::uniform_int_distribution<int> query_dist(0, N - 1);
+	for (auto &q : queries)
+	{
+		q = query_dist(rng);
+	}
+
+	MonotoneIndexer<int> indexer;
+	run_case(
+	    "indexer_add_index", N, [&] { indexer.clear(); },
+	    [&] {
+		    for (size_t i = 0; i < N; i++)
+		    {
+			    indexer.add_index();
+		    }
+	    });
+
+	run_case(
+	    "indexer_add_indices", N, [&] { indexer.clear(); },
+	    [&] { indexer.add_indices(N); });
+
+	run_case(
+	    "indexer_delete_index", deleted.size(),
+	    [&] {
+		    indexer.clear();
+		    indexer.add_indices(N);
+	    },
+	    [&] {
+		    for (auto i : deleted)
+		    {
+			    indexer.delete_index(i);
+		    }
+	    });
+
+	run_case(
+	    "indexer_delete_indices", deleted.size(),
+	    [&] {
+		    indexer.clear();
+		    indexer.add_indices(N);
+	    },
+	    [&] { indexer.delete_indices(deleted); });
+
+	// get_index after deletions, the ranks of the chunks are recomputed lazily
+	auto prepare_deleted = [&] {
+		indexer.clear();
+		indexer.add_indices(N);
+		for (auto i : deleted)
+		{
+			indexer.delete_index(i);
+		}
+	};
+	run_case("indexer_get_index_random", N, prepare_deleted, [&] {
+		long long s = 0;
+		for (auto q : queries)
+		{
+			s += indexer.get_index(q);
+		}
+		g_sink = g_sink + s;
+	});
+
+	std::vector<int> results(N);
+	run_case("indexer_get_indices_random", N, prepare_deleted, [&] {
+		indexer.get_indices(queries, results);
+		g_sink = g_sink + results.back();
+	});
+
+	run_case("indexer_get_index_sequential", N, prepare_deleted, [&] {
+		long long s = 0;
+		for (size_t i = 0; i < N; i++)
+		{
+			s += indexer.get_index(i);
+		}
+		g_sink = g_sink + s;
+	});
+
+	// interleaved deletions and queries invalidate the cached ranks repeatedly
+	run_case(
+	    "indexer_delete_get_interleaved", deleted.size(),
+	    [&] {
+		    indexer.clear();
+		    indexer.add_indices(N);
+	    },
+	    [&] {
+		    long long s = 0;
+		    for (size_t k = 0; k < deleted.size(); k++)
+		    {
+			    indexer.delete_index(deleted[k]);
+			    s += indexer.get_index(queries[k]);
+		    }
+		    g_sink = g_sink + s;
+	    });
+}
+
+void bench_linear_quadratic_evaluator(size_t N)
+{
+	std::mt19937_64 rng(3);
+	std::uniform_int_distribution<int> var_dist(0, N - 1);
+	std::uniform_real_distribution<double> coef_dist(-1.0, 1.0);
+	const int row_nnz = 10;
+	const size_t M = N / row_nnz;
+
+	std::vector<double> x(N);
+	for (auto &v : x)
+	{
+		v = coef_dist(rng);
+	}
+
+	LinearEvaluator linear;
+	QuadraticEvaluator quadratic;
+	for (size_t i = 0; i < M; i++)
+	{
+		ScalarAffineFunction f;
+		ScalarQuadraticFunction g;
+		for (int k = 0; k < row_nnz; k++)
+		{
+			auto v = var_dist(rng);
+			f.add_term(v, coef_dist(rng));
+			g.add_quadratic_term(v, var_dist(rng), coef_dist(rng));
+			g.add_affine_term(v, coef_dist(rng));
+		}
+		f.add_constant(coef_dist(rng));
+		linear.add_row(f);
+		quadratic.add_row(g);
+	}
+
+	std::vector<double> f(M);
+	run_case("linear_eval_function", M * row_nnz, [&] {
+		linear.eval_function(x.data(), f.data());
+		g_sink = g_sink + f[0];
+	});
+
+	size_t jacobian_nnz = 0;
+	std::vector<int> jacobian_rows, jacobian_cols;
+	linear.analyze_jacobian_structure(jacobian_nnz, jacobian_rows, jacobian_cols);
+	std::vector<double> jacobian(jacobian_nnz);
+	run_case("linear_eval_jacobian", jacobian_nnz, [&] {
+		linear.eval_jacobian(x.data(), jacobian.data());
+		g_sink = g_sink + jacobian[0];
+	});
+
+	run_case("quadratic_eval_function", M * row_nnz * 2, [&] {
+		quadratic.eval_function(x.data(), f.data());
+		g_sink = g_sink + f[0];
+	});
+
+	jacobian_nnz = 0;
+	jacobian_rows.clear();
+	jacobian_cols.clear();
+	quadratic.analyze_jacobian_structure(0, jacobian_nnz, jacobian_rows, jacobian_cols);
+	jacobian.resize(jacobian_nnz);
+	run_case("quadratic_eval_jacobian", jacobian_nnz, [&] {
+		quadratic.eval_jacobian(x.data(), jacobian.data());
+		g_sink = g_sink + jacobian[0];
+	});
+
+	size_t hessian_nnz = 0;
+	std::vector<int> hessian_rows, hessian_cols;
+	run_case(
+	    "quadratic_analyze_hessian_structure", M * row_nnz,
+	    [&] {
+		    hessian_nnz = 0;
+		    hessian_rows.clear();
+		    hessian_cols.clear();
+	    },
+	    [&] {
+		    HessianPatternBuilder builder(HessianSparsityType::Lower);
+		    quadratic.analyze_hessian_structure(builder);
+		    builder.finalize(hessian_nnz, hessian_rows, hessian_cols);
+	    });
+
+	std::vector<double> hessian(hessian_nnz);
+	std::vector<double> lambda(M, 1.0);
+	run_case("quadratic_eval_lagrangian_hessian", M * row_nnz, [&] {
+		std::fill(hessian.begin(), hessian.end(), 0.0);
+		quadratic.eval_lagrangian_hessian(lambda.data(), hessian.data());
+		g_sink = g_sink + hessian[0];
+	});
+}
+
+// builds the graph of x[i] * sin(x[j]) + exp(p * x[k]) - c as a constraint
+void build_nl_graph(ExpressionGraph &graph, int i, int j, int k, double c)
+{
+	auto xi = graph.add_variable(i);
+	auto xj = graph.add_variable(j);
+	auto xk = graph.add_variable(k);
+	auto p = graph.add_constant(0.5);
+	auto prod = graph.add_nary(NaryOperator::Mul, {xi, graph.add_unary(UnaryOperator::Sin, xj)});
+	auto e = graph.add_unary(UnaryOperator::Exp, graph.add_nary(NaryOperator::Mul, {p, xk}));
+	auto sum = graph.add_nary(NaryOperator::Add, {prod, e});
+	graph.add_constraint_output(graph.add_binary(BinaryOperator::Sub, sum, graph.add_constant(c)));
+}
+
+void bench_nonlinear_structure(size_t N)
+{
+	std::mt19937_64 rng(4);
+	std::uniform_int_distribution<int> var_dist(0, N - 1);
+	std::uniform_real_distribution<double> coef_dist(-1.0, 1.0);
+
+	std::vector<ExpressionGraph> graphs(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		build_nl_graph(graphs[i], var_dist(rng), var_dist(rng), var_dist(rng), coef_dist(rng));
+	}
+
+	// the autodiff structure is shared by all instances, so it is computed once outside the
+	// timed region
+	AutodiffSymbolicStructure structure;
+	{
+		auto f = cppad_trace_graph_constraints(graphs[0]);
+		std::vector<double> x_values(f.Domain(), 0.5), p_values(f.size_dyn_ind(), 0.5);
+		CppADAutodiffGraph cppad_graph;
+		cppad_autodiff(f, structure, cppad_graph, x_values, p_values);
+	}
+
+	NonlinearEvaluator evaluator;
+	run_case(
+	    "nleval_finalize_and_aggregate", N, [&] { evaluator = NonlinearEvaluator(); },
+	    [&] {
+		    for (size_t i = 0; i < N; i++)
+		    {
+			    auto index = evaluator.add_graph_instance();
+			    evaluator.finalize_graph_instance(index, graphs[i]);
+		    }
+		    int n_groups = evaluator.aggregate_constraint_groups();
+		    for (int g = 0; g < n_groups; g++)
+		    {
+			    evaluator.assign_constraint_group_autodiff_structure(g, structure);
+		    }
+		    evaluator.calculate_constraint_graph_instances_offset();
+	    });
+
+	size_t jacobian_nnz = 0;
+	std::vector<int> jacobian_rows, jacobian_cols;
+	run_case(
+	    "nleval_analyze_jacobian_structure", N,
+	    [&] {
+		    jacobian_nnz = 0;
+		    jacobian_rows.clear();
+		    jacobian_cols.clear();
+	    },
+	    [&] {
+		    evaluator.analyze_constraints_jacobian_structure(0, jacobian_nnz, jacobian_rows,
+		                                                     jacobian_cols);
+	    });
+
+	size_t hessian_nnz = 0;
+	std::vector<int> hessian_rows, hessian_cols;
+	run_case(
+	    "nleval_analyze_hessian_structure", N,
+	    [&] {
+		    hessian_nnz = 0;
+		    hessian_rows.clear();
+		    hessian_cols.clear();
+	    },
+	    [&] {
+		    HessianPatternBuilder builder(HessianSparsityType::Lower);
+		    evaluator.analyze_constraints_hessian_structure(builder);
+		    builder.finalize(hessian_nnz, hessian_rows, hessian_cols);
+	    });
+}
+
+// N groups of different structures: the sum of x[0] * sin(x[1]) * ... * exp(x[t]) over t < L,
+// where L varies from group to group
+void bench_codegen(size_t N)
+{
+	std::vector<CppADAutodiffGraph> cppad_graphs(N);
+	std::vector<AutodiffSymbolicStructure> structures(N);
+	NLCodegen codegen;
+	for (size_t i = 0; i < N; i++)
+	{
+		ExpressionGraph graph;
+		std::vector<ExpressionHandle> terms;
+		size_t L = 5 + i % 20;
+		for (size_t t = 0; t < L; t++)
+		{
+			auto xt = graph.add_variable(t);
+			auto xs = graph.add_variable(t + 1);
+			auto sin_xs = graph.add_unary(UnaryOperator::Sin, xs);
+			terms.push_back(graph.add_nary(
+			    NaryOperator::Mul, {xt, sin_xs, graph.add_unary(UnaryOperator::Exp, xt)}));
+		}
+		graph.add_constraint_output(graph.add_nary(NaryOperator::Add, terms));
+
+		auto f = cppad_trace_graph_constraints(graph);
+		std::vector<double> x_values(f.Domain(), 0.5), p_values(f.size_dyn_ind(), 0.5);
+		cppad_autodiff(f, structures[i], cppad_graphs[i], x_values, p_values);
+		codegen.add_constraint_group(cppad_graphs[i], structures[i], fmt::format("nl_{}", i));
+	}
+
+	size_t n_threads = std::max(1u, std::thread::hardware_concurrency());
+	for (auto target : {CodegenTarget::C, CodegenTarget::LLVM})
+	{
+		auto target_name = target == CodegenTarget::C ? "c" : "llvm";
+		run_case(fmt::format("codegen_{}_serial", target_name), N, [&] {
+			auto modules = codegen.generate(target, 1, 1);
+			g_sink = g_sink + modules[0].code.size();
+		});
+		run_case(fmt::format("codegen_{}_parallel", target_name), N, [&] {
+			auto modules = codegen.generate(target, n_threads, n_threads);
+			g_sink = g_sink + modules[0].code.size();
+		});
+	}
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+	size_t scale = 1000000;
+	if (argc > 1)
+	{
+		scale = std::strtoull(argv[1], nullptr, 10);
+	}
+	if (argc > 2)
+	{
+		g_repeat = std::max(1, std::atoi(argv[2]));
+	}
+
+	bench_exprbuilder(scale);
+	bench_canonicalize(scale);
+	bench_indexer(scale);
+	bench_linear_quadratic_evaluator(scale);
+	bench_nonlinear_structure(scale / 10);
+	bench_codegen(scale / 1000);
+
+	return 0;
+}
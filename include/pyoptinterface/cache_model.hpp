@@ -1,8 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <concepts>
 #include <vector>
 #include <span>
+#include <limits>
+#include <optional>
+#include <string>
+#include <stdexcept>
+#include <tuple>
+
+#include "pyoptinterface/core.hpp"
 
 // This file defines some common utilities to store the optimization model in a compact way
 
@@ -54,3 +62,195 @@ struct QuadraticExpressionCache
 		lin_column_ptr.push_back(lin_variables.size());
 	}
 };
+
+// CacheModel stores a whole model in the compact form above without any solver, it can be
+// loaded into any solver model that supports the bulk APIs with load_cache_model
+// The variables and constraints are numbered from 0 in the order they are added
+class CacheModel
+{
+  public:
+	VariableIndex add_variable(VariableDomain domain = VariableDomain::Continuous,
+	                           double lb = -std::numeric_limits<double>::infinity(),
+	                           double ub = std::numeric_limits<double>::infinity());
+	// add N variables with the same domain, the first one is returned
+	VariableIndex add_variables(int N, VariableDomain domain, const double *lb, const double *ub);
+
+	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
+	                                      ConstraintSense sense, CoeffT rhs);
+	ConstraintIndex add_linear_constraint(const ExprBuilder &function, ConstraintSense sense,
+	                                      CoeffT rhs);
+	// add M linear constraints whose coefficients are a CSR matrix, the first one is returned
+	ConstraintIndex add_linear_constraints(int M, const int *indptr, const int *variables,
+	                                       const double *coefficients, ConstraintSense sense,
+	                                       const double *rhs);
+	ConstraintIndex add_quadratic_constraint(const ScalarQuadraticFunction &function,
+	                                         ConstraintSense sense, CoeffT rhs);
+	ConstraintIndex add_quadratic_constraint(const ExprBuilder &function, ConstraintSense sense,
+	                                         CoeffT rhs);
+
+	void set_objective(const ScalarAffineFunction &function, ObjectiveSense sense);
+	void set_objective(const ScalarQuadraticFunction &function, ObjectiveSense sense);
+	void set_objective(const ExprBuilder &function, ObjectiveSense sense);
+
+	int get_num_variables() const;
+	int get_num_linear_constraints() const;
+	int get_num_quadratic_constraints() const;
+
+	void check_variables(std::span<const IndexT> variables) const;
+	// throws if the containers are inconsistent, e.g. a row refers to a variable that does not
+	// exist, the members are public and can be filled without the checks of the add_* methods
+	void check_consistency() const;
+
+	// write the model to an MPS or LP file chosen by the extension of filename
+	void write(const std::string &filename) const;
+
+	Vector<VariableDomain> variable_domains;
+	Vector<double> variable_lbs;
+	Vector<double> variable_ubs;
+
+	LinearExpressionCache<int, int, double> linear_constraints;
+	Vector<ConstraintSense> linear_senses;
+	Vector<double> linear_rhs;
+
+	QuadraticExpressionCache<int, int, double> quadratic_constraints;
+	Vector<ConstraintSense> quadratic_senses;
+	Vector<double> quadratic_rhs;
+
+	std::optional<ScalarQuadraticFunction> objective;
+	ObjectiveSense objective_sense = ObjectiveSense::Minimize;
+};
+
+// Load the cached model into a solver model with one bulk call for every run of variables with
+// the same domain and every run of linear constraints with the same sense
+// Returns the indices of the first variable, linear constraint and quadratic constraint in the
+// solver model (-1 if there is none), the i-th cached one is mapped to first + i
+template <typename T>
+std::tuple<IndexT, IndexT, IndexT> load_cache_model(T &model, const CacheModel &cache)
+{
+	// validate the whole cache before the first solver call, so that a bad cache cannot leave the
+	// solver model half loaded
+	cache.check_consistency();
+
+	// the indices assigned by the solver are only known after each call
+	auto check_contiguous = [](IndexT index, IndexT first, int offset) {
+		if (index != first + offset)
+		{
+			throw std::runtime_error("Solver model does not assign contiguous indices");
+		}
+	};
+
+	int N = cache.get_num_variables();
+	IndexT first_variable = -1;
+	for (int begin = 0; begin < N;)
+	{
+		auto domain = cache.variable_domains[begin];
+		int end = begin + 1;
+		while (end < N && cache.variable_domains[end] == domain)
+		{
+			end++;
+		}
+		auto variable = model.add_variables(end - begin, domain, cache.variable_lbs.data() + begin,
+		                                    cache.variable_ubs.data() + begin);
+		if (begin == 0)
+		{
+			first_variable = variable.index;
+		}
+		check_contiguous(variable.index, first_variable, begin);
+		begin = end;
+	}
+
+	// translate the cached variables if the solver model has variables already
+	const auto &linear = cache.linear_constraints;
+	const int *variables = linear.variables.data();
+	Vector<int> translated_variables;
+	if (first_variable > 0)
+	{
+		translated_variables.resize(linear.variables.size());
+		for (size_t i = 0; i < linear.variables.size(); i++)
+		{
+			translated_variables[i] = linear.variables[i] + first_variable;
+		}
+		variables = translated_variables.data();
+	}
+
+	int M = cache.get_num_linear_constraints();
+	IndexT first_linear_constraint = -1;
+	Vector<int> indptr;
+	for (int begin = 0; begin < M;)
+	{
+		auto sense = cache.linear_senses[begin];
+		int end = begin + 1;
+		while (end < M && cache.linear_senses[end] == sense)
+		{
+			end++;
+		}
+		int nz_begin = linear.column_ptr[begin];
+		indptr.resize(end - begin + 1);
+		for (int i = begin; i <= end; i++)
+		{
+			indptr[i - begin] = linear.column_ptr[i] - nz_begin;
+		}
+		auto constraint = model.add_linear_constraints(
+		    end - begin, indptr.data(), variables + nz_begin,
+		    linear.coefficients.data() + nz_begin, sense, cache.linear_rhs.data() + begin);
+		if (begin == 0)
+		{
+			first_linear_constraint = constraint.index;
+		}
+		check_contiguous(constraint.index, first_linear_constraint, begin);
+		begin = end;
+	}
+
+	const auto &quadratic = cache.quadratic_constraints;
+	auto offset = std::max<IndexT>(first_variable, 0);
+	IndexT first_quadratic_constraint = -1;
+	for (int i = 0; i < cache.get_num_quadratic_constraints(); i++)
+	{
+		ScalarQuadraticFunction f;
+		for (int j = quadratic.column_ptr[i]; j < quadratic.column_ptr[i + 1]; j++)
+		{
+			f.add_quadratic_term(quadratic.variable_1s[j] + offset,
+			                     quadratic.variable_2s[j] + offset, quadratic.coefficients[j]);
+		}
+		for (int j = quadratic.lin_column_ptr[i]; j < quadratic.lin_column_ptr[i + 1]; j++)
+		{
+			f.add_affine_term(quadratic.lin_variables[j] + offset, quadratic.lin_coefficients[j]);
+		}
+		auto constraint =
+		    model.add_quadratic_constraint(f, cache.quadratic_senses[i], cache.quadratic_rhs[i]);
+		if (i == 0)
+		{
+			first_quadratic_constraint = constraint.index;
+		}
+		check_contiguous(constraint.index, first_quadratic_constraint, i);
+	}
+
+	if (cache.objective)
+	{
+		auto f = cache.objective.value();
+		for (auto &v : f.variable_1s)
+		{
+			v += offset;
+		}
+		for (auto &v : f.variable_2s)
+		{
+			v += offset;
+		}
+		ScalarAffineFunction affine_part = f.affine_part.value_or(ScalarAffineFunction());
+		for (auto &v : affine_part.variables)
+		{
+			v += offset;
+		}
+		if (f.coefficients.empty())
+		{
+			model.set_objective(affine_part, cache.objective_sense);
+		}
+		else
+		{
+			f.affine_part = affine_part;
+			model.set_objective(f, cache.objective_sense);
+		}
+	}
+
+	return {first_variable, first_linear_constraint, first_quadratic_constraint};
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <algorithm>
 #include <bit>
+#include <span>
 #include <vector>
 #include <concepts>
 #include <assert.h>
@@ -213,6 +215,8 @@ class ChunkedBitVector
 			ChunkT mask = (newelement << (m_next_bit)) &
 			              (newelement >> (CHUNK_WIDTH - m_next_bit - extra_bits_in_current_chunk));
 			last_chunk |= mask;
+			// rank of the current chunk has changed
+			m_chunk_ranks.back() = -1;
 		}
 
 		N -= extra_bits_in_current_chunk;
@@ -238,7 +242,8 @@ class ChunkedBitVector
 			ChunkT remaining_chunk = (ChunkT{1} << N_remaining_bits) - 1;
 			m_data.push_back(remaining_chunk);
 			m_cumulated_ranks.push_back(m_cumulated_ranks.back());
-			m_chunk_ranks.push_back(N_remaining_bits);
+			// the last chunk is still filled by add_index later, so its rank is not cached
+			m_chunk_ranks.push_back(-1);
 
 			m_next_bit = N_remaining_bits;
 		}
@@ -277,6 +282,34 @@ class ChunkedBitVector
 		}
 	}
 
+	// delete a batch of indices, the ranks are invalidated once from the smallest touched chunk
+	void delete_indices(std::span<const IndexT> indices)
+	{
+		std::size_t first_tainted_chunk = m_data.size();
+		for (auto index : indices)
+		{
+			std::size_t chunk_index;
+			std::uint8_t bit_index;
+			locate_index(index, chunk_index, bit_index);
+			if (chunk_index >= m_data.size())
+			{
+				continue;
+			}
+			ChunkT &chunk = m_data[chunk_index];
+			ChunkT mask = ChunkT{1} << bit_index;
+			if (chunk & mask)
+			{
+				chunk &= ~(mask);
+				m_chunk_ranks[chunk_index] = -1;
+				first_tainted_chunk = std::min(first_tainted_chunk, chunk_index);
+			}
+		}
+		if (m_last_correct_chunk > first_tainted_chunk)
+		{
+			m_last_correct_chunk = first_tainted_chunk;
+		}
+	}
+
 	bool has_index(const IndexT &index) const
 	{
 		std::size_t chunk_index;
@@ -312,6 +345,50 @@ class ChunkedBitVector
 		return m_cumulated_ranks[chunk_index] + current_chunk_index;
 	}
 
+	// translate a batch of indices, results[i] = get_index(indices[i])
+	// the cumulated ranks are brought up to date by a single sweep to the largest chunk in the
+	// batch, so the lookups afterwards are only a popcount each, sorted or not
+	void get_indices(std::span<const IndexT> indices, std::span<ResultT> results)
+	{
+		assert(indices.size() == results.size());
+		const IndexT end = m_data.size() * CHUNK_WIDTH;
+		IndexT max_index = -1;
+		for (auto index : indices)
+		{
+			if (index < end)
+			{
+				max_index = std::max(max_index, index);
+			}
+		}
+		if (max_index >= 0)
+		{
+			std::size_t chunk_index = max_index >> LOG2_CHUNK_WIDTH;
+			if (chunk_index > m_last_correct_chunk)
+			{
+				update_to(chunk_index);
+			}
+		}
+		const ChunkT *data = m_data.data();
+		const ResultT *cumulated_ranks = m_cumulated_ranks.data();
+		for (std::size_t i = 0; i < indices.size(); i++)
+		{
+			auto index = indices[i];
+			if (index < 0 || index >= end)
+			{
+				results[i] = -1;
+				continue;
+			}
+			std::size_t chunk_index;
+			std::uint8_t bit_index;
+			locate_index(index, chunk_index, bit_index);
+			ChunkT chunk = data[chunk_index];
+			ChunkT mask = ChunkT{1} << bit_index;
+			// deleted and active indices are mixed randomly, so this is written without a branch
+			ResultT rank = cumulated_ranks[chunk_index] + std::popcount(chunk & (mask - 1));
+			results[i] = (chunk & mask) ? rank : ResultT{-1};
+		}
+	}
+
 	void update_to(std::size_t chunk_index)
 	{
 		// m_cumulated_ranks[0, m_last_correct_chunk] and m_chunk_ranks[0, m_last_correct_chunk) are
@@ -403,6 +480,20 @@ class SimpleMonotoneVector
 		}
 		return m_data[index];
 	}
+	void delete_indices(std::span<const IndexT> indices)
+	{
+		for (auto index : indices)
+		{
+			delete_index(index);
+		}
+	}
+	void get_indices(std::span<const IndexT> indices, std::span<T> results)
+	{
+		for (std::size_t i = 0; i < indices.size(); i++)
+		{
+			results[i] = get_index(indices[i]);
+		}
+	}
 	void clear()
 	{
 		m_data.clear();
@@ -29,8 +29,10 @@ extern "C"
 	B(COPT_WriteMst);              \
 	B(COPT_WriteParam);            \
 	B(COPT_AddCol);                \
+	B(COPT_AddCols);               \
 	B(COPT_DelCols);               \
 	B(COPT_AddRow);                \
+	B(COPT_AddRows);               \
 	B(COPT_AddQConstr);            \
 	B(COPT_AddSOSs);               \
 	B(COPT_AddCones);              \
@@ -79,6 +81,7 @@ extern "C"
 	B(COPT_SetQConstrRhs);         \
 	B(COPT_GetElem);               \
 	B(COPT_SetElem);               \
+	B(COPT_SetElems);              \
 	B(COPT_SetColObj);             \
 	B(COPT_GetBanner);             \
 	B(COPT_SetCallback);           \
@@ -199,12 +202,19 @@ class COPTModel : public OnesideLinearConstraintMixin<COPTModel>,
 	VariableIndex add_variable(VariableDomain domain = VariableDomain::Continuous,
 	                           double lb = -COPT_INFINITY, double ub = COPT_INFINITY,
 	                           const char *name = nullptr);
+	// add N variables of the same domain, lb[i] and ub[i] are the bounds of the i-th variable
+	// the new variables have contiguous indices, the first one is returned
+	VariableIndex add_variables(int N, VariableDomain domain, const double *lb, const double *ub);
 	void delete_variable(const VariableIndex &variable);
 	void delete_variables(const Vector<VariableIndex> &variables);
 	bool is_variable_active(const VariableIndex &variable);
 	double get_variable_value(const VariableIndex &variable);
+	// values[i] is the value of the variable whose VariableIndex::index is variables[i]
+	void get_variable_values(int N, const int *variables, double *values);
 	std::string pprint_variable(const VariableIndex &variable);
 	void set_variable_bounds(const VariableIndex &variable, double lb, double ub);
+	// set the bounds of N variables whose VariableIndex::index are variables in one call
+	void set_variable_bounds(int N, const int *variables, const double *lb, const double *ub);
 
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
 	                                      ConstraintSense sense, CoeffT rhs,
@@ -212,6 +222,11 @@ class COPTModel : public OnesideLinearConstraintMixin<COPTModel>,
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
 	                                      const std::tuple<double, double> &interval,
 	                                      const char *name = nullptr);
+	// add M linear constraints whose coefficients are a CSR matrix with VariableIndex::index as
+	// columns, the new constraints have contiguous indices and the first one is returned
+	ConstraintIndex add_linear_constraints(int M, const int *indptr, const int *variables,
+	                                       const double *coefficients, ConstraintSense sense,
+	                                       const double *rhs);
 	ConstraintIndex add_quadratic_constraint(const ScalarQuadraticFunction &function,
 	                                         ConstraintSense sense, CoeffT rhs,
 	                                         const char *name = nullptr);
@@ -298,19 +313,28 @@ class COPTModel : public OnesideLinearConstraintMixin<COPTModel>,
 	// 1. set/get RHS of a constraint
 	double get_normalized_rhs(const ConstraintIndex &constraint);
 	void set_normalized_rhs(const ConstraintIndex &constraint, double value);
+	// constraints[i] is ConstraintIndex::index of a linear constraint
+	void set_normalized_rhs(int N, const int *constraints, const double *values);
 	// 2. set/get coefficient of variable in constraint
 	double get_normalized_coefficient(const ConstraintIndex &constraint,
 	                                  const VariableIndex &variable);
 	void set_normalized_coefficient(const ConstraintIndex &constraint,
 	                                const VariableIndex &variable, double value);
+	void set_normalized_coefficients(int N, const int *constraints, const int *variables,
+	                                 const double *values);
 	// 3. set/get linear coefficient of variable in objective
 	double get_objective_coefficient(const VariableIndex &variable);
 	void set_objective_coefficient(const VariableIndex &variable, double value);
+	void set_objective_coefficients(int N, const int *variables, const double *values);
 
 	int _variable_index(const VariableIndex &variable);
+	// columns[i] is the column of variables[i] or -1 if it does not exist
+	void _variable_indices(std::span<const IndexT> variables, std::span<int> columns);
 	int _checked_variable_index(const VariableIndex &variable);
 	int _constraint_index(const ConstraintIndex &constraint);
 	int _checked_constraint_index(const ConstraintIndex &constraint);
+	// rows[i] is the row of the linear constraint constraints[i] or -1 if it does not exist
+	void _linear_constraint_indices(std::span<const IndexT> constraints, std::span<int> rows);
 
 	// Control logging
 	void set_logging(const COPTLoggingCallback &callback);
@@ -32,6 +32,18 @@ enum class VariableDomain
 	SemiContinuous,
 };
 
+// How ExprBuilder accumulates its affine terms
+// Hash: a hashmap keyed by variable index, suitable for sparse expressions
+// Dense: a scratch array indexed by variable index plus the list of touched variables, suitable
+// for huge expressions touching most variables of a model
+// Auto: start with Hash and switch to Dense once the expression is large and dense enough
+enum class AffineAccumulator
+{
+	Auto,
+	Hash,
+	Dense,
+};
+
 struct VariableIndex
 {
 	IndexT index;
@@ -122,6 +134,15 @@ struct ExprBuilder
 	Hashmap<IndexT, CoeffT> affine_terms;
 	std::optional<CoeffT> constant_term;
 
+	AffineAccumulator affine_accumulator = AffineAccumulator::Auto;
+	// when dense_affine is true, the affine terms are stored in the three vectors below and
+	// affine_terms is empty
+	// dense_affine_slots[v] is the position of variable v in dense_affine_variables or -1
+	bool dense_affine = false;
+	Vector<IndexT> dense_affine_slots;
+	Vector<IndexT> dense_affine_variables;
+	Vector<CoeffT> dense_affine_coefficients;
+
 	ExprBuilder() = default;
 	ExprBuilder(CoeffT c);
 	ExprBuilder(const VariableIndex &v);
@@ -164,6 +185,57 @@ struct ExprBuilder
 	void _set_affine_coef(IndexT i, CoeffT coeff);
 	void add_affine_term(const VariableIndex &i, CoeffT coeff);
 	void set_affine_coef(const VariableIndex &i, CoeffT coeff);
+
+	void set_affine_accumulator(AffineAccumulator accumulator);
+	bool is_dense_affine() const;
+	size_t affine_size() const;
+	// write the affine terms sorted by variable index
+	void sorted_affine_terms(Vector<IndexT> &variables, Vector<CoeffT> &coefficients) const;
+
+	// f(IndexT variable, CoeffT coefficient) is called for each affine term
+	template <typename F>
+	void for_each_affine_term(F &&f) const
+	{
+		if (dense_affine)
+		{
+			auto N = dense_affine_variables.size();
+			for (size_t i = 0; i < N; i++)
+			{
+				f(dense_affine_variables[i], dense_affine_coefficients[i]);
+			}
+		}
+		else
+		{
+			for (const auto &[v, c] : affine_terms)
+			{
+				f(v, c);
+			}
+		}
+	}
+	// f(CoeffT &coefficient) is called for each affine term
+	template <typename F>
+	void for_each_affine_coefficient(F &&f)
+	{
+		if (dense_affine)
+		{
+			for (auto &c : dense_affine_coefficients)
+			{
+				f(c);
+			}
+		}
+		else
+		{
+			for (auto &[v, c] : affine_terms)
+			{
+				f(c);
+			}
+		}
+	}
+	void _clear_affine_terms();
+	void _to_dense_affine();
+	void _to_hash_affine();
+	void _check_auto_dense_affine();
+	void _grow_dense_affine(IndexT i);
 };
 
 auto operator+(const VariableIndex &a, CoeffT b) -> ScalarAffineFunction;
@@ -228,6 +300,30 @@ auto operator-(const ScalarAffineFunction &a) -> ScalarAffineFunction;
 auto operator-(const ScalarQuadraticFunction &a) -> ScalarQuadraticFunction;
 auto operator-(const ExprBuilder &a) -> ExprBuilder;
 
+// rvalue overloads reuse the buffers of the left operand, so chains like a * x + b * y - c
+// do not copy the terms of every intermediate result
+auto operator+(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction;
+auto operator+(ScalarAffineFunction &&a, const VariableIndex &b) -> ScalarAffineFunction;
+auto operator+(ScalarAffineFunction &&a, const ScalarAffineFunction &b) -> ScalarAffineFunction;
+auto operator-(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction;
+auto operator-(ScalarAffineFunction &&a, const VariableIndex &b) -> ScalarAffineFunction;
+auto operator-(ScalarAffineFunction &&a, const ScalarAffineFunction &b) -> ScalarAffineFunction;
+auto operator*(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction;
+auto operator/(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction;
+auto operator-(ScalarAffineFunction &&a) -> ScalarAffineFunction;
+
+auto operator+(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction;
+auto operator+(ScalarQuadraticFunction &&a, const VariableIndex &b) -> ScalarQuadraticFunction;
+auto operator+(ScalarQuadraticFunction &&a, const ScalarAffineFunction &b)
+    -> ScalarQuadraticFunction;
+auto operator-(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction;
+auto operator-(ScalarQuadraticFunction &&a, const VariableIndex &b) -> ScalarQuadraticFunction;
+auto operator-(ScalarQuadraticFunction &&a, const ScalarAffineFunction &b)
+    -> ScalarQuadraticFunction;
+auto operator*(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction;
+auto operator/(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction;
+auto operator-(ScalarQuadraticFunction &&a) -> ScalarQuadraticFunction;
+
 // Operator overloading for	ExprBuilder
 // Sadly, they are inefficient than the +=,-=,*=,/= functions but they are important for a
 // user-friendly interface
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "pyoptinterface/cppad_interface.hpp"
+
+// number of arguments of the operators that appear in the graphs produced by cppad_autodiff
+size_t graph_op_n_arg(CppAD::graph::graph_op_enum op);
+
+enum class CodegenTarget
+{
+	C,
+	LLVM
+};
+
+// Options of one generated function
+// The function is void name(x, [p], [w], y, [xi], [pi], [wi], [yi]), where p exists if np > 0 and
+// w exists for the Hessian of Lagrangian. The batched function evaluates n instances in one call:
+// void batch_name(n, x, [p], [w], y, xi, [yi]), the inputs of instance i are xi + i * nx and
+// p + i * np
+struct GraphCodegenOptions
+{
+	size_t np = 0;
+	bool hessian_lagrange = false;
+	size_t nw = 0;
+	bool indirect_x = false;
+	bool indirect_p = false;
+	bool indirect_w = false;
+	bool indirect_y = false;
+	// y[i] += value instead of y[i] = value
+	bool add_y = false;
+	// no batched function is generated if it is empty
+	std::string batch_name;
+	// whether w and y are advanced per instance in the batched function
+	bool batch_stride_w = true;
+	bool batch_stride_y = true;
+};
+
+// C source consumed by TCC
+void generate_csrc_prelude(std::string &code);
+void generate_csrc_from_graph(std::string &code, const CppAD::cpp_graph &graph,
+                              const std::string &name, const GraphCodegenOptions &options);
+
+// textual LLVM IR consumed by llvmlite
+// opaque_pointers spells all pointers as ptr instead of double* and i32*, it must match the
+// version of LLVM that parses the IR
+void generate_llvmir_prelude(std::string &code);
+void generate_llvmir_from_graph(std::string &code, const CppAD::cpp_graph &graph,
+                                const std::string &name, const GraphCodegenOptions &options,
+                                bool opaque_pointers);
+
+// a compilation unit that contains the code of some nonlinear groups
+struct CodegenModule
+{
+	std::string code;
+	// f, Jacobian and Hessian of each group with their batched versions
+	std::vector<std::string> export_functions;
+};
+
+// Generate code of the nonlinear constraint and objective groups from the CppAD graphs directly
+// The groups are distributed to several independent modules so that the modules can be generated
+// and compiled concurrently
+// The graphs and structures are referenced rather than copied, so they must outlive generate()
+class NLCodegen
+{
+  public:
+	void add_constraint_group(const CppADAutodiffGraph &graph,
+	                          const AutodiffSymbolicStructure &structure, const std::string &name);
+	void add_objective_group(const CppADAutodiffGraph &graph,
+	                         const AutodiffSymbolicStructure &structure, const std::string &name);
+
+	size_t n_groups() const;
+
+	// groups are assigned to at most n_modules modules to balance their number of operators, and
+	// the modules are generated on n_threads threads
+	std::vector<CodegenModule> generate(CodegenTarget target, size_t n_modules, size_t n_threads,
+	                                    bool opaque_pointers = false) const;
+
+  private:
+	struct Group
+	{
+		const CppADAutodiffGraph *graph;
+		const AutodiffSymbolicStructure *structure;
+		std::string name;
+		bool objective;
+	};
+
+	void generate_group(std::string &code, std::vector<std::string> &export_functions,
+	                    const Group &group, CodegenTarget target, bool opaque_pointers) const;
+
+	std::vector<Group> m_groups;
+};
@@ -1,11 +1,19 @@
 #pragma once
 
+#include <mutex>
+
 #include "cppad/cppad.hpp"
 #include "pyoptinterface/nlexpr.hpp"
 #include "pyoptinterface/nleval.hpp"
 
 using ADFunDouble = CppAD::ADFun<double>;
 
+// CppAD keeps the tape being recorded and its memory pool (thread_alloc) in global state, and it
+// is not set up for multiple threads, so all work with CppAD (recording, differentiation and
+// evaluation) holds this lock when models are built or solved concurrently
+// It is recursive because the functions below call each other
+std::recursive_mutex &cppad_mutex();
+
 ADFunDouble dense_jacobian(const ADFunDouble &f);
 
 using sparsity_pattern_t = CppAD::sparse_rc<std::vector<size_t>>;
@@ -17,8 +25,10 @@ struct JacobianHessianSparsityPattern
 	sparsity_pattern_t reduced_hessian;
 };
 
+// the patterns of Hessian are left empty if hessian is false
 JacobianHessianSparsityPattern jacobian_hessian_sparsity(ADFunDouble &f,
-                                                         HessianSparsityType hessian_sparsity);
+                                                         HessianSparsityType hessian_sparsity,
+                                                         bool hessian = true);
 
 // [p, x] -> Jacobian
 ADFunDouble sparse_jacobian(const ADFunDouble &f, const sparsity_pattern_t &pattern_jac,
@@ -46,5 +56,8 @@ struct CppADAutodiffGraph
 
 // Generate computational graph for the CppAD function (itself, Jacobian and Hessian)
 // Analyze its sparsity as well
+// hessian = false skips the sparsity analysis and the graph of Hessian, e.g. when the solver
+// approximates the Hessian by itself, so structure.has_hessian is false
 void cppad_autodiff(ADFunDouble &f, AutodiffSymbolicStructure &structure, CppADAutodiffGraph &graph,
-                    const std::vector<double> &x_values, const std::vector<double> &p_values);
+                    const std::vector<double> &x_values, const std::vector<double> &p_values,
+                    bool hessian = true);
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "pyoptinterface/nleval.hpp"
+#include "pyoptinterface/threadpool.hpp"
+
+// Assembles the sparsity pattern of a global hessian from the local entries of many functions.
+// Instead of looking up every entry in a hashmap, the (row, col) pairs are collected into a flat
+// array, radix sorted and deduplicated. The distinct nonzeros are numbered by row, then by column.
+// Entries added to different builders are never merged, so all entries of one hessian must go
+// through the same builder.
+class HessianPatternBuilder
+{
+  public:
+	explicit HessianPatternBuilder(HessianSparsityType hessian_type);
+
+	// reserves n entries, finalize writes the global index of the k-th entry to slots[k]
+	// slots must stay valid until finalize is called
+	// returns the position of the first entry, which is passed to set_entry
+	size_t add_entries(int *slots, size_t n);
+
+	// row and col are swapped to the triangle of the sparsity type
+	void set_entry(size_t position, int row, int col)
+	{
+		if (m_hessian_type == HessianSparsityType::Upper)
+		{
+			if (row > col)
+				std::swap(row, col);
+		}
+		else
+		{
+			if (row < col)
+				std::swap(row, col);
+		}
+		m_keys[position] = (uint64_t(uint32_t(row)) << 32) | uint32_t(col);
+	}
+
+	size_t n_entries() const;
+
+	// the distinct entries are appended to global_hessian_rows/cols and numbered from
+	// global_hessian_nnz
+	// if pool is not nullptr, sorting and scattering the indices run on its threads
+	void finalize(size_t &global_hessian_nnz, std::vector<int> &global_hessian_rows,
+	              std::vector<int> &global_hessian_cols, ThreadPool *pool = nullptr);
+
+  private:
+	HessianSparsityType m_hessian_type;
+
+	std::vector<uint64_t> m_keys;
+
+	// the entries [begin, begin of next range) write their global indices to slots
+	struct SlotRange
+	{
+		int *slots;
+		size_t begin;
+	};
+	std::vector<SlotRange> m_ranges;
+};
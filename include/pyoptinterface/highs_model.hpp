@@ -10,62 +10,66 @@
 #include "pyoptinterface/solver_common.hpp"
 #include "pyoptinterface/dylib.hpp"
 
-#define APILIST                     \
-	B(Highs_create);                \
-	B(Highs_destroy);               \
-	B(Highs_writeModel);            \
-	B(Highs_writeSolution);         \
-	B(Highs_writeSolutionPretty);   \
-	B(Highs_addCol);                \
-	B(Highs_passColName);           \
-	B(Highs_getColName);            \
-	B(Highs_getNumCol);             \
-	B(Highs_changeColIntegrality);  \
-	B(Highs_deleteColsBySet);       \
-	B(Highs_addRow);                \
-	B(Highs_passRowName);           \
-	B(Highs_getRowName);            \
-	B(Highs_getNumRow);             \
-	B(Highs_deleteRowsBySet);       \
-	B(Highs_passHessian);           \
-	B(Highs_changeColsCostByRange); \
-	B(Highs_changeObjectiveOffset); \
-	B(Highs_changeObjectiveSense);  \
-	B(Highs_run);                   \
-	B(Highs_getNumCols);            \
-	B(Highs_getNumRows);            \
-	B(Highs_getModelStatus);        \
-	B(Highs_getDualRay);            \
-	B(Highs_getPrimalRay);          \
-	B(Highs_getIntInfoValue);       \
-	B(Highs_getSolution);           \
-	B(Highs_getHessianNumNz);       \
-	B(Highs_getBasis);              \
-	B(Highs_version);               \
-	B(Highs_getRunTime);            \
-	B(Highs_getOptionType);         \
-	B(Highs_setBoolOptionValue);    \
-	B(Highs_setIntOptionValue);     \
-	B(Highs_setDoubleOptionValue);  \
-	B(Highs_setStringOptionValue);  \
-	B(Highs_getBoolOptionValue);    \
-	B(Highs_getIntOptionValue);     \
-	B(Highs_getDoubleOptionValue);  \
-	B(Highs_getStringOptionValue);  \
-	B(Highs_getInfoType);           \
-	B(Highs_getInt64InfoValue);     \
-	B(Highs_getDoubleInfoValue);    \
-	B(Highs_getColIntegrality);     \
-	B(Highs_changeColsBoundsBySet); \
-	B(Highs_getColsBySet);          \
-	B(Highs_getObjectiveSense);     \
-	B(Highs_getObjectiveValue);     \
-	B(Highs_getColsByRange);        \
-	B(Highs_setSolution);           \
-	B(Highs_getRowsBySet);          \
-	B(Highs_changeRowsBoundsBySet); \
-	B(Highs_changeCoeff);           \
-	B(Highs_changeColCost);
+#define APILIST                            \
+	B(Highs_create);                       \
+	B(Highs_destroy);                      \
+	B(Highs_writeModel);                   \
+	B(Highs_writeSolution);                \
+	B(Highs_writeSolutionPretty);          \
+	B(Highs_addCol);                       \
+	B(Highs_addCols);                      \
+	B(Highs_passColName);                  \
+	B(Highs_getColName);                   \
+	B(Highs_getNumCol);                    \
+	B(Highs_changeColIntegrality);         \
+	B(Highs_changeColsIntegralityByRange); \
+	B(Highs_deleteColsBySet);              \
+	B(Highs_addRow);                       \
+	B(Highs_addRows);                      \
+	B(Highs_passRowName);                  \
+	B(Highs_getRowName);                   \
+	B(Highs_getNumRow);                    \
+	B(Highs_deleteRowsBySet);              \
+	B(Highs_passHessian);                  \
+	B(Highs_changeColsCostByRange);        \
+	B(Highs_changeObjectiveOffset);        \
+	B(Highs_changeObjectiveSense);         \
+	B(Highs_run);                          \
+	B(Highs_getNumCols);                   \
+	B(Highs_getNumRows);                   \
+	B(Highs_getModelStatus);               \
+	B(Highs_getDualRay);                   \
+	B(Highs_getPrimalRay);                 \
+	B(Highs_getIntInfoValue);              \
+	B(Highs_getSolution);                  \
+	B(Highs_getHessianNumNz);              \
+	B(Highs_getBasis);                     \
+	B(Highs_version);                      \
+	B(Highs_getRunTime);                   \
+	B(Highs_getOptionType);                \
+	B(Highs_setBoolOptionValue);           \
+	B(Highs_setIntOptionValue);            \
+	B(Highs_setDoubleOptionValue);         \
+	B(Highs_setStringOptionValue);         \
+	B(Highs_getBoolOptionValue);           \
+	B(Highs_getIntOptionValue);            \
+	B(Highs_getDoubleOptionValue);         \
+	B(Highs_getStringOptionValue);         \
+	B(Highs_getInfoType);                  \
+	B(Highs_getInt64InfoValue);            \
+	B(Highs_getDoubleInfoValue);           \
+	B(Highs_getColIntegrality);            \
+	B(Highs_changeColsBoundsBySet);        \
+	B(Highs_getColsBySet);                 \
+	B(Highs_getObjectiveSense);            \
+	B(Highs_getObjectiveValue);            \
+	B(Highs_getColsByRange);               \
+	B(Highs_setSolution);                  \
+	B(Highs_getRowsBySet);                 \
+	B(Highs_changeRowsBoundsBySet);        \
+	B(Highs_changeCoeff);                  \
+	B(Highs_changeColCost);                \
+	B(Highs_changeColsCostBySet);
 
 namespace highs
 {
@@ -127,12 +131,19 @@ class POIHighsModel : public OnesideLinearConstraintMixin<POIHighsModel>,
 	VariableIndex add_variable(VariableDomain domain = VariableDomain::Continuous,
 	                           double lb = -kHighsInf, double ub = kHighsInf,
 	                           const char *name = nullptr);
+	// add N variables of the same domain, lb[i] and ub[i] are the bounds of the i-th variable
+	// the new variables have contiguous indices, the first one is returned
+	VariableIndex add_variables(int N, VariableDomain domain, const double *lb, const double *ub);
 	void delete_variable(const VariableIndex &variable);
 	void delete_variables(const Vector<VariableIndex> &variables);
 	bool is_variable_active(const VariableIndex &variable);
 	double get_variable_value(const VariableIndex &variable);
+	// values[i] is the value of the variable whose VariableIndex::index is variables[i]
+	void get_variable_values(int N, const int *variables, double *values);
 	std::string pprint_variable(const VariableIndex &variable);
 	void set_variable_bounds(const VariableIndex &variable, double lb, double ub);
+	// set the bounds of N variables whose VariableIndex::index are variables in one call
+	void set_variable_bounds(int N, const int *variables, const double *lb, const double *ub);
 
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
 	                                      ConstraintSense sense, CoeffT rhs,
@@ -140,6 +151,11 @@ class POIHighsModel : public OnesideLinearConstraintMixin<POIHighsModel>,
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
 	                                      const std::tuple<double, double> &interval,
 	                                      const char *name = nullptr);
+	// add M linear constraints whose coefficients are a CSR matrix with VariableIndex::index as
+	// columns, the new constraints have contiguous indices and the first one is returned
+	ConstraintIndex add_linear_constraints(int M, const int *indptr, const int *variables,
+	                                       const double *coefficients, ConstraintSense sense,
+	                                       const double *rhs);
 	ConstraintIndex add_quadratic_constraint(const ScalarQuadraticFunction &function,
 	                                         ConstraintSense sense, CoeffT rhs,
 	                                         const char *name = nullptr);
@@ -201,9 +217,14 @@ class POIHighsModel : public OnesideLinearConstraintMixin<POIHighsModel>,
 	double get_obj_value();
 
 	HighsInt _variable_index(const VariableIndex &variable);
+	// columns[i] is the column of variables[i] or -1 if it does not exist
+	void _variable_indices(std::span<const IndexT> variables, std::span<HighsInt> columns);
 	HighsInt _checked_variable_index(const VariableIndex &variable);
 	HighsInt _constraint_index(const ConstraintIndex &constraint);
 	HighsInt _checked_constraint_index(const ConstraintIndex &constraint);
+	// rows[i] is the row of the linear constraint constraints[i] or -1 if it does not exist
+	void _linear_constraint_indices(std::span<const IndexT> constraints,
+	                                std::span<HighsInt> rows);
 
 	// Primal start
 	void set_primal_start(const Vector<VariableIndex> &variables, const Vector<double> &values);
@@ -212,14 +233,19 @@ class POIHighsModel : public OnesideLinearConstraintMixin<POIHighsModel>,
 	// 1. set/get RHS of a constraint
 	double get_normalized_rhs(const ConstraintIndex &constraint);
 	void set_normalized_rhs(const ConstraintIndex &constraint, double value);
+	// constraints[i] is ConstraintIndex::index of a linear constraint
+	void set_normalized_rhs(int N, const int *constraints, const double *values);
 	// 2. set/get coefficient of variable in constraint
 	double get_normalized_coefficient(const ConstraintIndex &constraint,
 	                                  const VariableIndex &variable);
 	void set_normalized_coefficient(const ConstraintIndex &constraint,
 	                                const VariableIndex &variable, double value);
+	void set_normalized_coefficients(int N, const int *constraints, const int *variables,
+	                                 const double *values);
 	// 3. set/get linear coefficient of variable in objective
 	double get_objective_coefficient(const VariableIndex &variable);
 	void set_objective_coefficient(const VariableIndex &variable, double value);
+	void set_objective_coefficients(int N, const int *variables, const double *values);
 
   private:
 	MonotoneIndexer<HighsInt> m_variable_index;
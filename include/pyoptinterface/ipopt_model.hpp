@@ -41,6 +41,36 @@ struct IpoptResult
 	// store results
 	std::vector<double> x, g, mult_g, mult_x_L, mult_x_U;
 	double obj_val;
+	// the number of linear and quadratic constraints when it is solved, used to map mult_g back
+	// to the constraints
+	size_t n_linear_constraints = 0, n_quadratic_constraints = 0;
+};
+
+// accumulated wall-clock time and number of calls of a phase
+struct IpoptTimer
+{
+	size_t calls = 0;
+	double seconds = 0.0;
+};
+
+// time spent in a callback of Ipopt, the sub-phases are the parts computed by the linear,
+// quadratic and nonlinear evaluators
+struct IpoptCallbackProfile
+{
+	IpoptTimer total;
+	double linear_seconds = 0.0;
+	double quadratic_seconds = 0.0;
+	double nonlinear_seconds = 0.0;
+};
+
+// the time spent inside Ipopt itself is ipopt_solve minus the total time of the callbacks
+struct IpoptProfile
+{
+	IpoptCallbackProfile eval_f, eval_grad_f, eval_g, eval_jac_g, eval_h;
+	IpoptTimer analyze_structure, update_bounds, ipopt_solve;
+	// recorded by the Python model around CppAD tracing, code generation and JIT compilation of
+	// the nonlinear functions
+	IpoptTimer cppad_autodiff, codegen, jit_compile;
 };
 
 struct IpoptModel : public OnesideLinearConstraintMixin<IpoptModel>,
@@ -57,19 +87,30 @@ struct IpoptModel : public OnesideLinearConstraintMixin<IpoptModel>,
 
 	VariableIndex add_variable(double lb = -INFINITY, double ub = INFINITY, double start = 0.0,
 	                           const char *name = nullptr);
+	// add N variables, lb[i], ub[i] and start[i] are the bounds and start of the i-th variable
+	// the new variables have contiguous indices, the first one is returned
+	VariableIndex add_variables(int N, const double *lb, const double *ub, const double *start);
 	double get_variable_lb(const VariableIndex &variable);
 	double get_variable_ub(const VariableIndex &variable);
 	void set_variable_lb(const VariableIndex &variable, double lb);
 	void set_variable_ub(const VariableIndex &variable, double ub);
 	void set_variable_bounds(const VariableIndex &variable, double lb, double ub);
+	// set the bounds of N variables whose VariableIndex::index are variables in one call
+	void set_variable_bounds(int N, const int *variables, const double *lb, const double *ub);
 
 	double get_variable_start(const VariableIndex &variable);
 	void set_variable_start(const VariableIndex &variable, double start);
+	// the starting point of the multipliers of the lower and upper bound of variable, they are
+	// nonnegative and only used by Ipopt if the option warm_start_init_point is yes
+	void set_variable_bound_dual_start(const VariableIndex &variable, double lb_dual,
+	                                   double ub_dual);
 
 	std::string get_variable_name(const VariableIndex &variable);
 	void set_variable_name(const VariableIndex &variable, const std::string &name);
 
 	double get_variable_value(const VariableIndex &variable);
+	// values[i] is the value of the variable whose VariableIndex::index is variables[i]
+	void get_variable_values(int N, const int *variables, double *values);
 
 	std::string pprint_variable(const VariableIndex &variable);
 
@@ -77,12 +118,21 @@ struct IpoptModel : public OnesideLinearConstraintMixin<IpoptModel>,
 	int _constraint_internal_index(const ConstraintIndex &constraint);
 	double get_constraint_primal(const ConstraintIndex &constraint);
 	double get_constraint_dual(const ConstraintIndex &constraint);
+	// the starting point of the dual of constraint, it has the same sign as get_constraint_dual
+	double &_constraint_dual_start(const ConstraintIndex &constraint);
+	double get_constraint_dual_start(const ConstraintIndex &constraint);
+	void set_constraint_dual_start(const ConstraintIndex &constraint, double dual);
 
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &f, ConstraintSense sense,
 	                                      double rhs, const char *name = nullptr);
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &f,
 	                                      const std::tuple<double, double> &interval,
 	                                      const char *name = nullptr);
+	// add M linear constraints whose coefficients are a CSR matrix with VariableIndex::index as
+	// columns, the new constraints have contiguous indices and the first one is returned
+	ConstraintIndex add_linear_constraints(int M, const int *indptr, const int *variables,
+	                                       const double *coefficients, ConstraintSense sense,
+	                                       const double *rhs);
 
 	ConstraintIndex add_quadratic_constraint(const ScalarQuadraticFunction &f,
 	                                         ConstraintSense sense, double rhs,
@@ -98,61 +148,8 @@ struct IpoptModel : public OnesideLinearConstraintMixin<IpoptModel>,
 	void _set_linear_objective(const ScalarAffineFunction &expr);
 	void _set_quadratic_objective(const ScalarQuadraticFunction &expr);
 
-	// new implementation
-	size_t n_graph_instances = 0;
-	std::vector<std::vector<int>> m_graph_instance_variables;
-	std::vector<std::vector<double>> m_graph_instance_constants;
-	// record graph instances with constraint output and objective output
-	struct GraphInstancesInfo
-	{
-		// hash of this graph instance
-		std::vector<uint64_t> hashes;
-		// index of this graph instance
-		std::vector<int> instance_indices;
-
-		size_t n_instances_since_last_aggregation;
-	} nl_constraint_info, nl_objective_info;
-
-	// length = n_graph_instances
-	struct GraphInstancesGroupInfo
-	{
-		// which group it belongs to
-		std::vector<int> group_indices;
-		// the number in that group
-		std::vector<int> group_orders;
-	} nl_constraint_group_info, nl_objective_group_info;
-
-	// graph groups
-	struct
-	{
-		Hashmap<uint64_t, int> hash_to_group;
-		size_t n_group = 0;
-		std::vector<int> representative_graph_indices;
-		std::vector<std::vector<int>> instance_indices;
-		std::vector<AutodiffSymbolicStructure> autodiff_structures;
-		std::vector<ConstraintAutodiffEvaluator> autodiff_evaluators;
-
-		// where to store the hessian matrix, each group length = n_instance * local_hessian_nnz
-		std::vector<std::vector<int>> hessian_indices;
-	} nl_constraint_groups;
-
-	struct
-	{
-		Hashmap<uint64_t, int> hash_to_group;
-		size_t n_group = 0;
-		std::vector<int> representative_graph_indices;
-		std::vector<std::vector<int>> instance_indices;
-		std::vector<AutodiffSymbolicStructure> autodiff_structures;
-		std::vector<ObjectiveAutodiffEvaluator> autodiff_evaluators;
-
-		// where to store the gradient vector, each group length = n_instance * local_jacobian_nnz
-		std::vector<std::vector<int>> gradient_indices;
-		// where to store the hessian matrix, each group length = n_instance * local_hessian_nnz
-		std::vector<std::vector<int>> hessian_indices;
-	} nl_objective_groups;
-
 	int add_graph_index();
-	void finalize_graph_instance(size_t graph_index, const ExpressionGraph &graph);
+	void finalize_graph_instance(size_t graph_index, ExpressionGraph &graph);
 	int aggregate_nl_constraint_groups();
 	int get_nl_constraint_group_representative(int group_index) const;
 	int aggregate_nl_objective_groups();
@@ -173,16 +170,51 @@ struct IpoptModel : public OnesideLinearConstraintMixin<IpoptModel>,
 	// void clear_nl_objective();
 
 	void analyze_structure();
+	// the sparsity pattern of the Hessian of Lagrangian, not needed in limited-memory mode
+	void analyze_hessian_structure();
+	// the rows of the nonlinear constraints and the jacobian entries that the affine and quadratic
+	// terms split off them are added to
+	void analyze_nl_quadratic_jacobian_structure(size_t nl_constraint_start,
+	                                             size_t nl_jacobian_start);
+	void update_bounds();
 	void optimize();
 
-	// load current solution as	initial guess
+	// parameters that can be used in nonlinear expressions, changing their values does not
+	// require rebuilding or recompiling the nonlinear functions
+	ParameterIndex add_parameter(double value = 0.0);
+	void set_parameter(const ParameterIndex &parameter, double value);
+	double get_parameter(const ParameterIndex &parameter) const;
+
+	// load current solution as	initial guess, including the duals of constraints and bounds
 	void load_current_solution();
 
+	// write the linear and quadratic parts of the model to an MPS or LP file, the model must not
+	// contain nonlinear functions
+	void write(const std::string &filename);
+
 	// set options
 	void set_raw_option_int(const std::string &name, int value);
 	void set_raw_option_double(const std::string &name, double value);
 	void set_raw_option_string(const std::string &name, const std::string &value);
 
+	// true if the option hessian_approximation is limited-memory, then Ipopt never calls eval_h
+	// and the Hessian of Lagrangian is neither analyzed nor differentiated
+	bool is_limited_memory_hessian() const;
+
+	// evaluate nonlinear constraints, jacobian and hessian with multiple threads
+	// n_threads <= 1 means serial evaluation
+	void set_nl_eval_threads(int n_threads);
+	int get_nl_eval_threads() const;
+
+	// assemble the sparsity pattern of hessian by sorting the entries instead of a hashmap
+	// it is faster and uses less memory for models with many nonlinear instances
+	void set_sorted_hessian_assembly(bool enable);
+	bool get_sorted_hessian_assembly() const;
+
+	// timings of callbacks and of the preparation of the problem, accumulated across optimize
+	// calls until reset_profile is called
+	void reset_profile();
+
 	/* Members */
 
 	size_t n_variables = 0;
@@ -209,16 +241,41 @@ struct IpoptModel : public OnesideLinearConstraintMixin<IpoptModel>,
 	// int means the internal order that passes to Ipopt
 	std::vector<int> nl_constraint_map_ext2int;
 
+	// the affine and quadratic terms split off the outputs of nonlinear constraints when their
+	// graphs are finalized, row i is added to the nonlinear constraint described by
+	// m_nl_quadratic_con_memberships[i]
+	QuadraticEvaluator m_nl_quadratic_con_evaluator;
+	std::vector<ConstraintGraphMembership> m_nl_quadratic_con_memberships;
+	// constructed before optimization: the index of row i in the constraints passed to Ipopt and
+	// the global indices of its jacobian entries, the entries from
+	// m_nl_quadratic_jacobian_start are not shared with the nonlinear part
+	std::vector<int> m_nl_quadratic_con_rows;
+	std::vector<int> m_nl_quadratic_jacobian_indices;
+	size_t m_nl_quadratic_jacobian_start = 0;
+	std::vector<double> m_nl_quadratic_con_buffer;
+
+	// the affine and quadratic terms split off nonlinear objectives
+	ExprBuilder m_nl_quadratic_obj;
+	std::optional<QuadraticEvaluator> m_nl_quadratic_obj_evaluator;
+	// the position of its gradient in sparse_gradient_values
+	size_t m_nl_quadratic_obj_gradient_offset = 0;
+
 	// we need a sparse vector to store the gradient
 	std::vector<double> sparse_gradient_values;
 	std::vector<int> sparse_gradient_indices;
 
 	std::vector<double> m_var_lb, m_var_ub, m_var_init;
+	// the starting point of duals in the order of adding variables and constraints, they are
+	// resized lazily and mapped to the order of Ipopt in optimize
+	std::vector<double> m_var_lb_dual_init, m_var_ub_dual_init;
+	std::vector<double> m_linear_con_dual_init, m_quadratic_con_dual_init, m_nl_con_dual_init;
 	std::vector<double> m_linear_con_lb, m_linear_con_ub, m_quadratic_con_lb, m_quadratic_con_ub,
 	    m_nl_con_lb, m_nl_con_ub, m_con_lb, m_con_ub;
 
 	Hashmap<IndexT, std::string> m_var_names;
 
+	std::vector<double> m_parameter_values;
+
 	size_t m_jacobian_nnz = 0;
 	std::vector<int> m_jacobian_rows, m_jacobian_cols;
 
@@ -234,13 +291,27 @@ struct IpoptModel : public OnesideLinearConstraintMixin<IpoptModel>,
 
 	NonlinearEvaluator m_nl_evaluator;
 
+	// thread pool used to evaluate m_nl_evaluator in parallel, nullptr means serial evaluation
+	std::unique_ptr<ThreadPool> m_nl_thread_pool = nullptr;
+
+	bool m_sorted_hessian_assembly = false;
+
+	bool m_limited_memory_hessian = false;
+
+	IpoptProfile m_profile;
+
 	// The options of the Ipopt solver, we cache them before constructing the m_problem
 	Hashmap<std::string, int> m_options_int;
 	Hashmap<std::string, double> m_options_num;
 	Hashmap<std::string, std::string> m_options_str;
 
 	IpoptResult m_result;
+	// m_is_dirty means the result is outdated
 	bool m_is_dirty = true;
+	// the sparsity structure must be analyzed again (new variables, constraints or objective)
+	bool m_structure_dirty = true;
+	// the bounds of variables have changed, so m_problem must be recreated
+	bool m_bounds_dirty = true;
 	enum ApplicationReturnStatus m_status;
 
 	std::unique_ptr<IpoptProblemInfo, IpoptfreeproblemT> m_problem = nullptr;
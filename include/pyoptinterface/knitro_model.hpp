@@ -10,6 +10,7 @@
 #include "pyoptinterface/core.hpp"
 #include "pyoptinterface/container.hpp"
 #include "pyoptinterface/cppad_interface.hpp"
+#include "pyoptinterface/nleval.hpp"
 #define USE_NLMIXIN
 #include "pyoptinterface/solver_common.hpp"
 #include "pyoptinterface/dylib.hpp"
@@ -31,17 +32,24 @@
 	B(KN_get_int_param);                \
 	B(KN_get_double_param);             \
 	B(KN_add_var);                      \
+	B(KN_add_vars);                     \
 	B(KN_add_con);                      \
+	B(KN_add_cons);                     \
 	B(KN_set_var_lobnd);                \
 	B(KN_set_var_upbnd);                \
+	B(KN_set_var_lobnds);               \
+	B(KN_set_var_upbnds);               \
 	B(KN_get_var_lobnd);                \
 	B(KN_get_var_upbnd);                \
 	B(KN_set_var_type);                 \
+	B(KN_set_var_types);                \
 	B(KN_get_var_type);                 \
 	B(KN_set_var_name);                 \
 	B(KN_get_var_name);                 \
 	B(KN_set_con_lobnd);                \
 	B(KN_set_con_upbnd);                \
+	B(KN_set_con_lobnds);               \
+	B(KN_set_con_upbnds);               \
 	B(KN_get_con_lobnd);                \
 	B(KN_get_con_upbnd);                \
 	B(KN_set_con_name);                 \
@@ -56,18 +64,21 @@
 	B(KN_add_obj_quadratic_struct);     \
 	B(KN_del_obj_quadratic_struct_all); \
 	B(KN_chg_obj_linear_term);          \
+	B(KN_chg_obj_linear_struct);        \
 	B(KN_add_con_constant);             \
 	B(KN_add_con_linear_struct);        \
 	B(KN_add_con_linear_term);          \
 	B(KN_add_con_quadratic_struct);     \
 	B(KN_add_con_quadratic_term);       \
 	B(KN_chg_con_linear_term);          \
+	B(KN_chg_con_linear_struct);        \
 	B(KN_add_eval_callback);            \
 	B(KN_set_cb_user_params);           \
 	B(KN_set_cb_grad);                  \
 	B(KN_set_cb_hess);                  \
 	B(KN_del_obj_eval_callback_all);    \
 	B(KN_get_var_primal_value);         \
+	B(KN_get_var_primal_values);        \
 	B(KN_get_var_dual_value);           \
 	B(KN_get_con_value);                \
 	B(KN_get_con_dual_value);           \
@@ -169,6 +180,8 @@ struct CallbackEvaluator
 
 	void setup()
 	{
+		// it is called in optimize() without the GIL, and it records the tape of Jacobian
+		std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 		fun.optimize();
 		size_t nx = fun.Domain();
 		size_t ny = fun.Range();
@@ -226,6 +239,7 @@ struct CallbackEvaluator
 
 	void eval_fun(const V *req_x, V *res_y)
 	{
+		std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 		copy(fun.Domain(), req_x, indexVars.data(), x.data());
 		auto y = fun.Forward(0, x);
 		int mode = is_objective() ? 2 : 0;
@@ -234,6 +248,7 @@ struct CallbackEvaluator
 
 	void eval_jac(const V *req_x, V *res_jac)
 	{
+		std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 		copy(fun.Domain(), req_x, indexVars.data(), x.data());
 		fun.sparse_jac_rev(x, jac, jp, CLRNG, jw);
 		copy(jac.nnz(), jac.val().data(), (const I *)nullptr, res_jac);
@@ -241,6 +256,7 @@ struct CallbackEvaluator
 
 	void eval_hess(const V *req_x, const V *req_w, V *res_hess)
 	{
+		std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 		copy(fun.Domain(), req_x, indexVars.data(), xw.data());
 		int mode = is_objective() ? 1 : 0;
 		copy(fun.Range(), req_w, indexCons.data(), xw.data() + fun.Domain(), mode);
@@ -328,6 +344,50 @@ struct CallbackEvaluator
 	}
 };
 
+// Evaluates the nonlinear functions of the graphs registered by KNITROModel::add_graph_index
+// between two solves. The graphs are grouped by structure in a NonlinearEvaluator and each group is
+// evaluated by the kernels compiled for it, so all nonlinear constraints of the batch share one
+// KNITRO callback and all nonlinear objectives share another one.
+struct GroupedCallbackEvaluator
+{
+	struct ConstraintOutput
+	{
+		int graph;
+		int rank;
+		KNINT indexCon;
+	};
+
+	NonlinearEvaluator evaluator;
+	Hashmap<const ExpressionGraph *, int> graph_indices;
+	std::vector<ExpressionGraph *> graphs;
+	std::vector<ConstraintOutput> constraint_outputs;
+	size_t n_finalized_graphs = 0;
+
+	// indexCons[i] is the KNITRO constraint of the i-th output of evaluator
+	std::vector<KNINT> indexCons;
+	size_t constraint_hessian_nnz = 0;
+	size_t objective_gradient_nnz = 0;
+	size_t objective_hessian_nnz = 0;
+
+	bool has_constraints() const;
+	bool has_objective() const;
+
+	// throws if some graph is not finalized or some group has no compiled kernels
+	void check_compiled() const;
+	// analyzes the sparsity pattern of the callbacks, the hessian is upper triangular
+	void analyze_structure(CallbackPattern<KNINT> &constraint_pattern,
+	                       CallbackPattern<KNINT> &objective_pattern);
+
+	void eval_constraints(const double *x, double *c) const;
+	void eval_constraints_jacobian(const double *x, double *jac) const;
+	// the multipliers of indexCons are gathered into a buffer local to each call, so concurrent
+	// callbacks do not share any state
+	void eval_constraints_hessian(const double *x, const double *req_lambda, double *hess) const;
+	double eval_objective(const double *x) const;
+	void eval_objective_gradient(const double *x, double *grad) const;
+	void eval_objective_hessian(const double *x, const double *sigma, double *hess) const;
+};
+
 inline bool is_name_empty(const char *name)
 {
 	return name == nullptr || name[0] == '\0';
@@ -451,13 +511,20 @@ class KNITROModel : public OnesideLinearConstraintMixin<KNITROModel>,
 	VariableIndex add_variable(VariableDomain domain = VariableDomain::Continuous,
 	                           double lb = -KN_INFINITY, double ub = KN_INFINITY,
 	                           const char *name = nullptr);
+	// add N variables of the same domain, lb[i] and ub[i] are the bounds of the i-th variable
+	// the new variables have contiguous indices, the first one is returned
+	VariableIndex add_variables(int N, VariableDomain domain, const double *lb, const double *ub);
 	void delete_variable(const VariableIndex &variable);
 	double get_variable_lb(const VariableIndex &variable) const;
 	double get_variable_ub(const VariableIndex &variable) const;
 	void set_variable_lb(const VariableIndex &variable, double lb);
 	void set_variable_ub(const VariableIndex &variable, double ub);
 	void set_variable_bounds(const VariableIndex &variable, double lb, double ub);
+	// set the bounds of N variables whose VariableIndex::index are variables in one call
+	void set_variable_bounds(int N, const int *variables, const double *lb, const double *ub);
 	double get_variable_value(const VariableIndex &variable) const;
+	// values[i] is the value of the variable whose VariableIndex::index is variables[i]
+	void get_variable_values(int N, const int *variables, double *values) const;
 	void set_variable_start(const VariableIndex &variable, double start);
 	std::string get_variable_name(const VariableIndex &variable) const;
 	void set_variable_name(const VariableIndex &variable, const std::string &name);
@@ -472,6 +539,11 @@ class KNITROModel : public OnesideLinearConstraintMixin<KNITROModel>,
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &f,
 	                                      const std::tuple<double, double> &interval,
 	                                      const char *name = nullptr);
+	// add M linear constraints whose coefficients are a CSR matrix with VariableIndex::index as
+	// columns, the new constraints have contiguous indices and the first one is returned
+	ConstraintIndex add_linear_constraints(int M, const int *indptr, const int *variables,
+	                                       const double *coefficients, ConstraintSense sense,
+	                                       const double *rhs);
 	ConstraintIndex add_quadratic_constraint(const ScalarQuadraticFunction &f,
 	                                         ConstraintSense sense, double rhs,
 	                                         const char *name = nullptr);
@@ -493,9 +565,13 @@ class KNITROModel : public OnesideLinearConstraintMixin<KNITROModel>,
 	double get_constraint_primal(const ConstraintIndex &constraint) const;
 	double get_constraint_dual(const ConstraintIndex &constraint) const;
 	void set_normalized_rhs(const ConstraintIndex &constraint, double rhs);
+	// constraints[i] is ConstraintIndex::index of a linear constraint
+	void set_normalized_rhs(int N, const int *constraints, const double *values);
 	double get_normalized_rhs(const ConstraintIndex &constraint) const;
 	void set_normalized_coefficient(const ConstraintIndex &constraint,
 	                                const VariableIndex &variable, double coefficient);
+	void set_normalized_coefficients(int N, const int *constraints, const int *variables,
+	                                 const double *values);
 
 	// Objective functions
 	void set_objective(const ScalarAffineFunction &f, ObjectiveSense sense);
@@ -506,6 +582,26 @@ class KNITROModel : public OnesideLinearConstraintMixin<KNITROModel>,
 	void set_obj_sense(ObjectiveSense sense);
 	ObjectiveSense get_obj_sense() const;
 	void set_objective_coefficient(const VariableIndex &variable, double coefficient);
+	void set_objective_coefficients(int N, const int *variables, const double *values);
+
+	// Grouped nonlinear functions
+	// the nonlinear constraints and objectives of a graph registered by add_graph_index are not
+	// traced by CppAD, every group of structurally identical graphs registered since the last solve
+	// is evaluated by the jit-compiled kernels assigned to it
+	int add_graph_index(ExpressionGraph &graph);
+	void finalize_graph_instance(size_t graph_index, ExpressionGraph &graph);
+	int aggregate_nl_constraint_groups();
+	int get_nl_constraint_group_representative(int group_index) const;
+	int aggregate_nl_objective_groups();
+	int get_nl_objective_group_representative(int group_index) const;
+	void assign_nl_constraint_group_autodiff_structure(int group_index,
+	                                                   const AutodiffSymbolicStructure &structure);
+	void assign_nl_constraint_group_autodiff_evaluator(
+	    int group_index, const ConstraintAutodiffEvaluator &evaluator);
+	void assign_nl_objective_group_autodiff_structure(int group_index,
+	                                                  const AutodiffSymbolicStructure &structure);
+	void assign_nl_objective_group_autodiff_evaluator(int group_index,
+	                                                  const ObjectiveAutodiffEvaluator &evaluator);
 
 	// Solve functions
 	void optimize();
@@ -593,6 +689,7 @@ class KNITROModel : public OnesideLinearConstraintMixin<KNITROModel>,
 	void _unmark_dirty();
 	void _check_dirty() const;
 	KNINT _variable_index(const VariableIndex &variable) const;
+	void _variable_indices(std::span<const IndexT> variables, std::span<KNINT> columns) const;
 	KNINT _constraint_index(const ConstraintIndex &constraint) const;
 
 	size_t get_num_vars() const;
@@ -621,6 +718,10 @@ class KNITROModel : public OnesideLinearConstraintMixin<KNITROModel>,
 	std::unordered_map<ExpressionGraph *, Outputs> m_pending_outputs;
 	std::vector<std::unique_ptr<Evaluator>> m_evaluators;
 	bool m_has_pending_callbacks = false;
+
+	// graphs registered by add_graph_index since the last solve
+	std::unique_ptr<GroupedCallbackEvaluator> m_pending_grouped_evaluator;
+	std::vector<std::unique_ptr<GroupedCallbackEvaluator>> m_grouped_evaluators;
 	int m_solve_status = 0;
 	bool m_is_dirty = true;
 
@@ -646,6 +747,9 @@ class KNITROModel : public OnesideLinearConstraintMixin<KNITROModel>,
 	void _add_callback(const ExpressionGraph &graph, const std::vector<size_t> &outputs,
 	                   const std::vector<ConstraintIndex> &constraints);
 	void _register_callback(Evaluator *evaluator);
+	GroupedCallbackEvaluator &_pending_grouped_evaluator();
+	int _grouped_graph_index(const ExpressionGraph &graph) const;
+	void _add_grouped_callbacks();
 	void _update();
 	void _pre_solve();
 	void _solve();
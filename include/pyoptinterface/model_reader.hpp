@@ -0,0 +1,26 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "pyoptinterface/cache_model.hpp"
+
+// This file defines a reader of MPS files that builds the model in a CacheModel, the cached model
+// can then be loaded into any solver model with load_cache_model
+
+// the names of variables, linear constraints and quadratic constraints in the order they are
+// stored in the CacheModel
+struct ModelFileNames
+{
+	std::vector<std::string> variables;
+	std::vector<std::string> linear_constraints;
+	std::vector<std::string> quadratic_constraints;
+};
+
+// read a free or fixed MPS file without spaces in names into an empty CacheModel, the lines are
+// split by whitespace and a line with a wrong number of fields is rejected
+// the COLUMNS section of a large file is tokenized by n_threads threads in parallel,
+// n_threads <= 0 means the number of hardware threads
+// a ranged row is stored as two linear constraints named {name}_lb and {name}_ub, free rows
+// except the objective are dropped
+ModelFileNames read_mps(CacheModel &model, const std::string &filename, int n_threads = 0);
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+
+#include "pyoptinterface/core.hpp"
+
+// This file defines a solver-independent writer of MPS and LP files
+// The writer only borrows the arrays of ModelWriterInput, so a model stored in compact form can be
+// written without copying the whole matrix
+// Variables are named x0, x1, ..., linear constraints c0, c1, ... and quadratic constraints q0,
+// q1, ... in the order they are stored
+
+struct ModelWriterInput
+{
+	int n_variables = 0;
+	// nullptr means that all variables are continuous
+	const VariableDomain *variable_domains = nullptr;
+	const double *variable_lbs = nullptr;
+	const double *variable_ubs = nullptr;
+
+	// linear constraints lb <= a'x <= ub in CSR format, row i is [indptr[i], indptr[i + 1])
+	int n_linear_constraints = 0;
+	const int *linear_indptr = nullptr;
+	const int *linear_variables = nullptr;
+	const double *linear_coefficients = nullptr;
+	const double *linear_lbs = nullptr;
+	const double *linear_ubs = nullptr;
+
+	// quadratic constraints lb <= x'Qx + a'x <= ub, the quadratic terms and linear terms of each
+	// row are stored in CSR format separately, at most one side of the interval can be finite
+	int n_quadratic_constraints = 0;
+	const int *quadratic_indptr = nullptr;
+	const int *quadratic_variable_1s = nullptr;
+	const int *quadratic_variable_2s = nullptr;
+	const double *quadratic_coefficients = nullptr;
+	const int *quadratic_lin_indptr = nullptr;
+	const int *quadratic_lin_variables = nullptr;
+	const double *quadratic_lin_coefficients = nullptr;
+	const double *quadratic_lbs = nullptr;
+	const double *quadratic_ubs = nullptr;
+
+	// nullptr means that the model has no objective
+	const ScalarQuadraticFunction *objective = nullptr;
+	ObjectiveSense objective_sense = ObjectiveSense::Minimize;
+};
+
+void write_mps(const ModelWriterInput &model, const std::string &filename);
+void write_lp(const ModelWriterInput &model, const std::string &filename);
+// chooses the format by the extension of filename, only .mps and .lp are supported
+void write_model(const ModelWriterInput &model, const std::string &filename);
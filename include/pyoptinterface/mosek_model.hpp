@@ -22,14 +22,18 @@
 	B(MSK_appendvars);                 \
 	B(MSK_getnumvar);                  \
 	B(MSK_putvartype);                 \
+	B(MSK_putvartypelist);             \
 	B(MSK_putvarbound);                \
+	B(MSK_putvarboundslice);           \
 	B(MSK_putvarname);                 \
 	B(MSK_removevars);                 \
 	B(MSK_getxxslice);                 \
 	B(MSK_appendcons);                 \
 	B(MSK_getnumcon);                  \
 	B(MSK_putarow);                    \
+	B(MSK_putarowslice);               \
 	B(MSK_putconbound);                \
+	B(MSK_putconboundslice);           \
 	B(MSK_putconname);                 \
 	B(MSK_putqconk);                   \
 	B(MSK_getnumafe);                  \
@@ -79,8 +83,12 @@
 	B(MSK_getconbound);                \
 	B(MSK_getaij);                     \
 	B(MSK_putaij);                     \
+	B(MSK_putaijlist);                 \
 	B(MSK_getcj);                      \
 	B(MSK_putcj);                      \
+	B(MSK_putclist);                   \
+	B(MSK_putconboundlist);            \
+	B(MSK_putvarboundlist);            \
 	B(MSK_getversion);                 \
 	B(MSK_solutiondef);                \
 	B(MSK_makeenv);                    \
@@ -149,14 +157,19 @@ class MOSEKModel : public OnesideLinearConstraintMixin<MOSEKModel>,
 	VariableIndex add_variable(VariableDomain domain = VariableDomain::Continuous,
 	                           double lb = -MSK_INFINITY, double ub = MSK_INFINITY,
 	                           const char *name = nullptr);
-	/*VariableIndex add_variables(int N, VariableDomain domain = VariableDomain::Continuous,
-	                            double lb = -MSK_INFINITY, double ub = MSK_INFINITY);*/
+	// add N variables of the same domain, lb[i] and ub[i] are the bounds of the i-th variable
+	// the new variables have contiguous indices, the first one is returned
+	VariableIndex add_variables(int N, VariableDomain domain, const double *lb, const double *ub);
 	void delete_variable(const VariableIndex &variable);
 	void delete_variables(const Vector<VariableIndex> &variables);
 	bool is_variable_active(const VariableIndex &variable);
 	double get_variable_value(const VariableIndex &variable);
+	// values[i] is the value of the variable whose VariableIndex::index is variables[i]
+	void get_variable_values(int N, const int *variables, double *values);
 	std::string pprint_variable(const VariableIndex &variable);
 	void set_variable_bounds(const VariableIndex &variable, double lb, double ub);
+	// set the bounds of N variables whose VariableIndex::index are variables in one call
+	void set_variable_bounds(int N, const int *variables, const double *lb, const double *ub);
 
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
 	                                      ConstraintSense sense, CoeffT rhs,
@@ -164,6 +177,11 @@ class MOSEKModel : public OnesideLinearConstraintMixin<MOSEKModel>,
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
 	                                      const std::tuple<double, double> &interval,
 	                                      const char *name = nullptr);
+	// add M linear constraints whose coefficients are a CSR matrix with VariableIndex::index as
+	// columns, the new constraints have contiguous indices and the first one is returned
+	ConstraintIndex add_linear_constraints(int M, const int *indptr, const int *variables,
+	                                       const double *coefficients, ConstraintSense sense,
+	                                       const double *rhs);
 	ConstraintIndex add_quadratic_constraint(const ScalarQuadraticFunction &function,
 	                                         ConstraintSense sense, CoeffT rhs,
 	                                         const char *name = nullptr);
@@ -245,19 +263,29 @@ class MOSEKModel : public OnesideLinearConstraintMixin<MOSEKModel>,
 	// 1. set/get RHS of a constraint
 	double get_normalized_rhs(const ConstraintIndex &constraint);
 	void set_normalized_rhs(const ConstraintIndex &constraint, double value);
+	// constraints[i] is ConstraintIndex::index of a linear constraint
+	void set_normalized_rhs(int N, const int *constraints, const double *values);
 	// 2. set/get coefficient of variable in constraint
 	double get_normalized_coefficient(const ConstraintIndex &constraint,
 	                                  const VariableIndex &variable);
 	void set_normalized_coefficient(const ConstraintIndex &constraint,
 	                                const VariableIndex &variable, double value);
+	void set_normalized_coefficients(int N, const int *constraints, const int *variables,
+	                                 const double *values);
 	// 3. set/get linear coefficient of variable in objective
 	double get_objective_coefficient(const VariableIndex &variable);
 	void set_objective_coefficient(const VariableIndex &variable, double value);
+	void set_objective_coefficients(int N, const int *variables, const double *values);
 
 	MSKint32t _variable_index(const VariableIndex &variable);
+	// columns[i] is the column of variables[i] or -1 if it does not exist
+	void _variable_indices(std::span<const IndexT> variables, std::span<MSKint32t> columns);
 	MSKint32t _checked_variable_index(const VariableIndex &variable);
 	MSKint32t _constraint_index(const ConstraintIndex &constraint);
 	MSKint32t _checked_constraint_index(const ConstraintIndex &constraint);
+	// rows[i] is the row of the linear constraint constraints[i] or -1 if it does not exist
+	void _linear_constraint_indices(std::span<const IndexT> constraints,
+	                                std::span<MSKint32t> rows);
 
 	// Control logging
 	void set_logging(const MOSEKLoggingCallback &callback);
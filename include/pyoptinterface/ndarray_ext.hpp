@@ -0,0 +1,281 @@
+#pragma once
+
+// helpers for the bulk APIs of solver bindings that take numpy arrays
+// only included by *_ext.cpp
+
+#include <nanobind/nanobind.h>
+#include <nanobind/ndarray.h>
+#include <nanobind/stl/optional.h>
+#include <nanobind/stl/tuple.h>
+#include <nanobind/stl/vector.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "fmt/format.h"
+#include "pyoptinterface/core.hpp"
+
+namespace nb = nanobind;
+
+using DoubleArrayT = nb::ndarray<const double, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+// the dtype of indices is checked by IndexArray, so that both int32 and the default int64 of
+// numpy are accepted
+using IndexArrayT = nb::ndarray<nb::ro, nb::ndim<1>, nb::c_contig, nb::device::cpu>;
+
+inline void check_array_size(size_t size, size_t n, const char *name)
+{
+	if (size != n)
+	{
+		throw std::runtime_error(
+		    fmt::format("The length of {} is {}, but {} is expected", name, size, n));
+	}
+}
+
+// indices of variables or constraints given by a numpy array of int32 or int64
+// int32 arrays are used in place, int64 arrays are narrowed into a buffer
+class IndexArray
+{
+  public:
+	IndexArray(const IndexArrayT &array, const char *name) : m_size(array.size())
+	{
+		if (array.dtype() == nb::dtype<int32_t>())
+		{
+			m_data = static_cast<const int *>(array.data());
+		}
+		else if (array.dtype() == nb::dtype<int64_t>())
+		{
+			auto values = static_cast<const int64_t *>(array.data());
+			m_buffer.resize(m_size);
+			for (size_t i = 0; i < m_size; i++)
+			{
+				if (values[i] < std::numeric_limits<int>::min() ||
+				    values[i] > std::numeric_limits<int>::max())
+				{
+					throw std::runtime_error(fmt::format("{}[{}] = {} is out of the range of int32",
+					                                     name, i, values[i]));
+				}
+				m_buffer[i] = values[i];
+			}
+			m_data = m_buffer.data();
+		}
+		else
+		{
+			throw std::runtime_error(fmt::format("The dtype of {} must be int32 or int64", name));
+		}
+	}
+
+	size_t size() const
+	{
+		return m_size;
+	}
+	const int *data() const
+	{
+		return m_data;
+	}
+
+  private:
+	const int *m_data = nullptr;
+	size_t m_size;
+	std::vector<int> m_buffer;
+};
+
+inline void check_variable_count(int N)
+{
+	if (N < 0)
+	{
+		throw std::runtime_error(
+		    fmt::format("The number of variables must be nonnegative, got {}", N));
+	}
+}
+
+// returns the data of array, or n copies of default_value stored in buffer if array is not given
+inline const double *array_or_fill(const std::optional<DoubleArrayT> &array, size_t n,
+                                   double default_value, std::vector<double> &buffer,
+                                   const char *name)
+{
+	if (array)
+	{
+		check_array_size(array->size(), n, name);
+		return array->data();
+	}
+	buffer.assign(n, default_value);
+	return buffer.data();
+}
+
+// the constraints are the rows of a CSR matrix whose column indices are VariableIndex::index
+template <typename T>
+auto add_linear_constraints_csr(T &model, const IndexArrayT &indptr_array,
+                                const IndexArrayT &variables_array,
+                                const DoubleArrayT &coefficients, ConstraintSense sense,
+                                const DoubleArrayT &rhs)
+{
+	IndexArray indptr(indptr_array, "indptr");
+	IndexArray variables(variables_array, "variables");
+	if (indptr.size() == 0)
+	{
+		throw std::runtime_error("indptr must not be empty");
+	}
+	int M = indptr.size() - 1;
+	check_array_size(rhs.size(), M, "rhs");
+	size_t nnz = std::max(indptr.data()[M], 0);
+	check_array_size(variables.size(), nnz, "variables");
+	check_array_size(coefficients.size(), nnz, "coefficients");
+	return model.add_linear_constraints(M, indptr.data(), variables.data(), coefficients.data(),
+	                                    sense, rhs.data());
+}
+
+inline std::vector<int> variable_index_vector(const Vector<VariableIndex> &variables)
+{
+	std::vector<int> indices(variables.size());
+	for (size_t i = 0; i < variables.size(); i++)
+	{
+		indices[i] = variables[i].index;
+	}
+	return indices;
+}
+
+// the batched modifications only apply to linear constraints
+inline std::vector<int> linear_constraint_index_vector(const Vector<ConstraintIndex> &constraints)
+{
+	std::vector<int> indices(constraints.size());
+	for (size_t i = 0; i < constraints.size(); i++)
+	{
+		if (constraints[i].type != ConstraintType::Linear)
+		{
+			throw std::runtime_error("Only linear constraints can be modified in batch");
+		}
+		indices[i] = constraints[i].index;
+	}
+	return indices;
+}
+
+using DoubleNumpyArrayT = nb::ndarray<nb::numpy, double, nb::ndim<1>>;
+
+// the returned numpy array takes the ownership of values
+inline DoubleNumpyArrayT to_numpy_array(std::vector<double> &&values)
+{
+	auto data = new std::vector<double>(std::move(values));
+	nb::capsule owner(data, [](void *p) noexcept { delete (std::vector<double> *)p; });
+	return DoubleNumpyArrayT(data->data(), {data->size()}, owner);
+}
+
+template <typename T>
+DoubleNumpyArrayT get_variable_values_array(T &model, const IndexArrayT &variables_array)
+{
+	IndexArray variables(variables_array, "variables");
+	std::vector<double> values(variables.size());
+	model.get_variable_values(variables.size(), variables.data(), values.data());
+	return to_numpy_array(std::move(values));
+}
+
+template <typename T>
+DoubleNumpyArrayT get_variable_values_list(T &model, const Vector<VariableIndex> &variables)
+{
+	auto indices = variable_index_vector(variables);
+	std::vector<double> values(variables.size());
+	model.get_variable_values(indices.size(), indices.data(), values.data());
+	return to_numpy_array(std::move(values));
+}
+
+template <typename T>
+DoubleNumpyArrayT get_expression_values_array(T &model,
+                                              const Vector<ScalarAffineFunction> &functions)
+{
+	std::vector<double> values(functions.size());
+	model.get_expression_values(functions, values.data());
+	return to_numpy_array(std::move(values));
+}
+
+template <typename T>
+void set_variable_bounds_array(T &model, const IndexArrayT &variables_array,
+                               const DoubleArrayT &lb, const DoubleArrayT &ub)
+{
+	IndexArray variables(variables_array, "variables");
+	size_t N = variables.size();
+	check_array_size(lb.size(), N, "lb");
+	check_array_size(ub.size(), N, "ub");
+	model.set_variable_bounds(N, variables.data(), lb.data(), ub.data());
+}
+
+template <typename T>
+void set_variable_bounds_list(T &model, const Vector<VariableIndex> &variables,
+                              const std::vector<double> &lb, const std::vector<double> &ub)
+{
+	size_t N = variables.size();
+	check_array_size(lb.size(), N, "lb");
+	check_array_size(ub.size(), N, "ub");
+	auto indices = variable_index_vector(variables);
+	model.set_variable_bounds(N, indices.data(), lb.data(), ub.data());
+}
+
+template <typename T>
+void set_objective_coefficients_array(T &model, const IndexArrayT &variables_array,
+                                      const DoubleArrayT &values)
+{
+	IndexArray variables(variables_array, "variables");
+	size_t N = variables.size();
+	check_array_size(values.size(), N, "values");
+	model.set_objective_coefficients(N, variables.data(), values.data());
+}
+
+template <typename T>
+void set_objective_coefficients_list(T &model, const Vector<VariableIndex> &variables,
+                                     const std::vector<double> &values)
+{
+	size_t N = variables.size();
+	check_array_size(values.size(), N, "values");
+	auto indices = variable_index_vector(variables);
+	model.set_objective_coefficients(N, indices.data(), values.data());
+}
+
+// the constraints are ConstraintIndex::index of linear constraints
+template <typename T>
+void set_normalized_rhs_array(T &model, const IndexArrayT &constraints_array,
+                              const DoubleArrayT &values)
+{
+	IndexArray constraints(constraints_array, "constraints");
+	size_t N = constraints.size();
+	check_array_size(values.size(), N, "values");
+	model.set_normalized_rhs(N, constraints.data(), values.data());
+}
+
+template <typename T>
+void set_normalized_rhs_list(T &model, const Vector<ConstraintIndex> &constraints,
+                             const std::vector<double> &values)
+{
+	size_t N = constraints.size();
+	check_array_size(values.size(), N, "values");
+	auto indices = linear_constraint_index_vector(constraints);
+	model.set_normalized_rhs(N, indices.data(), values.data());
+}
+
+template <typename T>
+void set_normalized_coefficients_array(T &model, const IndexArrayT &constraints_array,
+                                       const IndexArrayT &variables_array,
+                                       const DoubleArrayT &values)
+{
+	IndexArray constraints(constraints_array, "constraints");
+	IndexArray variables(variables_array, "variables");
+	size_t N = constraints.size();
+	check_array_size(variables.size(), N, "variables");
+	check_array_size(values.size(), N, "values");
+	model.set_normalized_coefficients(N, constraints.data(), variables.data(), values.data());
+}
+
+template <typename T>
+void set_normalized_coefficients_list(T &model, const Vector<ConstraintIndex> &constraints,
+                                      const Vector<VariableIndex> &variables,
+                                      const std::vector<double> &values)
+{
+	size_t N = constraints.size();
+	check_array_size(variables.size(), N, "variables");
+	check_array_size(values.size(), N, "values");
+	auto constraint_indices = linear_constraint_index_vector(constraints);
+	auto variable_indices = variable_index_vector(variables);
+	model.set_normalized_coefficients(N, constraint_indices.data(), variable_indices.data(),
+	                                  values.data());
+}
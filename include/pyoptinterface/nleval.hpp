@@ -1,10 +1,12 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "pyoptinterface/core.hpp"
 #include "pyoptinterface/nlexpr.hpp"
+#include "pyoptinterface/threadpool.hpp"
 
 enum class HessianSparsityType
 {
@@ -12,6 +14,8 @@ enum class HessianSparsityType
 	Lower
 };
 
+class HessianPatternBuilder;
+
 struct AutodiffSymbolicStructure
 {
 	size_t nx = 0, np = 0, ny = 0;
@@ -43,6 +47,27 @@ using additive_grad_funcptr_noparam = void (*)(const double *x, double *grad, co
 using hessian_funcptr_noparam = void (*)(const double *x, const double *w, double *hessian,
                                          const int *xi, const int *hessiani);
 
+// batched version, evaluates n instances of the same graph in one call
+// xi and p of instance i start at xi + i * nx and p + i * np
+// the strides of y/w are baked into the kernel when it is generated
+using f_batch_funcptr = void (*)(int n, const double *x, const double *p, double *y,
+                                 const int *xi);
+using jacobian_batch_funcptr = void (*)(int n, const double *x, const double *p,
+                                        double *jacobian, const int *xi);
+using additive_grad_batch_funcptr = void (*)(int n, const double *x, const double *p,
+                                             double *grad, const int *xi, const int *gradi);
+using hessian_batch_funcptr = void (*)(int n, const double *x, const double *p, const double *w,
+                                       double *hessian, const int *xi, const int *hessiani);
+
+using f_batch_funcptr_noparam = void (*)(int n, const double *x, double *y, const int *xi);
+using jacobian_batch_funcptr_noparam = void (*)(int n, const double *x, double *jacobian,
+                                                const int *xi);
+using additive_grad_batch_funcptr_noparam = void (*)(int n, const double *x, double *grad,
+                                                     const int *xi, const int *gradi);
+using hessian_batch_funcptr_noparam = void (*)(int n, const double *x, const double *w,
+                                               double *hessian, const int *xi,
+                                               const int *hessiani);
+
 struct ConstraintAutodiffEvaluator
 {
 	union {
@@ -58,9 +83,25 @@ struct ConstraintAutodiffEvaluator
 		hessian_funcptr_noparam nop;
 	} hessian_eval;
 
+	// optional, the per-instance kernels are used if they are nullptr
+	union {
+		f_batch_funcptr p = nullptr;
+		f_batch_funcptr_noparam nop;
+	} f_batch_eval;
+	union {
+		jacobian_batch_funcptr p = nullptr;
+		jacobian_batch_funcptr_noparam nop;
+	} jacobian_batch_eval;
+	union {
+		hessian_batch_funcptr p = nullptr;
+		hessian_batch_funcptr_noparam nop;
+	} hessian_batch_eval;
+
 	ConstraintAutodiffEvaluator() = default;
 
 	ConstraintAutodiffEvaluator(bool has_parameter, uintptr_t fp, uintptr_t jp, uintptr_t hp);
+	ConstraintAutodiffEvaluator(bool has_parameter, uintptr_t fp, uintptr_t jp, uintptr_t hp,
+	                            uintptr_t fbp, uintptr_t jbp, uintptr_t hbp);
 };
 
 struct ObjectiveAutodiffEvaluator
@@ -78,9 +119,25 @@ struct ObjectiveAutodiffEvaluator
 		hessian_funcptr_noparam nop;
 	} hessian_eval;
 
+	// optional, the per-instance kernels are used if they are nullptr
+	union {
+		f_batch_funcptr p = nullptr;
+		f_batch_funcptr_noparam nop;
+	} f_batch_eval;
+	union {
+		additive_grad_batch_funcptr p = nullptr;
+		additive_grad_batch_funcptr_noparam nop;
+	} grad_batch_eval;
+	union {
+		hessian_batch_funcptr p = nullptr;
+		hessian_batch_funcptr_noparam nop;
+	} hessian_batch_eval;
+
 	ObjectiveAutodiffEvaluator() = default;
 
 	ObjectiveAutodiffEvaluator(bool has_parameter, uintptr_t fp, uintptr_t ajp, uintptr_t hp);
+	ObjectiveAutodiffEvaluator(bool has_parameter, uintptr_t fp, uintptr_t ajp, uintptr_t hp,
+	                           uintptr_t fbp, uintptr_t ajbp, uintptr_t hbp);
 };
 
 #define restrict __restrict
@@ -98,6 +155,8 @@ struct LinearEvaluator
 	std::vector<int> constraint_intervals = {0};
 
 	void add_row(const ScalarAffineFunction &f);
+	// appends the rows of a CSR matrix, row i is [indptr[i], indptr[i + 1])
+	void add_rows(int M, const int *indptr, const int *variables, const double *coefficients);
 
 	void eval_function(const double *restrict x, double *restrict f);
 	void analyze_jacobian_structure(size_t &global_jacobian_nnz,
@@ -157,9 +216,34 @@ struct QuadraticEvaluator
 	                               std::vector<int> &global_hessian_cols,
 	                               Hashmap<std::tuple<int, int>, int> &hessian_index_map,
 	                               HessianSparsityType hessian_type);
+	// the same as above, but the global indices are assigned by builder.finalize
+	void analyze_hessian_structure(HessianPatternBuilder &builder);
 	void eval_lagrangian_hessian(const double *restrict lambda, double *restrict hessian) const;
 };
 
+// the structure hash is only used to find the bucket, two graphs are considered to have the same
+// structure only if their signatures are exactly equal, so a hash collision never makes two
+// different structures share a compiled kernel
+struct GraphStructureKey
+{
+	uint64_t hash;
+	std::string signature;
+
+	bool operator==(const GraphStructureKey &x) const
+	{
+		return hash == x.hash && signature == x.signature;
+	}
+};
+
+template <>
+struct ankerl::unordered_dense::hash<GraphStructureKey>
+{
+	[[nodiscard]] auto operator()(GraphStructureKey const &x) const noexcept -> uint64_t
+	{
+		return x.hash;
+	}
+};
+
 struct NonlinearEvaluator
 {
 	// How many graph instances are there
@@ -168,14 +252,17 @@ struct NonlinearEvaluator
 	struct GraphInput
 	{
 		std::vector<int> variables;
+		// values of constants followed by the values of parameters
 		std::vector<double> constants;
+		// indices of model parameters used by this graph
+		std::vector<int> parameters;
 	};
 	std::vector<GraphInput> graph_inputs;
 	// record graph instances with constraint output and objective output
 	struct GraphHash
 	{
-		// hash of this graph instance
-		uint64_t hash;
+		// structure of this graph instance
+		GraphStructureKey structure;
 		// index of this graph instance
 		int index;
 	};
@@ -205,18 +292,27 @@ struct NonlinearEvaluator
 		AutodiffSymbolicStructure autodiff_structure;
 		ConstraintAutodiffEvaluator autodiff_evaluator;
 
+		// inputs of all instances packed contiguously for the batched kernels
+		// length = instance_indices.size() * nx and instance_indices.size() * np
+		std::vector<int> batch_variables;
+		std::vector<double> batch_constants;
+
 		// where to store the hessian matrix
 		// length = instance_indices.size() * hessian_nnz
 		std::vector<int> hessian_indices;
 	};
 	std::vector<ConstraintGraphGroup> constraint_groups;
-	Hashmap<uint64_t, int> hash_to_constraint_group;
+	Hashmap<GraphStructureKey, int> hash_to_constraint_group;
 
 	struct ObjectiveGraphGroup
 	{
 		std::vector<int> instance_indices;
 		AutodiffSymbolicStructure autodiff_structure;
 		ObjectiveAutodiffEvaluator autodiff_evaluator;
+
+		// inputs of all instances packed contiguously for the batched kernels
+		std::vector<int> batch_variables;
+		std::vector<double> batch_constants;
 		// where to store the gradient vector
 		// length = instance_indices.size() * jacobian_nnz
 		std::vector<int> gradient_indices;
@@ -225,7 +321,7 @@ struct NonlinearEvaluator
 		std::vector<int> hessian_indices;
 	};
 	std::vector<ObjectiveGraphGroup> objective_groups;
-	Hashmap<uint64_t, int> hash_to_objective_group;
+	Hashmap<GraphStructureKey, int> hash_to_objective_group;
 
 	int add_graph_instance();
 	void finalize_graph_instance(size_t graph_index, const ExpressionGraph &graph);
@@ -244,6 +340,11 @@ struct NonlinearEvaluator
 	                                               const ObjectiveAutodiffEvaluator &evaluator);
 
 	void calculate_constraint_graph_instances_offset();
+	// pack the inputs of instances in each group for the batched kernels
+	void pack_group_inputs();
+	// write the current values of model parameters into the inputs of graph instances
+	// must be called after pack_group_inputs
+	void update_parameters(const std::vector<double> &parameter_values);
 
 	// functions to evaluate the nonlinear constraints and objectives
 
@@ -271,7 +372,85 @@ struct NonlinearEvaluator
 	                                         std::vector<int> &global_hessian_cols,
 	                                         Hashmap<std::tuple<int, int>, int> &hessian_index_map,
 	                                         HessianSparsityType hessian_type);
+	// the same as above, but the global indices are assigned by builder.finalize
+	void analyze_constraints_hessian_structure(HessianPatternBuilder &builder);
+	void analyze_objective_hessian_structure(HessianPatternBuilder &builder);
 
 	void eval_lagrangian_hessian(const double *restrict x, const double *restrict lambda,
 	                             const double sigma, double *restrict hessian) const;
+
+	// evaluate instances [begin, end) of one group
+	// the output pointers (f, jacobian, w, hessian_indices) point to the data of instance begin
+	void eval_constraint_group(const ConstraintGraphGroup &group, int begin, int end,
+	                           const double *restrict x, double *restrict f) const;
+	void eval_constraint_group_jacobian(const ConstraintGraphGroup &group, int begin, int end,
+	                                    const double *restrict x,
+	                                    double *restrict jacobian) const;
+	void eval_constraint_group_hessian(const ConstraintGraphGroup &group, int begin, int end,
+	                                   const double *restrict x, const double *restrict w,
+	                                   double *restrict hessian,
+	                                   const int *restrict hessian_indices) const;
+	void eval_objective_group(const ObjectiveGraphGroup &group, int begin, int end,
+	                          const double *restrict x, double *restrict f) const;
+	void eval_objective_group_gradient(const ObjectiveGraphGroup &group, int begin, int end,
+	                                   const double *restrict x, double *restrict grad_f,
+	                                   const int *restrict gradient_indices) const;
+	void eval_objective_group_hessian(const ObjectiveGraphGroup &group, int begin, int end,
+	                                  const double *restrict x, const double *restrict sigma,
+	                                  double *restrict hessian,
+	                                  const int *restrict hessian_indices) const;
+
+	// parallel evaluation
+	// a contiguous range [begin, end) of instances in one group
+	struct InstanceRange
+	{
+		int group;
+		int begin;
+		int end;
+	};
+	// the instances are split into n_tasks partitions, partition i consists of
+	// ranges[intervals[i], intervals[i + 1])
+	struct InstancePartition
+	{
+		std::vector<InstanceRange> ranges;
+		std::vector<int> intervals = {0};
+	};
+	struct ParallelPlan
+	{
+		size_t n_tasks = 0;
+
+		// per constraint group, where its f/lambda and jacobian values start
+		std::vector<int> constraint_f_offsets;
+		std::vector<int> constraint_jacobian_offsets;
+		InstancePartition constraint_partition;
+
+		// Each instance writes its local hessian into a private slice of local_hessian, then
+		// the slices are reduced into the global hessian slot by slot.
+		// The sources of each slot are kept in the serial evaluation order, so the result is
+		// deterministic and does not depend on the number of threads.
+		std::vector<int> objective_hessian_offsets;
+		std::vector<int> constraint_hessian_offsets;
+		InstancePartition objective_hessian_partition;
+		InstancePartition constraint_hessian_partition;
+		// local_hessian_indices[i] = i, passed as hessiani to the kernels
+		std::vector<int> local_hessian_indices;
+		std::vector<double> local_hessian;
+		// sources of global slot i are local_hessian[hessian_sources[hessian_source_intervals[i]
+		// ... hessian_source_intervals[i + 1]]]
+		std::vector<int> hessian_source_intervals;
+		std::vector<int> hessian_sources;
+	} parallel_plan;
+
+	// must be called after the structure of jacobian and hessian is analyzed
+	// the hessian part of the plan is left empty if global_hessian_nnz is 0, because the
+	// hessian_indices of groups are stale when the analysis of hessian is skipped
+	void prepare_parallel_evaluation(size_t n_tasks, size_t global_hessian_nnz);
+
+	void eval_constraints_parallel(const double *restrict x, double *restrict f,
+	                               ThreadPool &pool) const;
+	void eval_constraints_jacobian_parallel(const double *restrict x, double *restrict jacobian,
+	                                        ThreadPool &pool) const;
+	void eval_lagrangian_hessian_parallel(const double *restrict x, const double *restrict lambda,
+	                                      const double sigma, double *restrict hessian,
+	                                      ThreadPool &pool);
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "ankerl/unordered_dense.h"
@@ -13,6 +14,17 @@ using VariableNode = EntityId;
 using ConstantNode = double;
 using ParameterNode = EntityId;
 
+// a parameter of model whose value can be changed without rebuilding the expression graph
+struct ParameterIndex
+{
+	IndexT index;
+
+	ParameterIndex() = default;
+	ParameterIndex(IndexT v) : index(v)
+	{
+	}
+};
+
 enum class ArrayType
 {
 	Constant,
@@ -201,6 +213,7 @@ struct ExpressionGraph
 	// Merge VariableIndex/ScalarAffineFunction/ScalarQuadraticFunction/ExprBuilder into
 	// ExpressionGraph
 	ExpressionHandle merge_variableindex(const VariableIndex &v);
+	ExpressionHandle merge_parameterindex(const ParameterIndex &p);
 	ExpressionHandle merge_scalaraffinefunction(const ScalarAffineFunction &f);
 	ExpressionHandle merge_scalarquadraticfunction(const ScalarQuadraticFunction &f);
 	ExpressionHandle merge_exprbuilder(const ExprBuilder &expr);
@@ -212,6 +225,25 @@ struct ExpressionGraph
 	uint64_t main_structure_hash() const;
 	uint64_t constraint_structure_hash(uint64_t hash) const;
 	uint64_t objective_structure_hash(uint64_t hash) const;
+
+	// exact serialization of the structure (without the values of constants and the indices of
+	// variables), two graphs have the same signature if and only if they share the same kernel
+	std::string main_structure_signature() const;
+	std::string constraint_structure_signature(std::string signature) const;
+	std::string objective_structure_signature(std::string signature) const;
+
+	// rewrite the graph into a canonical form so that more graphs share the same structure:
+	// nodes unreachable from outputs are dropped, nodes are renumbered in the order of evaluation,
+	// operands of commutative operators are sorted by their shape and identical subexpressions
+	// are merged
+	void canonicalize();
+
+	// split the terms of a sum that are affine or quadratic in the variables off expression:
+	// they are added to quadratic_part and expression is replaced by the sum of the remaining
+	// terms, so only the truly nonlinear core is traced and compiled
+	// returns false and changes nothing unless some variable terms are split off and the remaining
+	// terms still depend on variables
+	bool split_quadratic_part(ExpressionHandle &expression, ExprBuilder &quadratic_part);
 };
 
 void unpack_comparison_expression(ExpressionGraph &graph, const ExpressionHandle &expr,
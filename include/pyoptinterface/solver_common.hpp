@@ -5,6 +5,7 @@
 #include <concepts>
 #include <tuple>
 #include <numeric>
+#include <span>
 #include "fmt/format.h"
 #include "fmt/ranges.h"
 #include "pyoptinterface/core.hpp"
@@ -249,6 +250,31 @@ class GetValueMixin
 		value += function.constant.value_or(0.0);
 		return value;
 	}
+	// values[i] is the value of functions[i], the values of all variables in functions are
+	// queried from the model at once
+	void get_expression_values(const Vector<ScalarAffineFunction> &functions, double *values)
+	{
+		T *model = get_base();
+		std::vector<int> variables;
+		for (const auto &function : functions)
+		{
+			variables.insert(variables.end(), function.variables.begin(), function.variables.end());
+		}
+		std::vector<double> variable_values(variables.size());
+		model->get_variable_values(variables.size(), variables.data(), variable_values.data());
+
+		size_t k = 0;
+		for (size_t i = 0; i < functions.size(); ++i)
+		{
+			const auto &function = functions[i];
+			double value = function.constant.value_or(0.0);
+			for (size_t j = 0; j < function.size(); ++j, ++k)
+			{
+				value += function.coefficients[j] * variable_values[k];
+			}
+			values[i] = value;
+		}
+	}
 	double get_expression_value(const ScalarQuadraticFunction &function)
 	{
 		T *model = get_base();
@@ -297,10 +323,8 @@ class GetValueMixin
 				value += coef * v1 * v2;
 			}
 		}
-		for (const auto &[var, coef] : function.affine_terms)
-		{
-			value += coef * model->get_variable_value(var);
-		}
+		function.for_each_affine_term(
+		    [&](IndexT var, CoeffT coef) { value += coef * model->get_variable_value(var); });
 		value += function.constant_term.value_or(0.0);
 		return value;
 	}
@@ -390,7 +414,7 @@ class PPrintMixin
 	{
 		T *model = get_base();
 		std::vector<std::string> terms;
-		terms.reserve(function.quadratic_terms.size() + function.affine_terms.size() + 1);
+		terms.reserve(function.quadratic_terms.size() + function.affine_size() + 1);
 		for (const auto &[varpair, coef] : function.quadratic_terms)
 		{
 			std::string var1_str = model->pprint_variable(varpair.var_1);
@@ -414,11 +438,10 @@ class PPrintMixin
 			}
 			terms.push_back(term);
 		}
-		for (const auto &[var, coef] : function.affine_terms)
-		{
+		function.for_each_affine_term([&](IndexT var, CoeffT coef) {
 			auto term = fmt::format("{:.{}g}*{}", coef, precision, model->pprint_variable(var));
 			terms.push_back(term);
-		}
+		});
 		if (function.constant_term)
 		{
 			auto term = fmt::format("{:.{}g}", function.constant_term.value(), precision);
@@ -480,10 +503,7 @@ struct AffineFunctionPtrForm
 		auto f_numnz = function.size();
 		numnz = f_numnz;
 		index_storage.resize(numnz);
-		for (int i = 0; i < numnz; ++i)
-		{
-			index_storage[i] = model->_variable_index(function.variables[i]);
-		}
+		model->_variable_indices(function.variables, index_storage);
 		index = index_storage.data();
 		if constexpr (std::is_same_v<VALT, CoeffT>)
 		{
@@ -500,6 +520,103 @@ struct AffineFunctionPtrForm
 	}
 };
 
+// translate variables to the columns of the solver in one batch, throws if any of them does not
+// exist
+template <VarIndexModel T, std::integral IDXT>
+void checked_variable_indices(T *model, std::span<const IndexT> variables,
+                              std::span<IDXT> columns)
+{
+	model->_variable_indices(variables, columns);
+	for (auto column : columns)
+	{
+		if (column < 0)
+		{
+			throw std::runtime_error("Variable does not exist");
+		}
+	}
+}
+
+// translate linear constraints to the rows of the solver in one batch, throws if any of them does
+// not exist
+template <typename T, std::integral IDXT>
+void checked_linear_constraint_indices(T *model, std::span<const IndexT> constraints,
+                                       std::span<IDXT> rows)
+{
+	model->_linear_constraint_indices(constraints, rows);
+	for (auto row : rows)
+	{
+		if (row < 0)
+		{
+			throw std::runtime_error("Constraint does not exist");
+		}
+	}
+}
+
+// row i of a CSR matrix with M rows is [indptr[i], indptr[i + 1])
+inline void check_csr_indptr(int M, const int *indptr)
+{
+	if (M < 0)
+	{
+		throw std::runtime_error("The number of rows must be non-negative");
+	}
+	if (indptr[0] != 0)
+	{
+		throw std::runtime_error("The first element of indptr must be 0");
+	}
+	for (int i = 0; i < M; ++i)
+	{
+		if (indptr[i + 1] < indptr[i])
+		{
+			throw std::runtime_error("indptr must be non-decreasing");
+		}
+	}
+}
+
+// the rows of a CSR matrix whose column indices are VariableIndex::index, translated to the
+// columns of the solver in one pass
+template <std::integral NZT, std::integral IDXT, std::floating_point VALT>
+struct CSRMatrixPtrForm
+{
+	int numrows;
+	NZT numnz;
+	// numrows + 1 entries
+	NZT *begin;
+	IDXT *index;
+	VALT *value;
+	std::vector<NZT> begin_storage;
+	std::vector<IDXT> index_storage;
+	std::vector<VALT> value_storage;
+
+	template <VarIndexModel T>
+	void make(T *model, int M, const int *indptr, const int *variables, const double *coefficients)
+	{
+		check_csr_indptr(M, indptr);
+		numrows = M;
+		numnz = indptr[M];
+		if constexpr (std::is_same_v<NZT, int>)
+		{
+			begin = (NZT *)indptr;
+		}
+		else
+		{
+			begin_storage.assign(indptr, indptr + M + 1);
+			begin = begin_storage.data();
+		}
+		index_storage.resize(numnz);
+		checked_variable_indices(model, {variables, size_t(numnz)}, std::span<IDXT>(index_storage));
+		index = index_storage.data();
+		if constexpr (std::is_same_v<VALT, double>)
+		{
+			value = (VALT *)coefficients;
+		}
+		else
+		{
+			value_storage.assign(coefficients, coefficients + numnz);
+			value = value_storage.data();
+		}
+	}
+};
+
 template <std::integral NZT, std::integral IDXT, std::floating_point VALT>
 struct QuadraticFunctionPtrForm
 {
@@ -518,18 +635,8 @@ struct QuadraticFunctionPtrForm
 		numnz = f_numnz;
 		row_storage.resize(numnz);
 		col_storage.resize(numnz);
-		for (int i = 0; i < numnz; ++i)
-		{
-			row_storage[i] = model->_variable_index(function.variable_1s[i]);
-			if (function.variable_1s[i] == function.variable_2s[i])
-			{
-				col_storage[i] = row_storage[i];
-			}
-			else
-			{
-				col_storage[i] = model->_variable_index(function.variable_2s[i]);
-			}
-		}
+		model->_variable_indices(function.variable_1s, row_storage);
+		model->_variable_indices(function.variable_2s, col_storage);
 		row = row_storage.data();
 		col = col_storage.data();
 		if constexpr (std::is_same_v<VALT, CoeffT>)
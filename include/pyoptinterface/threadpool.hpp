@@ -0,0 +1,46 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A minimal fork-join thread pool
+// parallel_for(n, f) runs f(0), ..., f(n-1) on the workers and the calling thread, and returns
+// after all of them are finished
+class ThreadPool
+{
+  public:
+	// n_threads includes the calling thread, so n_threads - 1 workers are spawned
+	explicit ThreadPool(size_t n_threads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool &) = delete;
+	ThreadPool &operator=(const ThreadPool &) = delete;
+
+	size_t n_threads() const;
+
+	void parallel_for(size_t n_tasks, const std::function<void(size_t)> &f);
+
+  private:
+	void worker_loop();
+	void run_tasks();
+
+	std::vector<std::thread> m_workers;
+
+	std::mutex m_mutex;
+	std::condition_variable m_start_cv;
+	std::condition_variable m_done_cv;
+
+	// state of the current parallel_for, guarded by m_mutex
+	const std::function<void(size_t)> *m_task = nullptr;
+	size_t m_n_tasks = 0;
+	size_t m_next_task = 0;
+	size_t m_n_finished = 0;
+	size_t m_generation = 0;
+	bool m_stop = false;
+	std::exception_ptr m_exception;
+};
@@ -140,6 +140,7 @@
 	B(XPRSchgbounds);           \
 	B(XPRSchgcoef);             \
 	B(XPRSchgcoltype);          \
+	B(XPRSchgmcoef64);          \
 	B(XPRSchgmqobj64);          \
 	B(XPRSchgobj);              \
 	B(XPRSchgobjsense);         \
@@ -508,17 +509,27 @@ class Model : public OnesideLinearConstraintMixin<Model>,
 	// Index mappings
 	int _constraint_index(ConstraintIndex constraint);
 	int _variable_index(VariableIndex variable);
+	// columns[i] is the column of variables[i] or -1 if it does not exist
+	void _variable_indices(std::span<const IndexT> variables, std::span<int> columns);
 	int _checked_constraint_index(ConstraintIndex constraint);
 	int _checked_variable_index(VariableIndex variable);
+	// rows[i] is the row of the linear constraint constraints[i] or -1 if it does not exist
+	void _linear_constraint_indices(std::span<const IndexT> constraints, std::span<int> rows);
 
 	// Variables
 	VariableIndex add_variable(VariableDomain domain = VariableDomain::Continuous,
 	                           double lb = POI_XPRS_MINUSINFINITY,
 	                           double ub = POI_XPRS_PLUSINFINITY, const char *name = nullptr);
+	// add N variables of the same domain, lb[i] and ub[i] are the bounds of the i-th variable
+	// the new variables have contiguous indices, the first one is returned
+	VariableIndex add_variables(int N, VariableDomain domain, const double *lb, const double *ub);
 	void delete_variable(VariableIndex variable);
 	void delete_variables(const Vector<VariableIndex> &variables);
 	void set_objective_coefficient(VariableIndex variable, double value);
+	void set_objective_coefficients(int N, const int *variables, const double *values);
 	void set_variable_bounds(VariableIndex variable, double lb, double ub);
+	// set the bounds of N variables whose VariableIndex::index are variables in one call
+	void set_variable_bounds(int N, const int *variables, const double *lb, const double *ub);
 	void set_variable_lowerbound(VariableIndex variable, double lb);
 	void set_variable_name(VariableIndex variable, const char *name);
 	void set_variable_type(VariableIndex variable, VariableDomain vtype);
@@ -536,6 +547,8 @@ class Model : public OnesideLinearConstraintMixin<Model>,
 	double get_variable_rc(VariableIndex variable);
 	double get_variable_upperbound(VariableIndex variable);
 	double get_variable_value(VariableIndex variable);
+	// values[i] is the value of the variable whose VariableIndex::index is variables[i]
+	void get_variable_values(int N, const int *variables, double *values);
 	std::string get_variable_name(VariableIndex variable);
 	std::string pprint_variable(VariableIndex variable);
 	VariableDomain get_variable_type(VariableIndex variable);
@@ -549,6 +562,11 @@ class Model : public OnesideLinearConstraintMixin<Model>,
 	ConstraintIndex add_linear_constraint(const ScalarAffineFunction &function,
 	                                      ConstraintSense sense, CoeffT rhs,
 	                                      const char *name = nullptr);
+	// add M linear constraints whose coefficients are a CSR matrix with VariableIndex::index as
+	// columns, the new constraints have contiguous indices and the first one is returned
+	ConstraintIndex add_linear_constraints(int M, const int *indptr, const int *variables,
+	                                       const double *coefficients, ConstraintSense sense,
+	                                       const double *rhs);
 	ConstraintIndex add_quadratic_constraint(const ScalarQuadraticFunction &function,
 	                                         ConstraintSense sense, CoeffT rhs,
 	                                         const char *name = nullptr);
@@ -566,7 +584,11 @@ class Model : public OnesideLinearConstraintMixin<Model>,
 	void set_constraint_sense(ConstraintIndex constraint, ConstraintSense sense);
 	void set_normalized_coefficient(ConstraintIndex constraint, VariableIndex variable,
 	                                double value);
+	void set_normalized_coefficients(int N, const int *constraints, const int *variables,
+	                                 const double *values);
 	void set_normalized_rhs(ConstraintIndex constraint, double value);
+	// constraints[i] is ConstraintIndex::index of a linear constraint
+	void set_normalized_rhs(int N, const int *constraints, const double *values);
 	bool is_constraint_active(ConstraintIndex constraint);
 	bool is_constraint_basic(ConstraintIndex constraint);
 	bool is_constraint_in_IIS(ConstraintIndex constraint);
@@ -1,143 +1,277 @@
-// #include <optional>
-//
-// #include "pyoptinterface/core.hpp"
-// #include "pyoptinterface/container.hpp"
-//
-// struct VariableInfo
-//{
-//	VariableDomain domain;
-// };
-//
-// class CacheModel
-//{
-//   public:
-//	VariableIndex add_variable(VariableDomain domain = VariableDomain::Continuous);
-//	void delete_variable(const VariableIndex &variable);
-//	bool is_variable_active(const VariableIndex &variable) const;
-//
-//	ConstraintIndex add_linear_constraint(const LinearConstraint &constraint);
-//	ConstraintIndex add_quadratic_constraint(const QuadraticConstraint &constraint);
-//	ConstraintIndex add_sos1_constraint(const SOSConstraint &constraint);
-//	ConstraintIndex add_sos2_constraint(const SOSConstraint &constraint);
-//
-//	void delete_constraint(const ConstraintIndex &constraint);
-//
-//	bool is_constraint_active(const ConstraintIndex &constraint) const;
-//
-//   private:
-//	int num_variable = 0;
-//	MonotoneVector<int> m_variable_index;
-//	Vector<std::optional<VariableInfo>> m_variables;
-//
-//	int num_linear_constraint = 0;
-//	MonotoneVector<int> m_linear_constraint_index;
-//	Vector<std::optional<LinearConstraint>> m_linear_constraints;
-//
-//	int num_quadratic_constraint = 0;
-//	MonotoneVector<int> m_quadratic_constraint_index;
-//	Vector<std::optional<QuadraticConstraint>> m_quadratic_constraints;
-//
-//	int num_sos1_constraint = 0;
-//	MonotoneVector<int> m_sos1_constraint_index;
-//	Vector<std::optional<SOSConstraint>> m_sos1_constraints;
-//
-//	int num_sos2_constraint = 0;
-//	MonotoneVector<int> m_sos2_constraint_index;
-//	Vector<std::optional<SOSConstraint>> m_sos2_constraints;
-// };
-//
-// VariableIndex CacheModel::add_variable(VariableDomain domain)
-//{
-//	IndexT index = m_variable_index.add_index();
-//	m_variables.push_back(VariableInfo{domain});
-//	num_variable++;
-//	return VariableIndex(index);
-// }
-//
-// void CacheModel::delete_variable(const VariableIndex &variable)
-//{
-//	m_variable_index.delete_index(variable.index);
-//	m_variables[variable.index] = std::nullopt;
-//	num_variable--;
-// }
-//
-// bool CacheModel::is_variable_active(const VariableIndex &variable) const
-//{
-//	return m_variables[variable.index].has_value();
-// }
-//
-// ConstraintIndex CacheModel::add_linear_constraint(const LinearConstraint &constraint)
-//{
-//	IndexT index = m_linear_constraint_index.add_index();
-//	m_linear_constraints.push_back(constraint);
-//	num_linear_constraint++;
-//	return ConstraintIndex{ConstraintType::Linear, index};
-// }
-//
-// ConstraintIndex CacheModel::add_quadratic_constraint(const QuadraticConstraint &constraint)
-//{
-//	IndexT index = m_quadratic_constraint_index.add_index();
-//	m_quadratic_constraints.push_back(constraint);
-//	num_quadratic_constraint++;
-//	return ConstraintIndex{ConstraintType::Quadratic, index};
-// }
-//
-// ConstraintIndex CacheModel::add_sos1_constraint(const SOSConstraint &constraint)
-//{
-//	IndexT index = m_sos1_constraint_index.add_index();
-//	m_sos1_constraints.push_back(constraint);
-//	num_sos1_constraint++;
-//	return ConstraintIndex{ConstraintType::SOS1, index};
-// }
-//
-// ConstraintIndex CacheModel::add_sos2_constraint(const SOSConstraint &constraint)
-//{
-//	IndexT index = m_sos2_constraint_index.add_index();
-//	m_sos2_constraints.push_back(constraint);
-//	num_sos2_constraint++;
-//	return ConstraintIndex{ConstraintType::SOS2, index};
-// }
-//
-// void CacheModel::delete_constraint(const ConstraintIndex &constraint)
-//{
-//	auto index = constraint.index;
-//	switch (constraint.type)
-//	{
-//	case ConstraintType::Linear:
-//		m_linear_constraint_index.delete_index(index);
-//		m_linear_constraints[index] = std::nullopt;
-//		num_linear_constraint--;
-//		break;
-//	case ConstraintType::Quadratic:
-//		m_quadratic_constraint_index.delete_index(index);
-//		m_quadratic_constraints[index] = std::nullopt;
-//		num_quadratic_constraint--;
-//		break;
-//	case ConstraintType::SOS1:
-//		m_sos1_constraint_index.delete_index(index);
-//		m_sos1_constraints[index] = std::nullopt;
-//		num_sos1_constraint--;
-//		break;
-//	case ConstraintType::SOS2:
-//		m_sos2_constraint_index.delete_index(index);
-//		m_sos2_constraints[index] = std::nullopt;
-//		num_sos2_constraint--;
-//		break;
-//	}
-// }
-//
-// bool CacheModel::is_constraint_active(const ConstraintIndex &constraint) const
-//{
-//	auto index = constraint.index;
-//	switch (constraint.type)
-//	{
-//	case ConstraintType::Linear:
-//		return m_linear_constraint_index.has_index(index);
-//	case ConstraintType::Quadratic:
-//		return m_quadratic_constraint_index.has_index(index);
-//	case ConstraintType::SOS1:
-//		return m_sos1_constraint_index.has_index(index);
-//	case ConstraintType::SOS2:
-//		return m_sos2_constraint_index.has_index(index);
-//	}
-// }
+#include "pyoptinterface/cache_model.hpp"
+#include "pyoptinterface/solver_common.hpp"
+#include "pyoptinterface/model_writer.hpp"
+#include "fmt/core.h"
+
+VariableIndex CacheModel::add_variable(VariableDomain domain, double lb, double ub)
+{
+	IndexT index = get_num_variables();
+	variable_domains.push_back(domain);
+	variable_lbs.push_back(lb);
+	variable_ubs.push_back(ub);
+	return VariableIndex(index);
+}
+
+VariableIndex CacheModel::add_variables(int N, VariableDomain domain, const double *lb,
+                                        const double *ub)
+{
+	IndexT index = get_num_variables();
+	variable_domains.insert(variable_domains.end(), N, domain);
+	variable_lbs.insert(variable_lbs.end(), lb, lb + N);
+	variable_ubs.insert(variable_ubs.end(), ub, ub + N);
+	return VariableIndex(index);
+}
+
+ConstraintIndex CacheModel::add_linear_constraint(const ScalarAffineFunction &function,
+                                                  ConstraintSense sense, CoeffT rhs)
+{
+	check_variables(function.variables);
+
+	IndexT index = get_num_linear_constraints();
+	linear_constraints.add_row<IndexT, CoeffT>(function.variables, function.coefficients);
+	linear_senses.push_back(sense);
+	linear_rhs.push_back(rhs - function.constant.value_or(0.0));
+	return ConstraintIndex(ConstraintType::Linear, index);
+}
+
+ConstraintIndex CacheModel::add_linear_constraint(const ExprBuilder &function,
+                                                  ConstraintSense sense, CoeffT rhs)
+{
+	ScalarAffineFunction f(function);
+	return add_linear_constraint(f, sense, rhs);
+}
+
+ConstraintIndex CacheModel::add_linear_constraints(int M, const int *indptr, const int *variables,
+                                                   const double *coefficients,
+                                                   ConstraintSense sense, const double *rhs)
+{
+	check_csr_indptr(M, indptr);
+	check_variables(std::span<const int>(variables, indptr[M]));
+
+	IndexT index = get_num_linear_constraints();
+	auto &column_ptr = linear_constraints.column_ptr;
+	int nz_begin = column_ptr.back();
+	column_ptr.reserve(column_ptr.size() + M);
+	for (int i = 1; i <= M; i++)
+	{
+		column_ptr.push_back(nz_begin + indptr[i]);
+	}
+	linear_constraints.variables.insert(linear_constraints.variables.end(), variables,
+	                                    variables + indptr[M]);
+	linear_constraints.coefficients.insert(linear_constraints.coefficients.end(), coefficients,
+	                                       coefficients + indptr[M]);
+	linear_senses.insert(linear_senses.end(), M, sense);
+	linear_rhs.insert(linear_rhs.end(), rhs, rhs + M);
+	return ConstraintIndex(ConstraintType::Linear, index);
+}
+
+ConstraintIndex CacheModel::add_quadratic_constraint(const ScalarQuadraticFunction &function,
+                                                     ConstraintSense sense, CoeffT rhs)
+{
+	check_variables(function.variable_1s);
+	check_variables(function.variable_2s);
+
+	IndexT index = get_num_quadratic_constraints();
+	ScalarAffineFunction affine_part = function.affine_part.value_or(ScalarAffineFunction());
+	check_variables(affine_part.variables);
+	quadratic_constraints.add_row<IndexT, CoeffT>(function.variable_1s, function.variable_2s,
+	                                              function.coefficients, affine_part.variables,
+	                                              affine_part.coefficients);
+	quadratic_senses.push_back(sense);
+	quadratic_rhs.push_back(rhs - affine_part.constant.value_or(0.0));
+	return ConstraintIndex(ConstraintType::Quadratic, index);
+}
+
+ConstraintIndex CacheModel::add_quadratic_constraint(const ExprBuilder &function,
+                                                     ConstraintSense sense, CoeffT rhs)
+{
+	ScalarQuadraticFunction f(function);
+	return add_quadratic_constraint(f, sense, rhs);
+}
+
+void CacheModel::set_objective(const ScalarAffineFunction &function, ObjectiveSense sense)
+{
+	check_variables(function.variables);
+
+	objective = ScalarQuadraticFunction({}, {}, {}, function);
+	objective_sense = sense;
+}
+
+void CacheModel::set_objective(const ScalarQuadraticFunction &function, ObjectiveSense sense)
+{
+	check_variables(function.variable_1s);
+	check_variables(function.variable_2s);
+	if (function.affine_part)
+	{
+		check_variables(function.affine_part->variables);
+	}
+
+	objective = function;
+	objective_sense = sense;
+}
+
+void CacheModel::set_objective(const ExprBuilder &function, ObjectiveSense sense)
+{
+	ScalarQuadraticFunction f(function);
+	set_objective(f, sense);
+}
+
+int CacheModel::get_num_variables() const
+{
+	return variable_domains.size();
+}
+
+int CacheModel::get_num_linear_constraints() const
+{
+	return linear_senses.size();
+}
+
+int CacheModel::get_num_quadratic_constraints() const
+{
+	return quadratic_senses.size();
+}
+
+void CacheModel::check_variables(std::span<const IndexT> variables) const
+{
+	IndexT N = get_num_variables();
+	for (auto v : variables)
+	{
+		if (v < 0 || v >= N)
+		{
+			throw std::runtime_error("Variable does not exist");
+		}
+	}
+}
+
+static void check_size(size_t size, size_t n, const char *name)
+{
+	if (size != n)
+	{
+		throw std::runtime_error(fmt::format(
+		    "CacheModel is inconsistent: {} has {} elements, expected {}", name, size, n));
+	}
+}
+
+template <typename ColumnIndexT>
+static void check_column_ptr(const std::vector<ColumnIndexT> &column_ptr, size_t M, size_t nnz,
+                             const char *name)
+{
+	check_size(column_ptr.size(), M + 1, name);
+	if (column_ptr.front() != 0 || size_t(column_ptr.back()) != nnz)
+	{
+		throw std::runtime_error(fmt::format(
+		    "CacheModel is inconsistent: {} must start at 0 and end at {}", name, nnz));
+	}
+	for (size_t i = 0; i < M; i++)
+	{
+		if (column_ptr[i + 1] < column_ptr[i])
+		{
+			throw std::runtime_error(
+			    fmt::format("CacheModel is inconsistent: {} must be non-decreasing", name));
+		}
+	}
+}
+
+void CacheModel::check_consistency() const
+{
+	size_t N = get_num_variables();
+	check_size(variable_lbs.size(), N, "variable_lbs");
+	check_size(variable_ubs.size(), N, "variable_ubs");
+
+	size_t M = get_num_linear_constraints();
+	const auto &linear = linear_constraints;
+	check_size(linear_rhs.size(), M, "linear_rhs");
+	check_size(linear.coefficients.size(), linear.variables.size(), "linear coefficients");
+	check_column_ptr(linear.column_ptr, M, linear.variables.size(), "linear column_ptr");
+	check_variables(linear.variables);
+
+	size_t Q = get_num_quadratic_constraints();
+	const auto &quadratic = quadratic_constraints;
+	check_size(quadratic_rhs.size(), Q, "quadratic_rhs");
+	check_size(quadratic.variable_2s.size(), quadratic.variable_1s.size(), "quadratic variable_2s");
+	check_size(quadratic.coefficients.size(), quadratic.variable_1s.size(),
+	           "quadratic coefficients");
+	check_column_ptr(quadratic.column_ptr, Q, quadratic.variable_1s.size(),
+	                 "quadratic column_ptr");
+	check_size(quadratic.lin_coefficients.size(), quadratic.lin_variables.size(),
+	           "quadratic lin_coefficients");
+	check_column_ptr(quadratic.lin_column_ptr, Q, quadratic.lin_variables.size(),
+	                 "quadratic lin_column_ptr");
+	check_variables(quadratic.variable_1s);
+	check_variables(quadratic.variable_2s);
+	check_variables(quadratic.lin_variables);
+
+	if (objective)
+	{
+		check_variables(objective->variable_1s);
+		check_variables(objective->variable_2s);
+		if (objective->affine_part)
+		{
+			check_variables(objective->affine_part->variables);
+		}
+	}
+}
+
+static void sense_to_interval(ConstraintSense sense, double rhs, double &lb, double &ub)
+{
+	lb = -std::numeric_limits<double>::infinity();
+	ub = std::numeric_limits<double>::infinity();
+	if (sense != ConstraintSense::LessEqual)
+	{
+		lb = rhs;
+	}
+	if (sense != ConstraintSense::GreaterEqual)
+	{
+		ub = rhs;
+	}
+}
+
+void CacheModel::write(const std::string &filename) const
+{
+	int M = get_num_linear_constraints();
+	int Q = get_num_quadratic_constraints();
+
+	std::vector<double> linear_lbs(M), linear_ubs(M);
+	for (int i = 0; i < M; i++)
+	{
+		sense_to_interval(linear_senses[i], linear_rhs[i], linear_lbs[i], linear_ubs[i]);
+	}
+	std::vector<double> quadratic_lbs(Q), quadratic_ubs(Q);
+	for (int i = 0; i < Q; i++)
+	{
+		sense_to_interval(quadratic_senses[i], quadratic_rhs[i], quadratic_lbs[i],
+		                  quadratic_ubs[i]);
+	}
+
+	ModelWriterInput input;
+	input.n_variables = get_num_variables();
+	input.variable_domains = variable_domains.data();
+	input.variable_lbs = variable_lbs.data();
+	input.variable_ubs = variable_ubs.data();
+
+	input.n_linear_constraints = M;
+	input.linear_indptr = linear_constraints.column_ptr.data();
+	input.linear_variables = linear_constraints.variables.data();
+	input.linear_coefficients = linear_constraints.coefficients.data();
+	input.linear_lbs = linear_lbs.data();
+	input.linear_ubs = linear_ubs.data();
+
+	input.n_quadratic_constraints = Q;
+	input.quadratic_indptr = quadratic_constraints.column_ptr.data();
+	input.quadratic_variable_1s = quadratic_constraints.variable_1s.data();
+	input.quadratic_variable_2s = quadratic_constraints.variable_2s.data();
+	input.quadratic_coefficients = quadratic_constraints.coefficients.data();
+	input.quadratic_lin_indptr = quadratic_constraints.lin_column_ptr.data();
+	input.quadratic_lin_variables = quadratic_constraints.lin_variables.data();
+	input.quadratic_lin_coefficients = quadratic_constraints.lin_coefficients.data();
+	input.quadratic_lbs = quadratic_lbs.data();
+	input.quadratic_ubs = quadratic_ubs.data();
+
+	if (objective)
+	{
+		input.objective = &objective.value();
+	}
+	input.objective_sense = objective_sense;
+
+	write_model(input, filename);
+}
@@ -213,6 +213,21 @@ VariableIndex COPTModel::add_variable(VariableDomain domain, double lb, double u
 	return variable;
 }
 
+VariableIndex COPTModel::add_variables(int N, VariableDomain domain, const double *lb,
+                                       const double *ub)
+{
+	IndexT index = m_variable_index.add_indices(N);
+	VariableIndex variable(index);
+
+	char vtype = copt_vtype(domain);
+	std::vector<char> vtypes(N, vtype);
+	int error = copt::COPT_AddCols(m_model.get(), N, NULL, NULL, NULL, NULL, NULL, vtypes.data(),
+	                               lb, ub, NULL);
+	check_error(error);
+
+	return variable;
+}
+
 void COPTModel::delete_variable(const VariableIndex &variable)
 {
 	if (!is_variable_active(variable))
@@ -233,25 +248,22 @@ void COPTModel::delete_variables(const Vector<VariableIndex> &variables)
 	if (n_variables == 0)
 		return;
 
-	std::vector<int> columns;
-	columns.reserve(n_variables);
+	std::vector<IndexT> indices;
+	indices.reserve(n_variables);
 	for (int i = 0; i < n_variables; i++)
 	{
-		if (!is_variable_active(variables[i]))
+		if (is_variable_active(variables[i]))
 		{
-			continue;
+			indices.push_back(variables[i].index);
 		}
-		auto column = _variable_index(variables[i]);
-		columns.push_back(column);
 	}
+	std::vector<int> columns(indices.size());
+	_variable_indices(indices, columns);
 
 	int error = copt::COPT_DelCols(m_model.get(), columns.size(), columns.data());
 	check_error(error);
 
-	for (int i = 0; i < n_variables; i++)
-	{
-		m_variable_index.delete_index(variables[i].index);
-	}
+	m_variable_index.delete_indices(indices);
 }
 
 bool COPTModel::is_variable_active(const VariableIndex &variable)
@@ -264,6 +276,14 @@ double COPTModel::get_variable_value(const VariableIndex &variable)
 	return get_variable_info(variable, COPT_DBLINFO_VALUE);
 }
 
+void COPTModel::get_variable_values(int N, const int *variables, double *values)
+{
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error = copt::COPT_GetColInfo(m_model.get(), COPT_DBLINFO_VALUE, N, columns.data(), values);
+	check_error(error);
+}
+
 std::string COPTModel::pprint_variable(const VariableIndex &variable)
 {
 	return get_variable_name(variable);
@@ -279,6 +299,18 @@ void COPTModel::set_variable_bounds(const VariableIndex &variable, double lb, do
 	check_error(error);
 }
 
+void COPTModel::set_variable_bounds(int N, const int *variables, const double *lb,
+                                    const double *ub)
+{
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error;
+	error = copt::COPT_SetColLower(m_model.get(), N, columns.data(), lb);
+	check_error(error);
+	error = copt::COPT_SetColUpper(m_model.get(), N, columns.data(), ub);
+	check_error(error);
+}
+
 ConstraintIndex COPTModel::add_linear_constraint(const ScalarAffineFunction &function,
                                                  ConstraintSense sense, CoeffT rhs,
                                                  const char *name)
@@ -340,6 +372,29 @@ ConstraintIndex COPTModel::add_linear_constraint(const ScalarAffineFunction &fun
 	return ConstraintIndex();
 }
 
+ConstraintIndex COPTModel::add_linear_constraints(int M, const int *indptr, const int *variables,
+                                                  const double *coefficients,
+                                                  ConstraintSense sense, const double *rhs)
+{
+	CSRMatrixPtrForm<int, int, double> ptr_form;
+	ptr_form.make(this, M, indptr, variables, coefficients);
+
+	IndexT index = m_linear_constraint_index.add_indices(M);
+	ConstraintIndex constraint_index(ConstraintType::Linear, index);
+
+	std::vector<int> counts(M);
+	for (int i = 0; i < M; i++)
+	{
+		counts[i] = ptr_form.begin[i + 1] - ptr_form.begin[i];
+	}
+	std::vector<char> senses(M, copt_con_sense(sense));
+
+	int error = copt::COPT_AddRows(m_model.get(), M, ptr_form.begin, counts.data(),
+	                               ptr_form.index, ptr_form.value, senses.data(), rhs, rhs, NULL);
+	check_error(error);
+	return constraint_index;
+}
+
 ConstraintIndex COPTModel::add_quadratic_constraint(const ScalarQuadraticFunction &function,
                                                     ConstraintSense sense, CoeffT rhs,
                                                     const char *name)
@@ -1235,6 +1290,55 @@ void COPTModel::set_normalized_rhs(const ConstraintIndex &constraint, double val
 	}
 }
 
+void COPTModel::set_normalized_rhs(int N, const int *constraints, const double *values)
+{
+	std::vector<int> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<int>(rows));
+
+	std::vector<double> lb(N), ub(N);
+	int error;
+	error = copt::COPT_GetRowInfo(m_model.get(), COPT_DBLINFO_LB, N, rows.data(), lb.data());
+	check_error(error);
+	error = copt::COPT_GetRowInfo(m_model.get(), COPT_DBLINFO_UB, N, rows.data(), ub.data());
+	check_error(error);
+
+	// like the single version, only the finite sides of each row are changed
+	std::vector<int> lb_rows, ub_rows;
+	std::vector<double> lb_values, ub_values;
+	for (int i = 0; i < N; i++)
+	{
+		bool lb_inf = lb[i] < -COPT_INFINITY + 1.0;
+		bool ub_inf = ub[i] > COPT_INFINITY - 1.0;
+		if (lb_inf && ub_inf)
+		{
+			throw std::runtime_error("Constraint has no finite bound");
+		}
+		if (!lb_inf)
+		{
+			lb_rows.push_back(rows[i]);
+			lb_values.push_back(values[i]);
+		}
+		if (!ub_inf)
+		{
+			ub_rows.push_back(rows[i]);
+			ub_values.push_back(values[i]);
+		}
+	}
+
+	if (!lb_rows.empty())
+	{
+		error = copt::COPT_SetRowLower(m_model.get(), lb_rows.size(), lb_rows.data(),
+		                               lb_values.data());
+		check_error(error);
+	}
+	if (!ub_rows.empty())
+	{
+		error = copt::COPT_SetRowUpper(m_model.get(), ub_rows.size(), ub_rows.data(),
+		                               ub_values.data());
+		check_error(error);
+	}
+}
+
 double COPTModel::get_normalized_coefficient(const ConstraintIndex &constraint,
                                              const VariableIndex &variable)
 {
@@ -1263,6 +1367,17 @@ void COPTModel::set_normalized_coefficient(const ConstraintIndex &constraint,
 	check_error(error);
 }
 
+void COPTModel::set_normalized_coefficients(int N, const int *constraints, const int *variables,
+                                            const double *values)
+{
+	std::vector<int> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<int>(rows));
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error = copt::COPT_SetElems(m_model.get(), N, columns.data(), rows.data(), values);
+	check_error(error);
+}
+
 double COPTModel::get_objective_coefficient(const VariableIndex &variable)
 {
 	return get_variable_info(variable, COPT_DBLINFO_OBJ);
@@ -1275,11 +1390,24 @@ void COPTModel::set_objective_coefficient(const VariableIndex &variable, double
 	check_error(error);
 }
 
+void COPTModel::set_objective_coefficients(int N, const int *variables, const double *values)
+{
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error = copt::COPT_SetColObj(m_model.get(), N, columns.data(), values);
+	check_error(error);
+}
+
 int COPTModel::_variable_index(const VariableIndex &variable)
 {
 	return m_variable_index.get_index(variable.index);
 }
 
+void COPTModel::_variable_indices(std::span<const IndexT> variables, std::span<int> columns)
+{
+	m_variable_index.get_indices(variables, columns);
+}
+
 int COPTModel::_checked_variable_index(const VariableIndex &variable)
 {
 	int column = _variable_index(variable);
@@ -1321,6 +1449,12 @@ int COPTModel::_checked_constraint_index(const ConstraintIndex &constraint)
 	return row;
 }
 
+void COPTModel::_linear_constraint_indices(std::span<const IndexT> constraints,
+                                           std::span<int> rows)
+{
+	m_linear_constraint_index.get_indices(constraints, rows);
+}
+
 void *COPTModel::get_raw_model()
 {
 	return m_model.get();
@@ -5,6 +5,8 @@
 #include <nanobind/stl/tuple.h>
 
 #include "pyoptinterface/copt_model.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
+#include "pyoptinterface/cache_model.hpp"
 
 namespace nb = nanobind;
 
@@ -39,12 +41,30 @@ NB_MODULE(copt_model_ext, m)
 	    .def("add_variable", &COPTModel::add_variable,
 	         nb::arg("domain") = VariableDomain::Continuous, nb::arg("lb") = -COPT_INFINITY,
 	         nb::arg("ub") = COPT_INFINITY, nb::arg("name") = "")
+	    .def(
+	        "_add_variables",
+	        [](COPTModel &model, int N, VariableDomain domain,
+	           const std::optional<DoubleArrayT> &lb, const std::optional<DoubleArrayT> &ub) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer;
+		        return model.add_variables(N, domain,
+		                                   array_or_fill(lb, N, -COPT_INFINITY, lb_buffer, "lb"),
+		                                   array_or_fill(ub, N, COPT_INFINITY, ub_buffer, "ub"));
+	        },
+	        nb::arg("N"), nb::arg("domain") = VariableDomain::Continuous,
+	        nb::arg("lb") = nb::none(), nb::arg("ub") = nb::none())
 	    // clang-format off
 	    BIND_F(delete_variable)
 	    BIND_F(delete_variables)
 	    BIND_F(is_variable_active)
 	    // clang-format on
-	    .def("set_variable_bounds", &COPTModel::set_variable_bounds, nb::arg("variable"),
+	    .def("set_variable_bounds",
+	         nb::overload_cast<const VariableIndex &, double, double>(
+	             &COPTModel::set_variable_bounds),
+	         nb::arg("variable"), nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_array<COPTModel>, nb::arg("variables"),
+	         nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_list<COPTModel>, nb::arg("variables"),
 	         nb::arg("lb"), nb::arg("ub"))
 
 	    .def("get_value", nb::overload_cast<const VariableIndex &>(&COPTModel::get_variable_value))
@@ -53,6 +73,9 @@ NB_MODULE(copt_model_ext, m)
 	    .def("get_value",
 	         nb::overload_cast<const ScalarQuadraticFunction &>(&COPTModel::get_expression_value))
 	    .def("get_value", nb::overload_cast<const ExprBuilder &>(&COPTModel::get_expression_value))
+	    .def("get_values", &get_variable_values_array<COPTModel>, nb::arg("variables"))
+	    .def("get_values", &get_variable_values_list<COPTModel>, nb::arg("variables"))
+	    .def("get_values", &get_expression_values_array<COPTModel>, nb::arg("exprs"))
 
 	    .def("pprint", &COPTModel::pprint_variable)
 	    .def("pprint",
@@ -80,6 +103,10 @@ NB_MODULE(copt_model_ext, m)
 	         nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
 	    .def("_add_linear_constraint", &COPTModel::add_linear_interval_constraint_from_expr,
 	         nb::arg("expr"), nb::arg("interval"), nb::arg("name") = "")
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<COPTModel>,
+	         nb::arg("indptr"), nb::arg("variables"), nb::arg("coefficients"), nb::arg("sense"),
+	         nb::arg("rhs"))
+	    .def("load_cache_model", &load_cache_model<COPTModel>, nb::arg("cache"))
 
 	    .def("_add_quadratic_constraint", &COPTModel::add_quadratic_constraint, nb::arg("expr"),
 	         nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
@@ -189,7 +216,6 @@ NB_MODULE(copt_model_ext, m)
 	    BIND_F(add_nl_start)
 
 		BIND_F(get_normalized_rhs)
-		BIND_F(set_normalized_rhs)
 		BIND_F(get_normalized_coefficient)
 		BIND_F(set_normalized_coefficient)
 		BIND_F(get_objective_coefficient)
@@ -200,5 +226,19 @@ NB_MODULE(copt_model_ext, m)
 		BIND_F(_get_variable_lowerbound_IIS)
 		BIND_F(_get_constraint_IIS)
 	    // clang-format on
+	    .def("set_normalized_rhs",
+	         nb::overload_cast<const ConstraintIndex &, double>(&COPTModel::set_normalized_rhs))
+	    .def("set_normalized_rhs", &set_normalized_rhs_array<COPTModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_rhs", &set_normalized_rhs_list<COPTModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_array<COPTModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_list<COPTModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_array<COPTModel>,
+	         nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_list<COPTModel>,
+	         nb::arg("variables"), nb::arg("values"))
 	    ;
 }
\ No newline at end of file
@@ -4,6 +4,12 @@
 
 #include "fmt/core.h"
 
+// Auto mode switches to the dense accumulator when the number of affine terms reaches
+// DENSE_AFFINE_AUTO_THRESHOLD and the largest variable index is less than
+// DENSE_AFFINE_MAX_SPARSITY times the number of terms
+static constexpr size_t DENSE_AFFINE_AUTO_THRESHOLD = 1 << 14;
+static constexpr size_t DENSE_AFFINE_MAX_SPARSITY = 4;
+
 VariableIndex::VariableIndex(IndexT v) : index(v)
 {
 }
@@ -34,16 +40,24 @@ ScalarAffineFunction::ScalarAffineFunction(const Vector<CoeffT> &a, const Vector
 }
 ScalarAffineFunction::ScalarAffineFunction(const ExprBuilder &t)
 {
-	const auto &affine_terms = t.affine_terms;
+	if (t.is_dense_affine())
+	{
+		// the dense accumulator yields sorted terms almost for free
+		t.sorted_affine_terms(variables, coefficients);
+	}
+	else
+	{
+		const auto &affine_terms = t.affine_terms;
 
-	auto N = affine_terms.size();
-	coefficients.reserve(N);
-	variables.reserve(N);
+		auto N = affine_terms.size();
+		coefficients.reserve(N);
+		variables.reserve(N);
 
-	for (auto &[v, c] : affine_terms)
-	{
-		coefficients.push_back(c);
-		variables.push_back(v);
+		for (auto &[v, c] : affine_terms)
+		{
+			coefficients.push_back(c);
+			variables.push_back(v);
+		}
 	}
 	if (t.constant_term)
 	{
@@ -64,19 +78,7 @@ void ScalarAffineFunction::canonicalize(CoeffT threshold)
 	// sort coefficients and variable lock by lock with std::views::zip
 	// std::ranges::sort(std::views::zip(variables, coefficients));
 
-	variables.clear();
-	variables.reserve(t.affine_terms.size());
-	for (const auto &it : t.affine_terms)
-	{
-		variables.push_back(it.first);
-	}
-	std::sort(variables.begin(), variables.end());
-	coefficients.clear();
-	coefficients.reserve(variables.size());
-	for (const auto &it : variables)
-	{
-		coefficients.push_back(t.affine_terms[it]);
-	}
+	t.sorted_affine_terms(variables, coefficients);
 	constant = t.constant_term;
 }
 
@@ -122,7 +124,7 @@ ScalarQuadraticFunction::ScalarQuadraticFunction(const ExprBuilder &t)
 		variable_1s.push_back(vp.var_1);
 		variable_2s.push_back(vp.var_2);
 	}
-	if (!t.affine_terms.empty() || t.constant_term)
+	if (t.affine_size() > 0 || t.constant_term)
 	{
 		affine_part = ScalarAffineFunction(t);
 	}
@@ -259,7 +261,7 @@ ExprBuilder::ExprBuilder(const ScalarQuadraticFunction &q)
 
 bool ExprBuilder::empty() const
 {
-	return quadratic_terms.empty() && affine_terms.empty() && !constant_term;
+	return quadratic_terms.empty() && affine_size() == 0 && !constant_term;
 }
 
 int ExprBuilder::degree() const
@@ -268,7 +270,7 @@ int ExprBuilder::degree() const
 	{
 		return 2;
 	}
-	if (!affine_terms.empty())
+	if (affine_size() > 0)
 	{
 		return 1;
 	}
@@ -282,13 +284,21 @@ void ExprBuilder::reserve_quadratic(size_t n)
 
 void ExprBuilder::reserve_affine(size_t n)
 {
-	affine_terms.reserve(n);
+	if (dense_affine)
+	{
+		dense_affine_variables.reserve(n);
+		dense_affine_coefficients.reserve(n);
+	}
+	else
+	{
+		affine_terms.reserve(n);
+	}
 }
 
 void ExprBuilder::clear()
 {
 	quadratic_terms.clear();
-	affine_terms.clear();
+	_clear_affine_terms();
 	constant_term.reset();
 }
 
@@ -306,15 +316,41 @@ void ExprBuilder::clean_nearzero_terms(CoeffT threshold)
 			++it;
 		}
 	}
-	for (auto it = affine_terms.begin(); it != affine_terms.end();)
+	if (dense_affine)
 	{
-		if (std::abs(it->second) < threshold)
+		size_t j = 0;
+		auto N = dense_affine_variables.size();
+		for (size_t i = 0; i < N; i++)
 		{
-			it = affine_terms.erase(it);
+			auto v = dense_affine_variables[i];
+			auto c = dense_affine_coefficients[i];
+			if (std::abs(c) < threshold)
+			{
+				dense_affine_slots[v] = -1;
+			}
+			else
+			{
+				dense_affine_slots[v] = IndexT(j);
+				dense_affine_variables[j] = v;
+				dense_affine_coefficients[j] = c;
+				j++;
+			}
 		}
-		else
+		dense_affine_variables.resize(j);
+		dense_affine_coefficients.resize(j);
+	}
+	else
+	{
+		for (auto it = affine_terms.begin(); it != affine_terms.end();)
 		{
-			++it;
+			if (std::abs(it->second) < threshold)
+			{
+				it = affine_terms.erase(it);
+			}
+			else
+			{
+				++it;
+			}
 		}
 	}
 	if (constant_term && std::abs(*constant_term) < threshold)
@@ -362,21 +398,70 @@ void ExprBuilder::set_quadratic_coef(const VariableIndex &i, const VariableIndex
 
 void ExprBuilder::_add_affine_term(IndexT i, CoeffT coeff)
 {
+	if (dense_affine)
+	{
+		if (size_t(i) < dense_affine_slots.size())
+		{
+			auto slot = dense_affine_slots[i];
+			if (slot >= 0)
+			{
+				dense_affine_coefficients[slot] += coeff;
+				return;
+			}
+		}
+		else
+		{
+			_grow_dense_affine(i);
+			if (!dense_affine)
+			{
+				_add_affine_term(i, coeff);
+				return;
+			}
+		}
+		dense_affine_slots[i] = IndexT(dense_affine_variables.size());
+		dense_affine_variables.push_back(i);
+		dense_affine_coefficients.push_back(coeff);
+		return;
+	}
+
 	auto ret = affine_terms.emplace(i, coeff);
 	if (!ret.second)
 	{
 		auto &iter = ret.first;
 		iter->second += coeff;
 	}
+	else if (affine_terms.size() == DENSE_AFFINE_AUTO_THRESHOLD)
+	{
+		_check_auto_dense_affine();
+	}
 }
 void ExprBuilder::_set_affine_coef(IndexT i, CoeffT coeff)
 {
+	if (dense_affine)
+	{
+		if (size_t(i) < dense_affine_slots.size())
+		{
+			auto slot = dense_affine_slots[i];
+			if (slot >= 0)
+			{
+				dense_affine_coefficients[slot] = coeff;
+				return;
+			}
+		}
+		_add_affine_term(i, coeff);
+		return;
+	}
+
 	auto ret = affine_terms.emplace(i, coeff);
 	if (!ret.second)
 	{
 		auto &iter = ret.first;
 		iter->second = coeff;
 	}
+	else if (affine_terms.size() == DENSE_AFFINE_AUTO_THRESHOLD)
+	{
+		_check_auto_dense_affine();
+	}
 }
 void ExprBuilder::add_affine_term(const VariableIndex &i, CoeffT coeff)
 {
@@ -387,6 +472,163 @@ void ExprBuilder::set_affine_coef(const VariableIndex &i, CoeffT coeff)
 	_set_affine_coef(i.index, coeff);
 }
 
+void ExprBuilder::set_affine_accumulator(AffineAccumulator accumulator)
+{
+	affine_accumulator = accumulator;
+	if (accumulator == AffineAccumulator::Dense)
+	{
+		_to_dense_affine();
+	}
+	else if (accumulator == AffineAccumulator::Hash)
+	{
+		_to_hash_affine();
+	}
+}
+
+bool ExprBuilder::is_dense_affine() const
+{
+	return dense_affine;
+}
+
+size_t ExprBuilder::affine_size() const
+{
+	return dense_affine ? dense_affine_variables.size() : affine_terms.size();
+}
+
+void ExprBuilder::sorted_affine_terms(Vector<IndexT> &variables, Vector<CoeffT> &coefficients) const
+{
+	auto N = affine_size();
+	variables.clear();
+	variables.reserve(N);
+	coefficients.clear();
+	coefficients.reserve(N);
+	if (dense_affine)
+	{
+		// scanning the slots is linear in the largest variable index, sorting the touched
+		// variables is N log N, pick the cheaper one
+		if (N * DENSE_AFFINE_MAX_SPARSITY >= dense_affine_slots.size())
+		{
+			auto M = dense_affine_slots.size();
+			for (size_t i = 0; i < M; i++)
+			{
+				auto slot = dense_affine_slots[i];
+				if (slot >= 0)
+				{
+					variables.push_back(IndexT(i));
+					coefficients.push_back(dense_affine_coefficients[slot]);
+				}
+			}
+		}
+		else
+		{
+			variables = dense_affine_variables;
+			std::sort(variables.begin(), variables.end());
+			for (auto v : variables)
+			{
+				coefficients.push_back(dense_affine_coefficients[dense_affine_slots[v]]);
+			}
+		}
+	}
+	else
+	{
+		for (const auto &[v, c] : affine_terms)
+		{
+			variables.push_back(v);
+		}
+		std::sort(variables.begin(), variables.end());
+		for (auto v : variables)
+		{
+			coefficients.push_back(affine_terms.find(v)->second);
+		}
+	}
+}
+
+void ExprBuilder::_clear_affine_terms()
+{
+	if (dense_affine)
+	{
+		for (auto v : dense_affine_variables)
+		{
+			dense_affine_slots[v] = -1;
+		}
+		dense_affine_variables.clear();
+		dense_affine_coefficients.clear();
+	}
+	else
+	{
+		affine_terms.clear();
+	}
+}
+
+void ExprBuilder::_to_dense_affine()
+{
+	if (dense_affine)
+		return;
+
+	IndexT max_index = -1;
+	for (const auto &[v, c] : affine_terms)
+	{
+		max_index = std::max(max_index, v);
+	}
+	auto N = affine_terms.size();
+	dense_affine_slots.assign(max_index + 1, -1);
+	dense_affine_variables.reserve(N);
+	dense_affine_coefficients.reserve(N);
+	for (const auto &[v, c] : affine_terms)
+	{
+		dense_affine_slots[v] = IndexT(dense_affine_variables.size());
+		dense_affine_variables.push_back(v);
+		dense_affine_coefficients.push_back(c);
+	}
+	affine_terms = {};
+	dense_affine = true;
+}
+
+void ExprBuilder::_to_hash_affine()
+{
+	if (!dense_affine)
+		return;
+
+	auto N = dense_affine_variables.size();
+	affine_terms.reserve(N);
+	for (size_t i = 0; i < N; i++)
+	{
+		affine_terms.emplace(dense_affine_variables[i], dense_affine_coefficients[i]);
+	}
+	dense_affine_slots = {};
+	dense_affine_variables = {};
+	dense_affine_coefficients = {};
+	dense_affine = false;
+}
+
+void ExprBuilder::_check_auto_dense_affine()
+{
+	if (affine_accumulator != AffineAccumulator::Auto)
+		return;
+
+	IndexT max_index = -1;
+	for (const auto &[v, c] : affine_terms)
+	{
+		max_index = std::max(max_index, v);
+	}
+	if (size_t(max_index) < DENSE_AFFINE_MAX_SPARSITY * affine_terms.size())
+	{
+		_to_dense_affine();
+	}
+}
+
+void ExprBuilder::_grow_dense_affine(IndexT i)
+{
+	// Auto mode falls back to the hashmap if the expression becomes too sparse
+	if (affine_accumulator == AffineAccumulator::Auto &&
+	    size_t(i) >= DENSE_AFFINE_MAX_SPARSITY * (dense_affine_variables.size() + 1))
+	{
+		_to_hash_affine();
+		return;
+	}
+	dense_affine_slots.resize(size_t(i) + 1, -1);
+}
+
 ExprBuilder &ExprBuilder::operator+=(CoeffT c)
 {
 	constant_term = constant_term.value_or(0.0) + c;
@@ -433,10 +675,7 @@ ExprBuilder &ExprBuilder::operator+=(const ExprBuilder &t)
 		{
 			c *= 2.0;
 		}
-		for (auto &[v, c] : affine_terms)
-		{
-			c *= 2.0;
-		}
+		for_each_affine_coefficient([&](CoeffT &c) { c *= 2.0; });
 		if (constant_term)
 		{
 			constant_term = constant_term.value() * 2.0;
@@ -448,10 +687,7 @@ ExprBuilder &ExprBuilder::operator+=(const ExprBuilder &t)
 		{
 			_add_quadratic_term(varpair.var_1, varpair.var_2, c);
 		}
-		for (const auto &[v, c] : t.affine_terms)
-		{
-			_add_affine_term(v, c);
-		}
+		t.for_each_affine_term([&](IndexT v, CoeffT c) { _add_affine_term(v, c); });
 		if (t.constant_term)
 		{
 			constant_term = constant_term.value_or(0.0) + t.constant_term.value();
@@ -503,7 +739,7 @@ ExprBuilder &ExprBuilder::operator-=(const ExprBuilder &t)
 	if (this == &t)
 	{
 		quadratic_terms.clear();
-		affine_terms.clear();
+		_clear_affine_terms();
 		constant_term.reset();
 	}
 	else
@@ -512,10 +748,7 @@ ExprBuilder &ExprBuilder::operator-=(const ExprBuilder &t)
 		{
 			_add_quadratic_term(varpair.var_1, varpair.var_2, -c);
 		}
-		for (const auto &[v, c] : t.affine_terms)
-		{
-			_add_affine_term(v, -c);
-		}
+		t.for_each_affine_term([&](IndexT v, CoeffT c) { _add_affine_term(v, -c); });
 		if (t.constant_term)
 		{
 			constant_term = constant_term.value_or(0.0) - t.constant_term.value();
@@ -530,10 +763,7 @@ ExprBuilder &ExprBuilder::operator*=(CoeffT c)
 	{
 		cc *= c;
 	}
-	for (auto &[v, cc] : affine_terms)
-	{
-		cc *= c;
-	}
+	for_each_affine_coefficient([&](CoeffT &cc) { cc *= c; });
 	if (constant_term)
 	{
 		constant_term = constant_term.value() * c;
@@ -549,21 +779,19 @@ ExprBuilder &ExprBuilder::operator*=(const VariableIndex &v)
 		    fmt::format("ExprBuilder with degree {} cannot multiply with VariableIndex", deg));
 	}
 
-	auto N = affine_terms.size();
+	auto N = affine_size();
 	quadratic_terms.reserve(N);
-	for (const auto &[var2, c] : affine_terms)
-	{
-		_add_quadratic_term(v.index, var2, c);
-	}
+	for_each_affine_term([&](IndexT var2, CoeffT c) { _add_quadratic_term(v.index, var2, c); });
 
 	if (constant_term)
 	{
-		affine_terms = {{v.index, constant_term.value()}};
+		_clear_affine_terms();
+		_add_affine_term(v.index, constant_term.value());
 		constant_term.reset();
 	}
 	else
 	{
-		affine_terms.clear();
+		_clear_affine_terms();
 	}
 	return *this;
 }
@@ -576,30 +804,26 @@ ExprBuilder &ExprBuilder::operator*=(const ScalarAffineFunction &a)
 		    "ExprBuilder with degree {} cannot multiply with ScalarAffineFunction", deg));
 	}
 
-	auto N1 = affine_terms.size();
+	auto N1 = affine_size();
 	auto N2 = a.size();
 	quadratic_terms.reserve(N1 * N2 / 2);
-	for (const auto &[xi, ci] : affine_terms)
-	{
+	for_each_affine_term([&](IndexT xi, CoeffT ci) {
 		for (int j = 0; j < a.size(); j++)
 		{
 			auto dj = a.coefficients[j];
 			auto xj = a.variables[j];
 			_add_quadratic_term(xi, xj, ci * dj);
 		}
-	}
+	});
 
 	if (a.constant)
 	{
 		auto d0 = a.constant.value();
-		for (auto &[_, ci] : affine_terms)
-		{
-			ci *= d0;
-		}
+		for_each_affine_coefficient([&](CoeffT &ci) { ci *= d0; });
 	}
 	else
 	{
-		affine_terms.clear();
+		_clear_affine_terms();
 	}
 
 	if (constant_term)
@@ -648,7 +872,7 @@ ExprBuilder &ExprBuilder::operator*=(const ScalarQuadraticFunction &q)
 	{
 		auto &affine_part = q.affine_part.value();
 		auto N = affine_part.coefficients.size();
-		affine_terms.reserve(N);
+		reserve_affine(N);
 		for (auto i = 0; i < N; i++)
 		{
 			_add_affine_term(affine_part.variables[i], c * affine_part.coefficients[i]);
@@ -695,28 +919,23 @@ ExprBuilder &ExprBuilder::operator*=(const ExprBuilder &t)
 		else
 		// deg = 1
 		{
-			auto N = affine_terms.size();
+			auto N = affine_size();
 			quadratic_terms.reserve(N * N / 2);
-			for (const auto &[xi, ci] : affine_terms)
-			{
-				for (const auto &[xj, cj] : affine_terms)
-				{
+			for_each_affine_term([&](IndexT xi, CoeffT ci) {
+				for_each_affine_term([&](IndexT xj, CoeffT cj) {
 					_add_quadratic_term(xi, xj, ci * cj);
-				}
-			}
+				});
+			});
 
 			if (constant_term)
 			{
 				auto d0 = constant_term.value();
-				for (auto &[_, ci] : affine_terms)
-				{
-					ci *= 2.0 * d0;
-				}
+				for_each_affine_coefficient([&](CoeffT &ci) { ci *= 2.0 * d0; });
 				constant_term = d0 * d0;
 			}
 			else
 			{
-				affine_terms.clear();
+				_clear_affine_terms();
 			}
 		}
 	}
@@ -735,12 +954,9 @@ ExprBuilder &ExprBuilder::operator*=(const ExprBuilder &t)
 					_add_quadratic_term(varpair.var_1, varpair.var_2, c * c2);
 				}
 
-				N = t.affine_terms.size();
-				affine_terms.reserve(N);
-				for (const auto &[v, c1] : t.affine_terms)
-				{
-					_add_affine_term(v, c * c1);
-				}
+				N = t.affine_size();
+				reserve_affine(N);
+				t.for_each_affine_term([&](IndexT v, CoeffT c1) { _add_affine_term(v, c * c1); });
 
 				if (t.constant_term)
 				{
@@ -756,38 +972,32 @@ ExprBuilder &ExprBuilder::operator*=(const ExprBuilder &t)
 		{
 			if (deg2 == 1)
 			{
-				auto N1 = affine_terms.size();
-				auto N2 = t.affine_terms.size();
+				auto N1 = affine_size();
+				auto N2 = t.affine_size();
 				quadratic_terms.reserve(N1 * N2 / 2);
-				for (const auto &[xi, ci] : affine_terms)
-				{
-					for (const auto &[xj, dj] : t.affine_terms)
-					{
+				for_each_affine_term([&](IndexT xi, CoeffT ci) {
+					t.for_each_affine_term([&](IndexT xj, CoeffT dj) {
 						_add_quadratic_term(xi, xj, ci * dj);
-					}
-				}
+					});
+				});
 			}
 
 			if (t.constant_term)
 			{
 				auto d0 = t.constant_term.value();
-				for (auto &[_, ci] : affine_terms)
-				{
-					ci *= d0;
-				}
+				for_each_affine_coefficient([&](CoeffT &ci) { ci *= d0; });
 			}
 			else
 			{
-				affine_terms.clear();
+				_clear_affine_terms();
 			}
 
 			if (constant_term)
 			{
 				auto c0 = constant_term.value();
-				for (const auto &[xj, dj] : t.affine_terms)
-				{
+				t.for_each_affine_term([&](IndexT xj, CoeffT dj) {
 					_add_affine_term(xj, c0 * dj);
-				}
+				});
 			}
 
 			if (t.constant_term && constant_term)
@@ -810,10 +1020,7 @@ ExprBuilder &ExprBuilder::operator*=(const ExprBuilder &t)
 					c2 *= c;
 				}
 
-				for (auto &[_, c1] : affine_terms)
-				{
-					c1 *= c;
-				}
+				for_each_affine_coefficient([&](CoeffT &c1) { c1 *= c; });
 
 				if (constant_term)
 				{
@@ -835,10 +1042,7 @@ ExprBuilder &ExprBuilder::operator/=(CoeffT c)
 	{
 		cc /= c;
 	}
-	for (auto &[v, cc] : affine_terms)
-	{
-		cc /= c;
-	}
+	for_each_affine_coefficient([&](CoeffT &cc) { cc /= c; });
 	if (constant_term)
 	{
 		constant_term = constant_term.value() / c;
@@ -848,6 +1052,85 @@ ExprBuilder &ExprBuilder::operator/=(CoeffT c)
 
 // Operator overloading functions
 
+// Sums with few terms are merged by linear search instead of building an ExprBuilder, the
+// result keeps the order of first appearance like ExprBuilder does
+static constexpr size_t SMALL_AFFINE_TERMS = 16;
+
+static ScalarAffineFunction copy_with_capacity(const ScalarAffineFunction &a, size_t extra)
+{
+	ScalarAffineFunction aa;
+	aa.reserve(a.size() + extra);
+	aa.coefficients.assign(a.coefficients.begin(), a.coefficients.end());
+	aa.variables.assign(a.variables.begin(), a.variables.end());
+	aa.constant = a.constant;
+	return aa;
+}
+
+// a += sign * b, duplicated variables are merged
+static void add_small_affine_function(ScalarAffineFunction &a, const ScalarAffineFunction &b,
+                                      CoeffT sign)
+{
+	if (&a == &b)
+	{
+		ScalarAffineFunction bb = b;
+		add_small_affine_function(a, bb, sign);
+		return;
+	}
+
+	a.reserve(a.size() + b.size());
+	auto N = b.size();
+	for (size_t i = 0; i < N; i++)
+	{
+		a.coefficients.push_back(sign * b.coefficients[i]);
+		a.variables.push_back(b.variables[i]);
+	}
+
+	size_t n_unique = 0;
+	N = a.size();
+	for (size_t i = 0; i < N; i++)
+	{
+		auto v = a.variables[i];
+		auto c = a.coefficients[i];
+		size_t j = 0;
+		while (j < n_unique && a.variables[j] != v)
+		{
+			j++;
+		}
+		if (j < n_unique)
+		{
+			a.coefficients[j] += c;
+		}
+		else
+		{
+			a.variables[n_unique] = v;
+			a.coefficients[n_unique] = c;
+			n_unique++;
+		}
+	}
+	a.coefficients.resize(n_unique);
+	a.variables.resize(n_unique);
+
+	if (b.constant)
+	{
+		a.constant = a.constant.value_or(0.0) + sign * b.constant.value();
+	}
+}
+
+static ScalarAffineFunction add_large_affine_function(const ScalarAffineFunction &a,
+                                                      const ScalarAffineFunction &b, CoeffT sign)
+{
+	ExprBuilder t(a);
+	if (sign > 0.0)
+	{
+		t.operator+=(b);
+	}
+	else
+	{
+		t.operator-=(b);
+	}
+	return ScalarAffineFunction(t);
+}
+
 auto operator+(const VariableIndex &a, CoeffT b) -> ScalarAffineFunction
 {
 	return ScalarAffineFunction(a, 1.0, b);
@@ -867,6 +1150,11 @@ auto operator+(const ScalarAffineFunction &a, CoeffT b) -> ScalarAffineFunction
 	CoeffT new_constant = a.constant.value_or(0.0) + b;
 	return ScalarAffineFunction(a.coefficients, a.variables, new_constant);
 }
+auto operator+(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction
+{
+	a.constant = a.constant.value_or(0.0) + b;
+	return std::move(a);
+}
 auto operator+(CoeffT a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 {
 	return b + a;
@@ -874,11 +1162,14 @@ auto operator+(CoeffT a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 
 auto operator+(const ScalarAffineFunction &a, const VariableIndex &b) -> ScalarAffineFunction
 {
-	auto coefficients = a.coefficients;
-	auto variables = a.variables;
-	coefficients.push_back(1.0);
-	variables.push_back(b.index);
-	return ScalarAffineFunction(coefficients, variables, a.constant);
+	auto aa = copy_with_capacity(a, 1);
+	aa.add_term(b, 1.0);
+	return aa;
+}
+auto operator+(ScalarAffineFunction &&a, const VariableIndex &b) -> ScalarAffineFunction
+{
+	a.add_term(b, 1.0);
+	return std::move(a);
 }
 auto operator+(const VariableIndex &a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 {
@@ -887,23 +1178,40 @@ auto operator+(const VariableIndex &a, const ScalarAffineFunction &b) -> ScalarA
 
 auto operator+(const ScalarAffineFunction &a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 {
-	ExprBuilder t(a);
-	t.operator+=(b);
-	return ScalarAffineFunction(t);
+	if (a.size() + b.size() > SMALL_AFFINE_TERMS)
+	{
+		return add_large_affine_function(a, b, 1.0);
+	}
+	auto aa = copy_with_capacity(a, b.size());
+	add_small_affine_function(aa, b, 1.0);
+	return aa;
+}
+auto operator+(ScalarAffineFunction &&a, const ScalarAffineFunction &b) -> ScalarAffineFunction
+{
+	if (a.size() + b.size() > SMALL_AFFINE_TERMS)
+	{
+		return add_large_affine_function(a, b, 1.0);
+	}
+	add_small_affine_function(a, b, 1.0);
+	return std::move(a);
 }
 
 auto operator+(const ScalarQuadraticFunction &a, CoeffT b) -> ScalarQuadraticFunction
 {
-	ScalarAffineFunction affine_part;
+	ScalarQuadraticFunction aa = a;
+	return std::move(aa) + b;
+}
+auto operator+(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction
+{
 	if (a.affine_part)
 	{
-		affine_part = operator+(a.affine_part.value(), b);
+		a.affine_part = std::move(a.affine_part.value()) + b;
 	}
 	else
 	{
-		affine_part = ScalarAffineFunction(b);
+		a.affine_part = ScalarAffineFunction(b);
 	}
-	return ScalarQuadraticFunction(a.coefficients, a.variable_1s, a.variable_2s, affine_part);
+	return std::move(a);
 }
 auto operator+(CoeffT a, const ScalarQuadraticFunction &b) -> ScalarQuadraticFunction
 {
@@ -912,16 +1220,20 @@ auto operator+(CoeffT a, const ScalarQuadraticFunction &b) -> ScalarQuadraticFun
 
 auto operator+(const ScalarQuadraticFunction &a, const VariableIndex &b) -> ScalarQuadraticFunction
 {
-	ScalarAffineFunction affine_part;
+	ScalarQuadraticFunction aa = a;
+	return std::move(aa) + b;
+}
+auto operator+(ScalarQuadraticFunction &&a, const VariableIndex &b) -> ScalarQuadraticFunction
+{
 	if (a.affine_part)
 	{
-		affine_part = operator+(a.affine_part.value(), b);
+		a.affine_part = std::move(a.affine_part.value()) + b;
 	}
 	else
 	{
-		affine_part = ScalarAffineFunction(b);
+		a.affine_part = ScalarAffineFunction(b);
 	}
-	return ScalarQuadraticFunction(a.coefficients, a.variable_1s, a.variable_2s, affine_part);
+	return std::move(a);
 }
 auto operator+(const VariableIndex &a, const ScalarQuadraticFunction &b) -> ScalarQuadraticFunction
 {
@@ -931,16 +1243,21 @@ auto operator+(const VariableIndex &a, const ScalarQuadraticFunction &b) -> Scal
 auto operator+(const ScalarQuadraticFunction &a, const ScalarAffineFunction &b)
     -> ScalarQuadraticFunction
 {
-	ScalarAffineFunction affine_part;
+	ScalarQuadraticFunction aa = a;
+	return std::move(aa) + b;
+}
+auto operator+(ScalarQuadraticFunction &&a, const ScalarAffineFunction &b)
+    -> ScalarQuadraticFunction
+{
 	if (a.affine_part)
 	{
-		affine_part = operator+(a.affine_part.value(), b);
+		a.affine_part = std::move(a.affine_part.value()) + b;
 	}
 	else
 	{
-		affine_part = b;
+		a.affine_part = b;
 	}
-	return ScalarQuadraticFunction(a.coefficients, a.variable_1s, a.variable_2s, affine_part);
+	return std::move(a);
 }
 auto operator+(const ScalarAffineFunction &a, const ScalarQuadraticFunction &b)
     -> ScalarQuadraticFunction
@@ -975,6 +1292,10 @@ auto operator-(const ScalarAffineFunction &a, CoeffT b) -> ScalarAffineFunction
 {
 	return operator+(a, -b);
 }
+auto operator-(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction
+{
+	return operator+(std::move(a), -b);
+}
 
 auto operator-(CoeffT a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 {
@@ -983,11 +1304,14 @@ auto operator-(CoeffT a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 
 auto operator-(const ScalarAffineFunction &a, const VariableIndex &b) -> ScalarAffineFunction
 {
-	auto coefficients = a.coefficients;
-	auto variables = a.variables;
-	coefficients.push_back(-1.0);
-	variables.push_back(b.index);
-	return ScalarAffineFunction(coefficients, variables, a.constant);
+	auto aa = copy_with_capacity(a, 1);
+	aa.add_term(b, -1.0);
+	return aa;
+}
+auto operator-(ScalarAffineFunction &&a, const VariableIndex &b) -> ScalarAffineFunction
+{
+	a.add_term(b, -1.0);
+	return std::move(a);
 }
 
 auto operator-(const VariableIndex &a, const ScalarAffineFunction &b) -> ScalarAffineFunction
@@ -997,13 +1321,32 @@ auto operator-(const VariableIndex &a, const ScalarAffineFunction &b) -> ScalarA
 
 auto operator-(const ScalarAffineFunction &a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 {
-	return operator+(a, operator*(b, -1.0));
+	if (a.size() + b.size() > SMALL_AFFINE_TERMS)
+	{
+		return add_large_affine_function(a, b, -1.0);
+	}
+	auto aa = copy_with_capacity(a, b.size());
+	add_small_affine_function(aa, b, -1.0);
+	return aa;
+}
+auto operator-(ScalarAffineFunction &&a, const ScalarAffineFunction &b) -> ScalarAffineFunction
+{
+	if (a.size() + b.size() > SMALL_AFFINE_TERMS)
+	{
+		return add_large_affine_function(a, b, -1.0);
+	}
+	add_small_affine_function(a, b, -1.0);
+	return std::move(a);
 }
 
 auto operator-(const ScalarQuadraticFunction &a, CoeffT b) -> ScalarQuadraticFunction
 {
 	return operator+(a, -b);
 }
+auto operator-(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction
+{
+	return operator+(std::move(a), -b);
+}
 
 auto operator-(CoeffT a, const ScalarQuadraticFunction &b) -> ScalarQuadraticFunction
 {
@@ -1014,6 +1357,10 @@ auto operator-(const ScalarQuadraticFunction &a, const VariableIndex &b) -> Scal
 {
 	return operator+(a, ScalarAffineFunction(b, -1.0));
 }
+auto operator-(ScalarQuadraticFunction &&a, const VariableIndex &b) -> ScalarQuadraticFunction
+{
+	return operator+(std::move(a), ScalarAffineFunction(b, -1.0));
+}
 
 auto operator-(const VariableIndex &a, const ScalarQuadraticFunction &b) -> ScalarQuadraticFunction
 {
@@ -1023,7 +1370,21 @@ auto operator-(const VariableIndex &a, const ScalarQuadraticFunction &b) -> Scal
 auto operator-(const ScalarQuadraticFunction &a, const ScalarAffineFunction &b)
     -> ScalarQuadraticFunction
 {
-	return operator+(a, operator*(b, -1.0));
+	ScalarQuadraticFunction aa = a;
+	return std::move(aa) - b;
+}
+auto operator-(ScalarQuadraticFunction &&a, const ScalarAffineFunction &b)
+    -> ScalarQuadraticFunction
+{
+	if (a.affine_part)
+	{
+		a.affine_part = std::move(a.affine_part.value()) - b;
+	}
+	else
+	{
+		a.affine_part = operator*(b, -1.0);
+	}
+	return std::move(a);
 }
 
 auto operator-(const ScalarAffineFunction &a, const ScalarQuadraticFunction &b)
@@ -1055,15 +1416,19 @@ auto operator*(const VariableIndex &a, const VariableIndex &b) -> ScalarQuadrati
 auto operator*(const ScalarAffineFunction &a, CoeffT b) -> ScalarAffineFunction
 {
 	ScalarAffineFunction aa = a;
-	for (auto &c : aa.coefficients)
+	return std::move(aa) * b;
+}
+auto operator*(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction
+{
+	for (auto &c : a.coefficients)
 	{
 		c *= b;
 	}
-	if (aa.constant)
+	if (a.constant)
 	{
-		aa.constant = aa.constant.value() * b;
+		a.constant = a.constant.value() * b;
 	}
-	return aa;
+	return std::move(a);
 }
 auto operator*(CoeffT a, const ScalarAffineFunction &b) -> ScalarAffineFunction
 {
@@ -1135,15 +1500,19 @@ auto operator*(const ScalarAffineFunction &a, const ScalarAffineFunction &b)
 auto operator*(const ScalarQuadraticFunction &a, CoeffT b) -> ScalarQuadraticFunction
 {
 	ScalarQuadraticFunction aa = a;
-	for (auto &c : aa.coefficients)
+	return std::move(aa) * b;
+}
+auto operator*(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction
+{
+	for (auto &c : a.coefficients)
 	{
 		c *= b;
 	}
-	if (aa.affine_part)
+	if (a.affine_part)
 	{
-		aa.affine_part = operator*(aa.affine_part.value(), b);
+		a.affine_part = std::move(a.affine_part.value()) * b;
 	}
-	return aa;
+	return std::move(a);
 }
 auto operator*(CoeffT a, const ScalarQuadraticFunction &b) -> ScalarQuadraticFunction
 {
@@ -1159,11 +1528,19 @@ auto operator/(const ScalarAffineFunction &a, CoeffT b) -> ScalarAffineFunction
 {
 	return a * (1.0 / b);
 }
+auto operator/(ScalarAffineFunction &&a, CoeffT b) -> ScalarAffineFunction
+{
+	return std::move(a) * (1.0 / b);
+}
 
 auto operator/(const ScalarQuadraticFunction &a, CoeffT b) -> ScalarQuadraticFunction
 {
 	return a * (1.0 / b);
 }
+auto operator/(ScalarQuadraticFunction &&a, CoeffT b) -> ScalarQuadraticFunction
+{
+	return std::move(a) * (1.0 / b);
+}
 
 auto operator-(const VariableIndex &a) -> ScalarAffineFunction
 {
@@ -1174,11 +1551,19 @@ auto operator-(const ScalarAffineFunction &a) -> ScalarAffineFunction
 {
 	return a * -1.0;
 }
+auto operator-(ScalarAffineFunction &&a) -> ScalarAffineFunction
+{
+	return std::move(a) * -1.0;
+}
 
 auto operator-(const ScalarQuadraticFunction &a) -> ScalarQuadraticFunction
 {
 	return a * -1.0;
 }
+auto operator-(ScalarQuadraticFunction &&a) -> ScalarQuadraticFunction
+{
+	return std::move(a) * -1.0;
+}
 
 auto operator-(const ExprBuilder &a) -> ExprBuilder
 {
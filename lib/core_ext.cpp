@@ -2,10 +2,14 @@
 #include <nanobind/operators.h>
 #include <nanobind/stl/vector.h>
 #include <nanobind/stl/optional.h>
+#include <nanobind/stl/string.h>
 #include <nanobind/ndarray.h>
 
 #include "pyoptinterface/core.hpp"
 #include "pyoptinterface/container.hpp"
+#include "pyoptinterface/cache_model.hpp"
+#include "pyoptinterface/model_reader.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
 
 #include <span>
 #include <algorithm>
@@ -47,6 +51,12 @@ NB_MODULE(core_ext, m)
 	    .value("Minimize", ObjectiveSense::Minimize)
 	    .value("Maximize", ObjectiveSense::Maximize);
 
+	// AffineAccumulator
+	nb::enum_<AffineAccumulator>(m, "AffineAccumulator")
+	    .value("Auto", AffineAccumulator::Auto)
+	    .value("Hash", AffineAccumulator::Hash)
+	    .value("Dense", AffineAccumulator::Dense);
+
 	nb::class_<VariableIndex>(m, "VariableIndex")
 	    .def(nb::init<IndexT>())
 	    .def_ro("index", &VariableIndex::index)
@@ -209,6 +219,8 @@ NB_MODULE(core_ext, m)
 	    .def("set_quadratic_coef", &ExprBuilder::set_quadratic_coef)
 	    .def("add_affine_term", &ExprBuilder::add_affine_term)
 	    .def("set_affine_coef", &ExprBuilder::set_affine_coef)
+	    .def("set_affine_accumulator", &ExprBuilder::set_affine_accumulator)
+	    .def("is_dense_affine", &ExprBuilder::is_dense_affine)
 	    .def(-nb::self)
 	    .def(nb::self += CoeffT(), nb::rv_policy::none)
 	    .def(nb::self += VariableIndex(), nb::rv_policy::none)
@@ -255,6 +267,72 @@ NB_MODULE(core_ext, m)
 	    .def(ScalarQuadraticFunction() * nb::self)
 	    .def(nb::self / CoeffT());
 
+	constexpr double inf = std::numeric_limits<double>::infinity();
+	nb::class_<CacheModel>(m, "CacheModel")
+	    .def(nb::init<>())
+	    .def("add_variable", &CacheModel::add_variable,
+	         nb::arg("domain") = VariableDomain::Continuous, nb::arg("lb") = -inf,
+	         nb::arg("ub") = inf)
+	    .def(
+	        "_add_variables",
+	        [](CacheModel &model, int N, VariableDomain domain,
+	           const std::optional<DoubleArrayT> &lb, const std::optional<DoubleArrayT> &ub) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer;
+		        return model.add_variables(N, domain, array_or_fill(lb, N, -inf, lb_buffer, "lb"),
+		                                   array_or_fill(ub, N, inf, ub_buffer, "ub"));
+	        },
+	        nb::arg("N"), nb::arg("domain") = VariableDomain::Continuous,
+	        nb::arg("lb") = nb::none(), nb::arg("ub") = nb::none())
+	    .def("add_linear_constraint",
+	         nb::overload_cast<const ScalarAffineFunction &, ConstraintSense, CoeffT>(
+	             &CacheModel::add_linear_constraint),
+	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"))
+	    .def("add_linear_constraint",
+	         nb::overload_cast<const ExprBuilder &, ConstraintSense, CoeffT>(
+	             &CacheModel::add_linear_constraint),
+	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"))
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<CacheModel>,
+	         nb::arg("indptr"), nb::arg("variables"), nb::arg("coefficients"), nb::arg("sense"),
+	         nb::arg("rhs"))
+	    .def("add_quadratic_constraint",
+	         nb::overload_cast<const ScalarQuadraticFunction &, ConstraintSense, CoeffT>(
+	             &CacheModel::add_quadratic_constraint),
+	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"))
+	    .def("add_quadratic_constraint",
+	         nb::overload_cast<const ExprBuilder &, ConstraintSense, CoeffT>(
+	             &CacheModel::add_quadratic_constraint),
+	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"))
+	    .def("set_objective",
+	         nb::overload_cast<const ScalarAffineFunction &, ObjectiveSense>(
+	             &CacheModel::set_objective),
+	         nb::arg("expr"), nb::arg("sense") = ObjectiveSense::Minimize)
+	    .def("set_objective",
+	         nb::overload_cast<const ScalarQuadraticFunction &, ObjectiveSense>(
+	             &CacheModel::set_objective),
+	         nb::arg("expr"), nb::arg("sense") = ObjectiveSense::Minimize)
+	    .def("set_objective",
+	         nb::overload_cast<const ExprBuilder &, ObjectiveSense>(&CacheModel::set_objective),
+	         nb::arg("expr"), nb::arg("sense") = ObjectiveSense::Minimize)
+	    .def("get_num_variables", &CacheModel::get_num_variables)
+	    .def("get_num_linear_constraints", &CacheModel::get_num_linear_constraints)
+	    .def("get_num_quadratic_constraints", &CacheModel::get_num_quadratic_constraints)
+	    .def("write", &CacheModel::write, nb::arg("filename"),
+	         nb::call_guard<nb::gil_scoped_release>())
+	    .def(
+	        "_read_mps",
+	        [](CacheModel &model, const std::string &filename, int n_threads) {
+		        ModelFileNames names;
+		        {
+			        nb::gil_scoped_release release;
+			        names = read_mps(model, filename, n_threads);
+		        }
+		        return std::make_tuple(std::move(names.variables),
+		                               std::move(names.linear_constraints),
+		                               std::move(names.quadratic_constraints));
+	        },
+	        nb::arg("filename"), nb::arg("n_threads") = 0);
+
 	// We need to test the functionality of MonotoneIndexer
 	using IntMonotoneIndexer = MonotoneIndexer<int>;
 	nb::class_<IntMonotoneIndexer>(m, "IntMonotoneIndexer")
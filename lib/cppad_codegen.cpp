@@ -0,0 +1,892 @@
+#include "pyoptinterface/cppad_codegen.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+
+#include "fmt/core.h"
+#include "fmt/ranges.h"
+
+using graph_op_enum = CppAD::graph::graph_op_enum;
+
+size_t graph_op_n_arg(graph_op_enum op)
+{
+	switch (op)
+	{
+	// unary operators
+	case graph_op_enum::abs_graph_op:
+	case graph_op_enum::acos_graph_op:
+	case graph_op_enum::acosh_graph_op:
+	case graph_op_enum::asin_graph_op:
+	case graph_op_enum::asinh_graph_op:
+	case graph_op_enum::atan_graph_op:
+	case graph_op_enum::atanh_graph_op:
+	case graph_op_enum::cos_graph_op:
+	case graph_op_enum::cosh_graph_op:
+	case graph_op_enum::erf_graph_op:
+	case graph_op_enum::erfc_graph_op:
+	case graph_op_enum::exp_graph_op:
+	case graph_op_enum::expm1_graph_op:
+	case graph_op_enum::log1p_graph_op:
+	case graph_op_enum::log_graph_op:
+	case graph_op_enum::neg_graph_op:
+	case graph_op_enum::sign_graph_op:
+	case graph_op_enum::sin_graph_op:
+	case graph_op_enum::sinh_graph_op:
+	case graph_op_enum::sqrt_graph_op:
+	case graph_op_enum::tan_graph_op:
+	case graph_op_enum::tanh_graph_op:
+		return 1;
+
+	// binary operators
+	case graph_op_enum::add_graph_op:
+	case graph_op_enum::azmul_graph_op:
+	case graph_op_enum::div_graph_op:
+	case graph_op_enum::mul_graph_op:
+	case graph_op_enum::pow_graph_op:
+	case graph_op_enum::sub_graph_op:
+		return 2;
+
+	// conditional operators
+	case graph_op_enum::cexp_eq_graph_op:
+	case graph_op_enum::cexp_le_graph_op:
+	case graph_op_enum::cexp_lt_graph_op:
+		return 4;
+
+	default: {
+		std::string op_name = CppAD::local::graph::op_enum2name[op];
+		auto message = "Unknown graph_op: " + op_name;
+		throw std::runtime_error(message);
+	}
+	}
+}
+
+namespace
+{
+// The nodes of cpp_graph are numbered as:
+// 0 -> dummy
+// [1, 1 + np) -> p
+// [1 + np, 1 + np + nw) -> w, only for the Hessian of Lagrangian
+// [1 + np + nw, 1 + n_dynamic_ind + n_variable_ind) -> x
+// [1 + n_dynamic_ind + n_variable_ind, ... + n_constant) -> c
+// the rest -> v, the results of operators
+enum class NodeKind
+{
+	P,
+	W,
+	X,
+	C,
+	V
+};
+
+struct GraphNodeLayout
+{
+	size_t np, nw, nx, nc, ny, n_node;
+
+	GraphNodeLayout(const CppAD::cpp_graph &graph, const GraphCodegenOptions &options)
+	{
+		np = options.np;
+		nw = options.hessian_lagrange ? options.nw : 0;
+		nx = graph.n_dynamic_ind_get() + graph.n_variable_ind_get() - np - nw;
+		nc = graph.constant_vec_size();
+		ny = graph.dependent_vec_size();
+		// every operator has exactly one result
+		n_node = graph.operator_vec_size();
+	}
+
+	// the kind of node and its index in the corresponding array
+	std::pair<NodeKind, size_t> locate(size_t node) const
+	{
+		if (node < 1)
+		{
+			throw std::runtime_error(fmt::format("Invalid node: {}", node));
+		}
+		node -= 1;
+		if (node < np)
+			return {NodeKind::P, node};
+		node -= np;
+		if (node < nw)
+			return {NodeKind::W, node};
+		node -= nw;
+		if (node < nx)
+			return {NodeKind::X, node};
+		node -= nx;
+		if (node < nc)
+			return {NodeKind::C, node};
+		node -= nc;
+		if (node < n_node)
+			return {NodeKind::V, node};
+		throw std::runtime_error(fmt::format("Invalid node: {}", node + 1 + np + nw + nx + nc));
+	}
+};
+
+// visit operators of graph in order as f(op, args, n_arg, result_index)
+template <typename F>
+void for_each_graph_op(const CppAD::cpp_graph &graph, F &&f)
+{
+	size_t n_op = graph.operator_vec_size();
+	size_t arg_index = 0;
+	size_t args[4];
+	for (size_t i = 0; i < n_op; i++)
+	{
+		auto op = graph.operator_vec_get(i);
+		auto n_arg = graph_op_n_arg(op);
+		for (size_t j = 0; j < n_arg; j++)
+		{
+			args[j] = graph.operator_arg_get(arg_index + j);
+		}
+		f(op, args, n_arg, i);
+		arg_index += n_arg;
+	}
+}
+
+const char *c_math_function_name(graph_op_enum op)
+{
+	switch (op)
+	{
+	case graph_op_enum::abs_graph_op:
+		return "fabs";
+	case graph_op_enum::acos_graph_op:
+		return "acos";
+	case graph_op_enum::asin_graph_op:
+		return "asin";
+	case graph_op_enum::atan_graph_op:
+		return "atan";
+	case graph_op_enum::cos_graph_op:
+		return "cos";
+	case graph_op_enum::exp_graph_op:
+		return "exp";
+	case graph_op_enum::log_graph_op:
+		return "log";
+	case graph_op_enum::pow_graph_op:
+		return "pow";
+	case graph_op_enum::sign_graph_op:
+		return "sign";
+	case graph_op_enum::sin_graph_op:
+		return "sin";
+	case graph_op_enum::sqrt_graph_op:
+		return "sqrt";
+	case graph_op_enum::tan_graph_op:
+		return "tan";
+	default:
+		return nullptr;
+	}
+}
+
+const char *c_infix_operator(graph_op_enum op)
+{
+	switch (op)
+	{
+	case graph_op_enum::add_graph_op:
+		return "+";
+	case graph_op_enum::sub_graph_op:
+	case graph_op_enum::neg_graph_op:
+		return "-";
+	case graph_op_enum::mul_graph_op:
+	case graph_op_enum::azmul_graph_op:
+		return "*";
+	case graph_op_enum::div_graph_op:
+		return "/";
+	default:
+		return nullptr;
+	}
+}
+
+// the comparison of conditional expressions, LLVM IR uses the ordered predicates
+const char *compare_operator(graph_op_enum op, bool llvm)
+{
+	switch (op)
+	{
+	case graph_op_enum::cexp_eq_graph_op:
+		return llvm ? "oeq" : "==";
+	case graph_op_enum::cexp_le_graph_op:
+		return llvm ? "ole" : "<=";
+	case graph_op_enum::cexp_lt_graph_op:
+		return llvm ? "olt" : "<";
+	default:
+		return nullptr;
+	}
+}
+
+std::runtime_error unknown_op_error(graph_op_enum op, const std::string &name)
+{
+	std::string op_name = CppAD::local::graph::op_enum2name[op];
+	return std::runtime_error(
+	    fmt::format("Unknown graph_op {} in the generated function {}", op_name, name));
+}
+
+// the math functions called by generated code
+const char *unary_math_functions[] = {"fabs", "acos", "asin", "atan", "cos",
+                                      "exp",  "log",  "sin",  "sqrt", "tan"};
+} // namespace
+
+void generate_csrc_prelude(std::string &code)
+{
+	auto out = std::back_inserter(code);
+	code += R"(// includes
+#include <stddef.h>
+
+// typedefs
+typedef double float_point_t;
+
+// declare mathematical functions
+#define UNARY(f) extern float_point_t f(float_point_t x)
+#define BINARY(f) extern float_point_t f(float_point_t x, float_point_t y)
+
+// unary functions
+)";
+	for (auto f : unary_math_functions)
+	{
+		fmt::format_to(out, "UNARY({});\n", f);
+	}
+	code += R"(
+// binary functions
+BINARY(pow);
+
+// externals
+// azmul
+static float_point_t azmul(float_point_t x, float_point_t y)
+{
+    if( x == 0.0 ) return 0.0;
+    return x * y;
+}
+
+// sign
+static float_point_t sign(float_point_t x)
+{
+    if( x > 0.0 ) return 1.0;
+    if( x == 0.0 ) return 0.0;
+    return -1.0;
+}
+)";
+}
+
+static void generate_csrc_batch_function(std::string &code, const std::string &name,
+                                         const GraphNodeLayout &layout,
+                                         const GraphCodegenOptions &options)
+{
+	auto out = std::back_inserter(code);
+	bool has_parameter = layout.np > 0;
+
+	std::vector<std::string> signature = {"int n", "const float_point_t* x"};
+	std::vector<std::string> call_args = {"x"};
+	if (has_parameter)
+	{
+		signature.push_back("const float_point_t* p");
+		call_args.push_back(fmt::format("p + i * {}", layout.np));
+	}
+	if (options.hessian_lagrange)
+	{
+		signature.push_back("const float_point_t* w");
+		call_args.push_back(options.batch_stride_w ? fmt::format("w + i * {}", layout.nw) : "w");
+	}
+	signature.push_back("float_point_t* y");
+	if (options.batch_stride_y && !options.indirect_y)
+	{
+		call_args.push_back(fmt::format("y + i * {}", layout.ny));
+	}
+	else
+	{
+		call_args.push_back("y");
+	}
+	signature.push_back("const int* xi");
+	call_args.push_back(fmt::format("xi + i * {}", layout.nx));
+	if (options.indirect_y)
+	{
+		signature.push_back("const int* yi");
+		call_args.push_back(fmt::format("yi + i * {}", layout.ny));
+	}
+
+	fmt::format_to(out, R"(
+void {}(
+    {}
+)
+{{
+    for (int i = 0; i < n; i++)
+    {{
+        {}({});
+    }}
+}}
+)",
+	               options.batch_name, fmt::join(signature, ", "), name, fmt::join(call_args, ", "));
+}
+
+void generate_csrc_from_graph(std::string &code, const CppAD::cpp_graph &graph,
+                              const std::string &name, const GraphCodegenOptions &options)
+{
+	auto out = std::back_inserter(code);
+	GraphNodeLayout layout(graph, options);
+	bool has_parameter = layout.np > 0;
+	bool hessian_lagrange = options.hessian_lagrange;
+
+	std::vector<std::string> signature = {"const float_point_t* x"};
+	if (has_parameter)
+		signature.push_back("const float_point_t* p");
+	if (hessian_lagrange)
+		signature.push_back("const float_point_t* w");
+	signature.push_back("float_point_t* y");
+	if (options.indirect_x)
+		signature.push_back("const int* xi");
+	if (has_parameter && options.indirect_p)
+		signature.push_back("const int* pi");
+	if (hessian_lagrange && options.indirect_w)
+		signature.push_back("const int* wi");
+	if (options.indirect_y)
+		signature.push_back("const int* yi");
+
+	fmt::format_to(out, R"(
+void {}(
+    {}
+)
+{{
+    // begin function body
+
+    // size checks
+    // const size_t nx = {};
+    // const size_t np = {};
+    // const size_t ny = {};
+)",
+	               name, fmt::join(signature, ", "), layout.nx, layout.np, layout.ny);
+	if (hessian_lagrange)
+	{
+		fmt::format_to(out, "    // const size_t nw = {};\n", layout.nw);
+	}
+
+	fmt::format_to(out, R"(
+    // declare variables
+    float_point_t v[{}];
+    )",
+	               layout.n_node);
+
+	size_t nc = layout.nc;
+	if (nc > 0)
+	{
+		fmt::format_to(out, R"(
+    // constants
+    // set c[i] for i = 0, ..., nc-1
+    // nc = {}
+    static const float_point_t c[{}] = {{
+        )",
+		               nc, nc);
+		for (size_t i = 0; i < nc; i++)
+		{
+			// the shortest representation that round-trips
+			fmt::format_to(out, "{}{}", i == 0 ? "" : ", ", graph.constant_vec_get(i));
+		}
+		code += "\n    };\n";
+	}
+
+	fmt::format_to(out, R"(
+    // result nodes
+    // set v[i] for i = 0, ..., n_result_node-1
+    // n_result_node = {}
+)",
+	               layout.n_node);
+
+	auto node_name = [&](size_t node) {
+		auto [kind, index] = layout.locate(node);
+		switch (kind)
+		{
+		case NodeKind::P:
+			return options.indirect_p ? fmt::format("p[pi[{}]]", index)
+			                          : fmt::format("p[{}]", index);
+		case NodeKind::W:
+			return options.indirect_w ? fmt::format("w[wi[{}]]", index)
+			                          : fmt::format("w[{}]", index);
+		case NodeKind::X:
+			return options.indirect_x ? fmt::format("x[xi[{}]]", index)
+			                          : fmt::format("x[{}]", index);
+		case NodeKind::C:
+			return fmt::format("c[{}]", index);
+		default:
+			return fmt::format("v[{}]", index);
+		}
+	};
+
+	for_each_graph_op(graph, [&](graph_op_enum op, const size_t *args, size_t n_arg,
+	                             size_t result) {
+		auto math_function = c_math_function_name(op);
+		auto infix_operator = c_infix_operator(op);
+		auto cmp = compare_operator(op, false);
+		if (n_arg == 1 && (math_function != nullptr || infix_operator != nullptr))
+		{
+			auto f = math_function != nullptr ? math_function : infix_operator;
+			fmt::format_to(out, "    v[{}] = {}({});\n", result, f, node_name(args[0]));
+		}
+		else if (n_arg == 2 && infix_operator != nullptr)
+		{
+			fmt::format_to(out, "    v[{}] = {} {} {};\n", result, node_name(args[0]),
+			               infix_operator, node_name(args[1]));
+		}
+		else if (n_arg == 2 && math_function != nullptr)
+		{
+			fmt::format_to(out, "    v[{}] = {}({}, {});\n", result, math_function,
+			               node_name(args[0]), node_name(args[1]));
+		}
+		else if (n_arg == 4 && cmp != nullptr)
+		{
+			fmt::format_to(out, "    v[{}] = {} {} {} ? {} : {};\n", result, node_name(args[0]),
+			               cmp, node_name(args[1]), node_name(args[2]), node_name(args[3]));
+		}
+		else
+		{
+			throw unknown_op_error(op, name);
+		}
+	});
+
+	code += R"(
+    // dependent variables
+    // set y[i] for i = 0, ny-1
+)";
+
+	const char *assign = options.add_y ? "+=" : "=";
+	for (size_t i = 0; i < layout.ny; i++)
+	{
+		auto value = node_name(graph.dependent_vec_get(i));
+		if (options.indirect_y)
+		{
+			fmt::format_to(out, "    y[yi[{}]] {} {};\n", i, assign, value);
+		}
+		else
+		{
+			fmt::format_to(out, "    y[{}] {} {};\n", i, assign, value);
+		}
+	}
+
+	code += R"(
+    // end function body
+}
+)";
+
+	if (!options.batch_name.empty())
+	{
+		generate_csrc_batch_function(code, name, layout, options);
+	}
+}
+
+void generate_llvmir_prelude(std::string &code)
+{
+	auto out = std::back_inserter(code);
+	for (auto f : unary_math_functions)
+	{
+		fmt::format_to(out, "declare double @{}(double)\n", f);
+	}
+	code += R"(declare double @pow(double, double)
+
+define internal double @sign(double %x) alwaysinline {
+entry:
+  %positive = fcmp ogt double %x, 0.0
+  %zero = fcmp oeq double %x, 0.0
+  %nonpositive = select i1 %zero, double 0.0, double -1.0
+  %result = select i1 %positive, double 1.0, double %nonpositive
+  ret double %result
+}
+)";
+}
+
+static void generate_llvmir_batch_function(std::string &code, const std::string &name,
+                                           const GraphNodeLayout &layout,
+                                           const GraphCodegenOptions &options,
+                                           bool opaque_pointers)
+{
+	auto out = std::back_inserter(code);
+	std::string double_ptr = opaque_pointers ? "ptr" : "double*";
+	std::string int_ptr = opaque_pointers ? "ptr" : "i32*";
+
+	struct BatchArg
+	{
+		const char *name;
+		bool is_index;
+		size_t stride;
+	};
+	std::vector<BatchArg> batch_args = {{"x", false, 0}};
+	if (layout.np > 0)
+		batch_args.push_back({"p", false, layout.np});
+	if (options.hessian_lagrange)
+		batch_args.push_back({"w", false, options.batch_stride_w ? layout.nw : 0});
+	batch_args.push_back(
+	    {"y", false, (options.batch_stride_y && !options.indirect_y) ? layout.ny : 0});
+	batch_args.push_back({"xi", true, layout.nx});
+	if (options.indirect_y)
+		batch_args.push_back({"yi", true, layout.ny});
+
+	std::vector<std::string> signature = {"i32 %n"};
+	for (auto &arg : batch_args)
+	{
+		signature.push_back(fmt::format("{} noalias %{}", arg.is_index ? int_ptr : double_ptr, arg.name));
+	}
+	fmt::format_to(out, R"(
+define void @{}({}) {{
+entry:
+  br label %loop
+loop:
+  %i = phi i32 [ 0, %entry ], [ %i.next, %body ]
+  %cond = icmp slt i32 %i, %n
+  br i1 %cond, label %body, label %exit
+body:
+)",
+	               options.batch_name, fmt::join(signature, ", "));
+
+	std::vector<std::string> call_args;
+	for (auto &arg : batch_args)
+	{
+		auto ptr_type = arg.is_index ? int_ptr : double_ptr;
+		if (arg.stride == 0)
+		{
+			call_args.push_back(fmt::format("{} %{}", ptr_type, arg.name));
+			continue;
+		}
+		auto elem_type = arg.is_index ? "i32" : "double";
+		fmt::format_to(out, "  %{0}.offset = mul i32 %i, {1}\n", arg.name, arg.stride);
+		fmt::format_to(out, "  %{0}.i = getelementptr {1}, {2} %{0}, i32 %{0}.offset\n", arg.name,
+		               elem_type, ptr_type);
+		call_args.push_back(fmt::format("{} %{}.i", ptr_type, arg.name));
+	}
+	fmt::format_to(out, R"(  call void @{}({})
+  %i.next = add i32 %i, 1
+  br label %loop
+exit:
+  ret void
+}}
+)",
+	               name, fmt::join(call_args, ", "));
+}
+
+void generate_llvmir_from_graph(std::string &code, const CppAD::cpp_graph &graph,
+                                const std::string &name, const GraphCodegenOptions &options,
+                                bool opaque_pointers)
+{
+	auto out = std::back_inserter(code);
+	GraphNodeLayout layout(graph, options);
+	bool has_parameter = layout.np > 0;
+	bool hessian_lagrange = options.hessian_lagrange;
+	std::string double_ptr = opaque_pointers ? "ptr" : "double*";
+	std::string int_ptr = opaque_pointers ? "ptr" : "i32*";
+
+	size_t nc = layout.nc;
+	std::string constants_type = fmt::format("[{} x double]", nc);
+	if (nc > 0)
+	{
+		fmt::format_to(out, "\n@{}_constants = internal constant {} [", name, constants_type);
+		for (size_t i = 0; i < nc; i++)
+		{
+			// hexadecimal form is exact for any double
+			auto bits = std::bit_cast<uint64_t>(graph.constant_vec_get(i));
+			fmt::format_to(out, "{}double 0x{:016X}", i == 0 ? "" : ", ", bits);
+		}
+		code += "]\n";
+	}
+
+	std::vector<std::string> signature = {double_ptr + " noalias %x"};
+	if (has_parameter)
+		signature.push_back(double_ptr + " noalias %p");
+	if (hessian_lagrange)
+		signature.push_back(double_ptr + " noalias %w");
+	signature.push_back(double_ptr + " noalias %y");
+	if (options.indirect_x)
+		signature.push_back(int_ptr + " noalias %xi");
+	if (has_parameter && options.indirect_p)
+		signature.push_back(int_ptr + " noalias %pi");
+	if (hessian_lagrange && options.indirect_w)
+		signature.push_back(int_ptr + " noalias %wi");
+	if (options.indirect_y)
+		signature.push_back(int_ptr + " noalias %yi");
+
+	// the scalar function is inlined into the loop of batched function
+	fmt::format_to(out, "\ndefine void @{}({}){} {{\nentry:\n", name, fmt::join(signature, ", "),
+	               options.batch_name.empty() ? "" : " alwaysinline");
+	if (hessian_lagrange)
+	{
+		fmt::format_to(out, "  ; nx = {}, np = {}, nw = {}, ny = {}\n", layout.nx, layout.np,
+		               layout.nw, layout.ny);
+	}
+	else
+	{
+		fmt::format_to(out, "  ; nx = {}, np = {}, ny = {}\n", layout.nx, layout.np, layout.ny);
+	}
+
+	// the inputs are loaded once on their first use
+	std::vector<bool> p_loaded(layout.np), w_loaded(layout.nw), x_loaded(layout.nx),
+	    c_loaded(nc);
+
+	// load ptr[index] or ptr[index_ptr[index]] as %ptr.index
+	auto load_input = [&](const char *ptr, bool indirect, size_t index) {
+		if (indirect)
+		{
+			fmt::format_to(out, "  %{0}i.{1}.ptr = getelementptr i32, {2} %{0}i, i32 {1}\n", ptr,
+			               index, int_ptr);
+			fmt::format_to(out, "  %{0}i.{1} = load i32, {2} %{0}i.{1}.ptr\n", ptr, index, int_ptr);
+			fmt::format_to(out, "  %{0}.{1}.ptr = getelementptr double, {2} %{0}, i32 %{0}i.{1}\n",
+			               ptr, index, double_ptr);
+		}
+		else
+		{
+			fmt::format_to(out, "  %{0}.{1}.ptr = getelementptr double, {2} %{0}, i32 {1}\n", ptr,
+			               index, double_ptr);
+		}
+		fmt::format_to(out, "  %{0}.{1} = load double, {2} %{0}.{1}.ptr\n", ptr, index, double_ptr);
+	};
+
+	auto node_value = [&](size_t node) {
+		auto [kind, index] = layout.locate(node);
+		switch (kind)
+		{
+		case NodeKind::P:
+			if (!p_loaded[index])
+			{
+				load_input("p", options.indirect_p, index);
+				p_loaded[index] = true;
+			}
+			return fmt::format("%p.{}", index);
+		case NodeKind::W:
+			if (!w_loaded[index])
+			{
+				load_input("w", options.indirect_w, index);
+				w_loaded[index] = true;
+			}
+			return fmt::format("%w.{}", index);
+		case NodeKind::X:
+			if (!x_loaded[index])
+			{
+				load_input("x", options.indirect_x, index);
+				x_loaded[index] = true;
+			}
+			return fmt::format("%x.{}", index);
+		case NodeKind::C:
+			if (!c_loaded[index])
+			{
+				fmt::format_to(out,
+				               "  %c.{0}.ptr = getelementptr {1}, {2} @{3}_constants, i32 0, "
+				               "i32 {0}\n",
+				               index, constants_type, opaque_pointers ? "ptr" : constants_type + "*",
+				               name);
+				fmt::format_to(out, "  %c.{0} = load double, {1} %c.{0}.ptr\n", index, double_ptr);
+				c_loaded[index] = true;
+			}
+			return fmt::format("%c.{}", index);
+		default:
+			return fmt::format("%v.{}", index);
+		}
+	};
+
+	for_each_graph_op(graph, [&](graph_op_enum op, const size_t *args, size_t n_arg,
+	                             size_t result) {
+		// the operands are loaded before the result is written
+		std::string operands[4];
+		for (size_t j = 0; j < n_arg; j++)
+		{
+			operands[j] = node_value(args[j]);
+		}
+		switch (op)
+		{
+		case graph_op_enum::add_graph_op:
+		case graph_op_enum::sub_graph_op:
+		case graph_op_enum::mul_graph_op:
+		case graph_op_enum::azmul_graph_op:
+		case graph_op_enum::div_graph_op: {
+			const char *instruction = op == graph_op_enum::add_graph_op   ? "fadd"
+			                          : op == graph_op_enum::sub_graph_op ? "fsub"
+			                          : op == graph_op_enum::div_graph_op ? "fdiv"
+			                                                              : "fmul";
+			fmt::format_to(out, "  %v.{} = {} fast double {}, {}\n", result, instruction,
+			               operands[0], operands[1]);
+			break;
+		}
+		case graph_op_enum::neg_graph_op:
+			fmt::format_to(out, "  %v.{} = fneg fast double {}\n", result, operands[0]);
+			break;
+		case graph_op_enum::pow_graph_op:
+			fmt::format_to(out, "  %v.{} = call double @pow(double {}, double {})\n", result,
+			               operands[0], operands[1]);
+			break;
+		case graph_op_enum::cexp_eq_graph_op:
+		case graph_op_enum::cexp_le_graph_op:
+		case graph_op_enum::cexp_lt_graph_op:
+			fmt::format_to(out, "  %v.{}.cond = fcmp {} double {}, {}\n", result,
+			               compare_operator(op, true), operands[0], operands[1]);
+			fmt::format_to(out, "  %v.{0} = select i1 %v.{0}.cond, double {1}, double {2}\n",
+			               result, operands[2], operands[3]);
+			break;
+		default: {
+			// sign and the unary math functions
+			auto math_function = c_math_function_name(op);
+			if (math_function == nullptr || n_arg != 1)
+			{
+				throw unknown_op_error(op, name);
+			}
+			fmt::format_to(out, "  %v.{} = call double @{}(double {})\n", result, math_function,
+			               operands[0]);
+			break;
+		}
+		}
+	});
+
+	for (size_t i = 0; i < layout.ny; i++)
+	{
+		auto value = node_value(graph.dependent_vec_get(i));
+		if (options.indirect_y)
+		{
+			fmt::format_to(out, "  %yi.{0}.ptr = getelementptr i32, {1} %yi, i32 {0}\n", i, int_ptr);
+			fmt::format_to(out, "  %yi.{0} = load i32, {1} %yi.{0}.ptr\n", i, int_ptr);
+			fmt::format_to(out, "  %y.{0}.ptr = getelementptr double, {1} %y, i32 %yi.{0}\n", i,
+			               double_ptr);
+		}
+		else
+		{
+			fmt::format_to(out, "  %y.{0}.ptr = getelementptr double, {1} %y, i32 {0}\n", i,
+			               double_ptr);
+		}
+		if (options.add_y)
+		{
+			fmt::format_to(out, "  %y.{0}.old = load double, {1} %y.{0}.ptr\n", i, double_ptr);
+			fmt::format_to(out, "  %y.{0}.new = fadd double %y.{0}.old, {1}\n", i, value);
+			value = fmt::format("%y.{}.new", i);
+		}
+		fmt::format_to(out, "  store double {}, {} %y.{}.ptr\n", value, double_ptr, i);
+	}
+	code += "  ret void\n}\n";
+
+	if (!options.batch_name.empty())
+	{
+		generate_llvmir_batch_function(code, name, layout, options, opaque_pointers);
+	}
+}
+
+void NLCodegen::add_constraint_group(const CppADAutodiffGraph &graph,
+                                     const AutodiffSymbolicStructure &structure,
+                                     const std::string &name)
+{
+	m_groups.push_back({&graph, &structure, name, false});
+}
+
+void NLCodegen::add_objective_group(const CppADAutodiffGraph &graph,
+                                    const AutodiffSymbolicStructure &structure,
+                                    const std::string &name)
+{
+	m_groups.push_back({&graph, &structure, name, true});
+}
+
+size_t NLCodegen::n_groups() const
+{
+	return m_groups.size();
+}
+
+void NLCodegen::generate_group(std::string &code, std::vector<std::string> &export_functions,
+                               const Group &group, CodegenTarget target,
+                               bool opaque_pointers) const
+{
+	auto &structure = *group.structure;
+	auto generate = [&](const CppAD::cpp_graph &graph, const std::string &name,
+	                    GraphCodegenOptions &options) {
+		options.np = structure.np;
+		options.indirect_x = true;
+		options.batch_name = name + "_batch";
+		if (target == CodegenTarget::C)
+		{
+			generate_csrc_from_graph(code, graph, name, options);
+		}
+		else
+		{
+			generate_llvmir_from_graph(code, graph, name, options, opaque_pointers);
+		}
+		export_functions.push_back(name);
+		export_functions.push_back(options.batch_name);
+	};
+
+	// the objective functions are accumulated into the same output
+	GraphCodegenOptions f_options;
+	if (group.objective)
+	{
+		f_options.add_y = true;
+		f_options.batch_stride_y = false;
+	}
+	generate(group.graph->f_graph, group.name, f_options);
+
+	if (structure.has_jacobian)
+	{
+		GraphCodegenOptions jacobian_options;
+		if (group.objective)
+		{
+			jacobian_options.indirect_y = true;
+			jacobian_options.add_y = true;
+		}
+		generate(group.graph->jacobian_graph, group.name + "_jacobian", jacobian_options);
+	}
+
+	if (structure.has_hessian)
+	{
+		GraphCodegenOptions hessian_options;
+		hessian_options.hessian_lagrange = true;
+		hessian_options.nw = structure.ny;
+		hessian_options.indirect_y = true;
+		hessian_options.add_y = true;
+		// all instances of an objective share the same multiplier
+		hessian_options.batch_stride_w = !group.objective;
+		generate(group.graph->hessian_graph, group.name + "_hessian", hessian_options);
+	}
+}
+
+std::vector<CodegenModule> NLCodegen::generate(CodegenTarget target, size_t n_modules,
+                                               size_t n_threads, bool opaque_pointers) const
+{
+	size_t n_groups = m_groups.size();
+	n_modules = std::max<size_t>(std::min(n_modules, n_groups), 1);
+
+	// assign the largest groups first, each to the module with the fewest operators so far
+	auto group_size = [&](size_t i) {
+		auto graph = m_groups[i].graph;
+		return graph->f_graph.operator_vec_size() + graph->jacobian_graph.operator_vec_size() +
+		       graph->hessian_graph.operator_vec_size();
+	};
+	std::vector<size_t> order(n_groups);
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(),
+	                 [&](size_t a, size_t b) { return group_size(a) > group_size(b); });
+	std::vector<std::vector<size_t>> module_groups(n_modules);
+	std::vector<size_t> module_sizes(n_modules, 0);
+	for (auto i : order)
+	{
+		size_t m = std::min_element(module_sizes.begin(), module_sizes.end()) - module_sizes.begin();
+		module_groups[m].push_back(i);
+		module_sizes[m] += group_size(i);
+	}
+
+	std::vector<CodegenModule> modules(n_modules);
+	auto generate_module = [&](size_t m) {
+		auto &module = modules[m];
+		if (target == CodegenTarget::C)
+		{
+			generate_csrc_prelude(module.code);
+		}
+		else
+		{
+			generate_llvmir_prelude(module.code);
+		}
+		// keep the order in which the groups are added
+		auto &groups = module_groups[m];
+		std::sort(groups.begin(), groups.end());
+		for (auto i : groups)
+		{
+			generate_group(module.code, module.export_functions, m_groups[i], target,
+			               opaque_pointers);
+		}
+	};
+
+	if (n_threads <= 1 || n_modules == 1)
+	{
+		for (size_t m = 0; m < n_modules; m++)
+		{
+			generate_module(m);
+		}
+	}
+	else
+	{
+		ThreadPool pool(std::min(n_threads, n_modules));
+		pool.parallel_for(n_modules, generate_module);
+	}
+
+	return modules;
+}
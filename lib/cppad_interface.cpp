@@ -4,8 +4,15 @@
 
 static const std::string opt_options = "no_compare_op no_conditional_skip no_cumulative_sum_op";
 
+std::recursive_mutex &cppad_mutex()
+{
+	static std::recursive_mutex mutex;
+	return mutex;
+}
+
 ADFunDouble dense_jacobian(const ADFunDouble &f)
 {
+	std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 	using CppAD::AD;
 	using CppAD::ADFun;
 	using CppAD::Independent;
@@ -32,7 +39,8 @@ ADFunDouble dense_jacobian(const ADFunDouble &f)
 }
 
 JacobianHessianSparsityPattern jacobian_hessian_sparsity(ADFunDouble &f,
-                                                         HessianSparsityType hessian_sparsity)
+                                                         HessianSparsityType hessian_sparsity,
+                                                         bool hessian)
 {
 	using s_vector = std::vector<size_t>;
 	using CppAD::sparse_rc;
@@ -66,6 +74,13 @@ JacobianHessianSparsityPattern jacobian_hessian_sparsity(ADFunDouble &f,
 		jachess.jacobian = pattern_jac;
 	}
 
+	if (!hessian)
+	{
+		jachess.hessian.resize(nx, nx, 0);
+		jachess.reduced_hessian.resize(nx, nx, 0);
+		return jachess;
+	}
+
 	std::vector<bool> select_range(ny, true);
 	const bool transpose = false;
 	const bool internal_bool = true;
@@ -109,6 +124,7 @@ ADFunDouble sparse_jacobian(const ADFunDouble &f, const sparsity_pattern_t &patt
                             const std::vector<double> &x_values,
                             const std::vector<double> &p_values)
 {
+	std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 	using CppAD::AD;
 	using CppAD::ADFun;
 	using CppAD::Independent;
@@ -153,6 +169,7 @@ ADFunDouble sparse_hessian(const ADFunDouble &f, const sparsity_pattern_t &patte
                            const sparsity_pattern_t &pattern_subset,
                            const std::vector<double> &x_values, const std::vector<double> &p_values)
 {
+	std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 	using CppAD::AD;
 	using CppAD::ADFun;
 	using CppAD::Independent;
@@ -366,7 +383,8 @@ CppAD::AD<double> cppad_trace_expression(
 		break;
 	}
 	case ArrayType::Parameter: {
-		throw std::runtime_error("Parameter is not supported in cppad_trace_expression");
+		// parameters are dynamic parameters after all constants
+		result = p[graph.n_constants() + id];
 		break;
 	}
 	case ArrayType::Unary: {
@@ -427,22 +445,35 @@ CppAD::AD<double> cppad_trace_expression(
 	return result;
 }
 
+// the values of model parameters are unknown when tracing, so they are recorded with 1.0
+static void trace_parameter_values(const ExpressionGraph &graph,
+                                   std::vector<CppAD::AD<double>> &p)
+{
+	auto N_constants = graph.n_constants();
+	for (size_t i = 0; i < N_constants; i++)
+	{
+		p[i] = graph.m_constants[i];
+	}
+	for (size_t i = N_constants; i < p.size(); i++)
+	{
+		p[i] = 1.0;
+	}
+}
+
 ADFunDouble cppad_trace_graph_constraints(const ExpressionGraph &graph,
                                           const std::vector<size_t> &selected)
 {
+	std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 	ankerl::unordered_dense::map<ExpressionHandle, CppAD::AD<double>> seen_expressions;
 
 	auto N_inputs = graph.n_variables();
 	std::vector<CppAD::AD<double>> x(N_inputs);
 
-	auto N_parameters = graph.n_constants();
+	auto N_parameters = graph.n_constants() + graph.n_parameters();
 	std::vector<CppAD::AD<double>> p(N_parameters);
 	// Must assign value to parameter, otherwise p will be zero
 	// and CppAD::pow(x, p) will be 0
-	for (size_t i = 0; i < N_parameters; i++)
-	{
-		p[i] = graph.m_constants[i];
-	}
+	trace_parameter_values(graph, p);
 
 	if (N_parameters > 0)
 	{
@@ -489,17 +520,15 @@ ADFunDouble cppad_trace_graph_constraints(const ExpressionGraph &graph,
 ADFunDouble cppad_trace_graph_objective(const ExpressionGraph &graph,
                                         const std::vector<size_t> &selected, bool aggregate)
 {
+	std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 	ankerl::unordered_dense::map<ExpressionHandle, CppAD::AD<double>> seen_expressions;
 
 	auto N_inputs = graph.n_variables();
 	std::vector<CppAD::AD<double>> x(N_inputs);
 
-	auto N_parameters = graph.n_constants();
+	auto N_parameters = graph.n_constants() + graph.n_parameters();
 	std::vector<CppAD::AD<double>> p(N_parameters);
-	for (size_t i = 0; i < N_parameters; i++)
-	{
-		p[i] = graph.m_constants[i];
-	}
+	trace_parameter_values(graph, p);
 
 	if (N_parameters > 0)
 	{
@@ -556,8 +585,10 @@ ADFunDouble cppad_trace_graph_objective(const ExpressionGraph &graph,
 }
 
 void cppad_autodiff(ADFunDouble &f, AutodiffSymbolicStructure &structure, CppADAutodiffGraph &graph,
-                    const std::vector<double> &x_values, const std::vector<double> &p_values)
+                    const std::vector<double> &x_values, const std::vector<double> &p_values,
+                    bool hessian)
 {
+	std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
 	auto nx = f.Domain();
 	auto np = f.size_dyn_ind();
 	assert(x_values.size() == nx);
@@ -572,7 +603,7 @@ void cppad_autodiff(ADFunDouble &f, AutodiffSymbolicStructure &structure, CppADA
 
 	f.to_graph(graph.f_graph);
 
-	auto sparsity = jacobian_hessian_sparsity(f, HessianSparsityType::Upper);
+	auto sparsity = jacobian_hessian_sparsity(f, HessianSparsityType::Upper, hessian);
 
 	{
 		auto &pattern = sparsity.jacobian;
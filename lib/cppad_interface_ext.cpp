@@ -7,6 +7,7 @@
 namespace nb = nanobind;
 
 #include "pyoptinterface/cppad_interface.hpp"
+#include "pyoptinterface/cppad_codegen.hpp"
 
 using graph_op_enum = CppAD::graph::graph_op_enum;
 
@@ -23,64 +24,7 @@ graph_op_enum cursor_op(CppAD::cpp_graph &graph, cpp_graph_cursor &cursor)
 
 size_t cursor_n_arg(CppAD::cpp_graph &graph, cpp_graph_cursor &cursor)
 {
-	auto op = cursor_op(graph, cursor);
-
-	size_t n_arg = 0;
-
-	switch (op)
-	{
-	// unary operators
-	case graph_op_enum::abs_graph_op:
-	case graph_op_enum::acos_graph_op:
-	case graph_op_enum::acosh_graph_op:
-	case graph_op_enum::asin_graph_op:
-	case graph_op_enum::asinh_graph_op:
-	case graph_op_enum::atan_graph_op:
-	case graph_op_enum::atanh_graph_op:
-	case graph_op_enum::cos_graph_op:
-	case graph_op_enum::cosh_graph_op:
-	case graph_op_enum::erf_graph_op:
-	case graph_op_enum::erfc_graph_op:
-	case graph_op_enum::exp_graph_op:
-	case graph_op_enum::expm1_graph_op:
-	case graph_op_enum::log1p_graph_op:
-	case graph_op_enum::log_graph_op:
-	case graph_op_enum::neg_graph_op:
-	case graph_op_enum::sign_graph_op:
-	case graph_op_enum::sin_graph_op:
-	case graph_op_enum::sinh_graph_op:
-	case graph_op_enum::sqrt_graph_op:
-	case graph_op_enum::tan_graph_op:
-	case graph_op_enum::tanh_graph_op:
-		n_arg = 1;
-		break;
-
-	// binary operators
-	case graph_op_enum::add_graph_op:
-	case graph_op_enum::azmul_graph_op:
-	case graph_op_enum::div_graph_op:
-	case graph_op_enum::mul_graph_op:
-	case graph_op_enum::pow_graph_op:
-	case graph_op_enum::sub_graph_op:
-		n_arg = 2;
-		break;
-
-	// conditional operators
-	case graph_op_enum::cexp_eq_graph_op:
-	case graph_op_enum::cexp_le_graph_op:
-	case graph_op_enum::cexp_lt_graph_op:
-		n_arg = 4;
-		break;
-
-	default: {
-		std::string op_name = CppAD::local::graph::op_enum2name[op];
-		auto message = "Unknown graph_op: " + op_name;
-		throw std::runtime_error(message);
-	}
-	break;
-	}
-
-	return n_arg;
+	return graph_op_n_arg(cursor_op(graph, cursor));
 }
 
 void advance_graph_cursor(CppAD::cpp_graph &graph, cpp_graph_cursor &cursor)
@@ -175,7 +119,10 @@ NB_MODULE(cppad_interface_ext, m)
 	    .def_prop_ro("nx", [](const ADFunDouble &f) { return f.Domain(); })
 	    .def_prop_ro("ny", [](const ADFunDouble &f) { return f.Range(); })
 	    .def_prop_ro("np", [](const ADFunDouble &f) { return f.size_dyn_ind(); })
-	    .def("to_graph", &ADFunDouble::to_graph);
+	    .def("to_graph", [](ADFunDouble &f, CppAD::cpp_graph &graph) {
+		    std::lock_guard<std::recursive_mutex> lock(cppad_mutex());
+		    f.to_graph(graph);
+	    });
 
 	nb::class_<CppADAutodiffGraph>(m, "CppADAutodiffGraph")
 	    .def(nb::init<>())
@@ -187,5 +134,26 @@ NB_MODULE(cppad_interface_ext, m)
 	      nb::arg("selected") = std::vector<size_t>{});
 	m.def("cppad_trace_graph_objective", cppad_trace_graph_objective, nb::arg("graph"),
 	      nb::arg("selected") = std::vector<size_t>{}, nb::arg("aggregate") = true);
-	m.def("cppad_autodiff", &cppad_autodiff);
+	m.def("cppad_autodiff", &cppad_autodiff, nb::arg("f"), nb::arg("structure"), nb::arg("graph"),
+	      nb::arg("x_values"), nb::arg("p_values"), nb::arg("hessian") = true);
+
+	nb::enum_<CodegenTarget>(m, "CodegenTarget")
+	    .value("C", CodegenTarget::C)
+	    .value("LLVM", CodegenTarget::LLVM);
+
+	nb::class_<CodegenModule>(m, "CodegenModule")
+	    .def_ro("code", &CodegenModule::code)
+	    .def_ro("export_functions", &CodegenModule::export_functions);
+
+	// the groups keep their graphs and structures alive until the code is generated
+	nb::class_<NLCodegen>(m, "NLCodegen")
+	    .def(nb::init<>())
+	    .def("add_constraint_group", &NLCodegen::add_constraint_group, nb::arg("graph"),
+	         nb::arg("structure"), nb::arg("name"), nb::keep_alive<1, 2>(), nb::keep_alive<1, 3>())
+	    .def("add_objective_group", &NLCodegen::add_objective_group, nb::arg("graph"),
+	         nb::arg("structure"), nb::arg("name"), nb::keep_alive<1, 2>(), nb::keep_alive<1, 3>())
+	    .def_prop_ro("n_groups", &NLCodegen::n_groups)
+	    .def("generate", &NLCodegen::generate, nb::arg("target"), nb::arg("n_modules"),
+	         nb::arg("n_threads"), nb::arg("opaque_pointers") = false,
+	         nb::call_guard<nb::gil_scoped_release>());
 }
@@ -224,6 +224,24 @@ VariableIndex GurobiModel::add_variable(VariableDomain domain, double lb, double
 	return variable;
 }
 
+VariableIndex GurobiModel::add_variables(int N, VariableDomain domain, const double *lb,
+                                         const double *ub)
+{
+	IndexT index = m_variable_index.add_indices(N);
+	VariableIndex variable(index);
+
+	char vtype = gurobi_vtype(domain);
+	std::vector<char> vtypes(N, vtype);
+	int error = gurobi::GRBaddvars(m_model.get(), N, 0, NULL, NULL, NULL, NULL,
+	                               const_cast<double *>(lb), const_cast<double *>(ub),
+	                               vtypes.data(), NULL);
+	check_error(error);
+
+	m_update_flag |= m_variable_creation;
+
+	return variable;
+}
+
 void GurobiModel::delete_variable(const VariableIndex &variable)
 {
 	if (!is_variable_active(variable))
@@ -247,25 +265,22 @@ void GurobiModel::delete_variables(const Vector<VariableIndex> &variables)
 	if (n_variables == 0)
 		return;
 
-	std::vector<int> columns;
-	columns.reserve(n_variables);
+	std::vector<IndexT> indices;
+	indices.reserve(n_variables);
 	for (int i = 0; i < n_variables; i++)
 	{
-		if (!is_variable_active(variables[i]))
+		if (is_variable_active(variables[i]))
 		{
-			continue;
+			indices.push_back(variables[i].index);
 		}
-		auto column = _variable_index(variables[i]);
-		columns.push_back(column);
 	}
+	std::vector<int> columns(indices.size());
+	_variable_indices(indices, columns);
 
 	int error = gurobi::GRBdelvars(m_model.get(), columns.size(), columns.data());
 	check_error(error);
 
-	for (int i = 0; i < n_variables; i++)
-	{
-		m_variable_index.delete_index(variables[i].index);
-	}
+	m_variable_index.delete_indices(indices);
 
 	m_update_flag |= m_variable_deletion;
 }
@@ -280,6 +295,15 @@ double GurobiModel::get_variable_value(const VariableIndex &variable)
 	return get_variable_raw_attribute_double(variable, GRB_DBL_ATTR_X);
 }
 
+void GurobiModel::get_variable_values(int N, const int *variables, double *values)
+{
+	_update_for_information();
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error = gurobi::GRBgetdblattrlist(m_model.get(), GRB_DBL_ATTR_X, N, columns.data(), values);
+	check_error(error);
+}
+
 std::string GurobiModel::pprint_variable(const VariableIndex &variable)
 {
 	return get_variable_raw_attribute_string(variable, GRB_STR_ATTR_VARNAME);
@@ -296,6 +320,21 @@ void GurobiModel::set_variable_bounds(const VariableIndex &variable, double lb,
 	m_update_flag |= m_attribute_update;
 }
 
+void GurobiModel::set_variable_bounds(int N, const int *variables, const double *lb,
+                                      const double *ub)
+{
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error;
+	error = gurobi::GRBsetdblattrlist(m_model.get(), GRB_DBL_ATTR_LB, N, columns.data(),
+	                                  (double *)lb);
+	check_error(error);
+	error = gurobi::GRBsetdblattrlist(m_model.get(), GRB_DBL_ATTR_UB, N, columns.data(),
+	                                  (double *)ub);
+	check_error(error);
+	m_update_flag |= m_attribute_update;
+}
+
 void GurobiModel::set_variable_name(const VariableIndex &variable, const char *name)
 {
 	set_variable_raw_attribute_string(variable, GRB_STR_ATTR_VARNAME, name);
@@ -349,6 +388,28 @@ ConstraintIndex GurobiModel::add_linear_constraint(const ScalarAffineFunction &f
 	return constraint_index;
 }
 
+ConstraintIndex GurobiModel::add_linear_constraints(int M, const int *indptr,
+                                                    const int *variables,
+                                                    const double *coefficients,
+                                                    ConstraintSense sense, const double *rhs)
+{
+	CSRMatrixPtrForm<int, int, double> ptr_form;
+	ptr_form.make(this, M, indptr, variables, coefficients);
+
+	IndexT index = m_linear_constraint_index.add_indices(M);
+	ConstraintIndex constraint_index(ConstraintType::Linear, index);
+
+	std::vector<char> senses(M, gurobi_con_sense(sense));
+	int error = gurobi::GRBaddconstrs(m_model.get(), M, ptr_form.numnz, ptr_form.begin,
+	                                  ptr_form.index, ptr_form.value, senses.data(),
+	                                  const_cast<double *>(rhs), NULL);
+	check_error(error);
+
+	m_update_flag |= m_linear_constraint_creation;
+
+	return constraint_index;
+}
+
 ConstraintIndex GurobiModel::add_quadratic_constraint(const ScalarQuadraticFunction &function,
                                                       ConstraintSense sense, CoeffT rhs,
                                                       const char *name)
@@ -1066,6 +1127,12 @@ int GurobiModel::_variable_index(const VariableIndex &variable)
 	return m_variable_index.get_index(variable.index);
 }
 
+void GurobiModel::_variable_indices(std::span<const IndexT> variables, std::span<int> columns)
+{
+	_update_for_variable_index();
+	m_variable_index.get_indices(variables, columns);
+}
+
 int GurobiModel::_checked_variable_index(const VariableIndex &variable)
 {
 	int column = _variable_index(variable);
@@ -1076,6 +1143,13 @@ int GurobiModel::_checked_variable_index(const VariableIndex &variable)
 	return column;
 }
 
+void GurobiModel::_linear_constraint_indices(std::span<const IndexT> constraints,
+                                             std::span<int> rows)
+{
+	_update_for_constraint_index(ConstraintType::Linear);
+	m_linear_constraint_index.get_indices(constraints, rows);
+}
+
 void GurobiModel::set_constraint_raw_attribute_int(const ConstraintIndex &constraint,
                                                    const char *attr_name, int value)
 {
@@ -1190,6 +1264,16 @@ void GurobiModel::set_normalized_rhs(const ConstraintIndex &constraint, double v
 	set_constraint_raw_attribute_double(constraint, name, value);
 }
 
+void GurobiModel::set_normalized_rhs(int N, const int *constraints, const double *values)
+{
+	std::vector<int> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<int>(rows));
+	int error = gurobi::GRBsetdblattrlist(m_model.get(), GRB_DBL_ATTR_RHS, N, rows.data(),
+	                                      (double *)values);
+	check_error(error);
+	m_update_flag |= m_attribute_update;
+}
+
 double GurobiModel::get_normalized_coefficient(const ConstraintIndex &constraint,
                                                const VariableIndex &variable)
 {
@@ -1220,6 +1304,19 @@ void GurobiModel::set_normalized_coefficient(const ConstraintIndex &constraint,
 	m_update_flag |= m_constraint_coefficient_update;
 }
 
+void GurobiModel::set_normalized_coefficients(int N, const int *constraints, const int *variables,
+                                              const double *values)
+{
+	std::vector<int> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<int>(rows));
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error =
+	    gurobi::GRBchgcoeffs(m_model.get(), N, rows.data(), columns.data(), (double *)values);
+	check_error(error);
+	m_update_flag |= m_constraint_coefficient_update;
+}
+
 double GurobiModel::get_objective_coefficient(const VariableIndex &variable)
 {
 	return get_variable_raw_attribute_double(variable, GRB_DBL_ATTR_OBJ);
@@ -1230,6 +1327,16 @@ void GurobiModel::set_objective_coefficient(const VariableIndex &variable, doubl
 	set_variable_raw_attribute_double(variable, GRB_DBL_ATTR_OBJ, value);
 }
 
+void GurobiModel::set_objective_coefficients(int N, const int *variables, const double *values)
+{
+	std::vector<int> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(columns));
+	int error = gurobi::GRBsetdblattrlist(m_model.get(), GRB_DBL_ATTR_OBJ, N, columns.data(),
+	                                      (double *)values);
+	check_error(error);
+	m_update_flag |= m_attribute_update;
+}
+
 void GurobiModel::_converttofixed()
 {
 	int error = gurobi::GRBconverttofixed(m_model.get());
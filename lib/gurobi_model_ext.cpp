@@ -5,6 +5,8 @@
 #include <nanobind/stl/function.h>
 
 #include "pyoptinterface/gurobi_model.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
+#include "pyoptinterface/cache_model.hpp"
 
 namespace nb = nanobind;
 
@@ -47,12 +49,30 @@ NB_MODULE(gurobi_model_ext, m)
 	    .def("add_variable", &GurobiModel::add_variable,
 	         nb::arg("domain") = VariableDomain::Continuous, nb::arg("lb") = -GRB_INFINITY,
 	         nb::arg("ub") = GRB_INFINITY, nb::arg("name") = "")
+	    .def(
+	        "_add_variables",
+	        [](GurobiModel &model, int N, VariableDomain domain,
+	           const std::optional<DoubleArrayT> &lb, const std::optional<DoubleArrayT> &ub) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer;
+		        return model.add_variables(N, domain,
+		                                   array_or_fill(lb, N, -GRB_INFINITY, lb_buffer, "lb"),
+		                                   array_or_fill(ub, N, GRB_INFINITY, ub_buffer, "ub"));
+	        },
+	        nb::arg("N"), nb::arg("domain") = VariableDomain::Continuous,
+	        nb::arg("lb") = nb::none(), nb::arg("ub") = nb::none())
 	    // clang-format off
 		BIND_F(delete_variable)
 		BIND_F(delete_variables)
 		BIND_F(is_variable_active)
 	    // clang-format on
-	    .def("set_variable_bounds", &GurobiModel::set_variable_bounds, nb::arg("variable"),
+	    .def("set_variable_bounds",
+	         nb::overload_cast<const VariableIndex &, double, double>(
+	             &GurobiModel::set_variable_bounds),
+	         nb::arg("variable"), nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_array<GurobiModel>, nb::arg("variables"),
+	         nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_list<GurobiModel>, nb::arg("variables"),
 	         nb::arg("lb"), nb::arg("ub"))
 
 	    .def("get_value", &GurobiModel::get_variable_value)
@@ -62,6 +82,9 @@ NB_MODULE(gurobi_model_ext, m)
 	         nb::overload_cast<const ScalarQuadraticFunction &>(&GurobiModel::get_expression_value))
 	    .def("get_value",
 	         nb::overload_cast<const ExprBuilder &>(&GurobiModel::get_expression_value))
+	    .def("get_values", &get_variable_values_array<GurobiModel>, nb::arg("variables"))
+	    .def("get_values", &get_variable_values_list<GurobiModel>, nb::arg("variables"))
+	    .def("get_values", &get_expression_values_array<GurobiModel>, nb::arg("exprs"))
 
 	    .def("pprint", &GurobiModel::pprint_variable)
 	    .def("pprint",
@@ -85,6 +108,10 @@ NB_MODULE(gurobi_model_ext, m)
 	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
 	    .def("_add_linear_constraint", &GurobiModel::add_linear_constraint_from_expr,
 	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<GurobiModel>,
+	         nb::arg("indptr"), nb::arg("variables"), nb::arg("coefficients"), nb::arg("sense"),
+	         nb::arg("rhs"))
+	    .def("load_cache_model", &load_cache_model<GurobiModel>, nb::arg("cache"))
 	    .def("_add_quadratic_constraint", &GurobiModel::add_quadratic_constraint, nb::arg("expr"),
 	         nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
 	    .def("_add_quadratic_constraint", &GurobiModel::add_quadratic_constraint_from_expr,
@@ -202,7 +229,6 @@ NB_MODULE(gurobi_model_ext, m)
 		BIND_F(get_constraint_raw_attribute_string)
 
 		BIND_F(get_normalized_rhs)
-		BIND_F(set_normalized_rhs)
 		BIND_F(get_normalized_coefficient)
 		BIND_F(set_normalized_coefficient)
 		BIND_F(get_objective_coefficient)
@@ -212,5 +238,19 @@ NB_MODULE(gurobi_model_ext, m)
 
 		BIND_F(computeIIS)
 	    // clang-format on
+	    .def("set_normalized_rhs",
+	         nb::overload_cast<const ConstraintIndex &, double>(&GurobiModel::set_normalized_rhs))
+	    .def("set_normalized_rhs", &set_normalized_rhs_array<GurobiModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_rhs", &set_normalized_rhs_list<GurobiModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_array<GurobiModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_list<GurobiModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_array<GurobiModel>,
+	         nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_list<GurobiModel>,
+	         nb::arg("variables"), nb::arg("values"))
 	    ;
 }
\ No newline at end of file
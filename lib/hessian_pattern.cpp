@@ -0,0 +1,209 @@
+#include "pyoptinterface/hessian_pattern.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+
+// below this number of entries, the calling thread does all the work
+static constexpr size_t PARALLEL_THRESHOLD = size_t(1) << 16;
+
+static constexpr int RADIX_BITS = 11;
+static constexpr size_t RADIX_BUCKETS = size_t(1) << RADIX_BITS;
+
+static void run_chunks(ThreadPool *pool, size_t n_chunks, const std::function<void(size_t)> &f)
+{
+	if (pool != nullptr && n_chunks > 1)
+	{
+		pool->parallel_for(n_chunks, f);
+	}
+	else
+	{
+		for (size_t c = 0; c < n_chunks; c++)
+		{
+			f(c);
+		}
+	}
+}
+
+HessianPatternBuilder::HessianPatternBuilder(HessianSparsityType hessian_type)
+    : m_hessian_type(hessian_type)
+{
+}
+
+size_t HessianPatternBuilder::add_entries(int *slots, size_t n)
+{
+	auto begin = m_keys.size();
+	if (n == 0)
+	{
+		return begin;
+	}
+	m_keys.resize(begin + n);
+	m_ranges.push_back({slots, begin});
+	return begin;
+}
+
+size_t HessianPatternBuilder::n_entries() const
+{
+	return m_keys.size();
+}
+
+void HessianPatternBuilder::finalize(size_t &global_hessian_nnz,
+                                     std::vector<int> &global_hessian_rows,
+                                     std::vector<int> &global_hessian_cols, ThreadPool *pool)
+{
+	auto N = m_keys.size();
+	if (N == 0)
+	{
+		return;
+	}
+	if (N > size_t(UINT32_MAX))
+	{
+		throw std::runtime_error("Too many hessian entries to assemble");
+	}
+
+	size_t n_chunks = 1;
+	if (pool != nullptr && N >= PARALLEL_THRESHOLD)
+	{
+		n_chunks = pool->n_threads();
+	}
+	auto chunk_begin = [&](size_t c) { return N * c / n_chunks; };
+
+	// only the significant bits of rows and columns take part in the sort
+	std::vector<uint64_t> chunk_max_row(n_chunks, 0), chunk_max_col(n_chunks, 0);
+	run_chunks(pool, n_chunks, [&](size_t c) {
+		uint64_t max_row = 0, max_col = 0;
+		for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+		{
+			max_row = std::max(max_row, m_keys[i] >> 32);
+			max_col = std::max(max_col, m_keys[i] & 0xFFFFFFFFu);
+		}
+		chunk_max_row[c] = max_row;
+		chunk_max_col[c] = max_col;
+	});
+	auto max_row = *std::max_element(chunk_max_row.begin(), chunk_max_row.end());
+	auto max_col = *std::max_element(chunk_max_col.begin(), chunk_max_col.end());
+	int col_bits = std::bit_width(max_col);
+	int key_bits = std::bit_width(max_row) + col_bits;
+	uint64_t col_mask = (uint64_t(1) << col_bits) - 1;
+
+	std::vector<uint32_t> ids(N);
+	run_chunks(pool, n_chunks, [&](size_t c) {
+		for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+		{
+			m_keys[i] = ((m_keys[i] >> 32) << col_bits) | (m_keys[i] & 0xFFFFFFFFu);
+			ids[i] = i;
+		}
+	});
+
+	// LSD radix sort, each chunk scatters its entries to the offsets computed in (bucket, chunk)
+	// order, so every pass is stable
+	std::vector<uint64_t> keys_buffer(N);
+	std::vector<uint32_t> ids_buffer(N);
+	std::vector<size_t> offsets(n_chunks * RADIX_BUCKETS);
+	for (int shift = 0; shift < key_bits; shift += RADIX_BITS)
+	{
+		std::fill(offsets.begin(), offsets.end(), 0);
+		run_chunks(pool, n_chunks, [&](size_t c) {
+			auto counts = offsets.data() + c * RADIX_BUCKETS;
+			for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+			{
+				counts[(m_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+			}
+		});
+
+		size_t offset = 0;
+		for (size_t b = 0; b < RADIX_BUCKETS; b++)
+		{
+			for (size_t c = 0; c < n_chunks; c++)
+			{
+				auto count = offsets[c * RADIX_BUCKETS + b];
+				offsets[c * RADIX_BUCKETS + b] = offset;
+				offset += count;
+			}
+		}
+
+		run_chunks(pool, n_chunks, [&](size_t c) {
+			auto chunk_offsets = offsets.data() + c * RADIX_BUCKETS;
+			for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+			{
+				auto dest = chunk_offsets[(m_keys[i] >> shift) & (RADIX_BUCKETS - 1)]++;
+				keys_buffer[dest] = m_keys[i];
+				ids_buffer[dest] = ids[i];
+			}
+		});
+		std::swap(m_keys, keys_buffer);
+		std::swap(ids, ids_buffer);
+	}
+	keys_buffer = std::vector<uint64_t>();
+	ids_buffer = std::vector<uint32_t>();
+
+	// number the distinct keys, the numbering of chunk c continues after the distinct keys of
+	// the previous chunks
+	std::vector<size_t> chunk_distinct(n_chunks + 1, 0);
+	run_chunks(pool, n_chunks, [&](size_t c) {
+		size_t n_distinct = 0;
+		for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+		{
+			if (i == 0 || m_keys[i] != m_keys[i - 1])
+			{
+				n_distinct++;
+			}
+		}
+		chunk_distinct[c + 1] = n_distinct;
+	});
+	for (size_t c = 0; c < n_chunks; c++)
+	{
+		chunk_distinct[c + 1] += chunk_distinct[c];
+	}
+
+	auto base = global_hessian_nnz;
+	auto n_distinct = chunk_distinct[n_chunks];
+	if (base + n_distinct > size_t(INT_MAX))
+	{
+		throw std::runtime_error("The number of hessian nonzeros exceeds the range of int");
+	}
+	global_hessian_rows.resize(base + n_distinct);
+	global_hessian_cols.resize(base + n_distinct);
+
+	std::vector<int> entry_slots(N);
+	run_chunks(pool, n_chunks, [&](size_t c) {
+		// the global index of the last distinct key before this chunk
+		int64_t slot = int64_t(base + chunk_distinct[c]) - 1;
+		for (size_t i = chunk_begin(c); i < chunk_begin(c + 1); i++)
+		{
+			auto key = m_keys[i];
+			if (i == 0 || key != m_keys[i - 1])
+			{
+				slot++;
+				global_hessian_rows[slot] = key >> col_bits;
+				global_hessian_cols[slot] = key & col_mask;
+			}
+			entry_slots[ids[i]] = slot;
+		}
+	});
+
+	// write the global indices back in the order of entries
+	run_chunks(pool, n_chunks, [&](size_t c) {
+		auto begin = chunk_begin(c);
+		auto end = chunk_begin(c + 1);
+		auto range = std::upper_bound(m_ranges.begin(), m_ranges.end(), begin,
+		                              [](size_t i, const SlotRange &r) { return i < r.begin; }) -
+		             1;
+		for (size_t i = begin; i < end; i++)
+		{
+			while (range + 1 != m_ranges.end() && (range + 1)->begin <= i)
+			{
+				range++;
+			}
+			range->slots[i - range->begin] = entry_slots[i];
+		}
+	});
+
+	global_hessian_nnz = base + n_distinct;
+
+	m_keys.clear();
+	m_ranges.clear();
+}
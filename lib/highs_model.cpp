@@ -1,5 +1,6 @@
 #include "pyoptinterface/highs_model.hpp"
 #include "fmt/core.h"
+#include <algorithm>
 
 namespace highs
 {
@@ -182,6 +183,50 @@ VariableIndex POIHighsModel::add_variable(VariableDomain domain, double lb, doub
 	return variable;
 }
 
+VariableIndex POIHighsModel::add_variables(int N, VariableDomain domain, const double *lb,
+                                           const double *ub)
+{
+	IndexT index = m_variable_index.add_indices(N);
+	VariableIndex variable(index);
+	if (N == 0)
+	{
+		return variable;
+	}
+
+	std::vector<double> lbs, ubs;
+	if (domain == VariableDomain::Binary)
+	{
+		lbs.assign(N, 0.0);
+		ubs.assign(N, 1.0);
+		lb = lbs.data();
+		ub = ubs.data();
+	}
+	std::vector<double> costs(N, 0.0);
+	auto error =
+	    highs::Highs_addCols(m_model.get(), N, costs.data(), lb, ub, 0, nullptr, nullptr, nullptr);
+	check_error(error);
+
+	auto column = m_n_variables;
+
+	if (domain != VariableDomain::Continuous)
+	{
+		if (domain == VariableDomain::Binary)
+		{
+			for (int i = 0; i < N; i++)
+			{
+				binary_variables.insert(index + i);
+			}
+		}
+		std::vector<HighsInt> vtypes(N, highs_vtype(domain));
+		error = highs::Highs_changeColsIntegralityByRange(m_model.get(), column, column + N - 1,
+		                                                  vtypes.data());
+		check_error(error);
+	}
+
+	m_n_variables += N;
+	return variable;
+}
+
 void POIHighsModel::delete_variable(const VariableIndex &variable)
 {
 	if (!is_variable_active(variable))
@@ -205,25 +250,22 @@ void POIHighsModel::delete_variables(const Vector<VariableIndex> &variables)
 	if (n_variables == 0)
 		return;
 
-	std::vector<HighsInt> columns;
-	columns.reserve(n_variables);
+	std::vector<IndexT> indices;
+	indices.reserve(n_variables);
 	for (int i = 0; i < n_variables; i++)
 	{
-		if (!is_variable_active(variables[i]))
+		if (is_variable_active(variables[i]))
 		{
-			continue;
+			indices.push_back(variables[i].index);
 		}
-		auto column = _variable_index(variables[i]);
-		columns.push_back(column);
 	}
+	std::vector<HighsInt> columns(indices.size());
+	_variable_indices(indices, columns);
 
 	int error = highs::Highs_deleteColsBySet(m_model.get(), columns.size(), columns.data());
 	check_error(error);
 
-	for (int i = 0; i < n_variables; i++)
-	{
-		m_variable_index.delete_index(variables[i].index);
-	}
+	m_variable_index.delete_indices(indices);
 	m_n_variables -= columns.size();
 }
 
@@ -242,6 +284,20 @@ double POIHighsModel::get_variable_value(const VariableIndex &variable)
 	throw std::runtime_error("No solution available");
 }
 
+void POIHighsModel::get_variable_values(int N, const int *variables, double *values)
+{
+	if (m_solution.primal_solution_status == kHighsSolutionStatusNone)
+	{
+		throw std::runtime_error("No solution available");
+	}
+	std::vector<HighsInt> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<HighsInt>(columns));
+	for (int i = 0; i < N; i++)
+	{
+		values[i] = m_solution.colvalue[columns[i]];
+	}
+}
+
 std::string POIHighsModel::pprint_variable(const VariableIndex &variable)
 {
 	return get_variable_name(variable);
@@ -254,6 +310,15 @@ void POIHighsModel::set_variable_bounds(const VariableIndex &variable, double lb
 	check_error(error);
 }
 
+void POIHighsModel::set_variable_bounds(int N, const int *variables, const double *lb,
+                                        const double *ub)
+{
+	std::vector<HighsInt> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<HighsInt>(columns));
+	auto error = highs::Highs_changeColsBoundsBySet(m_model.get(), N, columns.data(), lb, ub);
+	check_error(error);
+}
+
 ConstraintIndex POIHighsModel::add_linear_constraint(const ScalarAffineFunction &function,
                                                      ConstraintSense sense, CoeffT rhs,
                                                      const char *name)
@@ -320,6 +385,39 @@ ConstraintIndex POIHighsModel::add_linear_constraint(const ScalarAffineFunction
 	return constraint;
 }
 
+ConstraintIndex POIHighsModel::add_linear_constraints(int M, const int *indptr,
+                                                      const int *variables,
+                                                      const double *coefficients,
+                                                      ConstraintSense sense, const double *rhs)
+{
+	CSRMatrixPtrForm<HighsInt, HighsInt, double> ptr_form;
+	ptr_form.make(this, M, indptr, variables, coefficients);
+
+	IndexT index = m_linear_constraint_index.add_indices(M);
+	ConstraintIndex constraint(ConstraintType::Linear, index);
+
+	std::vector<double> lb(M, -kHighsInf), ub(M, kHighsInf);
+	for (int i = 0; i < M; i++)
+	{
+		if (sense != ConstraintSense::LessEqual)
+		{
+			lb[i] = rhs[i];
+		}
+		if (sense != ConstraintSense::GreaterEqual)
+		{
+			ub[i] = rhs[i];
+		}
+	}
+
+	auto error = highs::Highs_addRows(m_model.get(), M, lb.data(), ub.data(), ptr_form.numnz,
+	                                  ptr_form.begin, ptr_form.index, ptr_form.value);
+	check_error(error);
+
+	m_n_constraints += M;
+
+	return constraint;
+}
+
 ConstraintIndex POIHighsModel::add_quadratic_constraint(const ScalarQuadraticFunction &function,
                                                         ConstraintSense sense, CoeffT rhs,
                                                         const char *name)
@@ -815,6 +913,12 @@ HighsInt POIHighsModel::_variable_index(const VariableIndex &variable)
 	return m_variable_index.get_index(variable.index);
 }
 
+void POIHighsModel::_variable_indices(std::span<const IndexT> variables,
+                                      std::span<HighsInt> columns)
+{
+	m_variable_index.get_indices(variables, columns);
+}
+
 HighsInt POIHighsModel::_checked_variable_index(const VariableIndex &variable)
 {
 	HighsInt column = _variable_index(variable);
@@ -846,6 +950,12 @@ HighsInt POIHighsModel::_checked_constraint_index(const ConstraintIndex &constra
 	return row;
 }
 
+void POIHighsModel::_linear_constraint_indices(std::span<const IndexT> constraints,
+                                               std::span<HighsInt> rows)
+{
+	m_linear_constraint_index.get_indices(constraints, rows);
+}
+
 void POIHighsModel::set_primal_start(const Vector<VariableIndex> &variables,
                                      const Vector<double> &values)
 {
@@ -942,6 +1052,46 @@ void POIHighsModel::set_normalized_rhs(const ConstraintIndex &constraint, double
 	check_error(error);
 }
 
+void POIHighsModel::set_normalized_rhs(int N, const int *constraints, const double *values)
+{
+	std::vector<HighsInt> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<HighsInt>(rows));
+
+	// HiGHS requires the set of rows to be strictly increasing
+	std::vector<HighsInt> set(rows);
+	std::sort(set.begin(), set.end());
+	set.erase(std::unique(set.begin(), set.end()), set.end());
+	HighsInt M = set.size();
+
+	HighsInt numrow, nz;
+	std::vector<double> lb(M), ub(M);
+	auto error = highs::Highs_getRowsBySet(m_model.get(), M, set.data(), &numrow, lb.data(),
+	                                       ub.data(), &nz, nullptr, nullptr, nullptr);
+	check_error(error);
+
+	std::vector<bool> lb_inf(M), ub_inf(M);
+	for (HighsInt k = 0; k < M; k++)
+	{
+		lb_inf[k] = lb[k] < -kHighsInf + 1.0;
+		ub_inf[k] = ub[k] > kHighsInf - 1.0;
+		if (lb_inf[k] && ub_inf[k])
+		{
+			throw std::runtime_error("Constraint has no finite bound");
+		}
+	}
+	for (int i = 0; i < N; i++)
+	{
+		HighsInt k = std::lower_bound(set.begin(), set.end(), rows[i]) - set.begin();
+		if (!lb_inf[k])
+			lb[k] = values[i];
+		if (!ub_inf[k])
+			ub[k] = values[i];
+	}
+
+	error = highs::Highs_changeRowsBoundsBySet(m_model.get(), M, set.data(), lb.data(), ub.data());
+	check_error(error);
+}
+
 double POIHighsModel::get_normalized_coefficient(const ConstraintIndex &constraint,
                                                  const VariableIndex &variable)
 {
@@ -983,6 +1133,21 @@ void POIHighsModel::set_normalized_coefficient(const ConstraintIndex &constraint
 	check_error(error);
 }
 
+void POIHighsModel::set_normalized_coefficients(int N, const int *constraints,
+                                                const int *variables, const double *values)
+{
+	std::vector<HighsInt> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<HighsInt>(rows));
+	std::vector<HighsInt> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<HighsInt>(columns));
+	// HiGHS has no function to change multiple coefficients at once
+	for (int i = 0; i < N; i++)
+	{
+		auto error = highs::Highs_changeCoeff(m_model.get(), rows[i], columns[i], values[i]);
+		check_error(error);
+	}
+}
+
 double POIHighsModel::get_objective_coefficient(const VariableIndex &variable)
 {
 	auto column = _checked_variable_index(variable);
@@ -1000,3 +1165,11 @@ void POIHighsModel::set_objective_coefficient(const VariableIndex &variable, dou
 	auto error = highs::Highs_changeColCost(m_model.get(), column, value);
 	check_error(error);
 }
+
+void POIHighsModel::set_objective_coefficients(int N, const int *variables, const double *values)
+{
+	std::vector<HighsInt> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<HighsInt>(columns));
+	auto error = highs::Highs_changeColsCostBySet(m_model.get(), N, columns.data(), values);
+	check_error(error);
+}
@@ -4,6 +4,8 @@
 #include <nanobind/stl/vector.h>
 
 #include "pyoptinterface/highs_model.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
+#include "pyoptinterface/cache_model.hpp"
 
 namespace nb = nanobind;
 
@@ -49,12 +51,30 @@ NB_MODULE(highs_model_ext, m)
 	    .def("add_variable", &HighsModel::add_variable,
 	         nb::arg("domain") = VariableDomain::Continuous, nb::arg("lb") = -kHighsInf,
 	         nb::arg("ub") = kHighsInf, nb::arg("name") = "")
+	    .def(
+	        "_add_variables",
+	        [](HighsModel &model, int N, VariableDomain domain,
+	           const std::optional<DoubleArrayT> &lb, const std::optional<DoubleArrayT> &ub) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer;
+		        return model.add_variables(N, domain,
+		                                   array_or_fill(lb, N, -kHighsInf, lb_buffer, "lb"),
+		                                   array_or_fill(ub, N, kHighsInf, ub_buffer, "ub"));
+	        },
+	        nb::arg("N"), nb::arg("domain") = VariableDomain::Continuous,
+	        nb::arg("lb") = nb::none(), nb::arg("ub") = nb::none())
 	    // clang-format off
 	    BIND_F(delete_variable)
 	    BIND_F(delete_variables)
 	    BIND_F(is_variable_active)
 	    // clang-format on
-	    .def("set_variable_bounds", &HighsModel::set_variable_bounds, nb::arg("variable"),
+	    .def("set_variable_bounds",
+	         nb::overload_cast<const VariableIndex &, double, double>(
+	             &HighsModel::set_variable_bounds),
+	         nb::arg("variable"), nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_array<HighsModel>, nb::arg("variables"),
+	         nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_list<HighsModel>, nb::arg("variables"),
 	         nb::arg("lb"), nb::arg("ub"))
 
 	    .def("get_value", nb::overload_cast<const VariableIndex &>(&HighsModel::get_variable_value))
@@ -63,6 +83,9 @@ NB_MODULE(highs_model_ext, m)
 	    .def("get_value",
 	         nb::overload_cast<const ScalarQuadraticFunction &>(&HighsModel::get_expression_value))
 	    .def("get_value", nb::overload_cast<const ExprBuilder &>(&HighsModel::get_expression_value))
+	    .def("get_values", &get_variable_values_array<HighsModel>, nb::arg("variables"))
+	    .def("get_values", &get_variable_values_list<HighsModel>, nb::arg("variables"))
+	    .def("get_values", &get_expression_values_array<HighsModel>, nb::arg("exprs"))
 
 	    .def("pprint", &HighsModel::pprint_variable)
 	    .def("pprint",
@@ -91,6 +114,10 @@ NB_MODULE(highs_model_ext, m)
 	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
 	    .def("_add_linear_constraint", &HighsModel::add_linear_interval_constraint_from_expr,
 	         nb::arg("expr"), nb::arg("interval"), nb::arg("name") = "")
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<HighsModel>,
+	         nb::arg("indptr"), nb::arg("variables"), nb::arg("coefficients"), nb::arg("sense"),
+	         nb::arg("rhs"))
+	    .def("load_cache_model", &load_cache_model<HighsModel>, nb::arg("cache"))
 
 	    .def("delete_constraint", &HighsModel::delete_constraint)
 	    .def("is_constraint_active", &HighsModel::is_constraint_active)
@@ -163,11 +190,24 @@ NB_MODULE(highs_model_ext, m)
 		BIND_F(set_primal_start)
 
 		BIND_F(get_normalized_rhs)
-		BIND_F(set_normalized_rhs)
 		BIND_F(get_normalized_coefficient)
 		BIND_F(set_normalized_coefficient)
 		BIND_F(get_objective_coefficient)
 		BIND_F(set_objective_coefficient)
 	    // clang-format on
+	    .def("set_normalized_rhs",
+	         nb::overload_cast<const ConstraintIndex &, double>(&HighsModel::set_normalized_rhs))
+	    .def("set_normalized_rhs", &set_normalized_rhs_array<HighsModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_rhs", &set_normalized_rhs_list<HighsModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_array<HighsModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_list<HighsModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_array<HighsModel>,
+	         nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_list<HighsModel>,
+	         nb::arg("variables"), nb::arg("values"))
 	    ;
 }
\ No newline at end of file
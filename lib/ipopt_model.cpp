@@ -1,10 +1,13 @@
 #include "pyoptinterface/ipopt_model.hpp"
 #include "pyoptinterface/solver_common.hpp"
+#include "pyoptinterface/hessian_pattern.hpp"
+#include "pyoptinterface/model_writer.hpp"
 
 #include "fmt/core.h"
 #include "fmt/ranges.h"
 #include "pyoptinterface/dylib.hpp"
 #include <cassert>
+#include <chrono>
 
 static bool is_name_empty(const char *name)
 {
@@ -81,10 +84,52 @@ VariableIndex IpoptModel::add_variable(double lb, double ub, double start, const
 	}
 
 	m_is_dirty = true;
+	m_structure_dirty = true;
 
 	return vi;
 }
 
+VariableIndex IpoptModel::add_variables(int N, const double *lb, const double *ub,
+                                        const double *start)
+{
+	VariableIndex vi(n_variables);
+	m_var_lb.insert(m_var_lb.end(), lb, lb + N);
+	m_var_ub.insert(m_var_ub.end(), ub, ub + N);
+	m_var_init.insert(m_var_init.end(), start, start + N);
+	n_variables += N;
+
+	m_is_dirty = true;
+	m_structure_dirty = true;
+
+	return vi;
+}
+
+ParameterIndex IpoptModel::add_parameter(double value)
+{
+	ParameterIndex parameter(m_parameter_values.size());
+	m_parameter_values.push_back(value);
+	return parameter;
+}
+
+void IpoptModel::set_parameter(const ParameterIndex &parameter, double value)
+{
+	if (parameter.index < 0 || size_t(parameter.index) >= m_parameter_values.size())
+	{
+		throw std::runtime_error("Parameter does not exist");
+	}
+	m_parameter_values[parameter.index] = value;
+	m_is_dirty = true;
+}
+
+double IpoptModel::get_parameter(const ParameterIndex &parameter) const
+{
+	if (parameter.index < 0 || size_t(parameter.index) >= m_parameter_values.size())
+	{
+		throw std::runtime_error("Parameter does not exist");
+	}
+	return m_parameter_values[parameter.index];
+}
+
 double IpoptModel::get_variable_lb(const VariableIndex &variable)
 {
 	return m_var_lb[variable.index];
@@ -98,17 +143,38 @@ double IpoptModel::get_variable_ub(const VariableIndex &variable)
 void IpoptModel::set_variable_lb(const VariableIndex &variable, double lb)
 {
 	m_var_lb[variable.index] = lb;
+	m_bounds_dirty = true;
 }
 
 void IpoptModel::set_variable_ub(const VariableIndex &variable, double ub)
 {
 	m_var_ub[variable.index] = ub;
+	m_bounds_dirty = true;
 }
 
 void IpoptModel::set_variable_bounds(const VariableIndex &variable, double lb, double ub)
 {
 	m_var_lb[variable.index] = lb;
 	m_var_ub[variable.index] = ub;
+	m_bounds_dirty = true;
+}
+
+void IpoptModel::set_variable_bounds(int N, const int *variables, const double *lb,
+                                     const double *ub)
+{
+	for (int i = 0; i < N; i++)
+	{
+		if (variables[i] < 0 || size_t(variables[i]) >= n_variables)
+		{
+			throw std::runtime_error("Variable does not exist");
+		}
+	}
+	for (int i = 0; i < N; i++)
+	{
+		m_var_lb[variables[i]] = lb[i];
+		m_var_ub[variables[i]] = ub[i];
+	}
+	m_bounds_dirty = true;
 }
 
 double IpoptModel::get_variable_start(const VariableIndex &variable)
@@ -121,6 +187,19 @@ void IpoptModel::set_variable_start(const VariableIndex &variable, double start)
 	m_var_init[variable.index] = start;
 }
 
+void IpoptModel::set_variable_bound_dual_start(const VariableIndex &variable, double lb_dual,
+                                               double ub_dual)
+{
+	if (variable.index < 0 || size_t(variable.index) >= n_variables)
+	{
+		throw std::runtime_error("Variable does not exist");
+	}
+	m_var_lb_dual_init.resize(n_variables, 0.0);
+	m_var_ub_dual_init.resize(n_variables, 0.0);
+	m_var_lb_dual_init[variable.index] = lb_dual;
+	m_var_ub_dual_init[variable.index] = ub_dual;
+}
+
 double IpoptModel::get_variable_value(const VariableIndex &variable)
 {
 	if (m_is_dirty)
@@ -131,6 +210,23 @@ double IpoptModel::get_variable_value(const VariableIndex &variable)
 	return m_result.x[variable.index];
 }
 
+void IpoptModel::get_variable_values(int N, const int *variables, double *values)
+{
+	if (m_is_dirty)
+	{
+		throw std::runtime_error(
+		    "Variable value is not available before optimization. Call optimize() first.");
+	}
+	for (int i = 0; i < N; i++)
+	{
+		if (variables[i] < 0 || size_t(variables[i]) >= n_variables)
+		{
+			throw std::runtime_error("Variable does not exist");
+		}
+		values[i] = m_result.x[variables[i]];
+	}
+}
+
 std::string IpoptModel::get_variable_name(const VariableIndex &variable)
 {
 	auto iter = m_var_names.find(variable.index);
@@ -205,6 +301,45 @@ double IpoptModel::get_constraint_dual(const ConstraintIndex &constraint)
 	return dual;
 }
 
+double &IpoptModel::_constraint_dual_start(const ConstraintIndex &constraint)
+{
+	std::vector<double> *starts;
+	size_t n_constraints;
+	switch (constraint.type)
+	{
+	case ConstraintType::Linear:
+		starts = &m_linear_con_dual_init;
+		n_constraints = m_linear_con_evaluator.n_constraints;
+		break;
+	case ConstraintType::Quadratic:
+		starts = &m_quadratic_con_dual_init;
+		n_constraints = m_quadratic_con_evaluator.n_constraints;
+		break;
+	case ConstraintType::NL:
+		starts = &m_nl_con_dual_init;
+		n_constraints = n_nl_constraints;
+		break;
+	default:
+		throw std::runtime_error("Invalid constraint type");
+	}
+	if (constraint.index < 0 || size_t(constraint.index) >= n_constraints)
+	{
+		throw std::runtime_error("Constraint does not exist");
+	}
+	starts->resize(n_constraints, 0.0);
+	return (*starts)[constraint.index];
+}
+
+double IpoptModel::get_constraint_dual_start(const ConstraintIndex &constraint)
+{
+	return _constraint_dual_start(constraint);
+}
+
+void IpoptModel::set_constraint_dual_start(const ConstraintIndex &constraint, double dual)
+{
+	_constraint_dual_start(constraint) = dual;
+}
+
 ConstraintIndex IpoptModel::add_linear_constraint(const ScalarAffineFunction &f,
                                                   ConstraintSense sense, double rhs,
                                                   const char *name)
@@ -240,6 +375,45 @@ ConstraintIndex IpoptModel::add_linear_constraint(const ScalarAffineFunction &f,
 	m_linear_con_ub.push_back(ub);
 
 	m_is_dirty = true;
+	m_structure_dirty = true;
+
+	return con;
+}
+
+ConstraintIndex IpoptModel::add_linear_constraints(int M, const int *indptr, const int *variables,
+                                                   const double *coefficients,
+                                                   ConstraintSense sense, const double *rhs)
+{
+	check_csr_indptr(M, indptr);
+	for (int i = 0; i < indptr[M]; i++)
+	{
+		if (variables[i] < 0 || size_t(variables[i]) >= n_variables)
+		{
+			throw std::runtime_error("Variable does not exist");
+		}
+	}
+
+	ConstraintIndex con(ConstraintType::Linear, m_linear_con_evaluator.n_constraints);
+	m_linear_con_evaluator.add_rows(M, indptr, variables, coefficients);
+
+	for (int i = 0; i < M; i++)
+	{
+		double lb = -INFINITY;
+		double ub = INFINITY;
+		if (sense != ConstraintSense::LessEqual)
+		{
+			lb = rhs[i];
+		}
+		if (sense != ConstraintSense::GreaterEqual)
+		{
+			ub = rhs[i];
+		}
+		m_linear_con_lb.push_back(lb);
+		m_linear_con_ub.push_back(ub);
+	}
+
+	m_is_dirty = true;
+	m_structure_dirty = true;
 
 	return con;
 }
@@ -283,6 +457,7 @@ ConstraintIndex IpoptModel::add_quadratic_constraint(const ScalarQuadraticFuncti
 	m_quadratic_con_ub.push_back(ub);
 
 	m_is_dirty = true;
+	m_structure_dirty = true;
 
 	return con;
 }
@@ -322,6 +497,7 @@ void IpoptModel::_set_linear_objective(const ScalarAffineFunction &expr)
 	evaluator.add_row(expr);
 	m_linear_obj_evaluator = evaluator;
 	m_quadratic_obj_evaluator.reset();
+	m_structure_dirty = true;
 }
 
 void IpoptModel::_set_quadratic_objective(const ScalarQuadraticFunction &expr)
@@ -330,16 +506,43 @@ void IpoptModel::_set_quadratic_objective(const ScalarQuadraticFunction &expr)
 	evaluator.add_row(expr);
 	m_linear_obj_evaluator.reset();
 	m_quadratic_obj_evaluator = evaluator;
+	m_structure_dirty = true;
 }
 
 int IpoptModel::add_graph_index()
 {
+	m_structure_dirty = true;
 	return m_nl_evaluator.add_graph_instance();
 }
 
-void IpoptModel::finalize_graph_instance(size_t graph_index, const ExpressionGraph &graph)
+void IpoptModel::finalize_graph_instance(size_t graph_index, ExpressionGraph &graph)
 {
+	for (auto parameter : graph.m_parameters)
+	{
+		if (parameter < 0 || (size_t)parameter >= m_parameter_values.size())
+		{
+			throw std::runtime_error("Parameter used in nonlinear expression does not exist");
+		}
+	}
+	// affine and quadratic terms are evaluated analytically, only the nonlinear core of each output
+	// is traced and compiled
+	for (int rank = 0; rank < graph.m_constraint_outputs.size(); rank++)
+	{
+		ExprBuilder quadratic_part;
+		if (graph.split_quadratic_part(graph.m_constraint_outputs[rank], quadratic_part))
+		{
+			m_nl_quadratic_con_evaluator.add_row(ScalarQuadraticFunction(quadratic_part));
+			m_nl_quadratic_con_memberships.push_back({(int)graph_index, rank});
+		}
+	}
+	for (auto &output : graph.m_objective_outputs)
+	{
+		graph.split_quadratic_part(output, m_nl_quadratic_obj);
+	}
+	// graphs that differ only in the order of commutative operands are grouped together
+	graph.canonicalize();
 	m_nl_evaluator.finalize_graph_instance(graph_index, graph);
+	m_structure_dirty = true;
 }
 
 int IpoptModel::aggregate_nl_constraint_groups()
@@ -399,27 +602,83 @@ ConstraintIndex IpoptModel::add_single_nl_constraint(size_t graph_index,
 	    .graph = (int)graph_index, .rank = (int)graph.m_constraint_outputs.size() - 1});
 
 	m_is_dirty = true;
+	m_structure_dirty = true;
 
 	return ConstraintIndex(ConstraintType::NL, constraint_index);
 }
 
+using ProfileClock = std::chrono::steady_clock;
+
+static double seconds_between(ProfileClock::time_point start, ProfileClock::time_point end)
+{
+	return std::chrono::duration<double>(end - start).count();
+}
+
+// adds the time of its lifetime to timer
+struct ScopedTimer
+{
+	IpoptTimer &timer;
+	ProfileClock::time_point start = ProfileClock::now();
+
+	~ScopedTimer()
+	{
+		timer.calls++;
+		timer.seconds += seconds_between(start, ProfileClock::now());
+	}
+};
+
+// the sub-phases of a callback are measured by lap, the whole callback by the lifetime
+struct CallbackTimer
+{
+	IpoptCallbackProfile &profile;
+	ProfileClock::time_point start = ProfileClock::now();
+	ProfileClock::time_point last = start;
+
+	// seconds since the last lap
+	double lap()
+	{
+		auto now = ProfileClock::now();
+		auto seconds = seconds_between(last, now);
+		last = now;
+		return seconds;
+	}
+
+	~CallbackTimer()
+	{
+		profile.total.calls++;
+		profile.total.seconds += seconds_between(start, ProfileClock::now());
+	}
+};
+
 static bool eval_f(ipindex n, ipnumber *x, bool new_x, ipnumber *obj_value, UserDataPtr user_data)
 {
 	IpoptModel &model = *static_cast<IpoptModel *>(user_data);
+	auto &profile = model.m_profile.eval_f;
+	CallbackTimer timer{profile};
 	*obj_value = 0.0;
 	// fmt::print("Before linear and quad objective, obj_value: {}\n", *obj_value);
 	if (model.m_linear_obj_evaluator)
 	{
 		model.m_linear_obj_evaluator->eval_function(x, obj_value);
+		profile.linear_seconds += timer.lap();
 	}
 	else if (model.m_quadratic_obj_evaluator)
 	{
 		model.m_quadratic_obj_evaluator->eval_function(x, obj_value);
+		profile.quadratic_seconds += timer.lap();
+	}
+	if (model.m_nl_quadratic_obj_evaluator)
+	{
+		double value;
+		model.m_nl_quadratic_obj_evaluator->eval_function(x, &value);
+		*obj_value += value;
+		profile.quadratic_seconds += timer.lap();
 	}
 	// fmt::print("After linear and quad objective, obj_value: {}\n", *obj_value);
 
 	// nonlinear part
 	double nl_obj = model.m_nl_evaluator.eval_objective(x);
+	profile.nonlinear_seconds += timer.lap();
 
 	*obj_value += nl_obj;
 
@@ -429,6 +688,8 @@ static bool eval_f(ipindex n, ipnumber *x, bool new_x, ipnumber *obj_value, User
 static bool eval_grad_f(ipindex n, ipnumber *x, bool new_x, ipnumber *grad_f, UserDataPtr user_data)
 {
 	IpoptModel &model = *static_cast<IpoptModel *>(user_data);
+	auto &profile = model.m_profile.eval_grad_f;
+	CallbackTimer timer{profile};
 	std::fill(grad_f, grad_f + n, 0.0);
 
 	// fmt::print("Enters eval_grad_f\n");
@@ -438,17 +699,27 @@ static bool eval_grad_f(ipindex n, ipnumber *x, bool new_x, ipnumber *grad_f, Us
 	std::fill(sparse_gradient_values.begin(), sparse_gradient_values.end(), 0.0);
 
 	// analytical part
+	timer.lap();
 	if (model.m_linear_obj_evaluator)
 	{
 		model.m_linear_obj_evaluator->eval_jacobian(x, sparse_gradient_values.data());
+		profile.linear_seconds += timer.lap();
 	}
 	else if (model.m_quadratic_obj_evaluator)
 	{
 		model.m_quadratic_obj_evaluator->eval_jacobian(x, sparse_gradient_values.data());
+		profile.quadratic_seconds += timer.lap();
+	}
+	if (model.m_nl_quadratic_obj_evaluator)
+	{
+		model.m_nl_quadratic_obj_evaluator->eval_jacobian(
+		    x, sparse_gradient_values.data() + model.m_nl_quadratic_obj_gradient_offset);
+		profile.quadratic_seconds += timer.lap();
 	}
 
 	// nonlinear part
 	model.m_nl_evaluator.eval_objective_gradient(x, sparse_gradient_values.data());
+	profile.nonlinear_seconds += timer.lap();
 
 	// copy to grad_f
 	for (size_t i = 0; i < model.sparse_gradient_indices.size(); i++)
@@ -469,6 +740,8 @@ static bool eval_g(ipindex n, ipnumber *x, bool new_x, ipindex m, ipnumber *g,
                    UserDataPtr user_data)
 {
 	IpoptModel &model = *static_cast<IpoptModel *>(user_data);
+	auto &profile = model.m_profile.eval_g;
+	CallbackTimer timer{profile};
 	// std::fill(g, g + m, 0.0);
 
 	// fmt::print("Enters eval_g\n");
@@ -476,14 +749,37 @@ static bool eval_g(ipindex n, ipnumber *x, bool new_x, ipindex m, ipnumber *g,
 
 	// linear part
 	model.m_linear_con_evaluator.eval_function(x, g);
+	profile.linear_seconds += timer.lap();
 
 	// quadratic part
 	g += model.m_linear_con_evaluator.n_constraints;
 	model.m_quadratic_con_evaluator.eval_function(x, g);
+	profile.quadratic_seconds += timer.lap();
 
 	// nonlinear part
 	g += model.m_quadratic_con_evaluator.n_constraints;
-	model.m_nl_evaluator.eval_constraints(x, g);
+	if (model.m_nl_thread_pool)
+	{
+		model.m_nl_evaluator.eval_constraints_parallel(x, g, *model.m_nl_thread_pool);
+	}
+	else
+	{
+		model.m_nl_evaluator.eval_constraints(x, g);
+	}
+	profile.nonlinear_seconds += timer.lap();
+
+	// affine and quadratic terms split off nonlinear constraints
+	auto &nl_quadratic_evaluator = model.m_nl_quadratic_con_evaluator;
+	if (nl_quadratic_evaluator.n_constraints > 0)
+	{
+		auto buffer = model.m_nl_quadratic_con_buffer.data();
+		nl_quadratic_evaluator.eval_function(x, buffer);
+		for (int i = 0; i < nl_quadratic_evaluator.n_constraints; i++)
+		{
+			original_g[model.m_nl_quadratic_con_rows[i]] += buffer[i];
+		}
+		profile.quadratic_seconds += timer.lap();
+	}
 
 	// debug
 	/*fmt::print("Current x: {}\n", std::vector<double>(x, x + n));
@@ -496,6 +792,8 @@ static bool eval_jac_g(ipindex n, ipnumber *x, bool new_x, ipindex m, ipindex ne
                        ipindex *iRow, ipindex *jCol, ipnumber *values, UserDataPtr user_data)
 {
 	IpoptModel &model = *static_cast<IpoptModel *>(user_data);
+	auto &profile = model.m_profile.eval_jac_g;
+	CallbackTimer timer{profile};
 
 	// fmt::print("Enters eval_jac_g\n");
 
@@ -515,18 +813,45 @@ static bool eval_jac_g(ipindex n, ipnumber *x, bool new_x, ipindex m, ipindex ne
 
 		// linear part
 		model.m_linear_con_evaluator.eval_jacobian(x, values);
+		profile.linear_seconds += timer.lap();
 
 		// quadratic part
 		/*fmt::print("jacobian forwards {} for linear part\n",
 		           model.m_linear_con_evaluator.coefs.size());*/
 		values += model.m_linear_con_evaluator.coefs.size();
 		model.m_quadratic_con_evaluator.eval_jacobian(x, values);
+		profile.quadratic_seconds += timer.lap();
 
 		// nonlinear part
 		/*fmt::print("jacobian forwards {} for quadratic part\n",
 		           model.m_quadratic_con_evaluator.jacobian_nnz);*/
 		values += model.m_quadratic_con_evaluator.jacobian_nnz;
-		model.m_nl_evaluator.eval_constraints_jacobian(x, values);
+		if (model.m_nl_thread_pool)
+		{
+			model.m_nl_evaluator.eval_constraints_jacobian_parallel(x, values,
+			                                                        *model.m_nl_thread_pool);
+		}
+		else
+		{
+			model.m_nl_evaluator.eval_constraints_jacobian(x, values);
+		}
+		profile.nonlinear_seconds += timer.lap();
+
+		// affine and quadratic terms split off nonlinear constraints
+		auto &nl_quadratic_evaluator = model.m_nl_quadratic_con_evaluator;
+		if (nl_quadratic_evaluator.n_constraints > 0)
+		{
+			std::fill(original_jacobian + model.m_nl_quadratic_jacobian_start,
+			          original_jacobian + nele_jac, 0.0);
+			auto buffer = model.m_nl_quadratic_con_buffer.data();
+			nl_quadratic_evaluator.eval_jacobian(x, buffer);
+			auto &indices = model.m_nl_quadratic_jacobian_indices;
+			for (size_t i = 0; i < indices.size(); i++)
+			{
+				original_jacobian[indices[i]] += buffer[i];
+			}
+			profile.quadratic_seconds += timer.lap();
+		}
 
 		// debug
 		/*fmt::print("Current x: {}\n", std::vector<double>(x, x + n));
@@ -541,6 +866,8 @@ static bool eval_h(ipindex n, ipnumber *x, bool new_x, ipnumber obj_factor, ipin
                    ipindex *jCol, ipnumber *values, UserDataPtr user_data)
 {
 	IpoptModel &model = *static_cast<IpoptModel *>(user_data);
+	auto &profile = model.m_profile.eval_h;
+	CallbackTimer timer{profile};
 
 	// fmt::print("Enters eval_h\n");
 
@@ -554,6 +881,8 @@ static bool eval_h(ipindex n, ipnumber *x, bool new_x, ipnumber obj_factor, ipin
 	else
 	{
 		std::fill(values, values + nele_hess, 0.0);
+		timer.lap();
+		auto original_lambda = lambda;
 
 		// objective
 
@@ -562,16 +891,43 @@ static bool eval_h(ipindex n, ipnumber *x, bool new_x, ipnumber obj_factor, ipin
 		{
 			model.m_quadratic_obj_evaluator->eval_lagrangian_hessian(&obj_factor, values);
 		}
+		if (model.m_nl_quadratic_obj_evaluator)
+		{
+			model.m_nl_quadratic_obj_evaluator->eval_lagrangian_hessian(&obj_factor, values);
+		}
 
 		// constraint
 
 		// quadratic part
 		lambda += model.m_linear_con_evaluator.n_constraints;
 		model.m_quadratic_con_evaluator.eval_lagrangian_hessian(lambda, values);
+		profile.quadratic_seconds += timer.lap();
 
 		// nonlinear part
 		lambda += model.m_quadratic_con_evaluator.n_constraints;
-		model.m_nl_evaluator.eval_lagrangian_hessian(x, lambda, obj_factor, values);
+		if (model.m_nl_thread_pool)
+		{
+			model.m_nl_evaluator.eval_lagrangian_hessian_parallel(x, lambda, obj_factor, values,
+			                                                      *model.m_nl_thread_pool);
+		}
+		else
+		{
+			model.m_nl_evaluator.eval_lagrangian_hessian(x, lambda, obj_factor, values);
+		}
+		profile.nonlinear_seconds += timer.lap();
+
+		// affine and quadratic terms split off nonlinear constraints
+		auto &nl_quadratic_evaluator = model.m_nl_quadratic_con_evaluator;
+		if (nl_quadratic_evaluator.n_constraints > 0)
+		{
+			auto buffer = model.m_nl_quadratic_con_buffer.data();
+			for (int i = 0; i < nl_quadratic_evaluator.n_constraints; i++)
+			{
+				buffer[i] = original_lambda[model.m_nl_quadratic_con_rows[i]];
+			}
+			nl_quadratic_evaluator.eval_lagrangian_hessian(buffer, values);
+			profile.quadratic_seconds += timer.lap();
+		}
 
 		// debug
 		/*fmt::print("Current x: {}\n", std::vector<double>(x, x + n));
@@ -602,9 +958,6 @@ void IpoptModel::analyze_structure()
 	// analyze quadratic part
 	m_quadratic_con_evaluator.analyze_jacobian_structure(
 	    m_linear_con_evaluator.n_constraints, m_jacobian_nnz, m_jacobian_rows, m_jacobian_cols);
-	m_quadratic_con_evaluator.analyze_hessian_structure(m_hessian_nnz, m_hessian_rows,
-	                                                    m_hessian_cols, m_hessian_index_map,
-	                                                    HessianSparsityType::Lower);
 
 	// objective
 	sparse_gradient_indices.clear();
@@ -624,8 +977,18 @@ void IpoptModel::analyze_structure()
 		sparse_gradient_indices.insert(sparse_gradient_indices.end(),
 		                               evaluator.jacobian_variable_indices.begin(),
 		                               evaluator.jacobian_variable_indices.end());
-		evaluator.analyze_hessian_structure(m_hessian_nnz, m_hessian_rows, m_hessian_cols,
-		                                    m_hessian_index_map, HessianSparsityType::Lower);
+	}
+	// affine and quadratic terms split off nonlinear objectives
+	m_nl_quadratic_obj_evaluator.reset();
+	if (!m_nl_quadratic_obj.empty())
+	{
+		QuadraticEvaluator evaluator;
+		evaluator.add_row(ScalarQuadraticFunction(m_nl_quadratic_obj));
+		m_nl_quadratic_obj_gradient_offset = sparse_gradient_indices.size();
+		sparse_gradient_indices.insert(sparse_gradient_indices.end(),
+		                               evaluator.jacobian_variable_indices.begin(),
+		                               evaluator.jacobian_variable_indices.end());
+		m_nl_quadratic_obj_evaluator = std::move(evaluator);
 	}
 	// update map
 	for (int i = 0; i < sparse_gradient_indices.size(); i++)
@@ -640,23 +1003,33 @@ void IpoptModel::analyze_structure()
 
 		auto constraint_counter =
 		    m_linear_con_evaluator.n_constraints + m_quadratic_con_evaluator.n_constraints;
+		auto nl_jacobian_start = m_jacobian_nnz;
 		evaluator.analyze_constraints_jacobian_structure(constraint_counter, m_jacobian_nnz,
 		                                                 m_jacobian_rows, m_jacobian_cols);
 		evaluator.analyze_objective_gradient_structure(sparse_gradient_indices,
 		                                               sparse_gradient_map);
-		evaluator.analyze_constraints_hessian_structure(m_hessian_nnz, m_hessian_rows,
-		                                                m_hessian_cols, m_hessian_index_map,
-		                                                HessianSparsityType::Lower);
-		evaluator.analyze_objective_hessian_structure(m_hessian_nnz, m_hessian_rows, m_hessian_cols,
-		                                              m_hessian_index_map,
-		                                              HessianSparsityType::Lower);
+		evaluator.calculate_constraint_graph_instances_offset();
+
+		analyze_nl_quadratic_jacobian_structure(constraint_counter, nl_jacobian_start);
+	}
+
+	// hessian of quadratic and nonlinear parts
+	// Ipopt approximates the Hessian by itself in limited-memory mode and reports no nonzeros
+	if (!m_limited_memory_hessian)
+	{
+		analyze_hessian_structure();
 	}
 
 	sparse_gradient_values.resize(sparse_gradient_indices.size());
 
+	if (m_nl_thread_pool)
+	{
+		m_nl_evaluator.prepare_parallel_evaluation(m_nl_thread_pool->n_threads(), m_hessian_nnz);
+	}
+
 	// update the mapping of nl constraint
 	nl_constraint_map_ext2int.resize(n_nl_constraints);
-	m_nl_evaluator.calculate_constraint_graph_instances_offset();
+	m_nl_evaluator.pack_group_inputs();
 	for (int i = 0; i < n_nl_constraints; i++)
 	{
 		auto i_nl_con = i;
@@ -667,7 +1040,107 @@ void IpoptModel::analyze_structure()
 
 		nl_constraint_map_ext2int[i_nl_con] = index_base + i_graph_rank;
 	}
+}
+
+void IpoptModel::analyze_hessian_structure()
+{
+	if (m_sorted_hessian_assembly)
+	{
+		HessianPatternBuilder builder(HessianSparsityType::Lower);
+		m_quadratic_con_evaluator.analyze_hessian_structure(builder);
+		if (m_quadratic_obj_evaluator)
+		{
+			m_quadratic_obj_evaluator->analyze_hessian_structure(builder);
+		}
+		m_nl_quadratic_con_evaluator.analyze_hessian_structure(builder);
+		if (m_nl_quadratic_obj_evaluator)
+		{
+			m_nl_quadratic_obj_evaluator->analyze_hessian_structure(builder);
+		}
+		m_nl_evaluator.analyze_constraints_hessian_structure(builder);
+		m_nl_evaluator.analyze_objective_hessian_structure(builder);
+		builder.finalize(m_hessian_nnz, m_hessian_rows, m_hessian_cols, m_nl_thread_pool.get());
+	}
+	else
+	{
+		m_quadratic_con_evaluator.analyze_hessian_structure(m_hessian_nnz, m_hessian_rows,
+		                                                    m_hessian_cols, m_hessian_index_map,
+		                                                    HessianSparsityType::Lower);
+		if (m_quadratic_obj_evaluator)
+		{
+			m_quadratic_obj_evaluator->analyze_hessian_structure(
+			    m_hessian_nnz, m_hessian_rows, m_hessian_cols, m_hessian_index_map,
+			    HessianSparsityType::Lower);
+		}
+		m_nl_quadratic_con_evaluator.analyze_hessian_structure(
+		    m_hessian_nnz, m_hessian_rows, m_hessian_cols, m_hessian_index_map,
+		    HessianSparsityType::Lower);
+		if (m_nl_quadratic_obj_evaluator)
+		{
+			m_nl_quadratic_obj_evaluator->analyze_hessian_structure(
+			    m_hessian_nnz, m_hessian_rows, m_hessian_cols, m_hessian_index_map,
+			    HessianSparsityType::Lower);
+		}
+		m_nl_evaluator.analyze_constraints_hessian_structure(m_hessian_nnz, m_hessian_rows,
+		                                                     m_hessian_cols, m_hessian_index_map,
+		                                                     HessianSparsityType::Lower);
+		m_nl_evaluator.analyze_objective_hessian_structure(m_hessian_nnz, m_hessian_rows,
+		                                                   m_hessian_cols, m_hessian_index_map,
+		                                                   HessianSparsityType::Lower);
+		// the map is only needed during the analysis
+		m_hessian_index_map = {};
+	}
+}
+
+void IpoptModel::analyze_nl_quadratic_jacobian_structure(size_t nl_constraint_start,
+                                                         size_t nl_jacobian_start)
+{
+	auto &evaluator = m_nl_quadratic_con_evaluator;
+	auto n_rows = evaluator.n_constraints;
+
+	m_nl_quadratic_con_rows.resize(n_rows);
+	for (int i = 0; i < n_rows; i++)
+	{
+		auto &membership = m_nl_quadratic_con_memberships[i];
+		auto index_base = m_nl_evaluator.constraint_indices_offsets[membership.graph];
+		m_nl_quadratic_con_rows[i] = nl_constraint_start + index_base + membership.rank;
+	}
+
+	size_t jacobian_nnz = 0;
+	std::vector<int> rows, cols;
+	evaluator.analyze_jacobian_structure(0, jacobian_nnz, rows, cols);
+
+	// entries in the jacobian of the nonlinear core are shared, the others are appended
+	Hashmap<std::tuple<int, int>, int> jacobian_index_map;
+	if (n_rows > 0)
+	{
+		for (size_t i = nl_jacobian_start; i < m_jacobian_nnz; i++)
+		{
+			jacobian_index_map.emplace(std::make_tuple(m_jacobian_rows[i], m_jacobian_cols[i]), i);
+		}
+	}
+	m_nl_quadratic_jacobian_start = m_jacobian_nnz;
+	m_nl_quadratic_jacobian_indices.resize(jacobian_nnz);
+	for (size_t i = 0; i < jacobian_nnz; i++)
+	{
+		auto row = m_nl_quadratic_con_rows[rows[i]];
+		auto col = cols[i];
+		auto [iter, inserted] =
+		    jacobian_index_map.emplace(std::make_tuple(row, col), (int)m_jacobian_nnz);
+		if (inserted)
+		{
+			m_jacobian_rows.push_back(row);
+			m_jacobian_cols.push_back(col);
+			m_jacobian_nnz++;
+		}
+		m_nl_quadratic_jacobian_indices[i] = iter->second;
+	}
+
+	m_nl_quadratic_con_buffer.resize(std::max<size_t>(n_rows, jacobian_nnz));
+}
 
+void IpoptModel::update_bounds()
+{
 	// construct the lower bound and upper bound of the constraints
 	auto n_constraints = m_linear_con_evaluator.n_constraints +
 	                     m_quadratic_con_evaluator.n_constraints + n_nl_constraints;
@@ -693,7 +1166,26 @@ void IpoptModel::analyze_structure()
 
 void IpoptModel::optimize()
 {
-	analyze_structure();
+	// the sparsity structure, index maps and Ipopt problem are reused if only the values of
+	// starting points or parameters are changed since last optimization
+	bool structure_changed = m_structure_dirty;
+	bool bounds_changed = m_structure_dirty || m_bounds_dirty;
+	if (structure_changed)
+	{
+		ScopedTimer timer{m_profile.analyze_structure};
+		analyze_structure();
+		m_structure_dirty = false;
+	}
+	if (bounds_changed)
+	{
+		ScopedTimer timer{m_profile.update_bounds};
+		update_bounds();
+		m_bounds_dirty = false;
+	}
+	if (!m_parameter_values.empty())
+	{
+		m_nl_evaluator.update_parameters(m_parameter_values);
+	}
 
 	auto n_constraints = m_linear_con_evaluator.n_constraints +
 	                     m_quadratic_con_evaluator.n_constraints + n_nl_constraints;
@@ -737,12 +1229,17 @@ void IpoptModel::optimize()
 	    fmt::print("hessian_offdiag_indices : {}\n", evaluator.hessian_offdiag_indices);
 	}*/
 
-	auto problem_ptr =
-	    ipopt::CreateIpoptProblem(n_variables, m_var_lb.data(), m_var_ub.data(), n_constraints,
-	                              m_con_lb.data(), m_con_ub.data(), m_jacobian_nnz, m_hessian_nnz,
-	                              0, &eval_f, &eval_g, &eval_grad_f, &eval_jac_g, &eval_h);
+	// Ipopt copies the bounds when the problem is created, so it must be recreated when they change
+	if (!m_problem || bounds_changed)
+	{
+		auto problem_ptr = ipopt::CreateIpoptProblem(
+		    n_variables, m_var_lb.data(), m_var_ub.data(), n_constraints, m_con_lb.data(),
+		    m_con_ub.data(), m_jacobian_nnz, m_hessian_nnz, 0, &eval_f, &eval_g, &eval_grad_f,
+		    &eval_jac_g, &eval_h);
 
-	m_problem = std::unique_ptr<IpoptProblemInfo, IpoptfreeproblemT>(problem_ptr);
+		m_problem = std::unique_ptr<IpoptProblemInfo, IpoptfreeproblemT>(problem_ptr);
+	}
+	auto problem_ptr = m_problem.get();
 
 	// set options
 	for (auto &[key, value] : m_options_int)
@@ -779,13 +1276,88 @@ void IpoptModel::optimize()
 	m_result.g.resize(n_constraints);
 	m_result.mult_g.resize(n_constraints);
 
-	m_status = ipopt::IpoptSolve(problem_ptr, m_result.x.data(), m_result.g.data(),
-	                             &m_result.obj_val, m_result.mult_g.data(),
-	                             m_result.mult_x_L.data(), m_result.mult_x_U.data(), (void *)this);
+	// initialize the duals, Ipopt only uses them if the option warm_start_init_point is yes
+	// the constraints added since last optimization start from zero
+	auto n_linear_constraints = m_linear_con_evaluator.n_constraints;
+	auto n_quadratic_constraints = m_quadratic_con_evaluator.n_constraints;
+	m_var_lb_dual_init.resize(n_variables, 0.0);
+	m_var_ub_dual_init.resize(n_variables, 0.0);
+	m_linear_con_dual_init.resize(n_linear_constraints, 0.0);
+	m_quadratic_con_dual_init.resize(n_quadratic_constraints, 0.0);
+	m_nl_con_dual_init.resize(n_nl_constraints, 0.0);
+	std::copy(m_var_lb_dual_init.begin(), m_var_lb_dual_init.end(), m_result.mult_x_L.begin());
+	std::copy(m_var_ub_dual_init.begin(), m_var_ub_dual_init.end(), m_result.mult_x_U.begin());
+	// the multipliers of Ipopt have the opposite sign of get_constraint_dual
+	for (size_t i = 0; i < n_linear_constraints; i++)
+	{
+		m_result.mult_g[i] = -m_linear_con_dual_init[i];
+	}
+	for (size_t i = 0; i < n_quadratic_constraints; i++)
+	{
+		m_result.mult_g[n_linear_constraints + i] = -m_quadratic_con_dual_init[i];
+	}
+	auto nl_constraint_start = n_linear_constraints + n_quadratic_constraints;
+	for (size_t i = 0; i < n_nl_constraints; i++)
+	{
+		m_result.mult_g[nl_constraint_start + nl_constraint_map_ext2int[i]] =
+		    -m_nl_con_dual_init[i];
+	}
+	m_result.n_linear_constraints = n_linear_constraints;
+	m_result.n_quadratic_constraints = n_quadratic_constraints;
+
+	{
+		ScopedTimer timer{m_profile.ipopt_solve};
+		m_status = ipopt::IpoptSolve(problem_ptr, m_result.x.data(), m_result.g.data(),
+		                             &m_result.obj_val, m_result.mult_g.data(),
+		                             m_result.mult_x_L.data(), m_result.mult_x_U.data(),
+		                             (void *)this);
+	}
 	m_result.is_valid = true;
 	m_is_dirty = false;
 }
 
+void IpoptModel::set_nl_eval_threads(int n_threads)
+{
+	if (n_threads <= 1)
+	{
+		m_nl_thread_pool.reset();
+	}
+	else if (!m_nl_thread_pool || m_nl_thread_pool->n_threads() != (size_t)n_threads)
+	{
+		m_nl_thread_pool = std::make_unique<ThreadPool>(n_threads);
+		// the partition of parallel evaluation depends on the number of threads
+		m_structure_dirty = true;
+	}
+}
+
+void IpoptModel::set_sorted_hessian_assembly(bool enable)
+{
+	if (m_sorted_hessian_assembly != enable)
+	{
+		m_sorted_hessian_assembly = enable;
+		m_structure_dirty = true;
+	}
+}
+
+bool IpoptModel::get_sorted_hessian_assembly() const
+{
+	return m_sorted_hessian_assembly;
+}
+
+void IpoptModel::reset_profile()
+{
+	m_profile = IpoptProfile();
+}
+
+int IpoptModel::get_nl_eval_threads() const
+{
+	if (m_nl_thread_pool)
+	{
+		return m_nl_thread_pool->n_threads();
+	}
+	return 1;
+}
+
 void IpoptModel::load_current_solution()
 {
 	if (!m_result.is_valid)
@@ -794,6 +1366,140 @@ void IpoptModel::load_current_solution()
 	}
 
 	std::copy(m_result.x.begin(), m_result.x.end(), m_var_init.begin());
+
+	// the duals are stored in the order of adding constraints, so they stay valid when more
+	// constraints are added before next optimization
+	std::copy(m_result.mult_x_L.begin(), m_result.mult_x_L.end(), m_var_lb_dual_init.begin());
+	std::copy(m_result.mult_x_U.begin(), m_result.mult_x_U.end(), m_var_ub_dual_init.begin());
+	auto &mult_g = m_result.mult_g;
+	auto n_linear_constraints = m_result.n_linear_constraints;
+	auto n_quadratic_constraints = m_result.n_quadratic_constraints;
+	for (size_t i = 0; i < n_linear_constraints; i++)
+	{
+		m_linear_con_dual_init[i] = -mult_g[i];
+	}
+	for (size_t i = 0; i < n_quadratic_constraints; i++)
+	{
+		m_quadratic_con_dual_init[i] = -mult_g[n_linear_constraints + i];
+	}
+	// nl_constraint_map_ext2int is only rebuilt in next optimization
+	auto nl_constraint_start = n_linear_constraints + n_quadratic_constraints;
+	for (size_t i = 0; i < nl_constraint_map_ext2int.size(); i++)
+	{
+		m_nl_con_dual_init[i] = -mult_g[nl_constraint_start + nl_constraint_map_ext2int[i]];
+	}
+}
+
+void IpoptModel::write(const std::string &filename)
+{
+	if (m_nl_evaluator.n_graph_instances > 0)
+	{
+		throw std::runtime_error("Model with nonlinear functions cannot be written to a file");
+	}
+
+	// the constants of rows are stored in the evaluators, they are moved to the bounds
+	auto &linear = m_linear_con_evaluator;
+	std::vector<double> linear_lbs = m_linear_con_lb;
+	std::vector<double> linear_ubs = m_linear_con_ub;
+	for (size_t k = 0; k < linear.constant_indices.size(); k++)
+	{
+		auto i = linear.constant_indices[k];
+		linear_lbs[i] -= linear.constant_values[k];
+		linear_ubs[i] -= linear.constant_values[k];
+	}
+
+	// the diagonal and off-diagonal terms of quadratic constraints are merged into one matrix
+	auto &quadratic = m_quadratic_con_evaluator;
+	int Q = quadratic.n_constraints;
+	std::vector<int> quadratic_indptr = {0}, quadratic_variable_1s, quadratic_variable_2s;
+	std::vector<double> quadratic_coefficients;
+	for (int i = 0; i < Q; i++)
+	{
+		for (int k = quadratic.diag_intervals[i]; k < quadratic.diag_intervals[i + 1]; k++)
+		{
+			quadratic_variable_1s.push_back(quadratic.diag_indices[k]);
+			quadratic_variable_2s.push_back(quadratic.diag_indices[k]);
+			quadratic_coefficients.push_back(quadratic.diag_coefs[k]);
+		}
+		for (int k = quadratic.offdiag_intervals[i]; k < quadratic.offdiag_intervals[i + 1]; k++)
+		{
+			quadratic_variable_1s.push_back(quadratic.offdiag_rows[k]);
+			quadratic_variable_2s.push_back(quadratic.offdiag_cols[k]);
+			quadratic_coefficients.push_back(quadratic.offdiag_coefs[k]);
+		}
+		quadratic_indptr.push_back(quadratic_coefficients.size());
+	}
+	std::vector<double> quadratic_lbs = m_quadratic_con_lb;
+	std::vector<double> quadratic_ubs = m_quadratic_con_ub;
+	for (size_t k = 0; k < quadratic.linear_constant_indices.size(); k++)
+	{
+		auto i = quadratic.linear_constant_indices[k];
+		quadratic_lbs[i] -= quadratic.linear_constant_values[k];
+		quadratic_ubs[i] -= quadratic.linear_constant_values[k];
+	}
+
+	std::optional<ScalarQuadraticFunction> objective;
+	if (m_linear_obj_evaluator)
+	{
+		auto &evaluator = m_linear_obj_evaluator.value();
+		ScalarAffineFunction affine(evaluator.coefs, evaluator.indices);
+		if (!evaluator.constant_values.empty())
+		{
+			affine.constant = evaluator.constant_values[0];
+		}
+		objective = ScalarQuadraticFunction({}, {}, {}, affine);
+	}
+	else if (m_quadratic_obj_evaluator)
+	{
+		auto &evaluator = m_quadratic_obj_evaluator.value();
+		ScalarQuadraticFunction f;
+		f.variable_1s = evaluator.diag_indices;
+		f.variable_2s = evaluator.diag_indices;
+		f.coefficients = evaluator.diag_coefs;
+		f.variable_1s.insert(f.variable_1s.end(), evaluator.offdiag_rows.begin(),
+		                     evaluator.offdiag_rows.end());
+		f.variable_2s.insert(f.variable_2s.end(), evaluator.offdiag_cols.begin(),
+		                     evaluator.offdiag_cols.end());
+		f.coefficients.insert(f.coefficients.end(), evaluator.offdiag_coefs.begin(),
+		                      evaluator.offdiag_coefs.end());
+		ScalarAffineFunction affine(evaluator.linear_coefs, evaluator.linear_indices);
+		if (!evaluator.linear_constant_values.empty())
+		{
+			affine.constant = evaluator.linear_constant_values[0];
+		}
+		f.affine_part = affine;
+		objective = f;
+	}
+
+	ModelWriterInput input;
+	input.n_variables = n_variables;
+	input.variable_lbs = m_var_lb.data();
+	input.variable_ubs = m_var_ub.data();
+
+	input.n_linear_constraints = linear.n_constraints;
+	input.linear_indptr = linear.constraint_intervals.data();
+	input.linear_variables = linear.indices.data();
+	input.linear_coefficients = linear.coefs.data();
+	input.linear_lbs = linear_lbs.data();
+	input.linear_ubs = linear_ubs.data();
+
+	input.n_quadratic_constraints = Q;
+	input.quadratic_indptr = quadratic_indptr.data();
+	input.quadratic_variable_1s = quadratic_variable_1s.data();
+	input.quadratic_variable_2s = quadratic_variable_2s.data();
+	input.quadratic_coefficients = quadratic_coefficients.data();
+	input.quadratic_lin_indptr = quadratic.linear_intervals.data();
+	input.quadratic_lin_variables = quadratic.linear_indices.data();
+	input.quadratic_lin_coefficients = quadratic.linear_coefs.data();
+	input.quadratic_lbs = quadratic_lbs.data();
+	input.quadratic_ubs = quadratic_ubs.data();
+
+	if (objective)
+	{
+		input.objective = &objective.value();
+	}
+
+	write_model(input, filename);
 }
 
 void IpoptModel::set_raw_option_int(const std::string &name, int value)
@@ -809,4 +1515,20 @@ void IpoptModel::set_raw_option_double(const std::string &name, double value)
 void IpoptModel::set_raw_option_string(const std::string &name, const std::string &value)
 {
 	m_options_str[name] = value;
+
+	if (name == "hessian_approximation")
+	{
+		bool limited_memory = value == "limited-memory";
+		if (m_limited_memory_hessian != limited_memory)
+		{
+			m_limited_memory_hessian = limited_memory;
+			// the number of nonzeros in Hessian passed to Ipopt changes
+			m_structure_dirty = true;
+		}
+	}
+}
+
+bool IpoptModel::is_limited_memory_hessian() const
+{
+	return m_limited_memory_hessian;
 }
@@ -6,11 +6,13 @@
 namespace nb = nanobind;
 
 #include "pyoptinterface/ipopt_model.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
 
 NB_MODULE(ipopt_model_ext, m)
 {
 	m.import_("pyoptinterface._src.core_ext");
 	m.import_("pyoptinterface._src.nleval_ext");
+	m.import_("pyoptinterface._src.nlexpr_ext");
 
 	m.def("is_library_loaded", &ipopt::is_library_loaded);
 	m.def("load_library", &ipopt::load_library);
@@ -39,22 +41,72 @@ NB_MODULE(ipopt_model_ext, m)
 	    .value("Insufficient_Memory", ApplicationReturnStatus::Insufficient_Memory)
 	    .value("Internal_Error", ApplicationReturnStatus::Internal_Error);
 
+	nb::class_<IpoptTimer>(m, "IpoptTimer")
+	    .def(nb::init<>())
+	    .def_rw("calls", &IpoptTimer::calls)
+	    .def_rw("seconds", &IpoptTimer::seconds);
+
+	nb::class_<IpoptCallbackProfile>(m, "IpoptCallbackProfile")
+	    .def_ro("total", &IpoptCallbackProfile::total)
+	    .def_ro("linear_seconds", &IpoptCallbackProfile::linear_seconds)
+	    .def_ro("quadratic_seconds", &IpoptCallbackProfile::quadratic_seconds)
+	    .def_ro("nonlinear_seconds", &IpoptCallbackProfile::nonlinear_seconds);
+
+	nb::class_<IpoptProfile>(m, "IpoptProfile")
+	    .def_ro("eval_f", &IpoptProfile::eval_f)
+	    .def_ro("eval_grad_f", &IpoptProfile::eval_grad_f)
+	    .def_ro("eval_g", &IpoptProfile::eval_g)
+	    .def_ro("eval_jac_g", &IpoptProfile::eval_jac_g)
+	    .def_ro("eval_h", &IpoptProfile::eval_h)
+	    .def_ro("analyze_structure", &IpoptProfile::analyze_structure)
+	    .def_ro("update_bounds", &IpoptProfile::update_bounds)
+	    .def_ro("ipopt_solve", &IpoptProfile::ipopt_solve)
+	    .def_ro("cppad_autodiff", &IpoptProfile::cppad_autodiff)
+	    .def_ro("codegen", &IpoptProfile::codegen)
+	    .def_ro("jit_compile", &IpoptProfile::jit_compile);
+
 	nb::class_<IpoptModel>(m, "RawModel")
 	    .def(nb::init<>())
 	    .def("close", &IpoptModel::close)
 	    .def_ro("m_status", &IpoptModel::m_status)
 	    .def_rw("m_is_dirty", &IpoptModel::m_is_dirty)
+	    .def_ro("profile", &IpoptModel::m_profile)
+	    .def("reset_profile", &IpoptModel::reset_profile)
 	    .def("add_variable", &IpoptModel::add_variable, nb::arg("lb") = -INFINITY,
 	         nb::arg("ub") = INFINITY, nb::arg("start") = 0.0, nb::arg("name") = "")
+	    .def(
+	        "_add_variables",
+	        [](IpoptModel &model, int N, const std::optional<DoubleArrayT> &lb,
+	           const std::optional<DoubleArrayT> &ub, const std::optional<DoubleArrayT> &start) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer, start_buffer;
+		        return model.add_variables(N, array_or_fill(lb, N, -INFINITY, lb_buffer, "lb"),
+		                                   array_or_fill(ub, N, INFINITY, ub_buffer, "ub"),
+		                                   array_or_fill(start, N, 0.0, start_buffer, "start"));
+	        },
+	        nb::arg("N"), nb::arg("lb") = nb::none(), nb::arg("ub") = nb::none(),
+	        nb::arg("start") = nb::none())
 	    .def("get_variable_lb", &IpoptModel::get_variable_lb)
 	    .def("get_variable_ub", &IpoptModel::get_variable_ub)
 	    .def("set_variable_lb", &IpoptModel::set_variable_lb)
 	    .def("set_variable_ub", &IpoptModel::set_variable_ub)
-	    .def("set_variable_bounds", &IpoptModel::set_variable_bounds, nb::arg("variable"),
+	    .def("set_variable_bounds",
+	         nb::overload_cast<const VariableIndex &, double, double>(
+	             &IpoptModel::set_variable_bounds),
+	         nb::arg("variable"), nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_array<IpoptModel>, nb::arg("variables"),
 	         nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_list<IpoptModel>, nb::arg("variables"),
+	         nb::arg("lb"), nb::arg("ub"))
+
+	    .def("add_parameter", &IpoptModel::add_parameter, nb::arg("value") = 0.0)
+	    .def("set_parameter", &IpoptModel::set_parameter, nb::arg("parameter"), nb::arg("value"))
+	    .def("get_parameter", &IpoptModel::get_parameter)
 
 	    .def("get_variable_start", &IpoptModel::get_variable_start)
 	    .def("set_variable_start", &IpoptModel::set_variable_start)
+	    .def("set_variable_bound_dual_start", &IpoptModel::set_variable_bound_dual_start,
+	         nb::arg("variable"), nb::arg("lb_dual"), nb::arg("ub_dual"))
 
 	    .def("get_variable_name", &IpoptModel::get_variable_name)
 	    .def("set_variable_name", &IpoptModel::set_variable_name)
@@ -65,6 +117,9 @@ NB_MODULE(ipopt_model_ext, m)
 	    .def("get_value",
 	         nb::overload_cast<const ScalarQuadraticFunction &>(&IpoptModel::get_expression_value))
 	    .def("get_value", nb::overload_cast<const ExprBuilder &>(&IpoptModel::get_expression_value))
+	    .def("get_values", &get_variable_values_array<IpoptModel>, nb::arg("variables"))
+	    .def("get_values", &get_variable_values_list<IpoptModel>, nb::arg("variables"))
+	    .def("get_values", &get_expression_values_array<IpoptModel>, nb::arg("exprs"))
 
 	    .def("pprint", &IpoptModel::pprint_variable)
 	    .def("pprint",
@@ -80,6 +135,8 @@ NB_MODULE(ipopt_model_ext, m)
 	    .def("get_obj_value", &IpoptModel::get_obj_value)
 	    .def("get_constraint_primal", &IpoptModel::get_constraint_primal)
 	    .def("get_constraint_dual", &IpoptModel::get_constraint_dual)
+	    .def("get_constraint_dual_start", &IpoptModel::get_constraint_dual_start)
+	    .def("set_constraint_dual_start", &IpoptModel::set_constraint_dual_start)
 
 	    .def("_add_linear_constraint",
 	         nb::overload_cast<const ScalarAffineFunction &, ConstraintSense, CoeffT, const char *>(
@@ -97,6 +154,9 @@ NB_MODULE(ipopt_model_ext, m)
 	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
 	    .def("_add_linear_constraint", &IpoptModel::add_linear_interval_constraint_from_expr,
 	         nb::arg("expr"), nb::arg("interval"), nb::arg("name") = "")
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<IpoptModel>,
+	         nb::arg("indptr"), nb::arg("variables"), nb::arg("coefficients"), nb::arg("sense"),
+	         nb::arg("rhs"))
 
 	    .def("_add_quadratic_constraint",
 	         nb::overload_cast<const ScalarQuadraticFunction &, ConstraintSense, CoeffT,
@@ -150,8 +210,16 @@ NB_MODULE(ipopt_model_ext, m)
 	    .def("_optimize", &IpoptModel::optimize, nb::call_guard<nb::gil_scoped_release>())
 
 	    .def("load_current_solution", &IpoptModel::load_current_solution)
+	    .def("write", &IpoptModel::write, nb::arg("filename"))
 
 	    .def("set_raw_option_int", &IpoptModel::set_raw_option_int)
 	    .def("set_raw_option_double", &IpoptModel::set_raw_option_double)
-	    .def("set_raw_option_string", &IpoptModel::set_raw_option_string);
+	    .def("set_raw_option_string", &IpoptModel::set_raw_option_string)
+	    .def("is_limited_memory_hessian", &IpoptModel::is_limited_memory_hessian)
+
+	    .def("set_nl_eval_threads", &IpoptModel::set_nl_eval_threads, nb::arg("n_threads"))
+	    .def("get_nl_eval_threads", &IpoptModel::get_nl_eval_threads)
+	    .def("set_sorted_hessian_assembly", &IpoptModel::set_sorted_hessian_assembly,
+	         nb::arg("enable"))
+	    .def("get_sorted_hessian_assembly", &IpoptModel::get_sorted_hessian_assembly);
 }
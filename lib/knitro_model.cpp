@@ -209,6 +209,49 @@ VariableIndex KNITROModel::add_variable(VariableDomain domain, double lb, double
 	return variable;
 }
 
+VariableIndex KNITROModel::add_variables(int N, VariableDomain domain, const double *lb,
+                                         const double *ub)
+{
+	if (N == 0)
+	{
+		return VariableIndex(m_n_vars);
+	}
+
+	std::vector<KNINT> indexVars(N);
+	int error = knitro::KN_add_vars(m_kc.get(), N, indexVars.data());
+	_check_error(error);
+
+	VariableIndex variable(indexVars[0]);
+
+	int var_type = knitro_var_type(domain);
+	std::vector<int> var_types(N, var_type);
+	error = knitro::KN_set_var_types(m_kc.get(), N, indexVars.data(), var_types.data());
+	_check_error(error);
+
+	std::vector<double> lbs, ubs;
+	if (var_type == KN_VARTYPE_BINARY)
+	{
+		lbs.resize(N);
+		ubs.resize(N);
+		for (int i = 0; i < N; i++)
+		{
+			lbs[i] = (lb[i] < 0.0) ? 0.0 : lb[i];
+			ubs[i] = (ub[i] > 1.0) ? 1.0 : ub[i];
+		}
+		lb = lbs.data();
+		ub = ubs.data();
+	}
+	error = knitro::KN_set_var_lobnds(m_kc.get(), N, indexVars.data(), lb);
+	_check_error(error);
+	error = knitro::KN_set_var_upbnds(m_kc.get(), N, indexVars.data(), ub);
+	_check_error(error);
+
+	m_n_vars += N;
+	_mark_dirty();
+
+	return variable;
+}
+
 double KNITROModel::get_variable_lb(const VariableIndex &variable) const
 {
 	KNINT indexVar = _variable_index(variable);
@@ -239,6 +282,17 @@ void KNITROModel::set_variable_bounds(const VariableIndex &variable, double lb,
 	set_variable_ub(variable, ub);
 }
 
+void KNITROModel::set_variable_bounds(int N, const int *variables, const double *lb,
+                                      const double *ub)
+{
+	std::vector<KNINT> indexVars(variables, variables + N);
+	int error;
+	error = knitro::KN_set_var_lobnds(m_kc.get(), N, indexVars.data(), lb);
+	_check_error(error);
+	error = knitro::KN_set_var_upbnds(m_kc.get(), N, indexVars.data(), ub);
+	_check_error(error);
+}
+
 double KNITROModel::get_variable_value(const VariableIndex &variable) const
 {
 	_check_dirty();
@@ -246,6 +300,18 @@ double KNITROModel::get_variable_value(const VariableIndex &variable) const
 	return _get_value<KNINT, double>(knitro::KN_get_var_primal_value, indexVar);
 }
 
+void KNITROModel::get_variable_values(int N, const int *variables, double *values) const
+{
+	_check_dirty();
+	std::vector<KNINT> indexVars(N);
+	for (int i = 0; i < N; i++)
+	{
+		indexVars[i] = _variable_index(variables[i]);
+	}
+	int error = knitro::KN_get_var_primal_values(m_kc.get(), N, indexVars.data(), values);
+	_check_error(error);
+}
+
 void KNITROModel::set_variable_start(const VariableIndex &variable, double start)
 {
 	KNINT indexVar = _variable_index(variable);
@@ -340,6 +406,61 @@ ConstraintIndex KNITROModel::add_linear_constraint(const ScalarAffineFunction &f
 	return _add_constraint_impl(ConstraintType::Linear, interval, name, setter);
 }
 
+ConstraintIndex KNITROModel::add_linear_constraints(int M, const int *indptr, const int *variables,
+                                                    const double *coefficients,
+                                                    ConstraintSense sense, const double *rhs)
+{
+	CSRMatrixPtrForm<KNLONG, KNINT, double> ptr_form;
+	ptr_form.make(this, M, indptr, variables, coefficients);
+
+	if (M == 0)
+	{
+		return ConstraintIndex(ConstraintType::Linear, get_num_cons());
+	}
+
+	std::vector<KNINT> indexCons(M);
+	int error = knitro::KN_add_cons(m_kc.get(), M, indexCons.data());
+	_check_error(error);
+
+	ConstraintIndex constraint(ConstraintType::Linear, indexCons[0]);
+
+	std::vector<double> lbs(M), ubs(M);
+	for (int i = 0; i < M; i++)
+	{
+		std::tie(lbs[i], ubs[i]) = _sense_to_interval(sense, rhs[i]);
+	}
+	error = knitro::KN_set_con_lobnds(m_kc.get(), M, indexCons.data(), lbs.data());
+	_check_error(error);
+	error = knitro::KN_set_con_upbnds(m_kc.get(), M, indexCons.data(), ubs.data());
+	_check_error(error);
+
+	KNLONG nnz = ptr_form.numnz;
+	if (nnz > 0)
+	{
+		// the constraint of every nonzero
+		std::vector<KNINT> nzCons(nnz);
+		for (int i = 0; i < M; i++)
+		{
+			std::fill(nzCons.begin() + ptr_form.begin[i], nzCons.begin() + ptr_form.begin[i + 1],
+			          indexCons[i]);
+		}
+		error = knitro::KN_add_con_linear_struct(m_kc.get(), nnz, nzCons.data(), ptr_form.index,
+		                                         ptr_form.value);
+		_check_error(error);
+	}
+
+	for (int i = 0; i < M; i++)
+	{
+		m_con_sense_flags[indexCons[i]] = CON_UPBND;
+		_update_con_sense_flags(ConstraintIndex(ConstraintType::Linear, indexCons[i]), sense);
+	}
+	m_n_cons_map[ConstraintType::Linear] += M;
+
+	m_is_dirty = true;
+
+	return constraint;
+}
+
 ConstraintIndex KNITROModel::add_quadratic_constraint(const ScalarQuadraticFunction &function,
                                                       ConstraintSense sense, double rhs,
                                                       const char *name)
@@ -386,6 +507,19 @@ ConstraintIndex KNITROModel::add_single_nl_constraint(ExpressionGraph &graph,
                                                       const std::tuple<double, double> &interval,
                                                       const char *name)
 {
+	int graph_index = _grouped_graph_index(graph);
+	if (graph_index >= 0)
+	{
+		graph.add_constraint_output(result);
+		int rank = (int)graph.m_constraint_outputs.size() - 1;
+		auto setter = [this, graph_index, rank](const ConstraintIndex &constraint) {
+			m_pending_grouped_evaluator->constraint_outputs.push_back(
+			    GroupedCallbackEvaluator::ConstraintOutput{
+			        .graph = graph_index, .rank = rank, .indexCon = _constraint_index(constraint)});
+		};
+		return _add_constraint_impl(ConstraintType::NL, interval, name, setter);
+	}
+
 	_add_graph(graph);
 	graph.add_constraint_output(result);
 	size_t i = graph.m_constraint_outputs.size() - 1;
@@ -593,6 +727,44 @@ void KNITROModel::set_normalized_rhs(const ConstraintIndex &constraint, double r
 	_mark_dirty();
 }
 
+void KNITROModel::set_normalized_rhs(int N, const int *constraints, const double *values)
+{
+	std::vector<KNINT> lb_cons, ub_cons;
+	std::vector<double> lb_values, ub_values;
+	for (int i = 0; i < N; i++)
+	{
+		KNINT indexCon = constraints[i];
+		auto it = m_con_sense_flags.find(indexCon);
+		uint8_t flag = (it != m_con_sense_flags.end()) ? it->second : 0;
+		if (flag & CON_LOBND)
+		{
+			lb_cons.push_back(indexCon);
+			lb_values.push_back(values[i]);
+		}
+		if (flag & CON_UPBND)
+		{
+			ub_cons.push_back(indexCon);
+			ub_values.push_back(values[i]);
+		}
+	}
+
+	int error;
+	if (!lb_cons.empty())
+	{
+		error = knitro::KN_set_con_lobnds(m_kc.get(), lb_cons.size(), lb_cons.data(),
+		                                  lb_values.data());
+		_check_error(error);
+	}
+	if (!ub_cons.empty())
+	{
+		error = knitro::KN_set_con_upbnds(m_kc.get(), ub_cons.size(), ub_cons.data(),
+		                                  ub_values.data());
+		_check_error(error);
+	}
+
+	_mark_dirty();
+}
+
 double KNITROModel::get_normalized_rhs(const ConstraintIndex &constraint) const
 {
 	KNINT indexCon = _constraint_index(constraint);
@@ -624,6 +796,19 @@ void KNITROModel::set_normalized_coefficient(const ConstraintIndex &constraint,
 	_mark_dirty();
 }
 
+void KNITROModel::set_normalized_coefficients(int N, const int *constraints, const int *variables,
+                                              const double *values)
+{
+	std::vector<KNINT> indexCons(constraints, constraints + N);
+	std::vector<KNINT> indexVars(variables, variables + N);
+
+	_update();
+	int error =
+	    knitro::KN_chg_con_linear_struct(m_kc.get(), N, indexCons.data(), indexVars.data(), values);
+	_check_error(error);
+	_mark_dirty();
+}
+
 void KNITROModel::_set_linear_constraint(const ConstraintIndex &constraint,
                                          const ScalarAffineFunction &function)
 {
@@ -721,8 +906,26 @@ void KNITROModel::set_objective_coefficient(const VariableIndex &variable, doubl
 	_mark_dirty();
 }
 
+void KNITROModel::set_objective_coefficients(int N, const int *variables, const double *values)
+{
+	std::vector<KNINT> indexVars(variables, variables + N);
+
+	_update();
+	int error = knitro::KN_chg_obj_linear_struct(m_kc.get(), N, indexVars.data(), values);
+	_check_error(error);
+	_mark_dirty();
+}
+
 void KNITROModel::add_single_nl_objective(ExpressionGraph &graph, const ExpressionHandle &result)
 {
+	if (_grouped_graph_index(graph) >= 0)
+	{
+		graph.add_objective_output(result);
+		m_obj_flag |= OBJ_NONLINEAR;
+		_mark_dirty();
+		return;
+	}
+
 	_add_graph(graph);
 	graph.add_objective_output(result);
 	size_t i = graph.m_objective_outputs.size() - 1;
@@ -777,6 +980,14 @@ void KNITROModel::_reset_objective()
 		{
 			outputs.objective_outputs.clear();
 		}
+		// pending grouped graphs are not finalized yet, so their objective outputs are dropped
+		if (m_pending_grouped_evaluator)
+		{
+			for (auto *graph : m_pending_grouped_evaluator->graphs)
+			{
+				graph->m_objective_outputs.clear();
+			}
+		}
 	}
 	m_obj_flag = 0;
 	_update();
@@ -954,6 +1165,340 @@ void KNITROModel::_add_pending_callbacks()
 	m_has_pending_callbacks = false;
 }
 
+bool GroupedCallbackEvaluator::has_constraints() const
+{
+	return !constraint_outputs.empty();
+}
+
+bool GroupedCallbackEvaluator::has_objective() const
+{
+	return !evaluator.objective_groups.empty();
+}
+
+void GroupedCallbackEvaluator::check_compiled() const
+{
+	bool finalized =
+	    n_finalized_graphs == graphs.size() &&
+	    evaluator.constraint_graph_hashes.n_hashes_since_last_aggregation ==
+	        evaluator.constraint_graph_hashes.hashes.size() &&
+	    evaluator.objective_graph_hashes.n_hashes_since_last_aggregation ==
+	        evaluator.objective_graph_hashes.hashes.size();
+	bool compiled = finalized;
+	for (const auto &group : evaluator.constraint_groups)
+	{
+		compiled = compiled && group.autodiff_evaluator.f_eval.p != nullptr;
+	}
+	for (const auto &group : evaluator.objective_groups)
+	{
+		compiled = compiled && group.autodiff_evaluator.f_eval.p != nullptr;
+	}
+	if (!compiled)
+	{
+		throw std::runtime_error(
+		    "Grouped nonlinear functions must be compiled before the model is solved");
+	}
+}
+
+void GroupedCallbackEvaluator::analyze_structure(CallbackPattern<KNINT> &constraint_pattern,
+                                                 CallbackPattern<KNINT> &objective_pattern)
+{
+	evaluator.calculate_constraint_graph_instances_offset();
+	evaluator.pack_group_inputs();
+
+	// the outputs of evaluator are ordered by group, map them back to KNITRO constraints
+	indexCons.resize(constraint_outputs.size());
+	for (const auto &output : constraint_outputs)
+	{
+		auto index = evaluator.constraint_indices_offsets[output.graph] + output.rank;
+		indexCons[index] = output.indexCon;
+	}
+	constraint_pattern.indexCons = indexCons;
+
+	size_t jacobian_nnz = 0;
+	std::vector<int> jacobian_rows, jacobian_cols;
+	evaluator.analyze_constraints_jacobian_structure(0, jacobian_nnz, jacobian_rows,
+	                                                 jacobian_cols);
+	constraint_pattern.jacIndexCons.resize(jacobian_nnz);
+	for (size_t k = 0; k < jacobian_nnz; k++)
+	{
+		constraint_pattern.jacIndexCons[k] = indexCons[jacobian_rows[k]];
+	}
+	constraint_pattern.jacIndexVars = std::move(jacobian_cols);
+
+	Hashmap<std::tuple<int, int>, int> hessian_index_map;
+	evaluator.analyze_constraints_hessian_structure(
+	    constraint_hessian_nnz, constraint_pattern.hessIndexVars1,
+	    constraint_pattern.hessIndexVars2, hessian_index_map, HessianSparsityType::Upper);
+
+	Hashmap<int, int> sparse_gradient_map;
+	evaluator.analyze_objective_gradient_structure(objective_pattern.objGradIndexVars,
+	                                               sparse_gradient_map);
+	objective_gradient_nnz = objective_pattern.objGradIndexVars.size();
+
+	hessian_index_map = {};
+	evaluator.analyze_objective_hessian_structure(
+	    objective_hessian_nnz, objective_pattern.hessIndexVars1, objective_pattern.hessIndexVars2,
+	    hessian_index_map, HessianSparsityType::Upper);
+}
+
+void GroupedCallbackEvaluator::eval_constraints(const double *x, double *c) const
+{
+	evaluator.eval_constraints(x, c);
+}
+
+void GroupedCallbackEvaluator::eval_constraints_jacobian(const double *x, double *jac) const
+{
+	evaluator.eval_constraints_jacobian(x, jac);
+}
+
+void GroupedCallbackEvaluator::eval_constraints_hessian(const double *x, const double *req_lambda,
+                                                        double *hess) const
+{
+	// multipliers of indexCons, gathered from the multipliers of all constraints
+	std::vector<double> lambda(indexCons.size());
+	for (size_t i = 0; i < indexCons.size(); i++)
+	{
+		lambda[i] = req_lambda[indexCons[i]];
+	}
+	std::fill(hess, hess + constraint_hessian_nnz, 0.0);
+
+	const double *w = lambda.data();
+	for (const auto &group : evaluator.constraint_groups)
+	{
+		auto &structure = group.autodiff_structure;
+		int n_instances = group.instance_indices.size();
+		if (structure.has_hessian)
+		{
+			evaluator.eval_constraint_group_hessian(group, 0, n_instances, x, w, hess,
+			                                        group.hessian_indices.data());
+		}
+		w += structure.ny * n_instances;
+	}
+}
+
+double GroupedCallbackEvaluator::eval_objective(const double *x) const
+{
+	return evaluator.eval_objective(x);
+}
+
+void GroupedCallbackEvaluator::eval_objective_gradient(const double *x, double *grad) const
+{
+	std::fill(grad, grad + objective_gradient_nnz, 0.0);
+	evaluator.eval_objective_gradient(x, grad);
+}
+
+void GroupedCallbackEvaluator::eval_objective_hessian(const double *x, const double *sigma,
+                                                      double *hess) const
+{
+	std::fill(hess, hess + objective_hessian_nnz, 0.0);
+	for (const auto &group : evaluator.objective_groups)
+	{
+		if (!group.autodiff_structure.has_hessian)
+		{
+			continue;
+		}
+		evaluator.eval_objective_group_hessian(group, 0, group.instance_indices.size(), x, sigma,
+		                                       hess, group.hessian_indices.data());
+	}
+}
+
+GroupedCallbackEvaluator &KNITROModel::_pending_grouped_evaluator()
+{
+	if (!m_pending_grouped_evaluator)
+	{
+		m_pending_grouped_evaluator = std::make_unique<GroupedCallbackEvaluator>();
+	}
+	return *m_pending_grouped_evaluator;
+}
+
+int KNITROModel::_grouped_graph_index(const ExpressionGraph &graph) const
+{
+	if (!m_pending_grouped_evaluator)
+	{
+		return -1;
+	}
+	auto &graph_indices = m_pending_grouped_evaluator->graph_indices;
+	auto it = graph_indices.find(&graph);
+	return it != graph_indices.end() ? it->second : -1;
+}
+
+int KNITROModel::add_graph_index(ExpressionGraph &graph)
+{
+	int graph_index = _grouped_graph_index(graph);
+	if (graph_index >= 0)
+	{
+		return graph_index;
+	}
+	// all outputs of a graph instance are evaluated in the batch it is registered to
+	if (graph.has_constraint_output() || graph.has_objective_output())
+	{
+		throw std::runtime_error(
+		    "Graph that already has outputs in the model cannot be registered for grouping");
+	}
+	auto &grouped = _pending_grouped_evaluator();
+	graph_index = grouped.evaluator.add_graph_instance();
+	grouped.graph_indices.emplace(&graph, graph_index);
+	grouped.graphs.push_back(&graph);
+	return graph_index;
+}
+
+void KNITROModel::finalize_graph_instance(size_t graph_index, ExpressionGraph &graph)
+{
+	if (!graph.m_parameters.empty())
+	{
+		throw std::runtime_error("KNITRO does not support parameters in nonlinear expressions");
+	}
+	// graphs that differ only in the order of commutative operands are grouped together
+	graph.canonicalize();
+	auto &grouped = _pending_grouped_evaluator();
+	grouped.evaluator.finalize_graph_instance(graph_index, graph);
+	grouped.n_finalized_graphs += 1;
+}
+
+int KNITROModel::aggregate_nl_constraint_groups()
+{
+	return _pending_grouped_evaluator().evaluator.aggregate_constraint_groups();
+}
+
+int KNITROModel::get_nl_constraint_group_representative(int group_index) const
+{
+	if (!m_pending_grouped_evaluator)
+	{
+		throw std::runtime_error("No graph is registered for grouping");
+	}
+	return m_pending_grouped_evaluator->evaluator.get_constraint_group_representative(group_index);
+}
+
+int KNITROModel::aggregate_nl_objective_groups()
+{
+	return _pending_grouped_evaluator().evaluator.aggregate_objective_groups();
+}
+
+int KNITROModel::get_nl_objective_group_representative(int group_index) const
+{
+	if (!m_pending_grouped_evaluator)
+	{
+		throw std::runtime_error("No graph is registered for grouping");
+	}
+	return m_pending_grouped_evaluator->evaluator.get_objective_group_representative(group_index);
+}
+
+void KNITROModel::assign_nl_constraint_group_autodiff_structure(
+    int group_index, const AutodiffSymbolicStructure &structure)
+{
+	_pending_grouped_evaluator().evaluator.assign_constraint_group_autodiff_structure(group_index,
+	                                                                                  structure);
+}
+
+void KNITROModel::assign_nl_constraint_group_autodiff_evaluator(
+    int group_index, const ConstraintAutodiffEvaluator &evaluator)
+{
+	_pending_grouped_evaluator().evaluator.assign_constraint_group_autodiff_evaluator(group_index,
+	                                                                                  evaluator);
+}
+
+void KNITROModel::assign_nl_objective_group_autodiff_structure(
+    int group_index, const AutodiffSymbolicStructure &structure)
+{
+	_pending_grouped_evaluator().evaluator.assign_objective_group_autodiff_structure(group_index,
+	                                                                                 structure);
+}
+
+void KNITROModel::assign_nl_objective_group_autodiff_evaluator(
+    int group_index, const ObjectiveAutodiffEvaluator &evaluator)
+{
+	_pending_grouped_evaluator().evaluator.assign_objective_group_autodiff_evaluator(group_index,
+	                                                                                 evaluator);
+}
+
+void KNITROModel::_add_grouped_callbacks()
+{
+	if (!m_pending_grouped_evaluator)
+	{
+		return;
+	}
+
+	auto *grouped = m_pending_grouped_evaluator.get();
+	grouped->check_compiled();
+
+	CallbackPattern<KNINT> constraint_pattern, objective_pattern;
+	grouped->analyze_structure(constraint_pattern, objective_pattern);
+
+	int error;
+	if (grouped->has_constraints())
+	{
+		auto f = [](KN_context *, CB_context *cb, KN_eval_request *req, KN_eval_result *res,
+		            void *data) -> int {
+			auto grouped = static_cast<GroupedCallbackEvaluator *>(data);
+			grouped->eval_constraints(req->x, res->c);
+			return 0;
+		};
+		auto g = [](KN_context *, CB_context *cb, KN_eval_request *req, KN_eval_result *res,
+		            void *data) -> int {
+			auto grouped = static_cast<GroupedCallbackEvaluator *>(data);
+			grouped->eval_constraints_jacobian(req->x, res->jac);
+			return 0;
+		};
+		auto h = [](KN_context *, CB_context *cb, KN_eval_request *req, KN_eval_result *res,
+		            void *data) -> int {
+			auto grouped = static_cast<GroupedCallbackEvaluator *>(data);
+			grouped->eval_constraints_hessian(req->x, req->lambda, res->hess);
+			return 0;
+		};
+
+		auto &p = constraint_pattern;
+		CB_context *cb = nullptr;
+		error = knitro::KN_add_eval_callback(m_kc.get(), false, p.indexCons.size(),
+		                                     p.indexCons.data(), f, &cb);
+		_check_error(error);
+		error = knitro::KN_set_cb_user_params(m_kc.get(), cb, grouped);
+		_check_error(error);
+		error = knitro::KN_set_cb_grad(m_kc.get(), cb, 0, nullptr, p.jacIndexCons.size(),
+		                               p.jacIndexCons.data(), p.jacIndexVars.data(), g);
+		_check_error(error);
+		error = knitro::KN_set_cb_hess(m_kc.get(), cb, p.hessIndexVars1.size(),
+		                               p.hessIndexVars1.data(), p.hessIndexVars2.data(), h);
+		_check_error(error);
+	}
+
+	if (grouped->has_objective())
+	{
+		auto f = [](KN_context *, CB_context *cb, KN_eval_request *req, KN_eval_result *res,
+		            void *data) -> int {
+			auto grouped = static_cast<GroupedCallbackEvaluator *>(data);
+			*res->obj = grouped->eval_objective(req->x);
+			return 0;
+		};
+		auto g = [](KN_context *, CB_context *cb, KN_eval_request *req, KN_eval_result *res,
+		            void *data) -> int {
+			auto grouped = static_cast<GroupedCallbackEvaluator *>(data);
+			grouped->eval_objective_gradient(req->x, res->objGrad);
+			return 0;
+		};
+		auto h = [](KN_context *, CB_context *cb, KN_eval_request *req, KN_eval_result *res,
+		            void *data) -> int {
+			auto grouped = static_cast<GroupedCallbackEvaluator *>(data);
+			grouped->eval_objective_hessian(req->x, req->sigma, res->hess);
+			return 0;
+		};
+
+		auto &p = objective_pattern;
+		CB_context *cb = nullptr;
+		error = knitro::KN_add_eval_callback(m_kc.get(), true, 0, nullptr, f, &cb);
+		_check_error(error);
+		error = knitro::KN_set_cb_user_params(m_kc.get(), cb, grouped);
+		_check_error(error);
+		error = knitro::KN_set_cb_grad(m_kc.get(), cb, p.objGradIndexVars.size(),
+		                               p.objGradIndexVars.data(), 0, nullptr, nullptr, g);
+		_check_error(error);
+		error = knitro::KN_set_cb_hess(m_kc.get(), cb, p.hessIndexVars1.size(),
+		                               p.hessIndexVars1.data(), p.hessIndexVars2.data(), h);
+		_check_error(error);
+	}
+
+	m_grouped_evaluators.push_back(std::move(m_pending_grouped_evaluator));
+}
+
 // Solve functions
 void KNITROModel::_update()
 {
@@ -965,6 +1510,7 @@ void KNITROModel::_update()
 void KNITROModel::_pre_solve()
 {
 	_add_pending_callbacks();
+	_add_grouped_callbacks();
 }
 
 void KNITROModel::_solve()
@@ -1088,6 +1634,8 @@ void KNITROModel::_reset_state()
 	m_pending_outputs.clear();
 	m_evaluators.clear();
 	m_has_pending_callbacks = false;
+	m_pending_grouped_evaluator.reset();
+	m_grouped_evaluators.clear();
 	_mark_dirty();
 	m_solve_status = 0;
 }
@@ -1109,6 +1657,12 @@ KNINT KNITROModel::_variable_index(const VariableIndex &variable) const
 	return _get_index(variable);
 }
 
+void KNITROModel::_variable_indices(std::span<const IndexT> variables,
+                                    std::span<KNINT> columns) const
+{
+	std::copy(variables.begin(), variables.end(), columns.begin());
+}
+
 KNINT KNITROModel::_constraint_index(const ConstraintIndex &constraint) const
 {
 	return _get_index(constraint);
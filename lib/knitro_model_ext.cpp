@@ -5,6 +5,8 @@
 #include <nanobind/stl/tuple.h>
 
 #include "pyoptinterface/knitro_model.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
+#include "pyoptinterface/cache_model.hpp"
 
 namespace nb = nanobind;
 
@@ -54,10 +56,21 @@ NB_MODULE(knitro_model_ext, m)
 
 	    // clang-format off
 		BIND_F(get_variable_lb)
+	    .def(
+	        "_add_variables",
+	        [](KNITROModel &model, int N, VariableDomain domain,
+	           const std::optional<DoubleArrayT> &lb, const std::optional<DoubleArrayT> &ub) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer;
+		        return model.add_variables(N, domain,
+		                                   array_or_fill(lb, N, -KN_INFINITY, lb_buffer, "lb"),
+		                                   array_or_fill(ub, N, KN_INFINITY, ub_buffer, "ub"));
+	        },
+	        nb::arg("N"), nb::arg("domain") = VariableDomain::Continuous,
+	        nb::arg("lb") = nb::none(), nb::arg("ub") = nb::none())
 		BIND_F(get_variable_ub)
 		BIND_F(set_variable_lb)
 		BIND_F(set_variable_ub)
-		BIND_F(set_variable_bounds)
 		BIND_F(set_variable_start)
 		BIND_F(get_variable_name)
 		BIND_F(set_variable_name)
@@ -66,6 +79,14 @@ NB_MODULE(knitro_model_ext, m)
 		BIND_F(get_variable_rc)
 		BIND_F(delete_variable)
 	    // clang-format on
+	    .def("set_variable_bounds",
+	         nb::overload_cast<const VariableIndex &, double, double>(
+	             &KNITROModel::set_variable_bounds),
+	         nb::arg("variable"), nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_array<KNITROModel>, nb::arg("variables"),
+	         nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_list<KNITROModel>, nb::arg("variables"),
+	         nb::arg("lb"), nb::arg("ub"))
 
 	    .def("get_value", &KNITROModel::get_variable_value)
 	    .def("get_value",
@@ -74,6 +95,9 @@ NB_MODULE(knitro_model_ext, m)
 	         nb::overload_cast<const ScalarQuadraticFunction &>(&KNITROModel::get_expression_value))
 	    .def("get_value",
 	         nb::overload_cast<const ExprBuilder &>(&KNITROModel::get_expression_value))
+	    .def("get_values", &get_variable_values_array<KNITROModel>, nb::arg("variables"))
+	    .def("get_values", &get_variable_values_list<KNITROModel>, nb::arg("variables"))
+	    .def("get_values", &get_expression_values_array<KNITROModel>, nb::arg("exprs"))
 
 	    .def("pprint", &KNITROModel::pprint_variable)
 	    .def("pprint",
@@ -91,10 +115,19 @@ NB_MODULE(knitro_model_ext, m)
 		BIND_F(get_constraint_name)
 		BIND_F(get_constraint_primal)
 		BIND_F(get_constraint_dual)
-		BIND_F(set_normalized_rhs)
 		BIND_F(get_normalized_rhs)
 		BIND_F(set_normalized_coefficient)
 	    // clang-format on
+	    .def("set_normalized_rhs",
+	         nb::overload_cast<const ConstraintIndex &, double>(&KNITROModel::set_normalized_rhs))
+	    .def("set_normalized_rhs", &set_normalized_rhs_array<KNITROModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_rhs", &set_normalized_rhs_list<KNITROModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_array<KNITROModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_list<KNITROModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
 
 	    .def("_add_linear_constraint",
 	         nb::overload_cast<const ScalarAffineFunction &, ConstraintSense, CoeffT, const char *>(
@@ -112,6 +145,10 @@ NB_MODULE(knitro_model_ext, m)
 	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
 	    .def("_add_linear_constraint", &KNITROModel::add_linear_interval_constraint_from_expr,
 	         nb::arg("expr"), nb::arg("interval"), nb::arg("name") = "")
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<KNITROModel>,
+	         nb::arg("indptr"), nb::arg("variables"), nb::arg("coefficients"), nb::arg("sense"),
+	         nb::arg("rhs"))
+	    .def("load_cache_model", &load_cache_model<KNITROModel>, nb::arg("cache"))
 
 	    .def("_add_quadratic_constraint",
 	         nb::overload_cast<const ScalarQuadraticFunction &, ConstraintSense, CoeffT,
@@ -162,12 +199,33 @@ NB_MODULE(knitro_model_ext, m)
 	    .def("_add_single_nl_objective", &KNITROModel::add_single_nl_objective, nb::arg("graph"),
 	         nb::arg("result"))
 
+	    .def("_add_graph_index", &KNITROModel::add_graph_index, nb::arg("graph"))
+	    .def("_finalize_graph_instance", &KNITROModel::finalize_graph_instance)
+	    .def("_aggregate_nl_constraint_groups", &KNITROModel::aggregate_nl_constraint_groups)
+	    .def("_get_nl_constraint_group_representative",
+	         &KNITROModel::get_nl_constraint_group_representative)
+	    .def("_aggregate_nl_objective_groups", &KNITROModel::aggregate_nl_objective_groups)
+	    .def("_get_nl_objective_group_representative",
+	         &KNITROModel::get_nl_objective_group_representative)
+	    .def("_assign_nl_constraint_group_autodiff_structure",
+	         &KNITROModel::assign_nl_constraint_group_autodiff_structure)
+	    .def("_assign_nl_constraint_group_autodiff_evaluator",
+	         &KNITROModel::assign_nl_constraint_group_autodiff_evaluator)
+	    .def("_assign_nl_objective_group_autodiff_structure",
+	         &KNITROModel::assign_nl_objective_group_autodiff_structure)
+	    .def("_assign_nl_objective_group_autodiff_evaluator",
+	         &KNITROModel::assign_nl_objective_group_autodiff_evaluator)
+
 	    // clang-format off
 		BIND_F(set_objective_coefficient)
 		BIND_F(get_obj_value)
 		BIND_F(set_obj_sense)
 		BIND_F(get_obj_sense)
 	    // clang-format on
+	    .def("set_objective_coefficients", &set_objective_coefficients_array<KNITROModel>,
+	         nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_list<KNITROModel>,
+	         nb::arg("variables"), nb::arg("values"))
 
 	    .def("optimize", &KNITROModel::optimize, nb::call_guard<nb::gil_scoped_release>())
 
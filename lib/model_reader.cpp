@@ -0,0 +1,879 @@
+#include "pyoptinterface/model_reader.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+#include <exception>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+
+#include "fmt/format.h"
+
+namespace
+{
+// the COLUMNS section is only tokenized in parallel if it is larger than this size, and every
+// thread gets at least this size of text
+constexpr size_t PARALLEL_CHUNK_SIZE = 1 << 22;
+
+// values larger than this are regarded as infinity in bounds and right-hand sides
+constexpr double MPS_INFINITY = 1e30;
+
+// row index of the objective and free rows in the COLUMNS section, markers are stored in the
+// entries of COLUMNS with these row indices
+constexpr int OBJECTIVE_ROW = -1;
+constexpr int FREE_ROW = -2;
+constexpr int MARKER_INTORG = -3;
+constexpr int MARKER_INTEND = -4;
+
+constexpr int MAX_TOKENS = 6;
+
+std::string read_file(const std::string &filename)
+{
+	std::FILE *file = std::fopen(filename.c_str(), "rb");
+	if (file == nullptr)
+	{
+		throw std::runtime_error(fmt::format("Cannot open file {}", filename));
+	}
+	std::fseek(file, 0, SEEK_END);
+	auto size = std::ftell(file);
+	std::fseek(file, 0, SEEK_SET);
+
+	// the whole file is read by one call and parsed in place
+	std::string content(size, '\0');
+	auto read = std::fread(content.data(), 1, size, file);
+	std::fclose(file);
+	if (read != size_t(size))
+	{
+		throw std::runtime_error(fmt::format("Failed to read file {}", filename));
+	}
+	return content;
+}
+
+// returns the line starting from pos without line ending and moves pos to the next line
+std::string_view next_line(std::string_view text, size_t &pos)
+{
+	auto end = text.find('\n', pos);
+	if (end == std::string_view::npos)
+	{
+		end = text.size();
+	}
+	auto line = text.substr(pos, end - pos);
+	pos = end + 1;
+	if (!line.empty() && line.back() == '\r')
+	{
+		line.remove_suffix(1);
+	}
+	return line;
+}
+
+bool is_space(char c)
+{
+	return c == ' ' || c == '\t';
+}
+
+// a line starting with a non-space character is a section header
+bool is_header(std::string_view line)
+{
+	return !line.empty() && !is_space(line[0]) && line[0] != '*';
+}
+
+bool is_comment_or_empty(std::string_view line)
+{
+	return line.empty() || line[0] == '*' ||
+	       line.find_first_not_of(" \t") == std::string_view::npos;
+}
+
+int tokenize(std::string_view line, std::string_view *tokens)
+{
+	int n = 0;
+	size_t i = 0;
+	while (i < line.size() && n < MAX_TOKENS)
+	{
+		while (i < line.size() && is_space(line[i]))
+		{
+			i++;
+		}
+		if (i == line.size())
+		{
+			break;
+		}
+		auto begin = i;
+		while (i < line.size() && !is_space(line[i]))
+		{
+			i++;
+		}
+		tokens[n++] = line.substr(begin, i - begin);
+	}
+	// more tokens than any valid line has, only the first MAX_TOKENS are stored
+	if (n == MAX_TOKENS && line.find_first_not_of(" \t", i) != std::string_view::npos)
+	{
+		n++;
+	}
+	return n;
+}
+
+// MPS files are split into tokens by whitespace, so a name with spaces shows up as a line with a
+// wrong number of tokens
+[[noreturn]] void throw_invalid_line(const char *section, std::string_view line)
+{
+	throw std::runtime_error(fmt::format(
+	    "Invalid line in {} section, names with spaces are not supported: {}", section, line));
+}
+
+double parse_number(std::string_view token)
+{
+	// from_chars does not accept a leading plus sign
+	if (!token.empty() && token[0] == '+')
+	{
+		token.remove_prefix(1);
+	}
+	double value;
+	auto [ptr, ec] = std::from_chars(token.data(), token.data() + token.size(), value);
+	if (ec != std::errc() || ptr != token.data() + token.size())
+	{
+		throw std::runtime_error(fmt::format("Invalid number '{}' in MPS file", token));
+	}
+	return value;
+}
+
+double parse_bound(std::string_view token)
+{
+	double value = parse_number(token);
+	if (value >= MPS_INFINITY)
+	{
+		return INFINITY;
+	}
+	if (value <= -MPS_INFINITY)
+	{
+		return -INFINITY;
+	}
+	return value;
+}
+
+bool iequals(std::string_view a, std::string_view b)
+{
+	return a.size() == b.size() && std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+		       return std::toupper((unsigned char)x) == std::toupper((unsigned char)y);
+	       });
+}
+
+struct ColumnEntry
+{
+	std::string_view column;
+	int row;
+	double value;
+};
+
+// tokenizes the lines of COLUMNS section in [begin, end) of text, the rows are looked up in the
+// row map which is only read here
+void tokenize_columns(std::string_view text, size_t begin, size_t end,
+                      const Hashmap<std::string_view, int> &row_map,
+                      std::vector<ColumnEntry> &entries)
+{
+	std::string_view tokens[MAX_TOKENS];
+	auto lookup_row = [&](std::string_view name) {
+		auto it = row_map.find(name);
+		if (it == row_map.end())
+		{
+			throw std::runtime_error(fmt::format("Unknown row {} in COLUMNS section", name));
+		}
+		return it->second;
+	};
+
+	// a line of COLUMNS section is usually longer than 32 bytes
+	entries.reserve(entries.size() + (end - begin) / 32);
+
+	size_t pos = begin;
+	while (pos < end)
+	{
+		auto line = next_line(text, pos);
+		if (is_comment_or_empty(line))
+		{
+			continue;
+		}
+		int n = tokenize(line, tokens);
+		if (n >= 3 && tokens[1] == "'MARKER'")
+		{
+			if (tokens[2] == "'INTORG'")
+			{
+				entries.push_back({tokens[0], MARKER_INTORG, 0.0});
+			}
+			else if (tokens[2] == "'INTEND'")
+			{
+				entries.push_back({tokens[0], MARKER_INTEND, 0.0});
+			}
+			else
+			{
+				throw std::runtime_error(fmt::format("Unknown marker {} in MPS file", tokens[2]));
+			}
+			continue;
+		}
+		if (n != 3 && n != 5)
+		{
+			throw_invalid_line("COLUMNS", line);
+		}
+		for (int k = 1; k < n; k += 2)
+		{
+			entries.push_back({tokens[0], lookup_row(tokens[k]), parse_number(tokens[k + 1])});
+		}
+	}
+}
+
+// splits [begin, end) into chunks at line boundaries and tokenizes them in parallel
+std::vector<std::vector<ColumnEntry>> tokenize_columns_parallel(
+    std::string_view text, size_t begin, size_t end, const Hashmap<std::string_view, int> &row_map,
+    int n_threads)
+{
+	size_t size = end - begin;
+	size_t n_chunks = std::min<size_t>(n_threads, size / PARALLEL_CHUNK_SIZE);
+	n_chunks = std::max<size_t>(n_chunks, 1);
+
+	std::vector<size_t> bounds = {begin};
+	for (size_t i = 1; i < n_chunks; i++)
+	{
+		auto pos = std::max(bounds.back(), begin + size * i / n_chunks);
+		pos = text.find('\n', pos);
+		pos = pos == std::string_view::npos || pos >= end ? end : pos + 1;
+		bounds.push_back(pos);
+	}
+	bounds.push_back(end);
+
+	std::vector<std::vector<ColumnEntry>> chunks(n_chunks);
+	if (n_chunks == 1)
+	{
+		tokenize_columns(text, begin, end, row_map, chunks[0]);
+		return chunks;
+	}
+
+	std::vector<std::exception_ptr> errors(n_chunks);
+	std::vector<std::thread> threads;
+	threads.reserve(n_chunks);
+	for (size_t i = 0; i < n_chunks; i++)
+	{
+		threads.emplace_back([&, i]() {
+			try
+			{
+				tokenize_columns(text, bounds[i], bounds[i + 1], row_map, chunks[i]);
+			}
+			catch (...)
+			{
+				errors[i] = std::current_exception();
+			}
+		});
+	}
+	for (auto &thread : threads)
+	{
+		thread.join();
+	}
+	for (auto &error : errors)
+	{
+		if (error)
+		{
+			std::rethrow_exception(error);
+		}
+	}
+	return chunks;
+}
+
+struct QuadraticEntry
+{
+	int row;
+	int variable_1;
+	int variable_2;
+	double coefficient;
+};
+
+enum class MPSSection
+{
+	None,
+	ObjectiveSense,
+	Rows,
+	Rhs,
+	Ranges,
+	Bounds,
+	QuadraticObjective,
+	QuadraticMatrix,
+	QuadraticConstraint,
+};
+
+} // namespace
+
+ModelFileNames read_mps(CacheModel &model, const std::string &filename, int n_threads)
+{
+	if (model.get_num_variables() > 0 || model.get_num_linear_constraints() > 0 ||
+	    model.get_num_quadratic_constraints() > 0)
+	{
+		throw std::runtime_error("MPS file can only be read into an empty CacheModel");
+	}
+	if (n_threads <= 0)
+	{
+		n_threads = std::max(1u, std::thread::hardware_concurrency());
+	}
+
+	auto content = read_file(filename);
+	std::string_view text(content);
+
+	// rows
+	Hashmap<std::string_view, int> row_map;
+	std::string_view objective_row;
+	std::vector<std::string_view> row_names;
+	std::vector<char> row_types;
+	std::vector<double> row_rhs;
+	std::vector<double> row_ranges;
+
+	// columns
+	Hashmap<std::string_view, int> column_map;
+	std::vector<std::string_view> column_names;
+	std::vector<VariableDomain> domains;
+	std::vector<double> lbs, ubs;
+
+	// coefficients of the constraint matrix in column order
+	std::vector<int> entry_rows, entry_columns;
+	std::vector<double> entry_values;
+
+	Vector<IndexT> objective_variables;
+	Vector<CoeffT> objective_coefficients;
+	double objective_constant = 0.0;
+	// the quadratic terms of objective are coefficients of xi * xj
+	Vector<IndexT> objective_variable_1s, objective_variable_2s;
+	Vector<CoeffT> objective_quadratic_coefficients;
+	std::vector<QuadraticEntry> quadratic_entries;
+	ObjectiveSense sense = ObjectiveSense::Minimize;
+
+	auto lookup_row = [&](std::string_view name, const char *section) {
+		auto it = row_map.find(name);
+		if (it == row_map.end())
+		{
+			throw std::runtime_error(fmt::format("Unknown row {} in {} section", name, section));
+		}
+		return it->second;
+	};
+	auto lookup_column = [&](std::string_view name, const char *section) {
+		auto it = column_map.find(name);
+		if (it == column_map.end())
+		{
+			throw std::runtime_error(
+			    fmt::format("Unknown column {} in {} section", name, section));
+		}
+		return it->second;
+	};
+	auto parse_objective_sense = [&](std::string_view token) {
+		if (iequals(token, "MAX") || iequals(token, "MAXIMIZE"))
+		{
+			sense = ObjectiveSense::Maximize;
+		}
+		else if (iequals(token, "MIN") || iequals(token, "MINIMIZE"))
+		{
+			sense = ObjectiveSense::Minimize;
+		}
+		else
+		{
+			throw std::runtime_error(fmt::format("Unknown objective sense {}", token));
+		}
+	};
+
+	MPSSection section = MPSSection::None;
+	int quadratic_row = -1;
+	bool finished = false;
+	std::string_view tokens[MAX_TOKENS];
+
+	size_t pos = 0;
+	while (pos < text.size() && !finished)
+	{
+		auto line = next_line(text, pos);
+		if (is_comment_or_empty(line))
+		{
+			continue;
+		}
+		int n = tokenize(line, tokens);
+
+		if (is_header(line))
+		{
+			auto name = tokens[0];
+			section = MPSSection::None;
+			if (name == "NAME")
+			{
+			}
+			else if (name == "OBJSENSE")
+			{
+				if (n > 1)
+				{
+					parse_objective_sense(tokens[1]);
+				}
+				else
+				{
+					section = MPSSection::ObjectiveSense;
+				}
+			}
+			else if (name == "ROWS")
+			{
+				section = MPSSection::Rows;
+			}
+			else if (name == "COLUMNS")
+			{
+				// the end of COLUMNS section is the next header
+				auto begin = pos;
+				auto end = pos;
+				while (end < text.size())
+				{
+					auto line_begin = end;
+					auto next = next_line(text, end);
+					if (is_header(next))
+					{
+						end = line_begin;
+						break;
+					}
+				}
+				end = std::min(end, text.size());
+				pos = end;
+
+				auto chunks = tokenize_columns_parallel(text, begin, end, row_map, n_threads);
+
+				bool is_integer = false;
+				std::string_view current_column;
+				int column = -1;
+				for (const auto &chunk : chunks)
+				{
+					for (const auto &entry : chunk)
+					{
+						if (entry.row == MARKER_INTORG || entry.row == MARKER_INTEND)
+						{
+							is_integer = entry.row == MARKER_INTORG;
+							continue;
+						}
+						if (column < 0 || entry.column != current_column)
+						{
+							current_column = entry.column;
+							auto [it, inserted] =
+							    column_map.try_emplace(current_column, (int)column_names.size());
+							column = it->second;
+							if (inserted)
+							{
+								column_names.push_back(current_column);
+								domains.push_back(is_integer ? VariableDomain::Integer
+								                             : VariableDomain::Continuous);
+								lbs.push_back(0.0);
+								ubs.push_back(INFINITY);
+							}
+						}
+						if (entry.row >= 0)
+						{
+							entry_rows.push_back(entry.row);
+							entry_columns.push_back(column);
+							entry_values.push_back(entry.value);
+						}
+						else if (entry.row == OBJECTIVE_ROW)
+						{
+							objective_variables.push_back(column);
+							objective_coefficients.push_back(entry.value);
+						}
+					}
+				}
+			}
+			else if (name == "RHS")
+			{
+				section = MPSSection::Rhs;
+			}
+			else if (name == "RANGES")
+			{
+				section = MPSSection::Ranges;
+			}
+			else if (name == "BOUNDS")
+			{
+				section = MPSSection::Bounds;
+			}
+			else if (name == "QUADOBJ")
+			{
+				section = MPSSection::QuadraticObjective;
+			}
+			else if (name == "QMATRIX")
+			{
+				section = MPSSection::QuadraticMatrix;
+			}
+			else if (name == "QCMATRIX" || name == "QSECTION")
+			{
+				if (n < 2)
+				{
+					throw std::runtime_error("Missing row name of QCMATRIX section");
+				}
+				quadratic_row = lookup_row(tokens[1], "QCMATRIX");
+				if (quadratic_row == OBJECTIVE_ROW)
+				{
+					// QSECTION of the objective is the same as QMATRIX
+					section = MPSSection::QuadraticMatrix;
+				}
+				else if (quadratic_row < 0)
+				{
+					throw std::runtime_error(
+					    fmt::format("Quadratic part of free row {} is not supported", tokens[1]));
+				}
+				else
+				{
+					section = MPSSection::QuadraticConstraint;
+				}
+			}
+			else if (name == "ENDATA")
+			{
+				finished = true;
+			}
+			else
+			{
+				throw std::runtime_error(fmt::format("Unsupported MPS section {}", name));
+			}
+			continue;
+		}
+
+		switch (section)
+		{
+		case MPSSection::ObjectiveSense: {
+			parse_objective_sense(tokens[0]);
+			break;
+		}
+		case MPSSection::Rows: {
+			if (n != 2)
+			{
+				throw_invalid_line("ROWS", line);
+			}
+			char type = std::toupper((unsigned char)tokens[0][0]);
+			auto name = tokens[1];
+			int index;
+			if (type == 'N')
+			{
+				if (objective_row.empty())
+				{
+					objective_row = name;
+					index = OBJECTIVE_ROW;
+				}
+				else
+				{
+					index = FREE_ROW;
+				}
+			}
+			else if (type == 'L' || type == 'G' || type == 'E')
+			{
+				index = row_names.size();
+				row_names.push_back(name);
+				row_types.push_back(type);
+				row_rhs.push_back(0.0);
+				row_ranges.push_back(NAN);
+			}
+			else
+			{
+				throw std::runtime_error(fmt::format("Unknown row type {}", tokens[0]));
+			}
+			if (!row_map.try_emplace(name, index).second)
+			{
+				throw std::runtime_error(fmt::format("Duplicated row {}", name));
+			}
+			break;
+		}
+		case MPSSection::Rhs:
+		case MPSSection::Ranges: {
+			bool is_rhs = section == MPSSection::Rhs;
+			if (n < 2 || n > 5)
+			{
+				throw_invalid_line(is_rhs ? "RHS" : "RANGES", line);
+			}
+			// the name of the RHS or RANGES vector is optional
+			int first = n % 2 == 1 ? 1 : 0;
+			for (int k = first; k + 1 < n; k += 2)
+			{
+				int row = lookup_row(tokens[k], is_rhs ? "RHS" : "RANGES");
+				double value = parse_number(tokens[k + 1]);
+				if (row == OBJECTIVE_ROW)
+				{
+					if (is_rhs)
+					{
+						// the RHS of objective is the negated objective constant
+						objective_constant = -value;
+					}
+				}
+				else if (row >= 0)
+				{
+					if (is_rhs)
+					{
+						row_rhs[row] = value;
+					}
+					else
+					{
+						row_ranges[row] = value;
+					}
+				}
+			}
+			break;
+		}
+		case MPSSection::Bounds: {
+			if (n < 2 || n > 4)
+			{
+				throw_invalid_line("BOUNDS", line);
+			}
+			auto type = tokens[0];
+			bool has_value = !(type == "FR" || type == "MI" || type == "PL" || type == "BV");
+			int column;
+			double value = 0.0;
+			if (has_value)
+			{
+				// the name of the bound vector is optional
+				if (n < 3)
+				{
+					throw_invalid_line("BOUNDS", line);
+				}
+				int k = n >= 4 ? 2 : 1;
+				column = lookup_column(tokens[k], "BOUNDS");
+				value = parse_bound(tokens[k + 1]);
+			}
+			else
+			{
+				if (n > 3)
+				{
+					throw_invalid_line("BOUNDS", line);
+				}
+				int k = n >= 3 && column_map.contains(tokens[2]) ? 2 : 1;
+				column = lookup_column(tokens[k], "BOUNDS");
+			}
+
+			auto &lb = lbs[column];
+			auto &ub = ubs[column];
+			if (type == "UP")
+			{
+				// a negative upper bound without lower bound makes the lower bound -inf
+				if (value < 0.0 && lb == 0.0)
+				{
+					lb = -INFINITY;
+				}
+				ub = value;
+			}
+			else if (type == "LO")
+			{
+				lb = value;
+			}
+			else if (type == "FX")
+			{
+				lb = value;
+				ub = value;
+			}
+			else if (type == "FR")
+			{
+				lb = -INFINITY;
+				ub = INFINITY;
+			}
+			else if (type == "MI")
+			{
+				lb = -INFINITY;
+			}
+			else if (type == "PL")
+			{
+				ub = INFINITY;
+			}
+			else if (type == "BV")
+			{
+				domains[column] = VariableDomain::Binary;
+				lb = 0.0;
+				ub = 1.0;
+			}
+			else if (type == "LI")
+			{
+				domains[column] = VariableDomain::Integer;
+				lb = value;
+			}
+			else if (type == "UI")
+			{
+				domains[column] = VariableDomain::Integer;
+				ub = value;
+			}
+			else if (type == "SC")
+			{
+				domains[column] = VariableDomain::SemiContinuous;
+				ub = value == 0.0 ? INFINITY : value;
+			}
+			else
+			{
+				throw std::runtime_error(fmt::format("Unknown bound type {}", type));
+			}
+			break;
+		}
+		case MPSSection::QuadraticObjective:
+		case MPSSection::QuadraticMatrix:
+		case MPSSection::QuadraticConstraint: {
+			if (n != 3)
+			{
+				throw_invalid_line("quadratic", line);
+			}
+			int x1 = lookup_column(tokens[0], "quadratic");
+			int x2 = lookup_column(tokens[1], "quadratic");
+			double value = parse_number(tokens[2]);
+			// QUADOBJ is the upper triangle of Q in 0.5 x'Qx, QMATRIX is the full matrix of Q in
+			// 0.5 x'Qx and QCMATRIX is the full matrix of Q in x'Qx
+			if (section == MPSSection::QuadraticConstraint)
+			{
+				quadratic_entries.push_back({quadratic_row, x1, x2, value});
+			}
+			else
+			{
+				bool full = section == MPSSection::QuadraticMatrix;
+				objective_variable_1s.push_back(x1);
+				objective_variable_2s.push_back(x2);
+				objective_quadratic_coefficients.push_back(x1 == x2 || full ? 0.5 * value
+				                                                            : value);
+			}
+			break;
+		}
+		default:
+			throw std::runtime_error(fmt::format("Unexpected line in MPS file: {}", line));
+		}
+	}
+
+	// variables
+	int N = column_names.size();
+	model.variable_domains.assign(domains.begin(), domains.end());
+	model.variable_lbs.assign(lbs.begin(), lbs.end());
+	model.variable_ubs.assign(ubs.begin(), ubs.end());
+
+	// transpose the matrix to rows, the variables of each row are in column order
+	int R = row_names.size();
+	std::vector<int> row_ptr(R + 1, 0);
+	for (auto row : entry_rows)
+	{
+		row_ptr[row + 1] += 1;
+	}
+	for (int i = 0; i < R; i++)
+	{
+		row_ptr[i + 1] += row_ptr[i];
+	}
+	std::vector<int> row_variables(entry_rows.size());
+	std::vector<double> row_coefficients(entry_rows.size());
+	{
+		std::vector<int> next(row_ptr.begin(), row_ptr.end() - 1);
+		for (size_t k = 0; k < entry_rows.size(); k++)
+		{
+			auto p = next[entry_rows[k]]++;
+			row_variables[p] = entry_columns[k];
+			row_coefficients[p] = entry_values[k];
+		}
+	}
+
+	std::vector<bool> is_quadratic(R, false);
+	for (const auto &entry : quadratic_entries)
+	{
+		is_quadratic[entry.row] = true;
+	}
+
+	ModelFileNames names;
+	names.variables.reserve(N);
+	for (auto name : column_names)
+	{
+		names.variables.emplace_back(name);
+	}
+
+	auto sense_of = [](char type) {
+		return type == 'L'   ? ConstraintSense::LessEqual
+		       : type == 'G' ? ConstraintSense::GreaterEqual
+		                     : ConstraintSense::Equal;
+	};
+
+	// linear constraints
+	auto &linear = model.linear_constraints;
+	auto add_linear_row = [&](int i, ConstraintSense row_sense, double rhs) {
+		linear.variables.insert(linear.variables.end(), row_variables.begin() + row_ptr[i],
+		                        row_variables.begin() + row_ptr[i + 1]);
+		linear.coefficients.insert(linear.coefficients.end(),
+		                           row_coefficients.begin() + row_ptr[i],
+		                           row_coefficients.begin() + row_ptr[i + 1]);
+		linear.column_ptr.push_back(linear.variables.size());
+		model.linear_senses.push_back(row_sense);
+		model.linear_rhs.push_back(rhs);
+	};
+	for (int i = 0; i < R; i++)
+	{
+		if (is_quadratic[i])
+		{
+			continue;
+		}
+		auto type = row_types[i];
+		auto rhs = row_rhs[i];
+		auto range = row_ranges[i];
+		if (std::isnan(range) || (type == 'E' && range == 0.0))
+		{
+			add_linear_row(i, sense_of(type), rhs);
+			names.linear_constraints.emplace_back(row_names[i]);
+			continue;
+		}
+
+		double lb, ub;
+		if (type == 'L')
+		{
+			lb = rhs - std::abs(range);
+			ub = rhs;
+		}
+		else if (type == 'G')
+		{
+			lb = rhs;
+			ub = rhs + std::abs(range);
+		}
+		else
+		{
+			lb = range > 0.0 ? rhs : rhs + range;
+			ub = range > 0.0 ? rhs + range : rhs;
+		}
+		add_linear_row(i, ConstraintSense::GreaterEqual, lb);
+		add_linear_row(i, ConstraintSense::LessEqual, ub);
+		names.linear_constraints.push_back(fmt::format("{}_lb", row_names[i]));
+		names.linear_constraints.push_back(fmt::format("{}_ub", row_names[i]));
+	}
+
+	// quadratic constraints, the terms of each row are grouped while keeping their order
+	if (!quadratic_entries.empty())
+	{
+		std::stable_sort(
+		    quadratic_entries.begin(), quadratic_entries.end(),
+		    [](const QuadraticEntry &a, const QuadraticEntry &b) { return a.row < b.row; });
+		Vector<IndexT> variable_1s, variable_2s;
+		Vector<CoeffT> coefficients;
+		size_t k = 0;
+		for (int i = 0; i < R; i++)
+		{
+			if (!is_quadratic[i])
+			{
+				continue;
+			}
+			if (!std::isnan(row_ranges[i]))
+			{
+				throw std::runtime_error(
+				    fmt::format("Range of quadratic row {} is not supported", row_names[i]));
+			}
+			variable_1s.clear();
+			variable_2s.clear();
+			coefficients.clear();
+			for (; k < quadratic_entries.size() && quadratic_entries[k].row == i; k++)
+			{
+				variable_1s.push_back(quadratic_entries[k].variable_1);
+				variable_2s.push_back(quadratic_entries[k].variable_2);
+				coefficients.push_back(quadratic_entries[k].coefficient);
+			}
+			model.quadratic_constraints.add_row<IndexT, CoeffT>(
+			    variable_1s, variable_2s, coefficients,
+			    std::span<const int>(row_variables.data() + row_ptr[i],
+			                         row_ptr[i + 1] - row_ptr[i]),
+			    std::span<const double>(row_coefficients.data() + row_ptr[i],
+			                            row_ptr[i + 1] - row_ptr[i]));
+			model.quadratic_senses.push_back(sense_of(row_types[i]));
+			model.quadratic_rhs.push_back(row_rhs[i]);
+			names.quadratic_constraints.emplace_back(row_names[i]);
+		}
+	}
+
+	// objective
+	ScalarAffineFunction affine(objective_coefficients, objective_variables);
+	if (objective_constant != 0.0)
+	{
+		affine.constant = objective_constant;
+	}
+	model.objective = ScalarQuadraticFunction(objective_quadratic_coefficients,
+	                                          objective_variable_1s, objective_variable_2s, affine);
+	model.objective_sense = sense;
+
+	return names;
+}
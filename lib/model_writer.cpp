@@ -0,0 +1,854 @@
+#include "pyoptinterface/model_writer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "fmt/format.h"
+
+namespace
+{
+// the content is accumulated in memory and written to the file in chunks of this size, so that a
+// large model is written with few system calls and without allocating a string for each row
+constexpr size_t WRITE_BUFFER_SIZE = 1 << 20;
+
+class BufferedFileWriter
+{
+  public:
+	BufferedFileWriter(const std::string &filename)
+	{
+		m_file = std::fopen(filename.c_str(), "wb");
+		if (m_file == nullptr)
+		{
+			throw std::runtime_error(fmt::format("Cannot open file {} for writing", filename));
+		}
+		m_buffer.reserve(WRITE_BUFFER_SIZE);
+	}
+	~BufferedFileWriter()
+	{
+		// only reached without close() when an exception is thrown, the content is dropped
+		if (m_file != nullptr)
+		{
+			std::fclose(m_file);
+		}
+	}
+
+	template <typename... Args>
+	void write(fmt::format_string<Args...> format, Args &&...args)
+	{
+		fmt::format_to(fmt::appender(m_buffer), format, std::forward<Args>(args)...);
+		if (m_buffer.size() >= WRITE_BUFFER_SIZE)
+		{
+			flush();
+		}
+	}
+
+	void close()
+	{
+		flush();
+		auto error = std::fclose(m_file);
+		m_file = nullptr;
+		if (error != 0)
+		{
+			throw std::runtime_error("Failed to close the model file");
+		}
+	}
+
+  private:
+	void flush()
+	{
+		auto written = std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+		if (written != m_buffer.size())
+		{
+			throw std::runtime_error("Failed to write the model file");
+		}
+		m_buffer.clear();
+	}
+
+	std::FILE *m_file = nullptr;
+	fmt::memory_buffer m_buffer;
+};
+
+enum class RowType
+{
+	Free,
+	LessEqual,
+	GreaterEqual,
+	Equal,
+	Ranged,
+};
+
+RowType get_row_type(double lb, double ub)
+{
+	bool has_lb = std::isfinite(lb);
+	bool has_ub = std::isfinite(ub);
+	if (has_lb && has_ub)
+	{
+		return lb == ub ? RowType::Equal : RowType::Ranged;
+	}
+	if (has_lb)
+	{
+		return RowType::GreaterEqual;
+	}
+	if (has_ub)
+	{
+		return RowType::LessEqual;
+	}
+	return RowType::Free;
+}
+
+struct QuadraticTerm
+{
+	int variable_1;
+	int variable_2;
+	double coefficient;
+};
+
+// normalizes the terms to variable_1 <= variable_2, sorts them and merges duplicated terms
+void collect_quadratic_terms(int N, const int *variable_1s, const int *variable_2s,
+                             const double *coefficients, std::vector<QuadraticTerm> &terms)
+{
+	terms.clear();
+	for (int i = 0; i < N; i++)
+	{
+		auto [x1, x2] = std::minmax(variable_1s[i], variable_2s[i]);
+		terms.push_back({x1, x2, coefficients[i]});
+	}
+	std::sort(terms.begin(), terms.end(), [](const QuadraticTerm &a, const QuadraticTerm &b) {
+		return a.variable_1 < b.variable_1 ||
+		       (a.variable_1 == b.variable_1 && a.variable_2 < b.variable_2);
+	});
+	size_t n = 0;
+	for (size_t i = 0; i < terms.size(); i++)
+	{
+		if (n > 0 && terms[n - 1].variable_1 == terms[i].variable_1 &&
+		    terms[n - 1].variable_2 == terms[i].variable_2)
+		{
+			terms[n - 1].coefficient += terms[i].coefficient;
+		}
+		else
+		{
+			terms[n++] = terms[i];
+		}
+	}
+	terms.resize(n);
+}
+
+bool is_integer_domain(const ModelWriterInput &model, int j)
+{
+	if (model.variable_domains == nullptr)
+	{
+		return false;
+	}
+	auto domain = model.variable_domains[j];
+	return domain == VariableDomain::Integer || domain == VariableDomain::Binary;
+}
+
+VariableDomain get_domain(const ModelWriterInput &model, int j)
+{
+	return model.variable_domains == nullptr ? VariableDomain::Continuous
+	                                         : model.variable_domains[j];
+}
+
+// a binary variable is written as integer variable with its bounds clamped to [0, 1], it is only
+// declared as binary when the clamped bounds are exactly [0, 1]
+void get_variable_bounds(const ModelWriterInput &model, int j, double &lb, double &ub,
+                         bool &is_binary)
+{
+	lb = model.variable_lbs[j];
+	ub = model.variable_ubs[j];
+	is_binary = false;
+	if (get_domain(model, j) == VariableDomain::Binary)
+	{
+		lb = std::max(lb, 0.0);
+		ub = std::min(ub, 1.0);
+		is_binary = lb == 0.0 && ub == 1.0;
+	}
+}
+
+void check_model(const ModelWriterInput &model)
+{
+	for (int i = 0; i < model.n_quadratic_constraints; i++)
+	{
+		if (get_row_type(model.quadratic_lbs[i], model.quadratic_ubs[i]) == RowType::Ranged)
+		{
+			throw std::runtime_error(
+			    "Quadratic constraint with both lower and upper bound cannot be written");
+		}
+	}
+}
+
+// the transpose of all linear coefficients in the model, row 0 is the objective, rows
+// [1, 1 + n_linear_constraints) are linear constraints and the rest are the linear parts of
+// quadratic constraints, the entries of a column are sorted by row
+struct ColumnMatrix
+{
+	std::vector<int> column_ptr;
+	std::vector<int> rows;
+	std::vector<double> values;
+};
+
+void build_column_matrix(const ModelWriterInput &model, ColumnMatrix &matrix)
+{
+	int N = model.n_variables;
+	int M = model.n_linear_constraints;
+	int Q = model.n_quadratic_constraints;
+
+	const ScalarAffineFunction *objective = nullptr;
+	if (model.objective != nullptr && model.objective->affine_part)
+	{
+		objective = &model.objective->affine_part.value();
+	}
+
+	auto for_each_entry = [&](auto &&f) {
+		if (objective != nullptr)
+		{
+			for (size_t k = 0; k < objective->size(); k++)
+			{
+				f(0, objective->variables[k], objective->coefficients[k]);
+			}
+		}
+		for (int i = 0; i < M; i++)
+		{
+			for (int k = model.linear_indptr[i]; k < model.linear_indptr[i + 1]; k++)
+			{
+				f(1 + i, model.linear_variables[k], model.linear_coefficients[k]);
+			}
+		}
+		for (int i = 0; i < Q; i++)
+		{
+			auto begin = model.quadratic_lin_indptr[i];
+			auto end = model.quadratic_lin_indptr[i + 1];
+			for (int k = begin; k < end; k++)
+			{
+				f(1 + M + i, model.quadratic_lin_variables[k],
+				  model.quadratic_lin_coefficients[k]);
+			}
+		}
+	};
+
+	auto &column_ptr = matrix.column_ptr;
+	column_ptr.assign(N + 1, 0);
+	for_each_entry([&](int, int column, double) { column_ptr[column + 1] += 1; });
+	for (int j = 0; j < N; j++)
+	{
+		column_ptr[j + 1] += column_ptr[j];
+	}
+
+	matrix.rows.resize(column_ptr[N]);
+	matrix.values.resize(column_ptr[N]);
+	std::vector<int> next(column_ptr.begin(), column_ptr.end() - 1);
+	for_each_entry([&](int row, int column, double value) {
+		auto k = next[column]++;
+		matrix.rows[k] = row;
+		matrix.values[k] = value;
+	});
+}
+
+struct MPSRowName
+{
+	int M;
+	int row;
+};
+
+} // namespace
+
+template <>
+struct fmt::formatter<MPSRowName> : fmt::formatter<std::string_view>
+{
+	auto format(const MPSRowName &name, format_context &ctx) const
+	{
+		if (name.row == 0)
+		{
+			return fmt::format_to(ctx.out(), "obj");
+		}
+		else if (name.row <= name.M)
+		{
+			return fmt::format_to(ctx.out(), "c{}", name.row - 1);
+		}
+		else
+		{
+			return fmt::format_to(ctx.out(), "q{}", name.row - 1 - name.M);
+		}
+	}
+};
+
+void write_mps(const ModelWriterInput &model, const std::string &filename)
+{
+	check_model(model);
+
+	int N = model.n_variables;
+	int M = model.n_linear_constraints;
+	int Q = model.n_quadratic_constraints;
+
+	BufferedFileWriter writer(filename);
+
+	writer.write("NAME          model\n");
+	if (model.objective_sense == ObjectiveSense::Maximize)
+	{
+		writer.write("OBJSENSE\n    MAX\n");
+	}
+
+	auto row_type_name = [](RowType type) {
+		switch (type)
+		{
+		case RowType::LessEqual:
+			return 'L';
+		case RowType::GreaterEqual:
+		case RowType::Ranged:
+			return 'G';
+		case RowType::Equal:
+			return 'E';
+		default:
+			return 'N';
+		}
+	};
+
+	writer.write("ROWS\n N  obj\n");
+	for (int i = 0; i < M; i++)
+	{
+		auto type = get_row_type(model.linear_lbs[i], model.linear_ubs[i]);
+		writer.write(" {}  c{}\n", row_type_name(type), i);
+	}
+	for (int i = 0; i < Q; i++)
+	{
+		auto type = get_row_type(model.quadratic_lbs[i], model.quadratic_ubs[i]);
+		writer.write(" {}  q{}\n", row_type_name(type), i);
+	}
+
+	ColumnMatrix matrix;
+	build_column_matrix(model, matrix);
+
+	writer.write("COLUMNS\n");
+	bool in_integer_block = false;
+	for (int j = 0; j < N; j++)
+	{
+		bool is_integer = is_integer_domain(model, j);
+		if (is_integer != in_integer_block)
+		{
+			writer.write("    MARKER                 'MARKER'                 '{}'\n",
+			             is_integer ? "INTORG" : "INTEND");
+			in_integer_block = is_integer;
+		}
+
+		auto begin = matrix.column_ptr[j];
+		auto end = matrix.column_ptr[j + 1];
+		if (begin == end)
+		{
+			// every variable must appear in COLUMNS to be known by the reader
+			writer.write("    x{}  obj  0\n", j);
+			continue;
+		}
+		// duplicated entries of the same row are adjacent and merged here
+		for (auto k = begin; k < end;)
+		{
+			auto row = matrix.rows[k];
+			double value = 0.0;
+			for (; k < end && matrix.rows[k] == row; k++)
+			{
+				value += matrix.values[k];
+			}
+			writer.write("    x{}  {}  {}\n", j, MPSRowName{M, row}, value);
+		}
+	}
+	if (in_integer_block)
+	{
+		writer.write("    MARKER                 'MARKER'                 'INTEND'\n");
+	}
+
+	auto row_rhs = [](RowType type, double lb, double ub) {
+		return type == RowType::LessEqual ? ub : lb;
+	};
+
+	writer.write("RHS\n");
+	if (model.objective != nullptr && model.objective->affine_part &&
+	    model.objective->affine_part->constant.value_or(0.0) != 0.0)
+	{
+		// the RHS of the objective row is the negated objective constant
+		writer.write("    rhs  obj  {}\n", -model.objective->affine_part->constant.value());
+	}
+	for (int i = 0; i < M; i++)
+	{
+		auto lb = model.linear_lbs[i];
+		auto ub = model.linear_ubs[i];
+		auto type = get_row_type(lb, ub);
+		if (type == RowType::Free)
+		{
+			continue;
+		}
+		auto rhs = row_rhs(type, lb, ub);
+		if (rhs != 0.0)
+		{
+			writer.write("    rhs  c{}  {}\n", i, rhs);
+		}
+	}
+	for (int i = 0; i < Q; i++)
+	{
+		auto lb = model.quadratic_lbs[i];
+		auto ub = model.quadratic_ubs[i];
+		auto type = get_row_type(lb, ub);
+		if (type == RowType::Free)
+		{
+			continue;
+		}
+		auto rhs = row_rhs(type, lb, ub);
+		if (rhs != 0.0)
+		{
+			writer.write("    rhs  q{}  {}\n", i, rhs);
+		}
+	}
+
+	bool has_ranges = false;
+	for (int i = 0; i < M; i++)
+	{
+		auto lb = model.linear_lbs[i];
+		auto ub = model.linear_ubs[i];
+		if (get_row_type(lb, ub) == RowType::Ranged)
+		{
+			if (!has_ranges)
+			{
+				writer.write("RANGES\n");
+				has_ranges = true;
+			}
+			writer.write("    rng  c{}  {}\n", i, ub - lb);
+		}
+	}
+
+	writer.write("BOUNDS\n");
+	for (int j = 0; j < N; j++)
+	{
+		double lb, ub;
+		bool is_binary;
+		get_variable_bounds(model, j, lb, ub, is_binary);
+		if (is_binary)
+		{
+			writer.write(" BV bnd  x{}\n", j);
+			continue;
+		}
+
+		bool has_lb = std::isfinite(lb);
+		bool has_ub = std::isfinite(ub);
+		if (get_domain(model, j) == VariableDomain::SemiContinuous)
+		{
+			if (has_lb && lb != 0.0)
+			{
+				writer.write(" LO bnd  x{}  {}\n", j, lb);
+			}
+			// an infinite value is understood as infinity by the readers
+			writer.write(" SC bnd  x{}  {}\n", j, has_ub ? ub : 1e30);
+		}
+		else if (has_lb && has_ub && lb == ub)
+		{
+			writer.write(" FX bnd  x{}  {}\n", j, lb);
+		}
+		else if (!has_lb && !has_ub)
+		{
+			writer.write(" FR bnd  x{}\n", j);
+		}
+		else
+		{
+			if (!has_lb)
+			{
+				writer.write(" MI bnd  x{}\n", j);
+			}
+			else if (lb != 0.0 || (has_ub && ub < 0.0))
+			{
+				writer.write(" LO bnd  x{}  {}\n", j, lb);
+			}
+			if (has_ub)
+			{
+				writer.write(" UP bnd  x{}  {}\n", j, ub);
+			}
+			else if (is_integer_domain(model, j))
+			{
+				// some readers treat integer variables without upper bound as binary
+				writer.write(" PL bnd  x{}\n", j);
+			}
+		}
+	}
+
+	std::vector<QuadraticTerm> terms;
+	// the quadratic objective is 0.5 x'Qx and only the upper triangle of Q is written
+	if (model.objective != nullptr && model.objective->size() > 0)
+	{
+		auto &objective = *model.objective;
+		collect_quadratic_terms(objective.size(), objective.variable_1s.data(),
+		                        objective.variable_2s.data(), objective.coefficients.data(),
+		                        terms);
+		writer.write("QUADOBJ\n");
+		for (const auto &term : terms)
+		{
+			auto value = term.variable_1 == term.variable_2 ? 2.0 * term.coefficient
+			                                                : term.coefficient;
+			writer.write("    x{}  x{}  {}\n", term.variable_1, term.variable_2, value);
+		}
+	}
+	// the quadratic part of a constraint is x'Qx and Q is written as a full symmetric matrix
+	for (int i = 0; i < Q; i++)
+	{
+		auto begin = model.quadratic_indptr[i];
+		auto end = model.quadratic_indptr[i + 1];
+		if (begin == end)
+		{
+			continue;
+		}
+		collect_quadratic_terms(end - begin, model.quadratic_variable_1s + begin,
+		                        model.quadratic_variable_2s + begin,
+		                        model.quadratic_coefficients + begin, terms);
+		writer.write("QCMATRIX   q{}\n", i);
+		for (const auto &term : terms)
+		{
+			if (term.variable_1 == term.variable_2)
+			{
+				writer.write("    x{}  x{}  {}\n", term.variable_1, term.variable_1,
+				             term.coefficient);
+			}
+			else
+			{
+				auto half = 0.5 * term.coefficient;
+				writer.write("    x{}  x{}  {}\n", term.variable_1, term.variable_2, half);
+				writer.write("    x{}  x{}  {}\n", term.variable_2, term.variable_1, half);
+			}
+		}
+	}
+
+	writer.write("ENDATA\n");
+	writer.close();
+}
+
+namespace
+{
+// LP files are read line by line by some readers, so long expressions are wrapped
+constexpr int LP_TERMS_PER_LINE = 8;
+
+class LPExpressionWriter
+{
+  public:
+	LPExpressionWriter(BufferedFileWriter &writer) : m_writer(writer)
+	{
+	}
+
+	void add_linear_term(double coefficient, int x)
+	{
+		write_sign(coefficient);
+		m_writer.write("{} x{}", std::abs(coefficient), x);
+	}
+
+	void add_quadratic_term(double coefficient, int x1, int x2)
+	{
+		write_sign(coefficient);
+		if (x1 == x2)
+		{
+			m_writer.write("{} x{} ^ 2", std::abs(coefficient), x1);
+		}
+		else
+		{
+			m_writer.write("{} x{} * x{}", std::abs(coefficient), x1, x2);
+		}
+	}
+
+	void add_constant(double constant)
+	{
+		write_sign(constant);
+		m_writer.write("{}", std::abs(constant));
+	}
+
+	// the quadratic terms are enclosed in brackets
+	void begin_quadratic()
+	{
+		if (m_n_terms > 0)
+		{
+			m_writer.write(" +");
+		}
+		m_writer.write(" [");
+		m_n_terms = 0;
+	}
+
+	void end_quadratic(bool half)
+	{
+		m_writer.write("{}", half ? " ] / 2" : " ]");
+		m_n_terms = 1;
+	}
+
+	// an empty expression is written as 0
+	void finish()
+	{
+		if (m_n_terms == 0)
+		{
+			m_writer.write(" 0");
+		}
+	}
+
+  private:
+	void write_sign(double value)
+	{
+		if (m_n_terms > 0 && m_n_terms % LP_TERMS_PER_LINE == 0)
+		{
+			m_writer.write("\n  ");
+		}
+		if (value < 0.0)
+		{
+			m_writer.write(" - ");
+		}
+		else if (m_n_terms > 0)
+		{
+			m_writer.write(" + ");
+		}
+		else
+		{
+			m_writer.write(" ");
+		}
+		m_n_terms += 1;
+	}
+
+	BufferedFileWriter &m_writer;
+	int m_n_terms = 0;
+};
+
+void write_lp_row(BufferedFileWriter &writer, std::vector<QuadraticTerm> &terms, const int *indptr,
+                  const int *variables, const double *coefficients, int i,
+                  const ModelWriterInput *quadratic)
+{
+	LPExpressionWriter expression(writer);
+	for (int k = indptr[i]; k < indptr[i + 1]; k++)
+	{
+		expression.add_linear_term(coefficients[k], variables[k]);
+	}
+	if (quadratic != nullptr)
+	{
+		auto begin = quadratic->quadratic_indptr[i];
+		auto end = quadratic->quadratic_indptr[i + 1];
+		if (begin < end)
+		{
+			collect_quadratic_terms(end - begin, quadratic->quadratic_variable_1s + begin,
+			                        quadratic->quadratic_variable_2s + begin,
+			                        quadratic->quadratic_coefficients + begin, terms);
+			expression.begin_quadratic();
+			for (const auto &term : terms)
+			{
+				expression.add_quadratic_term(term.coefficient, term.variable_1,
+				                              term.variable_2);
+			}
+			expression.end_quadratic(false);
+		}
+	}
+	expression.finish();
+}
+} // namespace
+
+void write_lp(const ModelWriterInput &model, const std::string &filename)
+{
+	check_model(model);
+
+	int N = model.n_variables;
+	int M = model.n_linear_constraints;
+	int Q = model.n_quadratic_constraints;
+
+	BufferedFileWriter writer(filename);
+	std::vector<QuadraticTerm> terms;
+
+	writer.write("{}\n obj:", model.objective_sense == ObjectiveSense::Maximize ? "Maximize"
+	                                                                             : "Minimize");
+	{
+		LPExpressionWriter expression(writer);
+		if (model.objective != nullptr)
+		{
+			auto &objective = *model.objective;
+			if (objective.affine_part)
+			{
+				auto &affine = objective.affine_part.value();
+				for (size_t k = 0; k < affine.size(); k++)
+				{
+					expression.add_linear_term(affine.coefficients[k], affine.variables[k]);
+				}
+			}
+			if (objective.size() > 0)
+			{
+				// the quadratic objective is written as [ x'Qx ] / 2
+				collect_quadratic_terms(objective.size(), objective.variable_1s.data(),
+				                        objective.variable_2s.data(),
+				                        objective.coefficients.data(), terms);
+				expression.begin_quadratic();
+				for (const auto &term : terms)
+				{
+					expression.add_quadratic_term(2.0 * term.coefficient, term.variable_1,
+					                              term.variable_2);
+				}
+				expression.end_quadratic(true);
+			}
+			if (objective.affine_part && objective.affine_part->constant.value_or(0.0) != 0.0)
+			{
+				expression.add_constant(objective.affine_part->constant.value());
+			}
+		}
+		expression.finish();
+	}
+	writer.write("\n");
+
+	writer.write("Subject To\n");
+	for (int i = 0; i < M; i++)
+	{
+		auto lb = model.linear_lbs[i];
+		auto ub = model.linear_ubs[i];
+		auto type = get_row_type(lb, ub);
+		if (type == RowType::Free)
+		{
+			continue;
+		}
+		// a ranged constraint is written as two constraints because the LP format of different
+		// solvers does not agree on the syntax of ranges
+		if (type == RowType::Ranged)
+		{
+			writer.write(" c{}_lb:", i);
+			write_lp_row(writer, terms, model.linear_indptr, model.linear_variables,
+			             model.linear_coefficients, i, nullptr);
+			writer.write(" >= {}\n c{}_ub:", lb, i);
+			write_lp_row(writer, terms, model.linear_indptr, model.linear_variables,
+			             model.linear_coefficients, i, nullptr);
+			writer.write(" <= {}\n", ub);
+			continue;
+		}
+		writer.write(" c{}:", i);
+		write_lp_row(writer, terms, model.linear_indptr, model.linear_variables,
+		             model.linear_coefficients, i, nullptr);
+		if (type == RowType::LessEqual)
+		{
+			writer.write(" <= {}\n", ub);
+		}
+		else
+		{
+			writer.write(" {} {}\n", type == RowType::Equal ? "=" : ">=", lb);
+		}
+	}
+	for (int i = 0; i < Q; i++)
+	{
+		auto lb = model.quadratic_lbs[i];
+		auto ub = model.quadratic_ubs[i];
+		auto type = get_row_type(lb, ub);
+		if (type == RowType::Free)
+		{
+			continue;
+		}
+		writer.write(" q{}:", i);
+		write_lp_row(writer, terms, model.quadratic_lin_indptr, model.quadratic_lin_variables,
+		             model.quadratic_lin_coefficients, i, &model);
+		if (type == RowType::LessEqual)
+		{
+			writer.write(" <= {}\n", ub);
+		}
+		else
+		{
+			writer.write(" {} {}\n", type == RowType::Equal ? "=" : ">=", lb);
+		}
+	}
+
+	// variables without explicit bounds are in [0, +inf)
+	writer.write("Bounds\n");
+	for (int j = 0; j < N; j++)
+	{
+		double lb, ub;
+		bool is_binary;
+		get_variable_bounds(model, j, lb, ub, is_binary);
+		if (is_binary)
+		{
+			continue;
+		}
+
+		bool has_lb = std::isfinite(lb);
+		bool has_ub = std::isfinite(ub);
+		if (has_lb && has_ub)
+		{
+			if (lb == ub)
+			{
+				writer.write(" x{} = {}\n", j, lb);
+			}
+			else
+			{
+				writer.write(" {} <= x{} <= {}\n", lb, j, ub);
+			}
+		}
+		else if (has_lb)
+		{
+			if (lb != 0.0)
+			{
+				writer.write(" x{} >= {}\n", j, lb);
+			}
+		}
+		else if (has_ub)
+		{
+			writer.write(" -infinity <= x{} <= {}\n", j, ub);
+		}
+		else
+		{
+			writer.write(" x{} free\n", j);
+		}
+	}
+
+	auto write_variable_section = [&](const char *section, auto &&predicate) {
+		int count = 0;
+		for (int j = 0; j < N; j++)
+		{
+			if (!predicate(j))
+			{
+				continue;
+			}
+			if (count == 0)
+			{
+				writer.write("{}\n", section);
+			}
+			writer.write(" x{}", j);
+			count += 1;
+			if (count % LP_TERMS_PER_LINE == 0)
+			{
+				writer.write("\n");
+			}
+		}
+		if (count % LP_TERMS_PER_LINE != 0)
+		{
+			writer.write("\n");
+		}
+	};
+
+	auto is_binary_variable = [&](int j) {
+		double lb, ub;
+		bool is_binary;
+		get_variable_bounds(model, j, lb, ub, is_binary);
+		return is_binary;
+	};
+	write_variable_section("Generals", [&](int j) {
+		return is_integer_domain(model, j) && !is_binary_variable(j);
+	});
+	write_variable_section("Binaries", is_binary_variable);
+	write_variable_section("Semi-continuous", [&](int j) {
+		return get_domain(model, j) == VariableDomain::SemiContinuous;
+	});
+
+	writer.write("End\n");
+	writer.close();
+}
+
+void write_model(const ModelWriterInput &model, const std::string &filename)
+{
+	auto has_extension = [&](std::string_view extension) {
+		return filename.size() >= extension.size() &&
+		       filename.compare(filename.size() - extension.size(), extension.size(),
+		                        extension) == 0;
+	};
+	if (has_extension(".mps"))
+	{
+		write_mps(model, filename);
+	}
+	else if (has_extension(".lp"))
+	{
+		write_lp(model, filename);
+	}
+	else
+	{
+		throw std::runtime_error(
+		    fmt::format("Unsupported model file format of {}, only .mps and .lp are supported",
+		                filename));
+	}
+}
@@ -54,22 +54,15 @@ void QuadraticFunctionPtrForm<MSKint32t, MSKint32t, MSKrealt>::make<MOSEKModel>(
 	numnz = f_numnz;
 	row_storage.resize(numnz);
 	col_storage.resize(numnz);
+	model->_variable_indices(function.variable_1s, row_storage);
+	model->_variable_indices(function.variable_2s, col_storage);
 	for (int i = 0; i < numnz; ++i)
 	{
-		auto v1 = model->_variable_index(function.variable_1s[i]);
-		auto v2 = v1;
-		if (function.variable_1s[i] != function.variable_2s[i])
+		// MOSEK only accepts the lower triangle (i >= j)
+		if (row_storage[i] < col_storage[i])
 		{
-			v2 = model->_variable_index(function.variable_2s[i]);
-			// MOSEK only accepts the lower triangle (i >= j)
-			if (v1 < v2)
-			{
-				std::swap(v1, v2);
-			}
+			std::swap(row_storage[i], col_storage[i]);
 		}
-
-		row_storage[i] = v1;
-		col_storage[i] = v2;
 	}
 	row = row_storage.data();
 	col = col_storage.data();
@@ -146,6 +139,20 @@ static MSKvariabletypee mosek_vtype(VariableDomain domain)
 	}
 }
 
+static MSKboundkeye mosek_bound_key(double lb, double ub)
+{
+	bool lb_inf = lb < 1.0 - MSK_INFINITY;
+	bool ub_inf = ub > MSK_INFINITY - 1.0;
+	if (lb_inf && ub_inf)
+		return MSK_BK_FR;
+	else if (lb_inf)
+		return MSK_BK_UP;
+	else if (ub_inf)
+		return MSK_BK_LO;
+	else
+		return MSK_BK_RA;
+}
+
 static VariableDomain mosek_vtype_to_domain(MSKvariabletypee vtype)
 {
 	switch (vtype)
@@ -243,16 +250,7 @@ VariableIndex MOSEKModel::add_variable(VariableDomain domain, double lb, double
 	}
 	else
 	{
-		bool lb_inf = lb < 1.0 - MSK_INFINITY;
-		bool ub_inf = ub > MSK_INFINITY - 1.0;
-		if (lb_inf && ub_inf)
-			bk = MSK_BK_FR;
-		else if (lb_inf)
-			bk = MSK_BK_UP;
-		else if (ub_inf)
-			bk = MSK_BK_LO;
-		else
-			bk = MSK_BK_RA;
+		bk = mosek_bound_key(lb, ub);
 	}
 	error = mosek::MSK_putvarbound(m_model.get(), column, bk, lb, ub);
 	check_error(error);
@@ -266,63 +264,59 @@ VariableIndex MOSEKModel::add_variable(VariableDomain domain, double lb, double
 	return variable;
 }
 
-// VariableIndex MOSEKModel::add_variables(int N, VariableDomain domain, double lb, double ub)
-//{
-//	IndexT index = m_variable_index.add_indices(N);
-//	VariableIndex variable(index);
-//
-//	auto error = MSK_appendvars(m_model.get(), N);
-//	check_error(error);
-//
-//	MSKint32t column;
-//	error = MSK_getnumvar(m_model.get(), &column);
-//	check_error(error);
-//	// 0-based indexing
-//	column -= N;
-//	std::vector<MSKint32t> columns(N);
-//	for (int i = 0; i < N; i++)
-//	{
-//		columns[i] = column + i;
-//	}
-//
-//	MSKvariabletypee vtype = mosek_vtype(domain);
-//	std::vector<MSKvariabletypee> vtypes(N, vtype);
-//	error = MSK_putvartypelist(m_model.get(), N, columns.data(), vtypes.data());
-//	check_error(error);
-//
-//	MSKboundkeye bk;
-//	if (domain == VariableDomain::Binary)
-//	{
-//		bk = MSK_BK_RA;
-//		lb = 0.0;
-//		ub = 1.0;
-//		for (int i = 0; i < N; i++)
-//		{
-//			binary_variables.insert(index + i);
-//		}
-//	}
-//	else
-//	{
-//		bool lb_inf = lb < 1.0 - MSK_INFINITY;
-//		bool ub_inf = ub > MSK_INFINITY - 1.0;
-//		if (lb_inf && ub_inf)
-//			bk = MSK_BK_FR;
-//		else if (lb_inf)
-//			bk = MSK_BK_UP;
-//		else if (ub_inf)
-//			bk = MSK_BK_LO;
-//		else
-//			bk = MSK_BK_RA;
-//	}
-//	std::vector<MSKboundkeye> bks(N, bk);
-//	std::vector<MSKrealt> lbs(N, lb);
-//	std::vector<MSKrealt> ubs(N, ub);
-//	error =
-//	    MSK_putvarboundlist(m_model.get(), N, columns.data(), bks.data(), lbs.data(), ubs.data());
-//	check_error(error);
-//
-//	return variable;
-// }
+VariableIndex MOSEKModel::add_variables(int N, VariableDomain domain, const double *lb,
+                                        const double *ub)
+{
+	m_is_dirty = true;
+	IndexT index = m_variable_index.add_indices(N);
+	VariableIndex variable(index);
+	if (N == 0)
+	{
+		return variable;
+	}
+
+	MSKint32t column;
+	auto error = mosek::MSK_getnumvar(m_model.get(), &column);
+	check_error(error);
+
+	error = mosek::MSK_appendvars(m_model.get(), N);
+	check_error(error);
+
+	if (domain != VariableDomain::Continuous)
+	{
+		std::vector<MSKint32t> columns(N);
+		std::iota(columns.begin(), columns.end(), column);
+		std::vector<MSKvariabletypee> vtypes(N, mosek_vtype(domain));
+		error = mosek::MSK_putvartypelist(m_model.get(), N, columns.data(), vtypes.data());
+		check_error(error);
+	}
+
+	std::vector<MSKboundkeye> bks(N);
+	std::vector<MSKrealt> lbs, ubs;
+	if (domain == VariableDomain::Binary)
+	{
+		std::fill(bks.begin(), bks.end(), MSK_BK_RA);
+		lbs.assign(N, 0.0);
+		ubs.assign(N, 1.0);
+		lb = lbs.data();
+		ub = ubs.data();
+		for (int i = 0; i < N; i++)
+		{
+			binary_variables.insert(index + i);
+		}
+	}
+	else
+	{
+		for (int i = 0; i < N; i++)
+		{
+			bks[i] = mosek_bound_key(lb[i], ub[i]);
+		}
+	}
+	error = mosek::MSK_putvarboundslice(m_model.get(), column, column + N, bks.data(), lb, ub);
+	check_error(error);
+
+	return variable;
+}
 
 void MOSEKModel::delete_variable(const VariableIndex &variable)
 {
@@ -347,25 +341,22 @@ void MOSEKModel::delete_variables(const Vector<VariableIndex> &variables)
 	if (n_variables == 0)
 		return;
 
-	std::vector<MSKint32t> columns;
-	columns.reserve(n_variables);
+	std::vector<IndexT> indices;
+	indices.reserve(n_variables);
 	for (int i = 0; i < n_variables; i++)
 	{
-		if (!is_variable_active(variables[i]))
+		if (is_variable_active(variables[i]))
 		{
-			continue;
+			indices.push_back(variables[i].index);
 		}
-		auto column = _variable_index(variables[i]);
-		columns.push_back(column);
 	}
+	std::vector<MSKint32t> columns(indices.size());
+	_variable_indices(indices, columns);
 
 	auto error = mosek::MSK_removevars(m_model.get(), columns.size(), columns.data());
 	check_error(error);
 
-	for (int i = 0; i < n_variables; i++)
-	{
-		m_variable_index.delete_index(variables[i].index);
-	}
+	m_variable_index.delete_indices(indices);
 }
 
 bool MOSEKModel::is_variable_active(const VariableIndex &variable)
@@ -383,6 +374,25 @@ double MOSEKModel::get_variable_value(const VariableIndex &variable)
 	return retval;
 }
 
+void MOSEKModel::get_variable_values(int N, const int *variables, double *values)
+{
+	std::vector<MSKint32t> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<MSKint32t>(columns));
+
+	MSKint32t numvar;
+	auto error = mosek::MSK_getnumvar(m_model.get(), &numvar);
+	check_error(error);
+	std::vector<MSKrealt> xx(numvar);
+	auto soltype = get_current_solution();
+	error = mosek::MSK_getxxslice(m_model.get(), soltype, 0, numvar, xx.data());
+	check_error(error);
+
+	for (int i = 0; i < N; i++)
+	{
+		values[i] = xx[columns[i]];
+	}
+}
+
 std::string MOSEKModel::pprint_variable(const VariableIndex &variable)
 {
 	return get_variable_name(variable);
@@ -405,6 +415,21 @@ void MOSEKModel::set_variable_bounds(const VariableIndex &variable, double lb, d
 	check_error(error);
 }
 
+void MOSEKModel::set_variable_bounds(int N, const int *variables, const double *lb,
+                                     const double *ub)
+{
+	m_is_dirty = true;
+	std::vector<MSKint32t> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<MSKint32t>(columns));
+	std::vector<MSKboundkeye> bk(N);
+	for (int i = 0; i < N; i++)
+	{
+		bk[i] = lb[i] == ub[i] ? MSK_BK_FX : MSK_BK_RA;
+	}
+	auto error = mosek::MSK_putvarboundlist(m_model.get(), N, columns.data(), bk.data(), lb, ub);
+	check_error(error);
+}
+
 ConstraintIndex MOSEKModel::add_linear_constraint(const ScalarAffineFunction &function,
                                                   ConstraintSense sense, CoeffT rhs,
                                                   const char *name)
@@ -498,6 +523,39 @@ ConstraintIndex MOSEKModel::add_linear_constraint(const ScalarAffineFunction &fu
 	return constraint_index;
 }
 
+ConstraintIndex MOSEKModel::add_linear_constraints(int M, const int *indptr, const int *variables,
+                                                   const double *coefficients,
+                                                   ConstraintSense sense, const double *rhs)
+{
+	CSRMatrixPtrForm<MSKint32t, MSKint32t, MSKrealt> ptr_form;
+	ptr_form.make(this, M, indptr, variables, coefficients);
+
+	m_is_dirty = true;
+	IndexT index = m_linear_quadratic_constraint_index.add_indices(M);
+	ConstraintIndex constraint_index(ConstraintType::Linear, index);
+	if (M == 0)
+	{
+		return constraint_index;
+	}
+
+	MSKint32t first;
+	auto error = mosek::MSK_getnumcon(m_model.get(), &first);
+	check_error(error);
+	error = mosek::MSK_appendcons(m_model.get(), M);
+	check_error(error);
+
+	error = mosek::MSK_putarowslice(m_model.get(), first, first + M, ptr_form.begin,
+	                                ptr_form.begin + 1, ptr_form.index, ptr_form.value);
+	check_error(error);
+
+	std::vector<MSKboundkeye> bound_keys(M, mosek_con_sense(sense));
+	error = mosek::MSK_putconboundslice(m_model.get(), first, first + M, bound_keys.data(), rhs,
+	                                    rhs);
+	check_error(error);
+
+	return constraint_index;
+}
+
 ConstraintIndex MOSEKModel::add_quadratic_constraint(const ScalarQuadraticFunction &function,
                                                      ConstraintSense sense, CoeffT rhs,
                                                      const char *name)
@@ -1357,6 +1415,47 @@ void MOSEKModel::set_normalized_rhs(const ConstraintIndex &constraint, double va
 	}
 }
 
+void MOSEKModel::set_normalized_rhs(int N, const int *constraints, const double *values)
+{
+	m_is_dirty = true;
+	std::vector<MSKint32t> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<MSKint32t>(rows));
+
+	std::vector<MSKboundkeye> bk(N);
+	std::vector<MSKrealt> lb(N), ub(N);
+	for (int i = 0; i < N; i++)
+	{
+		auto error = mosek::MSK_getconbound(m_model.get(), rows[i], &bk[i], &lb[i], &ub[i]);
+		check_error(error);
+
+		switch (bk[i])
+		{
+		case MSK_BK_UP:
+			ub[i] = values[i];
+			break;
+		case MSK_BK_LO:
+			lb[i] = values[i];
+			break;
+		case MSK_BK_FX:
+			ub[i] = values[i];
+			lb[i] = values[i];
+			break;
+		case MSK_BK_FR:
+			throw std::runtime_error("Constraint has no finite bound");
+			break;
+		case MSK_BK_RA:
+			throw std::runtime_error("Constraint has two finite bounds");
+			break;
+		default:
+			throw std::runtime_error("Unknown bound type");
+		}
+	}
+
+	auto error = mosek::MSK_putconboundlist(m_model.get(), N, rows.data(), bk.data(), lb.data(),
+	                                        ub.data());
+	check_error(error);
+}
+
 double MOSEKModel::get_normalized_coefficient(const ConstraintIndex &constraint,
                                               const VariableIndex &variable)
 {
@@ -1388,6 +1487,18 @@ void MOSEKModel::set_normalized_coefficient(const ConstraintIndex &constraint,
 	check_error(error);
 }
 
+void MOSEKModel::set_normalized_coefficients(int N, const int *constraints, const int *variables,
+                                             const double *values)
+{
+	m_is_dirty = true;
+	std::vector<MSKint32t> rows(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<MSKint32t>(rows));
+	std::vector<MSKint32t> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<MSKint32t>(columns));
+	auto error = mosek::MSK_putaijlist(m_model.get(), N, rows.data(), columns.data(), values);
+	check_error(error);
+}
+
 double MOSEKModel::get_objective_coefficient(const VariableIndex &variable)
 {
 	auto column = _checked_variable_index(variable);
@@ -1405,11 +1516,26 @@ void MOSEKModel::set_objective_coefficient(const VariableIndex &variable, double
 	check_error(error);
 }
 
+void MOSEKModel::set_objective_coefficients(int N, const int *variables, const double *values)
+{
+	m_is_dirty = true;
+	std::vector<MSKint32t> columns(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<MSKint32t>(columns));
+	auto error = mosek::MSK_putclist(m_model.get(), N, columns.data(), values);
+	check_error(error);
+}
+
 MSKint32t MOSEKModel::_variable_index(const VariableIndex &variable)
 {
 	return m_variable_index.get_index(variable.index);
 }
 
+void MOSEKModel::_variable_indices(std::span<const IndexT> variables,
+                                   std::span<MSKint32t> columns)
+{
+	m_variable_index.get_indices(variables, columns);
+}
+
 MSKint32t MOSEKModel::_checked_variable_index(const VariableIndex &variable)
 {
 	MSKint32t column = _variable_index(variable);
@@ -1447,6 +1573,12 @@ MSKint32t MOSEKModel::_checked_constraint_index(const ConstraintIndex &constrain
 	return row;
 }
 
+void MOSEKModel::_linear_constraint_indices(std::span<const IndexT> constraints,
+                                            std::span<MSKint32t> rows)
+{
+	m_linear_quadratic_constraint_index.get_indices(constraints, rows);
+}
+
 // Logging callback
 static void RealLoggingCallbackFunction(void *handle, const char *msg)
 {
@@ -5,6 +5,8 @@
 #include <nanobind/stl/function.h>
 
 #include "pyoptinterface/mosek_model.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
+#include "pyoptinterface/cache_model.hpp"
 
 namespace nb = nanobind;
 
@@ -37,12 +39,30 @@ NB_MODULE(mosek_model_ext, m)
 	    .def("add_variable", &MOSEKModel::add_variable,
 	         nb::arg("domain") = VariableDomain::Continuous, nb::arg("lb") = -MSK_INFINITY,
 	         nb::arg("ub") = MSK_INFINITY, nb::arg("name") = "")
+	    .def(
+	        "_add_variables",
+	        [](MOSEKModel &model, int N, VariableDomain domain,
+	           const std::optional<DoubleArrayT> &lb, const std::optional<DoubleArrayT> &ub) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer;
+		        return model.add_variables(N, domain,
+		                                   array_or_fill(lb, N, -MSK_INFINITY, lb_buffer, "lb"),
+		                                   array_or_fill(ub, N, MSK_INFINITY, ub_buffer, "ub"));
+	        },
+	        nb::arg("N"), nb::arg("domain") = VariableDomain::Continuous,
+	        nb::arg("lb") = nb::none(), nb::arg("ub") = nb::none())
 	    // clang-format off
 	    BIND_F(delete_variable)
 	    BIND_F(delete_variables)
 	    BIND_F(is_variable_active)
 	    // clang-format on
-	    .def("set_variable_bounds", &MOSEKModel::set_variable_bounds, nb::arg("variable"),
+	    .def("set_variable_bounds",
+	         nb::overload_cast<const VariableIndex &, double, double>(
+	             &MOSEKModel::set_variable_bounds),
+	         nb::arg("variable"), nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_array<MOSEKModel>, nb::arg("variables"),
+	         nb::arg("lb"), nb::arg("ub"))
+	    .def("set_variable_bounds", &set_variable_bounds_list<MOSEKModel>, nb::arg("variables"),
 	         nb::arg("lb"), nb::arg("ub"))
 
 	    .def("get_value", nb::overload_cast<const VariableIndex &>(&MOSEKModel::get_variable_value))
@@ -51,6 +71,9 @@ NB_MODULE(mosek_model_ext, m)
 	    .def("get_value",
 	         nb::overload_cast<const ScalarQuadraticFunction &>(&MOSEKModel::get_expression_value))
 	    .def("get_value", nb::overload_cast<const ExprBuilder &>(&MOSEKModel::get_expression_value))
+	    .def("get_values", &get_variable_values_array<MOSEKModel>, nb::arg("variables"))
+	    .def("get_values", &get_variable_values_list<MOSEKModel>, nb::arg("variables"))
+	    .def("get_values", &get_expression_values_array<MOSEKModel>, nb::arg("exprs"))
 
 	    .def("pprint", &MOSEKModel::pprint_variable)
 	    .def("pprint",
@@ -79,6 +102,10 @@ NB_MODULE(mosek_model_ext, m)
 	         nb::arg("expr"), nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
 	    .def("_add_linear_constraint", &MOSEKModel::add_linear_interval_constraint_from_expr,
 	         nb::arg("expr"), nb::arg("interval"), nb::arg("name") = "")
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<MOSEKModel>,
+	         nb::arg("indptr"), nb::arg("variables"), nb::arg("coefficients"), nb::arg("sense"),
+	         nb::arg("rhs"))
+	    .def("load_cache_model", &load_cache_model<MOSEKModel>, nb::arg("cache"))
 
 	    .def("_add_quadratic_constraint", &MOSEKModel::add_quadratic_constraint, nb::arg("expr"),
 	         nb::arg("sense"), nb::arg("rhs"), nb::arg("name") = "")
@@ -160,11 +187,24 @@ NB_MODULE(mosek_model_ext, m)
 	    BIND_F(get_obj_sense)
 
 		BIND_F(get_normalized_rhs)
-		BIND_F(set_normalized_rhs)
 		BIND_F(get_normalized_coefficient)
 		BIND_F(set_normalized_coefficient)
 		BIND_F(get_objective_coefficient)
 		BIND_F(set_objective_coefficient)
 	    // clang-format on
+	    .def("set_normalized_rhs",
+	         nb::overload_cast<const ConstraintIndex &, double>(&MOSEKModel::set_normalized_rhs))
+	    .def("set_normalized_rhs", &set_normalized_rhs_array<MOSEKModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_rhs", &set_normalized_rhs_list<MOSEKModel>, nb::arg("constraints"),
+	         nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_array<MOSEKModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_list<MOSEKModel>,
+	         nb::arg("constraints"), nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_array<MOSEKModel>,
+	         nb::arg("variables"), nb::arg("values"))
+	    .def("set_objective_coefficients", &set_objective_coefficients_list<MOSEKModel>,
+	         nb::arg("variables"), nb::arg("values"))
 	    .def_rw("m_is_dirty", &MOSEKModel::m_is_dirty);
 }
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "pyoptinterface/nleval.hpp"
+#include "pyoptinterface/hessian_pattern.hpp"
+#include <algorithm>
 #include <cassert>
 #include <span>
 
@@ -19,6 +21,25 @@ ConstraintAutodiffEvaluator::ConstraintAutodiffEvaluator(bool has_parameter, uin
 	}
 }
 
+ConstraintAutodiffEvaluator::ConstraintAutodiffEvaluator(bool has_parameter, uintptr_t fp,
+                                                         uintptr_t jp, uintptr_t hp, uintptr_t fbp,
+                                                         uintptr_t jbp, uintptr_t hbp)
+    : ConstraintAutodiffEvaluator(has_parameter, fp, jp, hp)
+{
+	if (has_parameter)
+	{
+		f_batch_eval.p = (f_batch_funcptr)fbp;
+		jacobian_batch_eval.p = (jacobian_batch_funcptr)jbp;
+		hessian_batch_eval.p = (hessian_batch_funcptr)hbp;
+	}
+	else
+	{
+		f_batch_eval.nop = (f_batch_funcptr_noparam)fbp;
+		jacobian_batch_eval.nop = (jacobian_batch_funcptr_noparam)jbp;
+		hessian_batch_eval.nop = (hessian_batch_funcptr_noparam)hbp;
+	}
+}
+
 ObjectiveAutodiffEvaluator::ObjectiveAutodiffEvaluator(bool has_parameter, uintptr_t fp,
                                                        uintptr_t ajp, uintptr_t hp)
 {
@@ -36,6 +57,25 @@ ObjectiveAutodiffEvaluator::ObjectiveAutodiffEvaluator(bool has_parameter, uintp
 	}
 }
 
+ObjectiveAutodiffEvaluator::ObjectiveAutodiffEvaluator(bool has_parameter, uintptr_t fp,
+                                                       uintptr_t ajp, uintptr_t hp, uintptr_t fbp,
+                                                       uintptr_t ajbp, uintptr_t hbp)
+    : ObjectiveAutodiffEvaluator(has_parameter, fp, ajp, hp)
+{
+	if (has_parameter)
+	{
+		f_batch_eval.p = (f_batch_funcptr)fbp;
+		grad_batch_eval.p = (additive_grad_batch_funcptr)ajbp;
+		hessian_batch_eval.p = (hessian_batch_funcptr)hbp;
+	}
+	else
+	{
+		f_batch_eval.nop = (f_batch_funcptr_noparam)fbp;
+		grad_batch_eval.nop = (additive_grad_batch_funcptr_noparam)ajbp;
+		hessian_batch_eval.nop = (hessian_batch_funcptr_noparam)hbp;
+	}
+}
+
 void LinearEvaluator::add_row(const ScalarAffineFunction &f)
 {
 	coefs.insert(coefs.end(), f.coefficients.begin(), f.coefficients.end());
@@ -51,6 +91,20 @@ void LinearEvaluator::add_row(const ScalarAffineFunction &f)
 	n_constraints += 1;
 }
 
+void LinearEvaluator::add_rows(int M, const int *indptr, const int *variables,
+                               const double *coefficients)
+{
+	auto base = coefs.size();
+	coefs.insert(coefs.end(), coefficients, coefficients + indptr[M]);
+	indices.insert(indices.end(), variables, variables + indptr[M]);
+	for (int i = 0; i < M; i++)
+	{
+		constraint_intervals.push_back(base + indptr[i + 1]);
+	}
+
+	n_constraints += M;
+}
+
 void LinearEvaluator::eval_function(const double *restrict x, double *restrict f)
 {
 	for (size_t i = 0; i < n_constraints; i++)
@@ -348,6 +402,25 @@ void QuadraticEvaluator::analyze_hessian_structure(
 	}
 }
 
+void QuadraticEvaluator::analyze_hessian_structure(HessianPatternBuilder &builder)
+{
+	hessian_diag_indices.resize(diag_coefs.size());
+	hessian_offdiag_indices.resize(offdiag_coefs.size());
+
+	auto position = builder.add_entries(hessian_diag_indices.data(), diag_coefs.size());
+	for (size_t i = 0; i < diag_coefs.size(); i++)
+	{
+		auto x = diag_indices[i];
+		builder.set_entry(position + i, x, x);
+	}
+
+	position = builder.add_entries(hessian_offdiag_indices.data(), offdiag_coefs.size());
+	for (size_t i = 0; i < offdiag_coefs.size(); i++)
+	{
+		builder.set_entry(position + i, offdiag_rows[i], offdiag_cols[i]);
+	}
+}
+
 void QuadraticEvaluator::eval_lagrangian_hessian(const double *restrict lambda,
                                                  double *restrict hessian) const
 {
@@ -388,21 +461,31 @@ int NonlinearEvaluator::add_graph_instance()
 void NonlinearEvaluator::finalize_graph_instance(size_t graph_index, const ExpressionGraph &graph)
 {
 	auto bodyhash = graph.main_structure_hash();
+	auto bodysignature = graph.main_structure_signature();
 
-	graph_inputs[graph_index].variables = graph.m_variables;
-	graph_inputs[graph_index].constants = graph.m_constants;
+	auto &input = graph_inputs[graph_index];
+	input.variables = graph.m_variables;
+	input.constants = graph.m_constants;
+	// the values of parameters are filled by update_parameters
+	input.constants.resize(graph.n_constants() + graph.n_parameters(), 0.0);
+	input.parameters.assign(graph.m_parameters.begin(), graph.m_parameters.end());
 
 	if (graph.has_constraint_output())
 	{
-		auto hash = graph.constraint_structure_hash(bodyhash);
+		GraphStructureKey structure{.hash = graph.constraint_structure_hash(bodyhash),
+		                            .signature =
+		                                graph.constraint_structure_signature(bodysignature)};
 		constraint_graph_hashes.hashes.push_back(
-		    GraphHash{.hash = hash, .index = (int)graph_index});
+		    GraphHash{.structure = std::move(structure), .index = (int)graph_index});
 	}
 
 	if (graph.has_objective_output())
 	{
-		auto hash = graph.objective_structure_hash(bodyhash);
-		objective_graph_hashes.hashes.push_back(GraphHash{.hash = hash, .index = (int)graph_index});
+		GraphStructureKey structure{.hash = graph.objective_structure_hash(bodyhash),
+		                            .signature =
+		                                graph.objective_structure_signature(bodysignature)};
+		objective_graph_hashes.hashes.push_back(
+		    GraphHash{.structure = std::move(structure), .index = (int)graph_index});
 	}
 }
 
@@ -415,16 +498,16 @@ int NonlinearEvaluator::aggregate_constraint_groups()
 	group_memberships.resize(n_graph_instances, GraphGroupMembership{.group = -1, .rank = -1});
 
 	// graph hashes that has not been aggregated
-	std::span<const GraphHash> hashes_to_analyze(graph_hashes.hashes.begin() +
+	std::span<GraphHash> hashes_to_analyze(graph_hashes.hashes.begin() +
 	                                                 graph_hashes.n_hashes_since_last_aggregation,
 	                                             graph_hashes.hashes.end());
 
-	for (const auto &graph_hash : hashes_to_analyze)
+	for (auto &graph_hash : hashes_to_analyze)
 	{
 		auto index = graph_hash.index;
-		auto hash = graph_hash.hash;
-		auto [iter, inserted] =
-		    hash_to_constraint_group.try_emplace(hash, constraint_groups.size());
+		// the signature is moved into the map or released, it is not needed after aggregation
+		auto [iter, inserted] = hash_to_constraint_group.try_emplace(
+		    std::move(graph_hash.structure), constraint_groups.size());
 		auto group_index = iter->second;
 		if (inserted)
 		{
@@ -455,15 +538,15 @@ int NonlinearEvaluator::aggregate_objective_groups()
 	group_memberships.resize(n_graph_instances, GraphGroupMembership{.group = -1, .rank = -1});
 
 	// graph hashes that has not been aggregated
-	std::span<const GraphHash> hashes_to_analyze(graph_hashes.hashes.begin() +
+	std::span<GraphHash> hashes_to_analyze(graph_hashes.hashes.begin() +
 	                                                 graph_hashes.n_hashes_since_last_aggregation,
 	                                             graph_hashes.hashes.end());
 
-	for (const auto &graph_hash : hashes_to_analyze)
+	for (auto &graph_hash : hashes_to_analyze)
 	{
 		auto index = graph_hash.index;
-		auto hash = graph_hash.hash;
-		auto [iter, inserted] = hash_to_objective_group.try_emplace(hash, objective_groups.size());
+		auto [iter, inserted] = hash_to_objective_group.try_emplace(
+		    std::move(graph_hash.structure), objective_groups.size());
 		auto group_index = iter->second;
 		if (inserted)
 		{
@@ -526,73 +609,188 @@ void NonlinearEvaluator::calculate_constraint_graph_instances_offset()
 	}
 }
 
-void NonlinearEvaluator::eval_constraints(const double *restrict x, double *restrict f) const
+template <typename Group>
+static void pack_inputs(Group &group,
+                        const std::vector<NonlinearEvaluator::GraphInput> &graph_inputs)
 {
-	auto &groups = constraint_groups;
-	for (const auto &group : groups)
+	auto &instance_indices = group.instance_indices;
+	auto n_instances = instance_indices.size();
+	auto nx = group.autodiff_structure.nx;
+	auto np = group.autodiff_structure.np;
+
+	group.batch_variables.resize(n_instances * nx);
+	group.batch_constants.resize(n_instances * np);
+	for (size_t j = 0; j < n_instances; j++)
 	{
-		auto &instance_indices = group.instance_indices;
-		auto n_instances = instance_indices.size();
-		auto &structure = group.autodiff_structure;
-		auto &evaluator = group.autodiff_evaluator;
+		auto &input = graph_inputs[instance_indices[j]];
+		if (input.variables.size() != nx || input.constants.size() != np)
+		{
+			throw std::runtime_error("Graph instance does not match the structure of its group");
+		}
+		std::copy(input.variables.begin(), input.variables.end(),
+		          group.batch_variables.begin() + j * nx);
+		std::copy(input.constants.begin(), input.constants.end(),
+		          group.batch_constants.begin() + j * np);
+	}
+}
+
+void NonlinearEvaluator::pack_group_inputs()
+{
+	for (auto &group : constraint_groups)
+	{
+		pack_inputs(group, graph_inputs);
+	}
+	for (auto &group : objective_groups)
+	{
+		pack_inputs(group, graph_inputs);
+	}
+}
+
+template <typename Group>
+static void update_group_parameters(Group &group,
+                                    std::vector<NonlinearEvaluator::GraphInput> &graph_inputs,
+                                    const std::vector<double> &parameter_values)
+{
+	auto &instance_indices = group.instance_indices;
+	auto n_instances = instance_indices.size();
+	// all instances of a group have the same number of parameters
+	if (n_instances == 0 || graph_inputs[instance_indices[0]].parameters.empty())
+	{
+		return;
+	}
+	auto np = group.autodiff_structure.np;
+	for (size_t j = 0; j < n_instances; j++)
+	{
+		auto &input = graph_inputs[instance_indices[j]];
+		auto n_parameters = input.parameters.size();
+		auto n_constants = np - n_parameters;
+		double *batch_constants = group.batch_constants.data() + j * np;
+		for (size_t k = 0; k < n_parameters; k++)
+		{
+			double value = parameter_values[input.parameters[k]];
+			input.constants[n_constants + k] = value;
+			batch_constants[n_constants + k] = value;
+		}
+	}
+}
 
-		auto ny = structure.ny;
+void NonlinearEvaluator::update_parameters(const std::vector<double> &parameter_values)
+{
+	for (auto &group : constraint_groups)
+	{
+		update_group_parameters(group, graph_inputs, parameter_values);
+	}
+	for (auto &group : objective_groups)
+	{
+		update_group_parameters(group, graph_inputs, parameter_values);
+	}
+}
 
+void NonlinearEvaluator::eval_constraint_group(const ConstraintGraphGroup &group, int begin,
+                                               int end, const double *restrict x,
+                                               double *restrict f) const
+{
+	auto &instance_indices = group.instance_indices;
+	auto &structure = group.autodiff_structure;
+	auto &evaluator = group.autodiff_evaluator;
+
+	auto ny = structure.ny;
+
+	if (evaluator.f_batch_eval.p != nullptr)
+	{
+		const int *xi = group.batch_variables.data() + begin * structure.nx;
 		if (!structure.has_parameter)
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				evaluator.f_eval.nop(x, f, variables.data());
-				f += ny;
-			}
+			evaluator.f_batch_eval.nop(end - begin, x, f, xi);
 		}
 		else
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				auto &constant = graph_inputs[instance_index].constants;
-				evaluator.f_eval.p(x, constant.data(), f, variables.data());
-				f += ny;
-			}
+			const double *p = group.batch_constants.data() + begin * structure.np;
+			evaluator.f_batch_eval.p(end - begin, x, p, f, xi);
+		}
+	}
+	else if (!structure.has_parameter)
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			evaluator.f_eval.nop(x, f, variables.data());
+			f += ny;
+		}
+	}
+	else
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			auto &constant = graph_inputs[instance_index].constants;
+			evaluator.f_eval.p(x, constant.data(), f, variables.data());
+			f += ny;
 		}
 	}
 }
 
-double NonlinearEvaluator::eval_objective(const double *restrict x) const
+void NonlinearEvaluator::eval_constraints(const double *restrict x, double *restrict f) const
 {
-	auto &groups = objective_groups;
-	double obj_value = 0.0;
-	for (const auto &group : groups)
+	for (const auto &group : constraint_groups)
 	{
-		auto &instance_indices = group.instance_indices;
-		auto n_instances = instance_indices.size();
-		auto &structure = group.autodiff_structure;
-		auto &evaluator = group.autodiff_evaluator;
+		auto n_instances = group.instance_indices.size();
+		eval_constraint_group(group, 0, n_instances, x, f);
+		f += group.autodiff_structure.ny * n_instances;
+	}
+}
+
+void NonlinearEvaluator::eval_objective_group(const ObjectiveGraphGroup &group, int begin,
+                                              int end, const double *restrict x,
+                                              double *restrict f) const
+{
+	auto &instance_indices = group.instance_indices;
+	auto &structure = group.autodiff_structure;
+	auto &evaluator = group.autodiff_evaluator;
 
+	if (evaluator.f_batch_eval.p != nullptr)
+	{
+		const int *xi = group.batch_variables.data() + begin * structure.nx;
 		if (!structure.has_parameter)
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				evaluator.f_eval.nop(x, &obj_value, variables.data());
-			}
+			evaluator.f_batch_eval.nop(end - begin, x, f, xi);
 		}
 		else
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				auto &constant = graph_inputs[instance_index].constants;
-				evaluator.f_eval.p(x, constant.data(), &obj_value, variables.data());
-			}
+			const double *p = group.batch_constants.data() + begin * structure.np;
+			evaluator.f_batch_eval.p(end - begin, x, p, f, xi);
+		}
+	}
+	else if (!structure.has_parameter)
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			evaluator.f_eval.nop(x, f, variables.data());
 		}
 	}
+	else
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			auto &constant = graph_inputs[instance_index].constants;
+			evaluator.f_eval.p(x, constant.data(), f, variables.data());
+		}
+	}
+}
+
+double NonlinearEvaluator::eval_objective(const double *restrict x) const
+{
+	double obj_value = 0.0;
+	for (const auto &group : objective_groups)
+	{
+		eval_objective_group(group, 0, group.instance_indices.size(), x, &obj_value);
+	}
 	return obj_value;
 }
 
@@ -682,85 +880,129 @@ void NonlinearEvaluator::analyze_objective_gradient_structure(
 	}
 }
 
-void NonlinearEvaluator::eval_constraints_jacobian(const double *restrict x,
-                                                   double *restrict jacobian) const
+void NonlinearEvaluator::eval_constraint_group_jacobian(const ConstraintGraphGroup &group,
+                                                        int begin, int end,
+                                                        const double *restrict x,
+                                                        double *restrict jacobian) const
 {
-	auto &groups = constraint_groups;
+	auto &instance_indices = group.instance_indices;
+	auto &structure = group.autodiff_structure;
+	auto &evaluator = group.autodiff_evaluator;
 
-	for (const auto &group : groups)
+	auto local_jacobian_nnz = structure.m_jacobian_nnz;
+
+	if (evaluator.jacobian_batch_eval.p != nullptr)
 	{
-		auto &instance_indices = group.instance_indices;
-		auto n_instances = instance_indices.size();
-		auto &structure = group.autodiff_structure;
-		auto &evaluator = group.autodiff_evaluator;
-		if (!structure.has_jacobian)
-		{
-			continue;
-		}
-		auto local_jacobian_nnz = structure.m_jacobian_nnz;
+		const int *xi = group.batch_variables.data() + begin * structure.nx;
 		if (!structure.has_parameter)
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				evaluator.jacobian_eval.nop(x, jacobian, variables.data());
-				jacobian += local_jacobian_nnz;
-			}
+			evaluator.jacobian_batch_eval.nop(end - begin, x, jacobian, xi);
 		}
 		else
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				auto &constant = graph_inputs[instance_index].constants;
-				evaluator.jacobian_eval.p(x, constant.data(), jacobian, variables.data());
-				jacobian += local_jacobian_nnz;
-			}
+			const double *p = group.batch_constants.data() + begin * structure.np;
+			evaluator.jacobian_batch_eval.p(end - begin, x, p, jacobian, xi);
+		}
+	}
+	else if (!structure.has_parameter)
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			evaluator.jacobian_eval.nop(x, jacobian, variables.data());
+			jacobian += local_jacobian_nnz;
+		}
+	}
+	else
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			auto &constant = graph_inputs[instance_index].constants;
+			evaluator.jacobian_eval.p(x, constant.data(), jacobian, variables.data());
+			jacobian += local_jacobian_nnz;
 		}
 	}
 }
 
-void NonlinearEvaluator::eval_objective_gradient(const double *restrict x,
-                                                 double *restrict grad_f) const
+void NonlinearEvaluator::eval_constraints_jacobian(const double *restrict x,
+                                                   double *restrict jacobian) const
 {
-	auto &groups = objective_groups;
-
-	for (const auto &group : groups)
+	for (const auto &group : constraint_groups)
 	{
-		auto &instance_indices = group.instance_indices;
-		auto n_instances = instance_indices.size();
 		auto &structure = group.autodiff_structure;
-		auto &evaluator = group.autodiff_evaluator;
 		if (!structure.has_jacobian)
 		{
 			continue;
 		}
-		auto local_jacobian_nnz = structure.m_jacobian_nnz;
-		const int *grad_index = group.gradient_indices.data();
+		auto n_instances = group.instance_indices.size();
+		eval_constraint_group_jacobian(group, 0, n_instances, x, jacobian);
+		jacobian += structure.m_jacobian_nnz * n_instances;
+	}
+}
+
+void NonlinearEvaluator::eval_objective_group_gradient(const ObjectiveGraphGroup &group,
+                                                       int begin, int end,
+                                                       const double *restrict x,
+                                                       double *restrict grad_f,
+                                                       const int *restrict gradient_indices) const
+{
+	auto &instance_indices = group.instance_indices;
+	auto &structure = group.autodiff_structure;
+	auto &evaluator = group.autodiff_evaluator;
+
+	auto local_jacobian_nnz = structure.m_jacobian_nnz;
+
+	if (evaluator.grad_batch_eval.p != nullptr)
+	{
+		const int *xi = group.batch_variables.data() + begin * structure.nx;
 		if (!structure.has_parameter)
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				evaluator.grad_eval.nop(x, grad_f, variables.data(), grad_index);
-				grad_index += local_jacobian_nnz;
-			}
+			evaluator.grad_batch_eval.nop(end - begin, x, grad_f, xi, gradient_indices);
 		}
 		else
 		{
-			for (int j = 0; j < n_instances; j++)
-			{
-				auto instance_index = instance_indices[j];
-				auto &variables = graph_inputs[instance_index].variables;
-				auto &constant = graph_inputs[instance_index].constants;
-				evaluator.grad_eval.p(x, constant.data(), grad_f, variables.data(), grad_index);
-				grad_index += local_jacobian_nnz;
-			}
+			const double *p = group.batch_constants.data() + begin * structure.np;
+			evaluator.grad_batch_eval.p(end - begin, x, p, grad_f, xi, gradient_indices);
+		}
+	}
+	else if (!structure.has_parameter)
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			evaluator.grad_eval.nop(x, grad_f, variables.data(), gradient_indices);
+			gradient_indices += local_jacobian_nnz;
 		}
 	}
+	else
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			auto &constant = graph_inputs[instance_index].constants;
+			evaluator.grad_eval.p(x, constant.data(), grad_f, variables.data(), gradient_indices);
+			gradient_indices += local_jacobian_nnz;
+		}
+	}
+}
+
+void NonlinearEvaluator::eval_objective_gradient(const double *restrict x,
+                                                 double *restrict grad_f) const
+{
+	for (const auto &group : objective_groups)
+	{
+		if (!group.autodiff_structure.has_jacobian)
+		{
+			continue;
+		}
+		eval_objective_group_gradient(group, 0, group.instance_indices.size(), x, grad_f,
+		                              group.gradient_indices.data());
+	}
 }
 
 void NonlinearEvaluator::analyze_constraints_hessian_structure(
@@ -889,6 +1131,159 @@ void NonlinearEvaluator::analyze_objective_hessian_structure(
 	}
 }
 
+template <typename Group>
+static void add_group_hessian_entries(Group &group,
+                                      const std::vector<NonlinearEvaluator::GraphInput> &graph_inputs,
+                                      HessianPatternBuilder &builder)
+{
+	auto &instance_indices = group.instance_indices;
+	auto n_instances = instance_indices.size();
+	auto &structure = group.autodiff_structure;
+
+	if (!structure.has_hessian)
+	{
+		return;
+	}
+
+	auto local_hessian_nnz = structure.m_hessian_nnz;
+	auto &local_hessian_rows = structure.m_hessian_rows;
+	auto &local_hessian_cols = structure.m_hessian_cols;
+
+	group.hessian_indices.resize(n_instances * local_hessian_nnz);
+	auto position = builder.add_entries(group.hessian_indices.data(), group.hessian_indices.size());
+
+	for (size_t j = 0; j < n_instances; j++)
+	{
+		auto &variables = graph_inputs[instance_indices[j]].variables;
+		for (size_t k = 0; k < local_hessian_nnz; k++)
+		{
+			builder.set_entry(position, variables[local_hessian_rows[k]],
+			                  variables[local_hessian_cols[k]]);
+			position++;
+		}
+	}
+}
+
+void NonlinearEvaluator::analyze_constraints_hessian_structure(HessianPatternBuilder &builder)
+{
+	for (auto &group : constraint_groups)
+	{
+		add_group_hessian_entries(group, graph_inputs, builder);
+	}
+}
+
+void NonlinearEvaluator::analyze_objective_hessian_structure(HessianPatternBuilder &builder)
+{
+	for (auto &group : objective_groups)
+	{
+		add_group_hessian_entries(group, graph_inputs, builder);
+	}
+}
+
+void NonlinearEvaluator::eval_objective_group_hessian(const ObjectiveGraphGroup &group,
+                                                      int begin, int end,
+                                                      const double *restrict x,
+                                                      const double *restrict sigma,
+                                                      double *restrict hessian,
+                                                      const int *restrict hessian_indices) const
+{
+	auto &instance_indices = group.instance_indices;
+	auto &structure = group.autodiff_structure;
+	auto &evaluator = group.autodiff_evaluator;
+
+	auto local_hessian_nnz = structure.m_hessian_nnz;
+
+	if (evaluator.hessian_batch_eval.p != nullptr)
+	{
+		const int *xi = group.batch_variables.data() + begin * structure.nx;
+		if (!structure.has_parameter)
+		{
+			evaluator.hessian_batch_eval.nop(end - begin, x, sigma, hessian, xi, hessian_indices);
+		}
+		else
+		{
+			const double *p = group.batch_constants.data() + begin * structure.np;
+			evaluator.hessian_batch_eval.p(end - begin, x, p, sigma, hessian, xi,
+			                               hessian_indices);
+		}
+	}
+	else if (!structure.has_parameter)
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			evaluator.hessian_eval.nop(x, sigma, hessian, variables.data(), hessian_indices);
+			hessian_indices += local_hessian_nnz;
+		}
+	}
+	else
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			auto &constant = graph_inputs[instance_index].constants;
+			evaluator.hessian_eval.p(x, constant.data(), sigma, hessian, variables.data(),
+			                         hessian_indices);
+			hessian_indices += local_hessian_nnz;
+		}
+	}
+}
+
+void NonlinearEvaluator::eval_constraint_group_hessian(const ConstraintGraphGroup &group,
+                                                       int begin, int end,
+                                                       const double *restrict x,
+                                                       const double *restrict w,
+                                                       double *restrict hessian,
+                                                       const int *restrict hessian_indices) const
+{
+	auto &instance_indices = group.instance_indices;
+	auto &structure = group.autodiff_structure;
+	auto &evaluator = group.autodiff_evaluator;
+
+	auto local_hessian_nnz = structure.m_hessian_nnz;
+	auto ny = structure.ny;
+
+	if (evaluator.hessian_batch_eval.p != nullptr)
+	{
+		const int *xi = group.batch_variables.data() + begin * structure.nx;
+		if (!structure.has_parameter)
+		{
+			evaluator.hessian_batch_eval.nop(end - begin, x, w, hessian, xi, hessian_indices);
+		}
+		else
+		{
+			const double *p = group.batch_constants.data() + begin * structure.np;
+			evaluator.hessian_batch_eval.p(end - begin, x, p, w, hessian, xi, hessian_indices);
+		}
+	}
+	else if (!structure.has_parameter)
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			evaluator.hessian_eval.nop(x, w, hessian, variables.data(), hessian_indices);
+			hessian_indices += local_hessian_nnz;
+			w += ny;
+		}
+	}
+	else
+	{
+		for (int j = begin; j < end; j++)
+		{
+			auto instance_index = instance_indices[j];
+			auto &variables = graph_inputs[instance_index].variables;
+			auto &constant = graph_inputs[instance_index].constants;
+			evaluator.hessian_eval.p(x, constant.data(), w, hessian, variables.data(),
+			                         hessian_indices);
+			hessian_indices += local_hessian_nnz;
+			w += ny;
+		}
+	}
+}
+
 void NonlinearEvaluator::eval_lagrangian_hessian(const double *restrict x,
                                                  const double *restrict lambda,
                                                  const double obj_factor,
@@ -898,89 +1293,321 @@ void NonlinearEvaluator::eval_lagrangian_hessian(const double *restrict x,
 	// obj_factor is the multiplier of objective function
 
 	// objective
+	for (const auto &group : objective_groups)
 	{
-		auto &groups = objective_groups;
-		for (const auto &group : groups)
+		if (!group.autodiff_structure.has_hessian)
 		{
-			auto &instance_indices = group.instance_indices;
-			auto n_instances = instance_indices.size();
-			auto &structure = group.autodiff_structure;
-			auto &evaluator = group.autodiff_evaluator;
+			continue;
+		}
+		eval_objective_group_hessian(group, 0, group.instance_indices.size(), x, &obj_factor,
+		                             hessian, group.hessian_indices.data());
+	}
 
-			if (!structure.has_hessian)
-			{
-				continue;
-			}
+	// constraints
+	for (const auto &group : constraint_groups)
+	{
+		auto &structure = group.autodiff_structure;
+		auto n_instances = group.instance_indices.size();
+		if (structure.has_hessian)
+		{
+			eval_constraint_group_hessian(group, 0, n_instances, x, lambda, hessian,
+			                              group.hessian_indices.data());
+		}
+		lambda += structure.ny * n_instances;
+	}
+}
+
+static void partition_instances(const std::vector<size_t> &group_sizes,
+                                const std::vector<size_t> &group_weights, size_t n_tasks,
+                                NonlinearEvaluator::InstancePartition &partition)
+{
+	partition.ranges.clear();
+	partition.intervals.assign(1, 0);
 
-			auto local_hessian_nnz = structure.m_hessian_nnz;
-			const int *hessian_index = group.hessian_indices.data();
+	size_t total_weight = 0;
+	for (size_t i = 0; i < group_sizes.size(); i++)
+	{
+		total_weight += group_sizes[i] * group_weights[i];
+	}
+	size_t target_weight = (total_weight + n_tasks - 1) / n_tasks;
+	if (target_weight == 0)
+	{
+		target_weight = 1;
+	}
 
-			if (!structure.has_parameter)
+	size_t filled_weight = 0;
+	for (size_t i = 0; i < group_sizes.size(); i++)
+	{
+		size_t n_instances = group_sizes[i];
+		size_t weight = group_weights[i];
+		size_t begin = 0;
+		while (begin < n_instances)
+		{
+			size_t take = n_instances - begin;
+			bool is_last_partition = partition.intervals.size() == n_tasks;
+			if (!is_last_partition)
 			{
-				for (int j = 0; j < n_instances; j++)
-				{
-					auto instance_index = instance_indices[j];
-					auto &variables = graph_inputs[instance_index].variables;
-					evaluator.hessian_eval.nop(x, &obj_factor, hessian, variables.data(),
-					                           hessian_index);
-					hessian_index += local_hessian_nnz;
-				}
+				size_t capacity = target_weight - filled_weight;
+				take = std::min(take, (capacity + weight - 1) / weight);
 			}
-			else
+			partition.ranges.push_back(NonlinearEvaluator::InstanceRange{
+			    .group = (int)i, .begin = (int)begin, .end = (int)(begin + take)});
+			begin += take;
+			filled_weight += take * weight;
+
+			if (!is_last_partition && filled_weight >= target_weight)
 			{
-				for (int j = 0; j < n_instances; j++)
-				{
-					auto instance_index = instance_indices[j];
-					auto &variables = graph_inputs[instance_index].variables;
-					auto &constant = graph_inputs[instance_index].constants;
-					evaluator.hessian_eval.p(x, constant.data(), &obj_factor, hessian,
-					                         variables.data(), hessian_index);
-					hessian_index += local_hessian_nnz;
-				}
+				partition.intervals.push_back(partition.ranges.size());
+				filled_weight = 0;
 			}
 		}
 	}
+	while (partition.intervals.size() < n_tasks + 1)
+	{
+		partition.intervals.push_back(partition.ranges.size());
+	}
+}
 
-	// constraints
+void NonlinearEvaluator::prepare_parallel_evaluation(size_t n_tasks, size_t global_hessian_nnz)
+{
+	if (n_tasks < 1)
 	{
-		auto &groups = constraint_groups;
-		for (const auto &group : groups)
+		n_tasks = 1;
+	}
+	auto &plan = parallel_plan;
+	plan.n_tasks = n_tasks;
+
+	auto n_constraint_groups = constraint_groups.size();
+	auto n_objective_groups = objective_groups.size();
+
+	std::vector<size_t> group_sizes, group_weights;
+
+	// constraints and jacobian
+	plan.constraint_f_offsets.resize(n_constraint_groups);
+	plan.constraint_jacobian_offsets.resize(n_constraint_groups);
+	group_sizes.resize(n_constraint_groups);
+	group_weights.resize(n_constraint_groups);
+	int f_offset = 0;
+	int jacobian_offset = 0;
+	for (size_t i = 0; i < n_constraint_groups; i++)
+	{
+		const auto &group = constraint_groups[i];
+		const auto &structure = group.autodiff_structure;
+		auto n_instances = group.instance_indices.size();
+
+		plan.constraint_f_offsets[i] = f_offset;
+		plan.constraint_jacobian_offsets[i] = jacobian_offset;
+		f_offset += structure.ny * n_instances;
+		size_t jacobian_nnz = structure.has_jacobian ? structure.m_jacobian_nnz : 0;
+		jacobian_offset += jacobian_nnz * n_instances;
+
+		group_sizes[i] = n_instances;
+		group_weights[i] = structure.ny + jacobian_nnz + 1;
+	}
+	partition_instances(group_sizes, group_weights, n_tasks, plan.constraint_partition);
+
+	// hessian of objectives and constraints share one local buffer
+	size_t local_hessian_size = 0;
+	bool with_hessian = global_hessian_nnz > 0;
+
+	plan.objective_hessian_offsets.resize(n_objective_groups);
+	group_sizes.resize(n_objective_groups);
+	group_weights.resize(n_objective_groups);
+	for (size_t i = 0; i < n_objective_groups; i++)
+	{
+		const auto &group = objective_groups[i];
+		const auto &structure = group.autodiff_structure;
+		size_t hessian_nnz = with_hessian && structure.has_hessian ? structure.m_hessian_nnz : 0;
+		size_t n_instances = hessian_nnz > 0 ? group.instance_indices.size() : 0;
+
+		plan.objective_hessian_offsets[i] = local_hessian_size;
+		local_hessian_size += hessian_nnz * n_instances;
+
+		group_sizes[i] = n_instances;
+		group_weights[i] = hessian_nnz + 1;
+	}
+	partition_instances(group_sizes, group_weights, n_tasks, plan.objective_hessian_partition);
+
+	plan.constraint_hessian_offsets.resize(n_constraint_groups);
+	group_sizes.resize(n_constraint_groups);
+	group_weights.resize(n_constraint_groups);
+	for (size_t i = 0; i < n_constraint_groups; i++)
+	{
+		const auto &group = constraint_groups[i];
+		const auto &structure = group.autodiff_structure;
+		size_t hessian_nnz = with_hessian && structure.has_hessian ? structure.m_hessian_nnz : 0;
+		size_t n_instances = hessian_nnz > 0 ? group.instance_indices.size() : 0;
+
+		plan.constraint_hessian_offsets[i] = local_hessian_size;
+		local_hessian_size += hessian_nnz * n_instances;
+
+		group_sizes[i] = n_instances;
+		group_weights[i] = hessian_nnz + 1;
+	}
+	partition_instances(group_sizes, group_weights, n_tasks, plan.constraint_hessian_partition);
+
+	plan.local_hessian_indices.resize(local_hessian_size);
+	for (size_t k = 0; k < local_hessian_size; k++)
+	{
+		plan.local_hessian_indices[k] = k;
+	}
+	plan.local_hessian.resize(local_hessian_size);
+
+	// transpose the scatter map with a stable counting sort, the sources of each slot are
+	// visited in the same order as the serial evaluation (objectives first, then constraints)
+	auto &intervals = plan.hessian_source_intervals;
+	auto &sources = plan.hessian_sources;
+	intervals.assign(global_hessian_nnz + 1, 0);
+	sources.resize(local_hessian_size);
+
+	auto visit_hessian_indices = [&](auto &&f) {
+		if (!with_hessian)
+		{
+			return;
+		}
+		for (const auto &group : objective_groups)
+		{
+			if (group.autodiff_structure.has_hessian)
+				f(group.hessian_indices);
+		}
+		for (const auto &group : constraint_groups)
+		{
+			if (group.autodiff_structure.has_hessian)
+				f(group.hessian_indices);
+		}
+	};
+
+	visit_hessian_indices([&](const std::vector<int> &hessian_indices) {
+		for (auto slot : hessian_indices)
+		{
+			intervals[slot + 1] += 1;
+		}
+	});
+	for (size_t i = 0; i < global_hessian_nnz; i++)
+	{
+		intervals[i + 1] += intervals[i];
+	}
+	std::vector<int> cursor(intervals.begin(), intervals.end() - 1);
+	int local_index = 0;
+	visit_hessian_indices([&](const std::vector<int> &hessian_indices) {
+		for (auto slot : hessian_indices)
+		{
+			sources[cursor[slot]++] = local_index;
+			local_index++;
+		}
+	});
+}
+
+void NonlinearEvaluator::eval_constraints_parallel(const double *restrict x, double *restrict f,
+                                                   ThreadPool &pool) const
+{
+	auto &plan = parallel_plan;
+	auto &partition = plan.constraint_partition;
+
+	pool.parallel_for(plan.n_tasks, [&](size_t task) {
+		for (int r = partition.intervals[task]; r < partition.intervals[task + 1]; r++)
+		{
+			auto &range = partition.ranges[r];
+			auto &group = constraint_groups[range.group];
+			auto ny = group.autodiff_structure.ny;
+			double *y = f + plan.constraint_f_offsets[range.group] + range.begin * ny;
+			eval_constraint_group(group, range.begin, range.end, x, y);
+		}
+	});
+}
+
+void NonlinearEvaluator::eval_constraints_jacobian_parallel(const double *restrict x,
+                                                            double *restrict jacobian,
+                                                            ThreadPool &pool) const
+{
+	auto &plan = parallel_plan;
+	auto &partition = plan.constraint_partition;
+
+	pool.parallel_for(plan.n_tasks, [&](size_t task) {
+		for (int r = partition.intervals[task]; r < partition.intervals[task + 1]; r++)
 		{
-			auto &instance_indices = group.instance_indices;
-			auto n_instances = instance_indices.size();
+			auto &range = partition.ranges[r];
+			auto &group = constraint_groups[range.group];
 			auto &structure = group.autodiff_structure;
-			auto &evaluator = group.autodiff_evaluator;
-			if (!structure.has_hessian)
+			if (!structure.has_jacobian)
 			{
 				continue;
 			}
-			auto local_hessian_nnz = structure.m_hessian_nnz;
-			auto ny = structure.ny;
-			const int *hessian_index = group.hessian_indices.data();
-			if (!structure.has_parameter)
+			double *jac = jacobian + plan.constraint_jacobian_offsets[range.group] +
+			              range.begin * structure.m_jacobian_nnz;
+			eval_constraint_group_jacobian(group, range.begin, range.end, x, jac);
+		}
+	});
+}
+
+void NonlinearEvaluator::eval_lagrangian_hessian_parallel(const double *restrict x,
+                                                          const double *restrict lambda,
+                                                          const double obj_factor,
+                                                          double *restrict hessian,
+                                                          ThreadPool &pool)
+{
+	auto &plan = parallel_plan;
+	auto n_tasks = plan.n_tasks;
+	const int *local_indices = plan.local_hessian_indices.data();
+	double *local_hessian = plan.local_hessian.data();
+
+	// tasks [0, n_tasks) evaluate objectives, tasks [n_tasks, 2 * n_tasks) evaluate constraints
+	pool.parallel_for(2 * n_tasks, [&](size_t task) {
+		if (task < n_tasks)
+		{
+			auto &partition = plan.objective_hessian_partition;
+			for (int r = partition.intervals[task]; r < partition.intervals[task + 1]; r++)
 			{
-				for (int j = 0; j < n_instances; j++)
-				{
-					auto instance_index = instance_indices[j];
-					auto &variables = graph_inputs[instance_index].variables;
-					evaluator.hessian_eval.nop(x, lambda, hessian, variables.data(), hessian_index);
-					hessian_index += local_hessian_nnz;
-					lambda += ny;
-				}
+				auto &range = partition.ranges[r];
+				auto &group = objective_groups[range.group];
+				auto local_hessian_nnz = group.autodiff_structure.m_hessian_nnz;
+				auto offset =
+				    plan.objective_hessian_offsets[range.group] + range.begin * local_hessian_nnz;
+				std::fill(local_hessian + offset,
+				          local_hessian + offset + (range.end - range.begin) * local_hessian_nnz,
+				          0.0);
+				eval_objective_group_hessian(group, range.begin, range.end, x, &obj_factor,
+				                             local_hessian, local_indices + offset);
 			}
-			else
+		}
+		else
+		{
+			auto &partition = plan.constraint_hessian_partition;
+			task -= n_tasks;
+			for (int r = partition.intervals[task]; r < partition.intervals[task + 1]; r++)
 			{
-				for (int j = 0; j < n_instances; j++)
-				{
-					auto instance_index = instance_indices[j];
-					auto &variables = graph_inputs[instance_index].variables;
-					auto &constant = graph_inputs[instance_index].constants;
-					evaluator.hessian_eval.p(x, constant.data(), lambda, hessian, variables.data(),
-					                         hessian_index);
-					hessian_index += local_hessian_nnz;
-					lambda += ny;
-				}
+				auto &range = partition.ranges[r];
+				auto &group = constraint_groups[range.group];
+				auto local_hessian_nnz = group.autodiff_structure.m_hessian_nnz;
+				auto ny = group.autodiff_structure.ny;
+				auto offset =
+				    plan.constraint_hessian_offsets[range.group] + range.begin * local_hessian_nnz;
+				std::fill(local_hessian + offset,
+				          local_hessian + offset + (range.end - range.begin) * local_hessian_nnz,
+				          0.0);
+				const double *w = lambda + plan.constraint_f_offsets[range.group] + range.begin * ny;
+				eval_constraint_group_hessian(group, range.begin, range.end, x, w, local_hessian,
+				                              local_indices + offset);
 			}
 		}
-	}
+	});
+
+	// reduce the local hessian into the global slots
+	auto &intervals = plan.hessian_source_intervals;
+	auto &sources = plan.hessian_sources;
+	size_t n_slots = intervals.size() - 1;
+	size_t slots_per_task = (n_slots + n_tasks - 1) / n_tasks;
+	pool.parallel_for(n_tasks, [&](size_t task) {
+		size_t slot_begin = std::min(n_slots, task * slots_per_task);
+		size_t slot_end = std::min(n_slots, slot_begin + slots_per_task);
+		for (size_t slot = slot_begin; slot < slot_end; slot++)
+		{
+			double value = hessian[slot];
+			for (int s = intervals[slot]; s < intervals[slot + 1]; s++)
+			{
+				value += local_hessian[sources[s]];
+			}
+			hessian[slot] = value;
+		}
+	});
 }
@@ -1,5 +1,6 @@
 #include <nanobind/nanobind.h>
 #include <nanobind/stl/vector.h>
+#include <nanobind/stl/tuple.h>
 
 #include "pyoptinterface/nleval.hpp"
 
@@ -20,13 +21,33 @@ NB_MODULE(nleval_ext, m)
 	    .def_ro("m_hessian_nnz", &AutodiffSymbolicStructure::m_hessian_nnz)
 	    .def_ro("has_parameter", &AutodiffSymbolicStructure::has_parameter)
 	    .def_ro("has_jacobian", &AutodiffSymbolicStructure::has_jacobian)
-	    .def_ro("has_hessian", &AutodiffSymbolicStructure::has_hessian);
+	    .def_ro("has_hessian", &AutodiffSymbolicStructure::has_hessian)
+	    // pickle support, used by the on-disk cache of compiled evaluators
+	    .def("__getstate__",
+	         [](const AutodiffSymbolicStructure &s) {
+		         return std::make_tuple(s.nx, s.np, s.ny, s.m_jacobian_rows, s.m_jacobian_cols,
+		                                s.m_jacobian_nnz, s.m_hessian_rows, s.m_hessian_cols,
+		                                s.m_hessian_nnz, s.has_parameter, s.has_jacobian,
+		                                s.has_hessian);
+	         })
+	    .def("__setstate__",
+	         [](AutodiffSymbolicStructure &s,
+	            const std::tuple<size_t, size_t, size_t, std::vector<size_t>, std::vector<size_t>,
+	                             size_t, std::vector<size_t>, std::vector<size_t>, size_t, bool,
+	                             bool, bool> &state) {
+		         new (&s) AutodiffSymbolicStructure();
+		         std::tie(s.nx, s.np, s.ny, s.m_jacobian_rows, s.m_jacobian_cols, s.m_jacobian_nnz,
+		                  s.m_hessian_rows, s.m_hessian_cols, s.m_hessian_nnz, s.has_parameter,
+		                  s.has_jacobian, s.has_hessian) = state;
+	         });
 
 	nb::class_<ConstraintAutodiffEvaluator>(m, "ConstraintAutodiffEvaluator")
 	    .def(nb::init<>())
-	    .def(nb::init<bool, uintptr_t, uintptr_t, uintptr_t>());
+	    .def(nb::init<bool, uintptr_t, uintptr_t, uintptr_t>())
+	    .def(nb::init<bool, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t>());
 
 	nb::class_<ObjectiveAutodiffEvaluator>(m, "ObjectiveAutodiffEvaluator")
 	    .def(nb::init<>())
-	    .def(nb::init<bool, uintptr_t, uintptr_t, uintptr_t>());
+	    .def(nb::init<bool, uintptr_t, uintptr_t, uintptr_t>())
+	    .def(nb::init<bool, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t, uintptr_t>());
 }
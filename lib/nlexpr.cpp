@@ -1,7 +1,9 @@
 #include "pyoptinterface/nlexpr.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <stdexcept>
 #include "fmt/core.h"
 
 bool ExpressionHandle::operator==(const ExpressionHandle &x) const
@@ -335,6 +337,11 @@ ExpressionHandle ExpressionGraph::merge_variableindex(const VariableIndex &v)
 	return add_variable(v.index);
 }
 
+ExpressionHandle ExpressionGraph::merge_parameterindex(const ParameterIndex &p)
+{
+	return add_parameter(p.index);
+}
+
 ExpressionHandle ExpressionGraph::merge_scalaraffinefunction(const ScalarAffineFunction &f)
 {
 	// Convert it to a n-ary sum of multiplication nodes
@@ -429,7 +436,7 @@ ExpressionHandle ExpressionGraph::merge_scalarquadraticfunction(const ScalarQuad
 ExpressionHandle ExpressionGraph::merge_exprbuilder(const ExprBuilder &expr)
 {
 	std::vector<ExpressionHandle> terms;
-	terms.reserve(expr.quadratic_terms.size() + expr.affine_terms.size() + 1);
+	terms.reserve(expr.quadratic_terms.size() + expr.affine_size() + 1);
 	for (const auto &[varpair, coef] : expr.quadratic_terms)
 	{
 		auto x1 = varpair.var_1;
@@ -462,8 +469,7 @@ ExpressionHandle ExpressionGraph::merge_exprbuilder(const ExprBuilder &expr)
 			terms.push_back(add_nary(NaryOperator::Mul, {c, x1_var, x2_var}));
 		}
 	}
-	for (const auto &[var, coef] : expr.affine_terms)
-	{
+	expr.for_each_affine_term([&](IndexT var, CoeffT coef) {
 		auto x = add_variable(var);
 		if (coef == 1.0)
 		{
@@ -479,7 +485,7 @@ ExpressionHandle ExpressionGraph::merge_exprbuilder(const ExprBuilder &expr)
 			auto c = add_constant(coef);
 			terms.push_back(add_nary(NaryOperator::Mul, {c, x}));
 		}
-	}
+	});
 	if (expr.constant_term)
 	{
 		terms.push_back(add_constant(expr.constant_term.value()));
@@ -664,6 +670,515 @@ uint64_t ExpressionGraph::objective_structure_hash(uint64_t hash) const
 	return hash;
 }
 
+static void signature_append(std::string &signature, uint32_t value)
+{
+	signature.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+static void signature_append(std::string &signature, const ExpressionHandle &expr)
+{
+	signature_append(signature, static_cast<uint32_t>(expr.array));
+	signature_append(signature, static_cast<uint32_t>(expr.id));
+}
+
+std::string ExpressionGraph::main_structure_signature() const
+{
+	std::string signature;
+	signature_append(signature, m_variables.size());
+	signature_append(signature, m_constants.size());
+	signature_append(signature, m_parameters.size());
+
+	signature_append(signature, m_unaries.size());
+	for (const auto &unary : m_unaries)
+	{
+		signature_append(signature, (uint32_t)unary.op);
+		signature_append(signature, unary.operand);
+	}
+	signature_append(signature, m_binaries.size());
+	for (const auto &binary : m_binaries)
+	{
+		signature_append(signature, (uint32_t)binary.op);
+		signature_append(signature, binary.left);
+		signature_append(signature, binary.right);
+	}
+	signature_append(signature, m_ternaries.size());
+	for (const auto &ternary : m_ternaries)
+	{
+		signature_append(signature, (uint32_t)ternary.op);
+		signature_append(signature, ternary.left);
+		signature_append(signature, ternary.middle);
+		signature_append(signature, ternary.right);
+	}
+	signature_append(signature, m_naries.size());
+	for (const auto &nary : m_naries)
+	{
+		signature_append(signature, (uint32_t)nary.op);
+		signature_append(signature, nary.operands.size());
+		for (const auto &operand : nary.operands)
+		{
+			signature_append(signature, operand);
+		}
+	}
+	return signature;
+}
+
+std::string ExpressionGraph::constraint_structure_signature(std::string signature) const
+{
+	signature_append(signature, m_constraint_outputs.size());
+	for (const auto &output : m_constraint_outputs)
+	{
+		signature_append(signature, output);
+	}
+	return signature;
+}
+
+std::string ExpressionGraph::objective_structure_signature(std::string signature) const
+{
+	signature_append(signature, m_objective_outputs.size());
+	for (const auto &output : m_objective_outputs)
+	{
+		signature_append(signature, output);
+	}
+	return signature;
+}
+
+static bool is_commutative_binary_op(BinaryOperator op)
+{
+	return op == BinaryOperator::Add2 || op == BinaryOperator::Mul2;
+}
+
+// operands of a node in the order they appear in the node
+static void node_operands(const ExpressionGraph &graph, const ExpressionHandle &expr,
+                          std::vector<ExpressionHandle> &operands)
+{
+	operands.clear();
+	switch (expr.array)
+	{
+	case ArrayType::Unary:
+		operands.push_back(graph.m_unaries[expr.id].operand);
+		break;
+	case ArrayType::Binary: {
+		const auto &binary = graph.m_binaries[expr.id];
+		operands.push_back(binary.left);
+		operands.push_back(binary.right);
+		break;
+	}
+	case ArrayType::Ternary: {
+		const auto &ternary = graph.m_ternaries[expr.id];
+		operands.push_back(ternary.left);
+		operands.push_back(ternary.middle);
+		operands.push_back(ternary.right);
+		break;
+	}
+	case ArrayType::Nary: {
+		const auto &nary = graph.m_naries[expr.id];
+		operands.insert(operands.end(), nary.operands.begin(), nary.operands.end());
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+static bool is_commutative_node(const ExpressionGraph &graph, const ExpressionHandle &expr)
+{
+	// both Add and Mul of NaryOperator are commutative
+	return expr.array == ArrayType::Nary ||
+	       (expr.array == ArrayType::Binary && is_commutative_binary_op(graph.m_binaries[expr.id].op));
+}
+
+static uint32_t node_operator(const ExpressionGraph &graph, const ExpressionHandle &expr)
+{
+	switch (expr.array)
+	{
+	case ArrayType::Unary:
+		return (uint32_t)graph.m_unaries[expr.id].op;
+	case ArrayType::Binary:
+		return (uint32_t)graph.m_binaries[expr.id].op;
+	case ArrayType::Ternary:
+		return (uint32_t)graph.m_ternaries[expr.id].op;
+	case ArrayType::Nary:
+		return (uint32_t)graph.m_naries[expr.id].op;
+	default:
+		return 0;
+	}
+}
+
+// visit all nodes reachable from roots in post order without recursion, operands are visited in
+// the order given by get_operands
+template <typename T, typename GetOperands, typename Visit>
+static void visit_postorder(const std::vector<ExpressionHandle> &roots,
+                            Hashmap<ExpressionHandle, T> &visited, GetOperands &&get_operands,
+                            Visit &&visit)
+{
+	struct Frame
+	{
+		ExpressionHandle expr;
+		bool expanded;
+	};
+	std::vector<Frame> stack;
+	std::vector<ExpressionHandle> operands;
+	for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+	{
+		stack.push_back({*it, false});
+	}
+	while (!stack.empty())
+	{
+		auto frame = stack.back();
+		stack.pop_back();
+		if (visited.contains(frame.expr))
+		{
+			continue;
+		}
+		if (frame.expanded)
+		{
+			visited.emplace(frame.expr, visit(frame.expr));
+			continue;
+		}
+		stack.push_back({frame.expr, true});
+		get_operands(frame.expr, operands);
+		for (auto it = operands.rbegin(); it != operands.rend(); ++it)
+		{
+			if (!visited.contains(*it))
+			{
+				stack.push_back({*it, false});
+			}
+		}
+	}
+}
+
+void ExpressionGraph::canonicalize()
+{
+	std::vector<ExpressionHandle> roots;
+	roots.reserve(m_constraint_outputs.size() + m_objective_outputs.size());
+	roots.insert(roots.end(), m_constraint_outputs.begin(), m_constraint_outputs.end());
+	roots.insert(roots.end(), m_objective_outputs.begin(), m_objective_outputs.end());
+
+	// shape of each node: hash of its structure ignoring the identity of variables and the values
+	// of constants, it does not depend on the order of operands of commutative operators
+	Hashmap<ExpressionHandle, uint64_t> shapes;
+	std::vector<ExpressionHandle> operands;
+	std::vector<uint64_t> operand_shapes;
+	visit_postorder(
+	    roots, shapes,
+	    [this](const ExpressionHandle &expr, std::vector<ExpressionHandle> &operands) {
+		    node_operands(*this, expr, operands);
+	    },
+	    [&](const ExpressionHandle &expr) {
+		    uint64_t shape = 0;
+		    hash_combine(shape, (uint64_t)expr.array);
+		    hash_combine(shape, node_operator(*this, expr));
+		    node_operands(*this, expr, operands);
+		    operand_shapes.clear();
+		    for (const auto &operand : operands)
+		    {
+			    operand_shapes.push_back(shapes.at(operand));
+		    }
+		    if (is_commutative_node(*this, expr))
+		    {
+			    std::sort(operand_shapes.begin(), operand_shapes.end());
+		    }
+		    for (auto operand_shape : operand_shapes)
+		    {
+			    hash_combine(shape, operand_shape);
+		    }
+		    return shape;
+	    });
+
+	// operands of commutative operators are ordered by shape, ties keep the original order
+	auto canonical_operands = [&](const ExpressionHandle &expr,
+	                              std::vector<ExpressionHandle> &operands) {
+		node_operands(*this, expr, operands);
+		if (is_commutative_node(*this, expr))
+		{
+			std::stable_sort(operands.begin(), operands.end(),
+			                 [&](const ExpressionHandle &a, const ExpressionHandle &b) {
+				                 return shapes.at(a) < shapes.at(b);
+			                 });
+		}
+	};
+
+	// rebuild the graph in post order, identical subexpressions are merged by hash-consing
+	ExpressionGraph canonical;
+	Hashmap<ExpressionHandle, ExpressionHandle> remap;
+	Hashmap<std::string, ExpressionHandle> interned;
+	visit_postorder(roots, remap, canonical_operands, [&](const ExpressionHandle &expr) {
+		ExpressionHandle new_expr;
+		switch (expr.array)
+		{
+		case ArrayType::Variable:
+			return canonical.add_variable(m_variables[expr.id]);
+		case ArrayType::Constant:
+			canonical.m_constants.push_back(m_constants[expr.id]);
+			return ExpressionHandle(ArrayType::Constant,
+			                        static_cast<NodeId>(canonical.m_constants.size() - 1));
+		case ArrayType::Parameter:
+			canonical.m_parameters.push_back(m_parameters[expr.id]);
+			return ExpressionHandle(ArrayType::Parameter,
+			                        static_cast<NodeId>(canonical.m_parameters.size() - 1));
+		default:
+			break;
+		}
+
+		canonical_operands(expr, operands);
+		for (auto &operand : operands)
+		{
+			operand = remap.at(operand);
+		}
+
+		std::string key;
+		signature_append(key, (uint32_t)expr.array);
+		signature_append(key, node_operator(*this, expr));
+		for (const auto &operand : operands)
+		{
+			signature_append(key, operand);
+		}
+		auto iter = interned.find(key);
+		if (iter != interned.end())
+		{
+			return iter->second;
+		}
+
+		switch (expr.array)
+		{
+		case ArrayType::Unary:
+			canonical.m_unaries.emplace_back(m_unaries[expr.id].op, operands[0]);
+			new_expr = {ArrayType::Unary, static_cast<NodeId>(canonical.m_unaries.size() - 1)};
+			break;
+		case ArrayType::Binary:
+			canonical.m_binaries.emplace_back(m_binaries[expr.id].op, operands[0], operands[1]);
+			new_expr = {ArrayType::Binary, static_cast<NodeId>(canonical.m_binaries.size() - 1)};
+			break;
+		case ArrayType::Ternary:
+			canonical.m_ternaries.emplace_back(m_ternaries[expr.id].op, operands[0], operands[1],
+			                                   operands[2]);
+			new_expr = {ArrayType::Ternary, static_cast<NodeId>(canonical.m_ternaries.size() - 1)};
+			break;
+		case ArrayType::Nary:
+			canonical.m_naries.emplace_back(m_naries[expr.id].op, operands);
+			new_expr = {ArrayType::Nary, static_cast<NodeId>(canonical.m_naries.size() - 1)};
+			break;
+		default:
+			throw std::runtime_error("Unknown node type in expression graph");
+		}
+		interned.emplace(std::move(key), new_expr);
+		return new_expr;
+	});
+
+	for (const auto &output : m_constraint_outputs)
+	{
+		canonical.m_constraint_outputs.push_back(remap.at(output));
+	}
+	for (const auto &output : m_objective_outputs)
+	{
+		canonical.m_objective_outputs.push_back(remap.at(output));
+	}
+
+	*this = std::move(canonical);
+}
+
+// adds coef * (product of operands) to quadratic_part if the operands are constants and at most
+// two variables
+static bool collect_product_term(const ExpressionGraph &graph, const ExpressionHandle *operands,
+                                 size_t n_operands, double coef, ExprBuilder &quadratic_part)
+{
+	IndexT variables[2];
+	int n_variables = 0;
+	for (size_t i = 0; i < n_operands; i++)
+	{
+		const auto &operand = operands[i];
+		if (operand.array == ArrayType::Constant)
+		{
+			coef *= graph.m_constants[operand.id];
+		}
+		else if (operand.array == ArrayType::Variable && n_variables < 2)
+		{
+			variables[n_variables++] = graph.m_variables[operand.id];
+		}
+		else
+		{
+			return false;
+		}
+	}
+	switch (n_variables)
+	{
+	case 0:
+		quadratic_part += coef;
+		break;
+	case 1:
+		quadratic_part._add_affine_term(variables[0], coef);
+		break;
+	default:
+		quadratic_part._add_quadratic_term(variables[0], variables[1], coef);
+		break;
+	}
+	return true;
+}
+
+// adds coef * expr to quadratic_part if expr is a constant, a variable, a product of constants
+// and at most two variables, the square of a variable or the negation of them
+static bool collect_quadratic_term(const ExpressionGraph &graph, const ExpressionHandle &expr,
+                                   double coef, ExprBuilder &quadratic_part)
+{
+	switch (expr.array)
+	{
+	case ArrayType::Constant:
+	case ArrayType::Variable:
+		return collect_product_term(graph, &expr, 1, coef, quadratic_part);
+	case ArrayType::Unary: {
+		const auto &unary = graph.m_unaries[expr.id];
+		if (unary.op != UnaryOperator::Neg)
+		{
+			return false;
+		}
+		return collect_quadratic_term(graph, unary.operand, -coef, quadratic_part);
+	}
+	case ArrayType::Binary: {
+		const auto &binary = graph.m_binaries[expr.id];
+		if (binary.op == BinaryOperator::Mul2)
+		{
+			ExpressionHandle operands[2] = {binary.left, binary.right};
+			return collect_product_term(graph, operands, 2, coef, quadratic_part);
+		}
+		if (binary.op == BinaryOperator::Pow && binary.left.array == ArrayType::Variable &&
+		    binary.right.array == ArrayType::Constant && graph.m_constants[binary.right.id] == 2.0)
+		{
+			ExpressionHandle operands[2] = {binary.left, binary.left};
+			return collect_product_term(graph, operands, 2, coef, quadratic_part);
+		}
+		return false;
+	}
+	case ArrayType::Nary: {
+		const auto &nary = graph.m_naries[expr.id];
+		if (nary.op != NaryOperator::Mul)
+		{
+			return false;
+		}
+		return collect_product_term(graph, nary.operands.data(), nary.operands.size(), coef,
+		                            quadratic_part);
+	}
+	default:
+		return false;
+	}
+}
+
+// flattens the sum expr * coef, the affine and quadratic terms are added to quadratic_part and the
+// others are appended to nonlinear_terms with their coefficients
+static void split_sum_terms(const ExpressionGraph &graph, const ExpressionHandle &expr, double coef,
+                            ExprBuilder &quadratic_part,
+                            std::vector<std::pair<ExpressionHandle, double>> &nonlinear_terms)
+{
+	if (expr.array == ArrayType::Nary && graph.m_naries[expr.id].op == NaryOperator::Add)
+	{
+		for (const auto &operand : graph.m_naries[expr.id].operands)
+		{
+			split_sum_terms(graph, operand, coef, quadratic_part, nonlinear_terms);
+		}
+		return;
+	}
+	if (expr.array == ArrayType::Unary && graph.m_unaries[expr.id].op == UnaryOperator::Neg)
+	{
+		split_sum_terms(graph, graph.m_unaries[expr.id].operand, -coef, quadratic_part,
+		                nonlinear_terms);
+		return;
+	}
+	if (expr.array == ArrayType::Binary)
+	{
+		const auto &binary = graph.m_binaries[expr.id];
+		if (binary.op == BinaryOperator::Add2 || binary.op == BinaryOperator::Sub)
+		{
+			double right_coef = binary.op == BinaryOperator::Sub ? -coef : coef;
+			split_sum_terms(graph, binary.left, coef, quadratic_part, nonlinear_terms);
+			split_sum_terms(graph, binary.right, right_coef, quadratic_part, nonlinear_terms);
+			return;
+		}
+		if (binary.op == BinaryOperator::Div && binary.right.array == ArrayType::Constant &&
+		    graph.m_constants[binary.right.id] != 0.0)
+		{
+			split_sum_terms(graph, binary.left, coef / graph.m_constants[binary.right.id],
+			                quadratic_part, nonlinear_terms);
+			return;
+		}
+	}
+	if (!collect_quadratic_term(graph, expr, coef, quadratic_part))
+	{
+		nonlinear_terms.emplace_back(expr, coef);
+	}
+}
+
+// visited keeps the nodes checked by earlier calls, they contain no variables because the search
+// stops at the first variable, so shared subexpressions of the DAG are only traversed once
+static bool depends_on_variables(const ExpressionGraph &graph, const ExpressionHandle &expr,
+                                 Hashset<ExpressionHandle> &visited)
+{
+	std::vector<ExpressionHandle> stack = {expr};
+	std::vector<ExpressionHandle> operands;
+	while (!stack.empty())
+	{
+		auto node = stack.back();
+		stack.pop_back();
+		if (node.array == ArrayType::Variable)
+		{
+			return true;
+		}
+		if (!visited.insert(node).second)
+		{
+			continue;
+		}
+		node_operands(graph, node, operands);
+		stack.insert(stack.end(), operands.begin(), operands.end());
+	}
+	return false;
+}
+
+bool ExpressionGraph::split_quadratic_part(ExpressionHandle &expression,
+                                           ExprBuilder &quadratic_part)
+{
+	ExprBuilder terms;
+	std::vector<std::pair<ExpressionHandle, double>> nonlinear_terms;
+	split_sum_terms(*this, expression, 1.0, terms, nonlinear_terms);
+
+	if (terms.degree() < 1 || nonlinear_terms.empty())
+	{
+		return false;
+	}
+	bool has_variables = false;
+	Hashset<ExpressionHandle> visited;
+	for (const auto &[term, coef] : nonlinear_terms)
+	{
+		if (depends_on_variables(*this, term, visited))
+		{
+			has_variables = true;
+			break;
+		}
+	}
+	if (!has_variables)
+	{
+		return false;
+	}
+
+	std::vector<ExpressionHandle> operands;
+	operands.reserve(nonlinear_terms.size());
+	for (const auto &[term, coef] : nonlinear_terms)
+	{
+		if (coef == 1.0)
+		{
+			operands.push_back(term);
+		}
+		else if (coef == -1.0)
+		{
+			operands.push_back(add_unary(UnaryOperator::Neg, term));
+		}
+		else
+		{
+			operands.push_back(add_nary(NaryOperator::Mul, {add_constant(coef), term}));
+		}
+	}
+	expression = operands.size() == 1 ? operands[0] : add_nary(NaryOperator::Add, operands);
+	quadratic_part += terms;
+	return true;
+}
+
 void unpack_comparison_expression(ExpressionGraph &graph, const ExpressionHandle &expr,
                                   ExpressionHandle &real_expr, double &lb, double &ub)
 {
@@ -53,6 +53,10 @@ NB_MODULE(nlexpr_ext, m)
 	    .value("Add", NaryOperator::Add)
 	    .value("Mul", NaryOperator::Mul);
 
+	nb::class_<ParameterIndex>(m, "ParameterIndex")
+	    .def(nb::init<IndexT>())
+	    .def_ro("index", &ParameterIndex::index);
+
 	nb::class_<ExpressionHandle>(m, "ExpressionHandle")
 	    .def(nb::init<ArrayType, NodeId>())
 	    .def_ro("array", &ExpressionHandle::array)
@@ -92,10 +96,24 @@ NB_MODULE(nlexpr_ext, m)
 	    .def("add_constraint_output", &ExpressionGraph::add_constraint_output)
 	    .def("add_objective_output", &ExpressionGraph::add_objective_output)
 	    .def("merge_variableindex", &ExpressionGraph::merge_variableindex)
+	    .def("merge_parameterindex", &ExpressionGraph::merge_parameterindex)
 	    .def("merge_scalaraffinefunction", &ExpressionGraph::merge_scalaraffinefunction)
 	    .def("merge_scalarquadraticfunction", &ExpressionGraph::merge_scalarquadraticfunction)
 	    .def("merge_exprbuilder", &ExpressionGraph::merge_exprbuilder)
-	    .def("is_compare_expression", &ExpressionGraph::is_compare_expression);
+	    .def("is_compare_expression", &ExpressionGraph::is_compare_expression)
+	    .def("constraint_structure_signature",
+	         [](const ExpressionGraph &graph) {
+		         auto signature =
+		             graph.constraint_structure_signature(graph.main_structure_signature());
+		         return nb::bytes(signature.data(), signature.size());
+	         })
+	    .def("objective_structure_signature",
+	         [](const ExpressionGraph &graph) {
+		         auto signature =
+		             graph.objective_structure_signature(graph.main_structure_signature());
+		         return nb::bytes(signature.data(), signature.size());
+	         })
+	    .def("canonicalize", &ExpressionGraph::canonicalize);
 
 	m.def("unpack_comparison_expression",
 	      [](ExpressionGraph &graph, const ExpressionHandle &expr, double INF) {
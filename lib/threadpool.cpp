@@ -0,0 +1,134 @@
+#include "pyoptinterface/threadpool.hpp"
+
+ThreadPool::ThreadPool(size_t n_threads)
+{
+	if (n_threads < 1)
+	{
+		n_threads = 1;
+	}
+	m_workers.reserve(n_threads - 1);
+	for (size_t i = 1; i < n_threads; i++)
+	{
+		m_workers.emplace_back([this] { worker_loop(); });
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_start_cv.notify_all();
+	for (auto &worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+size_t ThreadPool::n_threads() const
+{
+	return m_workers.size() + 1;
+}
+
+void ThreadPool::parallel_for(size_t n_tasks, const std::function<void(size_t)> &f)
+{
+	if (n_tasks == 0)
+	{
+		return;
+	}
+	if (m_workers.empty() || n_tasks == 1)
+	{
+		for (size_t i = 0; i < n_tasks; i++)
+		{
+			f(i);
+		}
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_task = &f;
+		m_n_tasks = n_tasks;
+		m_next_task = 0;
+		m_n_finished = 0;
+		m_exception = nullptr;
+		m_generation++;
+	}
+	m_start_cv.notify_all();
+
+	// the calling thread takes part in the work
+	run_tasks();
+
+	std::exception_ptr exception;
+	{
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_done_cv.wait(lock, [this] { return m_n_finished == m_n_tasks; });
+		m_task = nullptr;
+		exception = m_exception;
+	}
+	if (exception)
+	{
+		std::rethrow_exception(exception);
+	}
+}
+
+void ThreadPool::worker_loop()
+{
+	size_t seen_generation = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_start_cv.wait(lock, [&] { return m_stop || m_generation != seen_generation; });
+			if (m_stop)
+			{
+				return;
+			}
+			seen_generation = m_generation;
+		}
+		run_tasks();
+	}
+}
+
+void ThreadPool::run_tasks()
+{
+	while (true)
+	{
+		size_t task_index;
+		const std::function<void(size_t)> *task;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (m_task == nullptr || m_next_task >= m_n_tasks)
+			{
+				return;
+			}
+			task_index = m_next_task++;
+			task = m_task;
+		}
+
+		try
+		{
+			(*task)(task_index);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			if (!m_exception)
+			{
+				m_exception = std::current_exception();
+			}
+		}
+
+		bool all_finished;
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_n_finished++;
+			all_finished = m_n_finished == m_n_tasks;
+		}
+		if (all_finished)
+		{
+			m_done_cv.notify_all();
+		}
+	}
+}
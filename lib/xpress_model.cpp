@@ -500,6 +500,33 @@ VariableIndex Model::add_variable(VariableDomain domain, double lb, double ub, c
 	return variable;
 }
 
+VariableIndex Model::add_variables(int N, VariableDomain domain, const double *lb,
+                                   const double *ub)
+{
+	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
+	_ensure_postsolved();
+	_clear_caches();
+
+	IndexT index = m_variable_index.add_indices(N);
+	VariableIndex variable(index);
+	if (N == 0)
+	{
+		return variable;
+	}
+
+	std::vector<double> zeros(N, 0.0);
+	int colidx = get_raw_attribute_int_by_id(POI_XPRS_COLS);
+	_check(XPRSaddcols64(m_model.get(), N, 0, zeros.data(), nullptr, nullptr, nullptr, lb, ub));
+	if (domain != VariableDomain::Continuous)
+	{
+		std::vector<int> cols(N);
+		std::iota(cols.begin(), cols.end(), colidx);
+		std::vector<char> vtypes(N, poi_to_xprs_var_type(domain));
+		_check(XPRSchgcoltype(m_model.get(), N, cols.data(), vtypes.data()));
+	}
+	return variable;
+}
+
 void Model::delete_variable(VariableIndex variable)
 {
 	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
@@ -525,23 +552,20 @@ void Model::delete_variables(const Vector<VariableIndex> &variables)
 	if (n_variables == 0)
 		return;
 
-	std::vector<int> columns;
-	columns.reserve(n_variables);
+	std::vector<IndexT> indices;
+	indices.reserve(n_variables);
 	for (int i = {}; i < n_variables; i++)
 	{
-		if (!is_variable_active(variables[i]))
+		if (is_variable_active(variables[i]))
 		{
-			continue;
+			indices.push_back(variables[i].index);
 		}
-		auto column = _variable_index(variables[i]);
-		columns.push_back(column);
 	}
+	std::vector<int> columns(indices.size());
+	_variable_indices(indices, columns);
 	_check(XPRSdelcols(m_model.get(), columns.size(), columns.data()));
 
-	for (int i = {}; i < n_variables; i++)
-	{
-		m_variable_index.delete_index(variables[i].index);
-	}
+	m_variable_index.delete_indices(indices);
 }
 
 bool Model::is_variable_active(VariableIndex variable)
@@ -599,6 +623,29 @@ void Model::set_variable_bounds(VariableIndex variable, double lb, double ub)
 	_check(XPRSchgbounds(m_model.get(), 2, columns, btypes, bounds));
 }
 
+void Model::set_variable_bounds(int N, const int *variables, const double *lb, const double *ub)
+{
+	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
+	_ensure_postsolved();
+	_clear_caches();
+
+	std::vector<int> colidxs(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(colidxs));
+	std::vector<int> columns(2 * N);
+	std::vector<char> btypes(2 * N);
+	std::vector<double> bounds(2 * N);
+	for (int i = 0; i < N; i++)
+	{
+		columns[2 * i] = colidxs[i];
+		btypes[2 * i] = 'L';
+		bounds[2 * i] = lb[i];
+		columns[2 * i + 1] = colidxs[i];
+		btypes[2 * i + 1] = 'U';
+		bounds[2 * i + 1] = ub[i];
+	}
+	_check(XPRSchgbounds(m_model.get(), 2 * N, columns.data(), btypes.data(), bounds.data()));
+}
+
 void Model::set_variable_lowerbound(VariableIndex variable, double lb)
 {
 	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
@@ -787,6 +834,46 @@ ConstraintIndex Model::add_linear_constraint(const ScalarAffineFunction &functio
 	return constraint_index;
 }
 
+ConstraintIndex Model::add_linear_constraints(int M, const int *indptr, const int *variables,
+                                              const double *coefficients, ConstraintSense sense,
+                                              const double *rhs)
+{
+	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
+	_ensure_postsolved();
+	_clear_caches();
+
+	CSRMatrixPtrForm<XPRSint64, int, double> ptr_form;
+	ptr_form.make(this, M, indptr, variables, coefficients);
+
+	IndexT index = m_constraint_index.add_indices(M);
+	ConstraintIndex constraint_index(ConstraintType::Linear, index);
+	if (M == 0)
+	{
+		return constraint_index;
+	}
+
+	char sense_type = poi_to_xprs_cons_sense(sense);
+	std::vector<char> g_senses(M, sense_type);
+	std::vector<double> g_rhs(M);
+	for (int i = 0; i < M; i++)
+	{
+		g_rhs[i] = std::clamp(rhs[i], POI_XPRS_MINUSINFINITY, POI_XPRS_PLUSINFINITY);
+
+		// Map expr >= -inf and expr <= +inf to free rows
+		if ((sense_type == 'G' && g_rhs[i] <= POI_XPRS_MINUSINFINITY) ||
+		    (sense_type == 'L' && g_rhs[i] >= POI_XPRS_PLUSINFINITY))
+		{
+			g_senses[i] = 'N'; // Free row
+			g_rhs[i] = 0.0;
+		}
+	}
+
+	_check(XPRSaddrows64(m_model.get(), M, ptr_form.numnz, g_senses.data(), g_rhs.data(),
+	                     nullptr, ptr_form.begin, ptr_form.index, ptr_form.value));
+
+	return constraint_index;
+}
+
 static QuadraticFunctionPtrForm<int, int, double> poi_to_xprs_quad_formula(
     Model &model, const ScalarQuadraticFunction &function, bool is_objective)
 {
@@ -1427,6 +1514,17 @@ void Model::set_normalized_rhs(ConstraintIndex constraint, double value)
 	_check(XPRSchgrhs(m_model.get(), 1, &rowidx, &value));
 }
 
+void Model::set_normalized_rhs(int N, const int *constraints, const double *values)
+{
+	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
+	_ensure_postsolved();
+	_clear_caches();
+
+	std::vector<int> rowidxs(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<int>(rowidxs));
+	_check(XPRSchgrhs(m_model.get(), N, rowidxs.data(), values));
+}
+
 double Model::get_normalized_coefficient(ConstraintIndex constraint, VariableIndex variable)
 {
 	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
@@ -1450,6 +1548,20 @@ void Model::set_normalized_coefficient(ConstraintIndex constraint, VariableIndex
 	_check(XPRSchgcoef(m_model.get(), rowidx, colidx, value));
 }
 
+void Model::set_normalized_coefficients(int N, const int *constraints, const int *variables,
+                                        const double *values)
+{
+	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
+	_ensure_postsolved();
+	_clear_caches();
+
+	std::vector<int> rowidxs(N);
+	checked_linear_constraint_indices(this, {constraints, size_t(N)}, std::span<int>(rowidxs));
+	std::vector<int> colidxs(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(colidxs));
+	_check(XPRSchgmcoef64(m_model.get(), N, rowidxs.data(), colidxs.data(), values));
+}
+
 double Model::get_objective_coefficient(VariableIndex variable)
 {
 	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
@@ -1470,6 +1582,17 @@ void Model::set_objective_coefficient(VariableIndex variable, double value)
 	_check(XPRSchgobj(m_model.get(), 1, &colidx, &value));
 }
 
+void Model::set_objective_coefficients(int N, const int *variables, const double *values)
+{
+	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
+	_ensure_postsolved();
+	_clear_caches();
+
+	std::vector<int> colidxs(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(colidxs));
+	_check(XPRSchgobj(m_model.get(), N, colidxs.data(), values));
+}
+
 int Model::_constraint_index(ConstraintIndex constraint)
 {
 	switch (constraint.type)
@@ -1492,6 +1615,16 @@ int Model::_variable_index(VariableIndex variable)
 	return m_variable_index.get_index(variable.index);
 }
 
+void Model::_variable_indices(std::span<const IndexT> variables, std::span<int> columns)
+{
+	m_variable_index.get_indices(variables, columns);
+}
+
+void Model::_linear_constraint_indices(std::span<const IndexT> constraints, std::span<int> rows)
+{
+	m_constraint_index.get_indices(constraints, rows);
+}
+
 int Model::_checked_constraint_index(ConstraintIndex constraint)
 {
 	int rowidx = _constraint_index(constraint);
@@ -1542,6 +1675,31 @@ double Model::get_variable_value(VariableIndex variable)
 	return value;
 }
 
+void Model::get_variable_values(int N, const int *variables, double *values)
+{
+	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
+	std::vector<int> colidxs(N);
+	checked_variable_indices(this, {variables, size_t(N)}, std::span<int>(colidxs));
+
+	int ncols = get_raw_attribute_int_by_id(POI_XPRS_COLS);
+	if (ncols == 0)
+	{
+		return;
+	}
+	int status = POI_XPRS_SOLAVAILABLE_NOTFOUND;
+	std::vector<double> solution(ncols);
+	_check(XPRSgetsolution(m_model.get(), &status, solution.data(), 0, ncols - 1));
+	if (status == POI_XPRS_SOLAVAILABLE_NOTFOUND)
+	{
+		throw std::runtime_error("No solution found");
+	}
+
+	for (int i = 0; i < N; i++)
+	{
+		values[i] = solution[colidxs[i]];
+	}
+}
+
 double Model::get_variable_rc(VariableIndex variable)
 {
 	_check_expected_mode(XPRESS_MODEL_MODE::MAIN);
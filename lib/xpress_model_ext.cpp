@@ -8,6 +8,8 @@
 #include <nanobind/trampoline.h>
 #include "pyoptinterface/core.hpp"
 #include "pyoptinterface/xpress_model.hpp"
+#include "pyoptinterface/ndarray_ext.hpp"
+#include "pyoptinterface/cache_model.hpp"
 
 namespace nb = nanobind;
 
@@ -60,11 +62,32 @@ NB_MODULE(xpress_model_ext, m)
 	    // Variables
 	    .def("add_variable", &Model::add_variable, "domain"_a = VariableDomain::Continuous,
 	         "lb"_a = POI_XPRS_MINUSINFINITY, "ub"_a = POI_XPRS_PLUSINFINITY, "name"_a = "")
+	    .def(
+	        "_add_variables",
+	        [](Model &model, int N, VariableDomain domain, const std::optional<DoubleArrayT> &lb,
+	           const std::optional<DoubleArrayT> &ub) {
+		        check_variable_count(N);
+		        std::vector<double> lb_buffer, ub_buffer;
+		        return model.add_variables(
+		            N, domain, array_or_fill(lb, N, POI_XPRS_MINUSINFINITY, lb_buffer, "lb"),
+		            array_or_fill(ub, N, POI_XPRS_PLUSINFINITY, ub_buffer, "ub"));
+	        },
+	        "N"_a, "domain"_a = VariableDomain::Continuous, "lb"_a = nb::none(),
+	        "ub"_a = nb::none())
 	    .def("delete_variable", &Model::delete_variable, "variable"_a)
 	    .def("delete_variables", &Model::delete_variables, "variables"_a)
 	    .def("set_objective_coefficient", &Model::set_objective_coefficient, "variable"_a,
 	         "value"_a)
-	    .def("set_variable_bounds", &Model::set_variable_bounds, "variable"_a, "lb"_a, "ub"_a)
+	    .def("set_objective_coefficients", &set_objective_coefficients_array<Model>, "variables"_a,
+	         "values"_a)
+	    .def("set_objective_coefficients", &set_objective_coefficients_list<Model>, "variables"_a,
+	         "values"_a)
+	    .def("set_variable_bounds",
+	         nb::overload_cast<VariableIndex, double, double>(&Model::set_variable_bounds),
+	         "variable"_a, "lb"_a, "ub"_a)
+	    .def("set_variable_bounds", &set_variable_bounds_array<Model>, "variables"_a, "lb"_a,
+	         "ub"_a)
+	    .def("set_variable_bounds", &set_variable_bounds_list<Model>, "variables"_a, "lb"_a, "ub"_a)
 	    .def("set_variable_lowerbound", &Model::set_variable_lowerbound, "variable"_a, "lb"_a)
 	    .def("set_variable_name", &Model::set_variable_name, "variable"_a, "name"_a)
 	    .def("set_variable_type", &Model::set_variable_type, "variable"_a, "vtype"_a)
@@ -97,6 +120,9 @@ NB_MODULE(xpress_model_ext, m)
 	         nb::overload_cast<const ScalarAffineFunction &, ConstraintSense, CoeffT, const char *>(
 	             &Model::add_linear_constraint),
 	         "function"_a, "sense"_a, "rhs"_a, "name"_a = "")
+	    .def("_add_linear_constraints", &add_linear_constraints_csr<Model>, "indptr"_a,
+	         "variables"_a, "coefficients"_a, "sense"_a, "rhs"_a)
+	    .def("load_cache_model", &load_cache_model<Model>, "cache"_a)
 	    .def("add_quadratic_constraint", &Model::add_quadratic_constraint, "function"_a, "sense"_a,
 	         "rhs"_a, "name"_a = "")
 	    .def("_add_quadratic_constraint", &Model::add_quadratic_constraint, "function"_a, "sense"_a,
@@ -119,7 +145,15 @@ NB_MODULE(xpress_model_ext, m)
 	    .def("set_constraint_sense", &Model::set_constraint_sense, "constraint"_a, "sense"_a)
 	    .def("set_normalized_coefficient", &Model::set_normalized_coefficient, "constraint"_a,
 	         "variable"_a, "value"_a)
-	    .def("set_normalized_rhs", &Model::set_normalized_rhs, "constraint"_a, "value"_a)
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_array<Model>,
+	         "constraints"_a, "variables"_a, "values"_a)
+	    .def("set_normalized_coefficients", &set_normalized_coefficients_list<Model>,
+	         "constraints"_a, "variables"_a, "values"_a)
+	    .def("set_normalized_rhs",
+	         nb::overload_cast<ConstraintIndex, double>(&Model::set_normalized_rhs), "constraint"_a,
+	         "value"_a)
+	    .def("set_normalized_rhs", &set_normalized_rhs_array<Model>, "constraints"_a, "values"_a)
+	    .def("set_normalized_rhs", &set_normalized_rhs_list<Model>, "constraints"_a, "values"_a)
 	    .def("is_constraint_active", &Model::is_constraint_active, "constraint"_a)
 	    .def("is_constraint_basic", &Model::is_constraint_basic, "constraint"_a)
 	    .def("is_constraint_in_IIS", &Model::is_constraint_in_IIS, "constraint"_a)
@@ -227,6 +261,9 @@ NB_MODULE(xpress_model_ext, m)
 	    .def("get_value",
 	         nb::overload_cast<const ScalarQuadraticFunction &>(&Model::get_expression_value))
 	    .def("get_value", nb::overload_cast<const ExprBuilder &>(&Model::get_expression_value))
+	    .def("get_values", &get_variable_values_array<Model>, "variables"_a)
+	    .def("get_values", &get_variable_values_list<Model>, "variables"_a)
+	    .def("get_values", &get_expression_values_array<Model>, "exprs"_a)
 
 	    .def("_add_linear_constraint", &Model::add_linear_constraint_from_var, "expr"_a, "sense"_a,
 	         "rhs"_a, "name"_a = "")
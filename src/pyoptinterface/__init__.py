@@ -2,6 +2,8 @@ from pyoptinterface._src.core_ext import (
     VariableIndex,
     ConstraintIndex,
     ExprBuilder,
+    AffineAccumulator,
+    CacheModel,
     VariableDomain,
     ConstraintSense,
     ConstraintType,
@@ -45,6 +47,8 @@ __all__ = [
     "VariableIndex",
     "ConstraintIndex",
     "ExprBuilder",
+    "AffineAccumulator",
+    "CacheModel",
     "VariableDomain",
     "ConstraintSense",
     "ConstraintType",
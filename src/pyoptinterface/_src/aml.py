@@ -1,6 +1,7 @@
-from .core_ext import ExprBuilder, VariableDomain
+from .core_ext import ExprBuilder, VariableDomain, VariableIndex
 from .tupledict import make_tupledict
 
+import math
 from collections.abc import Collection
 from typing import Tuple, Union, Optional
 
@@ -19,6 +20,9 @@ def make_variable_ndarray(
     if isinstance(shape, int):
         shape = (shape,)
 
+    if hasattr(model, "_add_variables"):
+        return _make_variable_ndarray_batch(model, shape, domain, lb, ub, name, start)
+
     variables = np.empty(shape, dtype=object)
 
     kw_args = dict()
@@ -40,6 +44,40 @@ def make_variable_ndarray(
     return variables
 
 
+def _make_variable_ndarray_batch(model, shape, domain, lb, ub, name, start):
+    import numpy as np
+
+    N = math.prod(shape)
+
+    # lb/ub/start can be scalars or arrays broadcastable to shape
+    def flatten(values):
+        values = np.broadcast_to(np.asarray(values, dtype=np.float64), shape)
+        return np.ascontiguousarray(values).reshape(-1)
+
+    kw_args = dict()
+    if domain is not None:
+        kw_args["domain"] = domain
+    if lb is not None:
+        kw_args["lb"] = flatten(lb)
+    if ub is not None:
+        kw_args["ub"] = flatten(ub)
+    if start is not None:
+        kw_args["start"] = flatten(start)
+
+    # the new variables have contiguous indices
+    first_index = model._add_variables(N, **kw_args).index
+
+    variables = np.empty(N, dtype=object)
+    variables[:] = list(map(VariableIndex, range(first_index, first_index + N)))
+    variables = variables.reshape(shape)
+
+    if name is not None:
+        for index in np.ndindex(shape):
+            model.set_variable_name(variables[index], f"{name}{index}")
+
+    return variables
+
+
 def make_variable_tupledict(
     model,
     *coords: Collection,
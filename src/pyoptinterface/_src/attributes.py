@@ -122,7 +122,7 @@ model_attr_type_map = {
 class ConstraintAttribute(Enum):
     Name = auto()
     # PrimalStart = auto()
-    # DualStart = auto()
+    DualStart = auto()
     Primal = auto()
     Dual = auto()
     # BasisStatus = auto()
@@ -131,6 +131,7 @@ class ConstraintAttribute(Enum):
 
 constraint_attr_type_map = {
     ConstraintAttribute.Name: str,
+    ConstraintAttribute.DualStart: float,
     ConstraintAttribute.Primal: float,
     ConstraintAttribute.Dual: float,
     ConstraintAttribute.IIS: bool,
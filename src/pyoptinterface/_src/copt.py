@@ -2,6 +2,7 @@ import os
 import platform
 from pathlib import Path
 import logging
+import threading
 from typing import Dict, Tuple, Union, overload
 
 from .copt_model_ext import RawModel, Env, COPT, load_library
@@ -31,7 +32,7 @@ from .solver_common import (
     _direct_set_entity_attribute,
 )
 from .aml import make_variable_tupledict, make_variable_ndarray
-from .matrix import add_matrix_constraints
+from .matrix import add_matrix_constraints, load_mps
 
 
 def detected_libraries():
@@ -75,12 +76,15 @@ def autoload_library():
 autoload_library()
 
 DEFAULT_ENV = None
+# models may be created from multiple threads
+_default_env_lock = threading.Lock()
 
 
 def init_default_env():
     global DEFAULT_ENV
-    if DEFAULT_ENV is None:
-        DEFAULT_ENV = Env()
+    with _default_env_lock:
+        if DEFAULT_ENV is None:
+            DEFAULT_ENV = Env()
 
 
 variable_attribute_get_func_map = {
@@ -680,3 +684,4 @@ class Model(RawModel):
     add_variables = make_variable_tupledict
     add_m_variables = make_variable_ndarray
     add_m_linear_constraints = add_matrix_constraints
+    load_mps = load_mps
@@ -4,6 +4,7 @@ from pathlib import Path
 import re
 import sys
 import logging
+import threading
 from typing import Tuple, Union, overload
 
 from .gurobi_model_ext import RawModel, RawEnv, GRB, load_library
@@ -37,7 +38,7 @@ from .solver_common import (
 )
 from .constraint_bridge import bridge_soc_quadratic_constraint
 from .aml import make_variable_tupledict, make_variable_ndarray
-from .matrix import add_matrix_constraints
+from .matrix import add_matrix_constraints, load_mps
 
 
 def detected_libraries():
@@ -119,12 +120,15 @@ def autoload_library():
 autoload_library()
 
 DEFAULT_ENV = None
+# models may be created from multiple threads
+_default_env_lock = threading.Lock()
 
 
 def init_default_env():
     global DEFAULT_ENV
-    if DEFAULT_ENV is None:
-        DEFAULT_ENV = RawEnv()
+    with _default_env_lock:
+        if DEFAULT_ENV is None:
+            DEFAULT_ENV = RawEnv()
 
 
 # Variable Attribute
@@ -879,4 +883,5 @@ class Model(RawModel):
     add_variables = make_variable_tupledict
     add_m_variables = make_variable_ndarray
     add_m_linear_constraints = add_matrix_constraints
+    load_mps = load_mps
     add_second_order_cone_constraint = bridge_soc_quadratic_constraint
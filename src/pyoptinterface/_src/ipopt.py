@@ -1,16 +1,11 @@
-from io import StringIO
 import logging
 import platform
-from typing import Optional, List, Dict, Set, Union, Tuple, overload
-
-from llvmlite import ir
+import time
+from typing import Optional, Union, Tuple, overload
 
 from .ipopt_model_ext import RawModel, ApplicationReturnStatus, load_library
-from .codegen_c import generate_csrc_prelude, generate_csrc_from_graph
-from .jit_c import TCCJITCompiler
-from .codegen_llvm import create_llvmir_basic_functions, generate_llvmir_from_graph
-from .jit_llvm import LLJITCompiler
-from .nlexpr_ext import ExpressionHandle, ExpressionGraph, unpack_comparison_expression
+from .jit_evaluator import JITEvaluatorMixin
+from .nlexpr_ext import ExpressionHandle, unpack_comparison_expression
 from .nlfunc import (
     ExpressionGraphContext,
     convert_to_expressionhandle,
@@ -24,17 +19,6 @@ from .core_ext import (
     ConstraintSense,
 )
 from .comparison_constraint import ComparisonConstraint
-from .nleval_ext import (
-    AutodiffSymbolicStructure,
-    ConstraintAutodiffEvaluator,
-    ObjectiveAutodiffEvaluator,
-)
-from .cppad_interface_ext import (
-    CppADAutodiffGraph,
-    cppad_trace_graph_constraints,
-    cppad_trace_graph_objective,
-    cppad_autodiff,
-)
 
 from .attributes import (
     VariableAttribute,
@@ -203,46 +187,40 @@ def get_constraint_dual(model, constraint):
     return model.get_constraint_dual(constraint)
 
 
+def get_constraint_dual_start(model, constraint):
+    return model.get_constraint_dual_start(constraint)
+
+
+def set_constraint_dual_start(model, constraint, value):
+    model.set_constraint_dual_start(constraint, value)
+
+
 constraint_attribute_get_func_map = {
+    ConstraintAttribute.DualStart: get_constraint_dual_start,
     ConstraintAttribute.Primal: get_constraint_primal,
     ConstraintAttribute.Dual: get_constraint_dual,
 }
 
-constraint_attribute_set_func_map = {}
+constraint_attribute_set_func_map = {
+    ConstraintAttribute.DualStart: set_constraint_dual_start,
+}
+
 
+def _record_profile(timer, start: float):
+    timer.calls += 1
+    timer.seconds += time.perf_counter() - start
 
-class Model(RawModel):
-    def __init__(self, jit: str = "LLVM"):
+
+class Model(RawModel, JITEvaluatorMixin):
+    def __init__(self, jit: str = "LLVM", jit_cache_dir: Optional[str] = None):
         super().__init__()
+        self._init_jit(jit, jit_cache_dir)
 
-        if jit == "C":
-            self.jit_compiler = TCCJITCompiler()
-        elif jit == "LLVM":
-            self.jit_compiler = LLJITCompiler()
-        else:
-            raise ValueError(f"JIT engine can only be 'C' or 'LLVM', got {jit}")
-        self.jit = jit
-
-        # store graph_instance to graph_index
-        self.graph_instance_to_index: Dict[ExpressionGraph, int] = {}
-        self.graph_instances: List[ExpressionGraph] = []
-
-        self.nl_constraint_group_num = 0
-        self.nl_constraint_group_representatives: List[int] = []
-        self.nl_constraint_cppad_autodiff_graphs: List[CppADAutodiffGraph] = []
-        self.nl_constraint_autodiff_structures: List[AutodiffSymbolicStructure] = []
-        self.nl_constraint_evaluators: List[ConstraintAutodiffEvaluator] = []
-
-        self.nl_objective_group_num = 0
-        self.nl_objective_group_representatives: List[int] = []
-        self.nl_objective_cppad_autodiff_graphs: List[CppADAutodiffGraph] = []
-        self.nl_objective_autodiff_structures: List[AutodiffSymbolicStructure] = []
-        self.nl_objective_evaluators: List[ObjectiveAutodiffEvaluator] = []
-
-        # record the analyzed part of the problem
-        self.n_graph_instances_since_last_optimize = 0
-        self.nl_constraint_group_num_since_last_optimize = 0
-        self.nl_objective_group_num_since_last_optimize = 0
+    def _record_jit_profile(self, phase: str, start: float):
+        _record_profile(getattr(self.profile, phase), start)
+
+    def _nl_hessian_required(self) -> bool:
+        return not self.is_limited_memory_hessian()
 
     @staticmethod
     def supports_variable_attribute(attribute: VariableAttribute, settable=False):
@@ -528,411 +506,6 @@ class Model(RawModel):
 
         super()._optimize()
 
-    def _find_similar_graphs(self):
-        for i in range(
-            self.n_graph_instances_since_last_optimize, len(self.graph_instances)
-        ):
-            graph = self.graph_instances[i]
-            self._finalize_graph_instance(i, graph)
-
-        # constraint part
-
-        n_groups = self._aggregate_nl_constraint_groups()
-        # print(f"Found {n_groups} nonlinear constraint groups of similar graphs")
-        self.nl_constraint_group_num = n_groups
-
-        rep_instances = self.nl_constraint_group_representatives
-
-        for i in range(self.nl_constraint_group_num_since_last_optimize, n_groups):
-            graph_index = self._get_nl_constraint_group_representative(i)
-            rep_instances.append(graph_index)
-
-        # objective part
-        n_groups = self._aggregate_nl_objective_groups()
-        # print(f"Found {n_groups} nonlinear objective groups of similar graphs")
-        self.nl_objective_group_num = n_groups
-
-        rep_instances = self.nl_objective_group_representatives
-
-        for i in range(self.nl_objective_group_num_since_last_optimize, n_groups):
-            graph_index = self._get_nl_objective_group_representative(i)
-            rep_instances.append(graph_index)
-
-    def _compile_evaluators(self):
-        # for each group of nonlinear constraint and objective, we construct a cppad_autodiff graph
-        # and then compile them to get the function pointers
-
-        # constraint
-        # self.nl_constraint_cppad_autodiff_graphs.clear()
-        # self.nl_constraint_autodiff_structures.clear()
-        for i in range(
-            self.nl_constraint_group_num_since_last_optimize,
-            self.nl_constraint_group_num,
-        ):
-            graph_index = self.nl_constraint_group_representatives[i]
-            graph = self.graph_instances[graph_index]
-
-            # print(graph)
-
-            cppad_function = cppad_trace_graph_constraints(graph)
-
-            nx = cppad_function.nx
-            var_values = [(i + 1) / (nx + 1) for i in range(nx)]
-            np = cppad_function.np
-            param_values = [(i + 1) / (np + 1) for i in range(np)]
-
-            # print(f"nx = {nx}, np = {np}")
-            # print(f"var_values = {var_values}")
-            # print(f"param_values = {param_values}")
-
-            autodiff_structure = AutodiffSymbolicStructure()
-            cppad_graph = CppADAutodiffGraph()
-
-            cppad_autodiff(
-                cppad_function,
-                autodiff_structure,
-                cppad_graph,
-                var_values,
-                param_values,
-            )
-
-            # print(cppad_graph.f)
-
-            self._assign_nl_constraint_group_autodiff_structure(i, autodiff_structure)
-
-            self.nl_constraint_cppad_autodiff_graphs.append(cppad_graph)
-            self.nl_constraint_autodiff_structures.append(autodiff_structure)
-
-        # objective
-        # self.nl_objective_cppad_autodiff_graphs.clear()
-        # self.nl_objective_autodiff_structures.clear()
-        for i in range(
-            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
-        ):
-            graph_index = self.nl_objective_group_representatives[i]
-            graph = self.graph_instances[graph_index]
-
-            cppad_function = cppad_trace_graph_objective(graph)
-
-            nx = cppad_function.nx
-            var_values = [(i + 1) / (nx + 1) for i in range(nx)]
-            np = cppad_function.np
-            param_values = [(i + 1) / (np + 1) for i in range(np)]
-
-            autodiff_structure = AutodiffSymbolicStructure()
-            cppad_graph = CppADAutodiffGraph()
-
-            cppad_autodiff(
-                cppad_function,
-                autodiff_structure,
-                cppad_graph,
-                var_values,
-                param_values,
-            )
-
-            self._assign_nl_objective_group_autodiff_structure(i, autodiff_structure)
-
-            self.nl_objective_cppad_autodiff_graphs.append(cppad_graph)
-            self.nl_objective_autodiff_structures.append(autodiff_structure)
-
-        # compile the evaluators
-        jit_compiler = self.jit_compiler
-        if isinstance(jit_compiler, TCCJITCompiler):
-            self._codegen_c()
-        elif isinstance(jit_compiler, LLJITCompiler):
-            self._codegen_llvm()
-
-    def _codegen_c(self):
-        jit_compiler: TCCJITCompiler = self.jit_compiler
-        io = StringIO()
-
-        generate_csrc_prelude(io)
-
-        for group_index in range(
-            self.nl_constraint_group_num_since_last_optimize,
-            self.nl_constraint_group_num,
-        ):
-            cppad_autodiff_graph = self.nl_constraint_cppad_autodiff_graphs[group_index]
-            autodiff_structure = self.nl_constraint_autodiff_structures[group_index]
-
-            np = autodiff_structure.np
-            ny = autodiff_structure.ny
-
-            name = f"nlconstraint_{group_index}"
-
-            f_name = name
-            generate_csrc_from_graph(
-                io,
-                cppad_autodiff_graph.f,
-                f_name,
-                np=np,
-                indirect_x=True,
-            )
-            if autodiff_structure.has_jacobian:
-                jacobian_name = name + "_jacobian"
-                generate_csrc_from_graph(
-                    io,
-                    cppad_autodiff_graph.jacobian,
-                    jacobian_name,
-                    np=np,
-                    indirect_x=True,
-                )
-            if autodiff_structure.has_hessian:
-                hessian_name = name + "_hessian"
-                generate_csrc_from_graph(
-                    io,
-                    cppad_autodiff_graph.hessian,
-                    hessian_name,
-                    np=np,
-                    hessian_lagrange=True,
-                    nw=ny,
-                    indirect_x=True,
-                    indirect_y=True,
-                    add_y=True,
-                )
-
-        for group_index in range(
-            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
-        ):
-            cppad_autodiff_graph = self.nl_objective_cppad_autodiff_graphs[group_index]
-            autodiff_structure = self.nl_objective_autodiff_structures[group_index]
-
-            np = autodiff_structure.np
-            ny = autodiff_structure.ny
-
-            name = f"nlobjective_{group_index}"
-
-            f_name = name
-            generate_csrc_from_graph(
-                io, cppad_autodiff_graph.f, f_name, np=np, indirect_x=True, add_y=True
-            )
-            if autodiff_structure.has_jacobian:
-                jacobian_name = name + "_jacobian"
-                generate_csrc_from_graph(
-                    io,
-                    cppad_autodiff_graph.jacobian,
-                    jacobian_name,
-                    np=np,
-                    indirect_x=True,
-                    indirect_y=True,
-                    add_y=True,
-                )
-            if autodiff_structure.has_hessian:
-                hessian_name = name + "_hessian"
-                generate_csrc_from_graph(
-                    io,
-                    cppad_autodiff_graph.hessian,
-                    hessian_name,
-                    np=np,
-                    hessian_lagrange=True,
-                    nw=ny,
-                    indirect_x=True,
-                    indirect_y=True,
-                    add_y=True,
-                )
-
-        csrc = io.getvalue()
-
-        inst = jit_compiler.create_instance()
-        jit_compiler.compile_string(inst, csrc)
-
-        for group_index in range(
-            self.nl_constraint_group_num_since_last_optimize,
-            self.nl_constraint_group_num,
-        ):
-            name = f"nlconstraint_{group_index}"
-            autodiff_structure = self.nl_constraint_autodiff_structures[group_index]
-            has_parameter = autodiff_structure.has_parameter
-
-            f_name = name
-            jacobian_name = name + "_jacobian"
-            hessian_name = name + "_hessian"
-
-            f_ptr = inst.get_symbol(f_name)
-            jacobian_ptr = hessian_ptr = 0
-            if autodiff_structure.has_jacobian:
-                jacobian_ptr = inst.get_symbol(jacobian_name)
-            if autodiff_structure.has_hessian:
-                hessian_ptr = inst.get_symbol(hessian_name)
-
-            evaluator = ConstraintAutodiffEvaluator(
-                has_parameter, f_ptr, jacobian_ptr, hessian_ptr
-            )
-            self._assign_nl_constraint_group_autodiff_evaluator(group_index, evaluator)
-
-        for group_index in range(
-            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
-        ):
-            name = f"nlobjective_{group_index}"
-            autodiff_structure = self.nl_objective_autodiff_structures[group_index]
-            has_parameter = autodiff_structure.has_parameter
-
-            f_name = name
-            jacobian_name = name + "_jacobian"
-            hessian_name = name + "_hessian"
-
-            f_ptr = inst.get_symbol(f_name)
-            jacobian_ptr = hessian_ptr = 0
-            if autodiff_structure.has_jacobian:
-                jacobian_ptr = inst.get_symbol(jacobian_name)
-            if autodiff_structure.has_hessian:
-                hessian_ptr = inst.get_symbol(hessian_name)
-
-            evaluator = ObjectiveAutodiffEvaluator(
-                has_parameter, f_ptr, jacobian_ptr, hessian_ptr
-            )
-            self._assign_nl_objective_group_autodiff_evaluator(group_index, evaluator)
-
-    def _codegen_llvm(self):
-        jit_compiler: LLJITCompiler = self.jit_compiler
-        module = ir.Module(name="my_module")
-        create_llvmir_basic_functions(module)
-
-        export_functions = []
-
-        for group_index in range(
-            self.nl_constraint_group_num_since_last_optimize,
-            self.nl_constraint_group_num,
-        ):
-            cppad_autodiff_graph = self.nl_constraint_cppad_autodiff_graphs[group_index]
-            autodiff_structure = self.nl_constraint_autodiff_structures[group_index]
-
-            np = autodiff_structure.np
-            ny = autodiff_structure.ny
-
-            name = f"nlconstraint_{group_index}"
-
-            f_name = name
-            generate_llvmir_from_graph(
-                module,
-                cppad_autodiff_graph.f,
-                f_name,
-                np=np,
-                indirect_x=True,
-            )
-            export_functions.append(f_name)
-            if autodiff_structure.has_jacobian:
-                jacobian_name = name + "_jacobian"
-                generate_llvmir_from_graph(
-                    module,
-                    cppad_autodiff_graph.jacobian,
-                    jacobian_name,
-                    np=np,
-                    indirect_x=True,
-                )
-                export_functions.append(jacobian_name)
-            if autodiff_structure.has_hessian:
-                hessian_name = name + "_hessian"
-                generate_llvmir_from_graph(
-                    module,
-                    cppad_autodiff_graph.hessian,
-                    hessian_name,
-                    np=np,
-                    hessian_lagrange=True,
-                    nw=ny,
-                    indirect_x=True,
-                    indirect_y=True,
-                    add_y=True,
-                )
-                export_functions.append(hessian_name)
-
-        for group_index in range(
-            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
-        ):
-            cppad_autodiff_graph = self.nl_objective_cppad_autodiff_graphs[group_index]
-            autodiff_structure = self.nl_objective_autodiff_structures[group_index]
-
-            np = autodiff_structure.np
-            ny = autodiff_structure.ny
-
-            name = f"nlobjective_{group_index}"
-
-            f_name = name
-            generate_llvmir_from_graph(
-                module,
-                cppad_autodiff_graph.f,
-                f_name,
-                np=np,
-                indirect_x=True,
-                add_y=True,
-            )
-            export_functions.append(f_name)
-            if autodiff_structure.has_jacobian:
-                jacobian_name = name + "_jacobian"
-                generate_llvmir_from_graph(
-                    module,
-                    cppad_autodiff_graph.jacobian,
-                    jacobian_name,
-                    np=np,
-                    indirect_x=True,
-                    indirect_y=True,
-                    add_y=True,
-                )
-                export_functions.append(jacobian_name)
-            if autodiff_structure.has_hessian:
-                hessian_name = name + "_hessian"
-                generate_llvmir_from_graph(
-                    module,
-                    cppad_autodiff_graph.hessian,
-                    hessian_name,
-                    np=np,
-                    hessian_lagrange=True,
-                    nw=ny,
-                    indirect_x=True,
-                    indirect_y=True,
-                    add_y=True,
-                )
-                export_functions.append(hessian_name)
-
-        rt = jit_compiler.compile_module(module, export_functions)
-
-        for group_index in range(
-            self.nl_constraint_group_num_since_last_optimize,
-            self.nl_constraint_group_num,
-        ):
-            name = f"nlconstraint_{group_index}"
-            autodiff_structure = self.nl_constraint_autodiff_structures[group_index]
-            has_parameter = autodiff_structure.has_parameter
-
-            f_name = name
-            jacobian_name = name + "_jacobian"
-            hessian_name = name + "_hessian"
-
-            f_ptr = rt[f_name]
-            jacobian_ptr = hessian_ptr = 0
-            if autodiff_structure.has_jacobian:
-                jacobian_ptr = rt[jacobian_name]
-            if autodiff_structure.has_hessian:
-                hessian_ptr = rt[hessian_name]
-
-            evaluator = ConstraintAutodiffEvaluator(
-                has_parameter, f_ptr, jacobian_ptr, hessian_ptr
-            )
-            self._assign_nl_constraint_group_autodiff_evaluator(group_index, evaluator)
-
-        for group_index in range(
-            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
-        ):
-            name = f"nlobjective_{group_index}"
-            autodiff_structure = self.nl_objective_autodiff_structures[group_index]
-            has_parameter = autodiff_structure.has_parameter
-
-            f_name = name
-            jacobian_name = name + "_jacobian"
-            hessian_name = name + "_hessian"
-
-            f_ptr = rt[f_name]
-            jacobian_ptr = hessian_ptr = 0
-            if autodiff_structure.has_jacobian:
-                jacobian_ptr = rt[jacobian_name]
-            if autodiff_structure.has_hessian:
-                hessian_ptr = rt[hessian_name]
-
-            evaluator = ObjectiveAutodiffEvaluator(
-                has_parameter, f_ptr, jacobian_ptr, hessian_ptr
-            )
-            self._assign_nl_objective_group_autodiff_evaluator(group_index, evaluator)
-
     add_variables = make_variable_tupledict
     add_m_variables = make_variable_ndarray
     add_m_linear_constraints = add_matrix_constraints
@@ -0,0 +1,66 @@
+import hashlib
+import os
+import pickle
+import tempfile
+from typing import Optional, Any
+
+# bump this number whenever the generated code or the layout of cache entries changes
+CODEGEN_VERSION = 2
+
+# the sparsity pattern of Hessian produced by cppad_autodiff
+HESSIAN_SPARSITY = "upper"
+
+
+class JITCache:
+    """
+    A content-addressed on-disk cache of compiled nonlinear evaluators.
+
+    Each entry is keyed by the structure signatures of the nonlinear groups compiled together,
+    the type of Hessian sparsity, the version of code generator and the JIT backend. The value
+    stores the symbolic structures of automatic differentiation and the compiled artifact, so that
+    tracing, differentiation and compilation are skipped on a hit.
+    """
+
+    def __init__(self, directory: str):
+        self.directory = os.path.abspath(directory)
+        os.makedirs(self.directory, exist_ok=True)
+
+    def make_key(self, *components) -> str:
+        h = hashlib.sha256()
+        h.update(f"codegen={CODEGEN_VERSION};hessian={HESSIAN_SPARSITY};".encode())
+        for component in components:
+            if isinstance(component, str):
+                component = component.encode()
+            elif not isinstance(component, bytes):
+                component = repr(component).encode()
+            # prefix the length to make the concatenation unambiguous
+            h.update(len(component).to_bytes(8, "little"))
+            h.update(component)
+        return h.hexdigest()
+
+    def _path(self, key: str) -> str:
+        return os.path.join(self.directory, f"{key}.pkl")
+
+    def load(self, key: str) -> Optional[Any]:
+        try:
+            with open(self._path(key), "rb") as f:
+                return pickle.load(f)
+        except FileNotFoundError:
+            return None
+        except Exception:
+            # a corrupted or incompatible entry is treated as a miss and overwritten later
+            return None
+
+    def save(self, key: str, entry: Any):
+        # write to a temporary file first so that concurrent readers never see a partial entry
+        fd, tmp_path = tempfile.mkstemp(dir=self.directory, suffix=".tmp")
+        try:
+            with os.fdopen(fd, "wb") as f:
+                pickle.dump(entry, f, protocol=pickle.HIGHEST_PROTOCOL)
+            os.replace(tmp_path, self._path(key))
+        except BaseException:
+            try:
+                os.remove(tmp_path)
+            except OSError:
+                pass
+            raise
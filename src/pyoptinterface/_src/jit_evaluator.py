@@ -0,0 +1,436 @@
+import os
+import time
+from typing import Optional, List, Dict
+
+from .jit_cache import JITCache
+from .nlexpr_ext import ExpressionGraph
+from .nleval_ext import (
+    AutodiffSymbolicStructure,
+    ConstraintAutodiffEvaluator,
+    ObjectiveAutodiffEvaluator,
+)
+from .cppad_interface_ext import (
+    CppADAutodiffGraph,
+    CodegenTarget,
+    NLCodegen,
+    cppad_trace_graph_constraints,
+    cppad_trace_graph_objective,
+    cppad_autodiff,
+)
+
+
+class JITEvaluatorMixin:
+    """
+    Groups structurally identical nonlinear graphs and compiles one evaluator per group.
+
+    The model class must provide the bindings of NonlinearEvaluator used below
+    (_finalize_graph_instance, _aggregate_nl_constraint_groups, ...) and append every graph
+    registered in the evaluator to self.graph_instances.
+    """
+
+    def _init_jit(self, jit: str, jit_cache_dir: Optional[str]):
+        # the JIT engines are imported on demand as they are optional dependencies
+        if jit == "C":
+            from .jit_c import TCCJITCompiler
+
+            self.jit_compiler = TCCJITCompiler()
+        elif jit == "LLVM":
+            from .jit_llvm import LLJITCompiler
+
+            self.jit_compiler = LLJITCompiler()
+        else:
+            raise ValueError(f"JIT engine can only be 'C' or 'LLVM', got {jit}")
+        self.jit = jit
+
+        # the nonlinear groups are split into modules that are generated and compiled concurrently
+        self.jit_threads = os.cpu_count() or 1
+
+        # optional on-disk cache of compiled evaluators
+        self.jit_cache: Optional[JITCache] = None
+        if jit_cache_dir is not None:
+            self.jit_cache = JITCache(jit_cache_dir)
+
+        self._reset_nl_groups()
+
+    def set_jit_threads(self, n_threads: int):
+        """
+        Set the number of threads used to generate the code of nonlinear functions.
+        """
+        if n_threads < 1:
+            raise ValueError(f"The number of threads must be positive, got {n_threads}")
+        self.jit_threads = n_threads
+
+    def _reset_nl_groups(self):
+        # store graph_instance to graph_index
+        self.graph_instance_to_index: Dict[ExpressionGraph, int] = {}
+        self.graph_instances: List[ExpressionGraph] = []
+
+        self.nl_constraint_group_num = 0
+        self.nl_constraint_group_representatives: List[int] = []
+        # the entry is None if the group is loaded from the on-disk cache
+        self.nl_constraint_cppad_autodiff_graphs: List[
+            Optional[CppADAutodiffGraph]
+        ] = []
+        self.nl_constraint_autodiff_structures: List[AutodiffSymbolicStructure] = []
+        self.nl_constraint_evaluators: List[ConstraintAutodiffEvaluator] = []
+
+        self.nl_objective_group_num = 0
+        self.nl_objective_group_representatives: List[int] = []
+        self.nl_objective_cppad_autodiff_graphs: List[Optional[CppADAutodiffGraph]] = []
+        self.nl_objective_autodiff_structures: List[AutodiffSymbolicStructure] = []
+        self.nl_objective_evaluators: List[ObjectiveAutodiffEvaluator] = []
+
+        # some groups are compiled without Hessian because the solver approximates it
+        self.nl_hessian_skipped = False
+
+        # record the analyzed part of the problem
+        self.n_graph_instances_since_last_optimize = 0
+        self.nl_constraint_group_num_since_last_optimize = 0
+        self.nl_objective_group_num_since_last_optimize = 0
+
+    def _record_jit_profile(self, phase: str, start: float):
+        # phase is one of "cppad_autodiff", "codegen" and "jit_compile"
+        pass
+
+    def _nl_hessian_required(self) -> bool:
+        # the Hessian is neither differentiated nor compiled if the solver does not need it
+        return True
+
+    def _find_similar_graphs(self):
+        for i in range(
+            self.n_graph_instances_since_last_optimize, len(self.graph_instances)
+        ):
+            graph = self.graph_instances[i]
+            self._finalize_graph_instance(i, graph)
+
+        # constraint part
+
+        n_groups = self._aggregate_nl_constraint_groups()
+        # print(f"Found {n_groups} nonlinear constraint groups of similar graphs")
+        self.nl_constraint_group_num = n_groups
+
+        rep_instances = self.nl_constraint_group_representatives
+
+        for i in range(self.nl_constraint_group_num_since_last_optimize, n_groups):
+            graph_index = self._get_nl_constraint_group_representative(i)
+            rep_instances.append(graph_index)
+
+        # objective part
+        n_groups = self._aggregate_nl_objective_groups()
+        # print(f"Found {n_groups} nonlinear objective groups of similar graphs")
+        self.nl_objective_group_num = n_groups
+
+        rep_instances = self.nl_objective_group_representatives
+
+        for i in range(self.nl_objective_group_num_since_last_optimize, n_groups):
+            graph_index = self._get_nl_objective_group_representative(i)
+            rep_instances.append(graph_index)
+
+    def _compile_evaluators(self):
+        # for each group of nonlinear constraint and objective, we construct a cppad_autodiff graph
+        # and then compile them to get the function pointers
+
+        n_new_constraint_groups = (
+            self.nl_constraint_group_num - self.nl_constraint_group_num_since_last_optimize
+        )
+        n_new_objective_groups = (
+            self.nl_objective_group_num - self.nl_objective_group_num_since_last_optimize
+        )
+        hessian = self._nl_hessian_required()
+        if hessian and self.nl_hessian_skipped:
+            raise RuntimeError(
+                "The nonlinear functions have been compiled without Hessian, "
+                "the exact Hessian is not available for this model"
+            )
+
+        if n_new_constraint_groups == 0 and n_new_objective_groups == 0:
+            # nothing new to compile, e.g. re-solving after changing parameters
+            return
+        if not hessian:
+            self.nl_hessian_skipped = True
+
+        jit_cache = self.jit_cache
+        if jit_cache is not None:
+            cache_key = self._jit_cache_key()
+            entry = jit_cache.load(cache_key)
+            if entry is not None:
+                start = time.perf_counter()
+                self._load_cached_evaluators(entry)
+                self._record_jit_profile("jit_compile", start)
+                return
+
+        start = time.perf_counter()
+        # constraint
+        # self.nl_constraint_cppad_autodiff_graphs.clear()
+        # self.nl_constraint_autodiff_structures.clear()
+        for i in range(
+            self.nl_constraint_group_num_since_last_optimize,
+            self.nl_constraint_group_num,
+        ):
+            graph_index = self.nl_constraint_group_representatives[i]
+            graph = self.graph_instances[graph_index]
+
+            # print(graph)
+
+            cppad_function = cppad_trace_graph_constraints(graph)
+
+            nx = cppad_function.nx
+            var_values = [(i + 1) / (nx + 1) for i in range(nx)]
+            np = cppad_function.np
+            param_values = [(i + 1) / (np + 1) for i in range(np)]
+
+            # print(f"nx = {nx}, np = {np}")
+            # print(f"var_values = {var_values}")
+            # print(f"param_values = {param_values}")
+
+            autodiff_structure = AutodiffSymbolicStructure()
+            cppad_graph = CppADAutodiffGraph()
+
+            cppad_autodiff(
+                cppad_function,
+                autodiff_structure,
+                cppad_graph,
+                var_values,
+                param_values,
+                hessian=hessian,
+            )
+
+            # print(cppad_graph.f)
+
+            self._assign_nl_constraint_group_autodiff_structure(i, autodiff_structure)
+
+            self.nl_constraint_cppad_autodiff_graphs.append(cppad_graph)
+            self.nl_constraint_autodiff_structures.append(autodiff_structure)
+
+        # objective
+        # self.nl_objective_cppad_autodiff_graphs.clear()
+        # self.nl_objective_autodiff_structures.clear()
+        for i in range(
+            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
+        ):
+            graph_index = self.nl_objective_group_representatives[i]
+            graph = self.graph_instances[graph_index]
+
+            cppad_function = cppad_trace_graph_objective(graph)
+
+            nx = cppad_function.nx
+            var_values = [(i + 1) / (nx + 1) for i in range(nx)]
+            np = cppad_function.np
+            param_values = [(i + 1) / (np + 1) for i in range(np)]
+
+            autodiff_structure = AutodiffSymbolicStructure()
+            cppad_graph = CppADAutodiffGraph()
+
+            cppad_autodiff(
+                cppad_function,
+                autodiff_structure,
+                cppad_graph,
+                var_values,
+                param_values,
+                hessian=hessian,
+            )
+
+            self._assign_nl_objective_group_autodiff_structure(i, autodiff_structure)
+
+            self.nl_objective_cppad_autodiff_graphs.append(cppad_graph)
+            self.nl_objective_autodiff_structures.append(autodiff_structure)
+        self._record_jit_profile("cppad_autodiff", start)
+
+        # compile the evaluators
+        start = time.perf_counter()
+        if self.jit == "C":
+            modules = self._codegen(CodegenTarget.C)
+        elif self.jit == "LLVM":
+            modules = self._codegen(CodegenTarget.LLVM, self.jit_compiler.opaque_pointers)
+        self._record_jit_profile("codegen", start)
+        export_functions = [list(module.export_functions) for module in modules]
+
+        start = time.perf_counter()
+        if self.jit == "C":
+            artifact = [module.code for module in modules]
+        elif self.jit == "LLVM":
+            artifact = self.jit_compiler.compile_ir_to_objects(
+                [module.code for module in modules]
+            )
+        self._assign_nl_evaluators(self._link_jit_modules(artifact, export_functions))
+        self._record_jit_profile("jit_compile", start)
+
+        if jit_cache is not None:
+            entry = {
+                "constraint_structures": self.nl_constraint_autodiff_structures[
+                    self.nl_constraint_group_num_since_last_optimize :
+                ],
+                "objective_structures": self.nl_objective_autodiff_structures[
+                    self.nl_objective_group_num_since_last_optimize :
+                ],
+                "export_functions": export_functions,
+                "artifact": artifact,
+            }
+            jit_cache.save(cache_key, entry)
+
+    def _jit_cache_key(self):
+        # the names of generated functions depend on the index of group, so they are part of the key
+        components = [
+            self.jit,
+            self._nl_hessian_required(),
+            self.nl_constraint_group_num_since_last_optimize,
+            self.nl_constraint_group_num,
+            self.nl_objective_group_num_since_last_optimize,
+            self.nl_objective_group_num,
+        ]
+        if self.jit == "LLVM":
+            components.append(self.jit_compiler.cache_tag)
+        for i in range(
+            self.nl_constraint_group_num_since_last_optimize,
+            self.nl_constraint_group_num,
+        ):
+            graph_index = self.nl_constraint_group_representatives[i]
+            graph = self.graph_instances[graph_index]
+            components.append(graph.constraint_structure_signature())
+        for i in range(
+            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
+        ):
+            graph_index = self.nl_objective_group_representatives[i]
+            graph = self.graph_instances[graph_index]
+            components.append(graph.objective_structure_signature())
+        return self.jit_cache.make_key(*components)
+
+    def _load_cached_evaluators(self, entry):
+        for i, autodiff_structure in zip(
+            range(
+                self.nl_constraint_group_num_since_last_optimize,
+                self.nl_constraint_group_num,
+            ),
+            entry["constraint_structures"],
+        ):
+            self._assign_nl_constraint_group_autodiff_structure(i, autodiff_structure)
+            self.nl_constraint_cppad_autodiff_graphs.append(None)
+            self.nl_constraint_autodiff_structures.append(autodiff_structure)
+
+        for i, autodiff_structure in zip(
+            range(
+                self.nl_objective_group_num_since_last_optimize,
+                self.nl_objective_group_num,
+            ),
+            entry["objective_structures"],
+        ):
+            self._assign_nl_objective_group_autodiff_structure(i, autodiff_structure)
+            self.nl_objective_cppad_autodiff_graphs.append(None)
+            self.nl_objective_autodiff_structures.append(autodiff_structure)
+
+        get_symbol = self._link_jit_modules(entry["artifact"], entry["export_functions"])
+        self._assign_nl_evaluators(get_symbol)
+
+    def _link_jit_modules(self, artifact, export_functions):
+        # artifact holds one C source (TCC compiles in memory only) or object code per module
+        # returns a function to look up the exported functions of all modules by name
+        jit_compiler = self.jit_compiler
+        symbols = {}
+        for code, functions in zip(artifact, export_functions):
+            if self.jit == "C":
+                # libtcc is not reentrant, so the modules are compiled one after another
+                inst = jit_compiler.create_instance()
+                jit_compiler.compile_string(inst, code)
+                for name in functions:
+                    symbols[name] = inst.get_symbol(name)
+            elif self.jit == "LLVM":
+                rt = jit_compiler.load_object(code, functions)
+                for name in functions:
+                    symbols[name] = rt[name]
+        return symbols.__getitem__
+
+    def _codegen(self, target: CodegenTarget, opaque_pointers: bool = False):
+        # the code is generated from the CppAD graphs in C++ without holding the GIL
+        codegen = NLCodegen()
+        for group_index in range(
+            self.nl_constraint_group_num_since_last_optimize,
+            self.nl_constraint_group_num,
+        ):
+            codegen.add_constraint_group(
+                self.nl_constraint_cppad_autodiff_graphs[group_index],
+                self.nl_constraint_autodiff_structures[group_index],
+                f"nlconstraint_{group_index}",
+            )
+        for group_index in range(
+            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
+        ):
+            codegen.add_objective_group(
+                self.nl_objective_cppad_autodiff_graphs[group_index],
+                self.nl_objective_autodiff_structures[group_index],
+                f"nlobjective_{group_index}",
+            )
+        n_threads = self.jit_threads
+        return codegen.generate(
+            target,
+            n_modules=n_threads,
+            n_threads=n_threads,
+            opaque_pointers=opaque_pointers,
+        )
+
+    def _assign_nl_evaluators(self, get_symbol):
+        for group_index in range(
+            self.nl_constraint_group_num_since_last_optimize,
+            self.nl_constraint_group_num,
+        ):
+            name = f"nlconstraint_{group_index}"
+            autodiff_structure = self.nl_constraint_autodiff_structures[group_index]
+            has_parameter = autodiff_structure.has_parameter
+
+            f_name = name
+            jacobian_name = name + "_jacobian"
+            hessian_name = name + "_hessian"
+
+            f_ptr = get_symbol(f_name)
+            f_batch_ptr = get_symbol(f_name + "_batch")
+            jacobian_ptr = hessian_ptr = 0
+            jacobian_batch_ptr = hessian_batch_ptr = 0
+            if autodiff_structure.has_jacobian:
+                jacobian_ptr = get_symbol(jacobian_name)
+                jacobian_batch_ptr = get_symbol(jacobian_name + "_batch")
+            if autodiff_structure.has_hessian:
+                hessian_ptr = get_symbol(hessian_name)
+                hessian_batch_ptr = get_symbol(hessian_name + "_batch")
+
+            evaluator = ConstraintAutodiffEvaluator(
+                has_parameter,
+                f_ptr,
+                jacobian_ptr,
+                hessian_ptr,
+                f_batch_ptr,
+                jacobian_batch_ptr,
+                hessian_batch_ptr,
+            )
+            self._assign_nl_constraint_group_autodiff_evaluator(group_index, evaluator)
+
+        for group_index in range(
+            self.nl_objective_group_num_since_last_optimize, self.nl_objective_group_num
+        ):
+            name = f"nlobjective_{group_index}"
+            autodiff_structure = self.nl_objective_autodiff_structures[group_index]
+            has_parameter = autodiff_structure.has_parameter
+
+            f_name = name
+            jacobian_name = name + "_jacobian"
+            hessian_name = name + "_hessian"
+
+            f_ptr = get_symbol(f_name)
+            f_batch_ptr = get_symbol(f_name + "_batch")
+            jacobian_ptr = hessian_ptr = 0
+            jacobian_batch_ptr = hessian_batch_ptr = 0
+            if autodiff_structure.has_jacobian:
+                jacobian_ptr = get_symbol(jacobian_name)
+                jacobian_batch_ptr = get_symbol(jacobian_name + "_batch")
+            if autodiff_structure.has_hessian:
+                hessian_ptr = get_symbol(hessian_name)
+                hessian_batch_ptr = get_symbol(hessian_name + "_batch")
+
+            evaluator = ObjectiveAutodiffEvaluator(
+                has_parameter,
+                f_ptr,
+                jacobian_ptr,
+                hessian_ptr,
+                f_batch_ptr,
+                jacobian_batch_ptr,
+                hessian_batch_ptr,
+            )
+            self._assign_nl_objective_group_autodiff_evaluator(group_index, evaluator)
@@ -19,13 +19,32 @@ class LLJITCompiler:
         target_machine = target.create_target_machine(jit=True, opt=3)
         self.lljit = binding.create_lljit_compiler(target_machine)
 
+        # used to emit relocatable object code that can be cached on disk
+        self.object_target_machine = target.create_target_machine(opt=3, reloc="pic")
+        self.cache_tag = f"{target.triple};llvm={binding.llvm_version_info}"
+
+        # the IR generated in C++ must spell pointers in the same way as llvmlite
+        self.opaque_pointers = str(ir.PointerType(ir.DoubleType())) == "ptr"
+
         self.rts = []
         self.source_codes = []
 
-    def compile_module(self, module: ir.Module, export_functions: List[str] = []):
-        ir_str = str(module)
-        self.source_codes.append(ir_str)
-        builder = binding.JITLibraryBuilder().add_ir(ir_str).add_current_process()
+    def compile_ir_to_objects(self, ir_strs: List[str]) -> List[bytes]:
+        # the modules are compiled one by one, only their code is generated on multiple threads
+        self.source_codes.extend(ir_strs)
+        objects = []
+        for ir_str in ir_strs:
+            llvm_module = binding.parse_assembly(ir_str)
+            llvm_module.verify()
+            objects.append(self.object_target_machine.emit_object(llvm_module))
+        return objects
+
+    def load_object(self, object_code: bytes, export_functions: List[str] = []):
+        builder = (
+            binding.JITLibraryBuilder()
+            .add_object_img(object_code)
+            .add_current_process()
+        )
         for f in export_functions:
             builder.export_symbol(f)
         n = len(self.rts)
@@ -3,7 +3,7 @@ import os
 import platform
 import re
 from pathlib import Path
-from typing import Tuple, Union, overload
+from typing import Optional, Tuple, Union, overload
 
 from .aml import make_variable_ndarray, make_variable_tupledict
 from .attributes import (
@@ -23,7 +23,8 @@ from .core_ext import (
     VariableIndex,
 )
 from .knitro_model_ext import KN, RawEnv, RawModel, load_library
-from .matrix import add_matrix_constraints
+from .jit_evaluator import JITEvaluatorMixin
+from .matrix import add_matrix_constraints, load_mps
 from .nlexpr_ext import ExpressionGraph, ExpressionHandle
 from .nlfunc import ExpressionGraphContext, convert_to_expressionhandle
 from .solver_common import (
@@ -270,20 +271,34 @@ class Env(RawEnv):
         return self.empty()
 
 
-class Model(RawModel):
+class Model(RawModel, JITEvaluatorMixin):
     """
     KNITRO model class for PyOptInterface.
+
+    By default, each nonlinear graph is traced into its own CppAD tape and evaluated in its own
+    callback. If ``jit`` is "C" or "LLVM", structurally identical graphs added between two solves
+    share one JIT-compiled kernel and all of them are evaluated in a single callback.
     """
 
-    def __init__(self, env: Env = None) -> None:
+    def __init__(
+        self,
+        env: Env = None,
+        jit: Optional[str] = None,
+        jit_cache_dir: Optional[str] = None,
+    ) -> None:
         if env is not None:
             super().__init__(env)
         else:
             super().__init__()
         self.graph_map: dict[ExpressionGraph, int] = {}
+        self.jit = jit
+        if jit is not None:
+            self._init_jit(jit, jit_cache_dir)
 
     def _reset_graph_map(self) -> None:
         self.graph_map.clear()
+        if self.jit is not None:
+            self._reset_nl_groups()
 
     def _add_graph_expr(
         self, expr: ExpressionHandle
@@ -294,6 +309,9 @@ class Model(RawModel):
             raise ValueError("Expression should be convertible to ExpressionHandle")
         if graph not in self.graph_map:
             self.graph_map[graph] = len(self.graph_map)
+        if self.jit is not None and graph not in self.graph_instance_to_index:
+            self.graph_instance_to_index[graph] = self._add_graph_index(graph)
+            self.graph_instances.append(graph)
         return graph, expr
 
     def init(self, env: Env = None) -> None:
@@ -425,6 +443,16 @@ class Model(RawModel):
         graph, expr = self._add_graph_expr(expr)
         self._add_single_nl_objective(graph, expr)
 
+    def optimize(self) -> None:
+        if self.jit is not None and self.graph_instances:
+            self._find_similar_graphs()
+            self._compile_evaluators()
+        super().optimize()
+        if self.jit is not None:
+            # the grouped graphs are evaluated by the callbacks registered in this solve, graphs
+            # added later are grouped and compiled for the next solve
+            self._reset_nl_groups()
+
     def get_model_attribute(self, attr: ModelAttribute):
         def e(attribute):
             raise ValueError(f"Unknown model attribute to get: {attribute}")
@@ -513,3 +541,4 @@ class Model(RawModel):
 Model.add_variables = make_variable_tupledict
 Model.add_m_variables = make_variable_ndarray
 Model.add_m_linear_constraints = add_matrix_constraints
+Model.load_mps = load_mps
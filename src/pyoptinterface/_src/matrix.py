@@ -1,5 +1,12 @@
 from .tupledict import tupledict
-from .core_ext import ScalarAffineFunction
+from .core_ext import (
+    CacheModel,
+    ScalarAffineFunction,
+    VariableIndex,
+    ConstraintIndex,
+    ConstraintSense,
+    ConstraintType,
+)
 
 
 def iterate_sparse_matrix_rows(A):
@@ -65,6 +72,13 @@ def add_matrix_constraints(model, A, x, sense, b):
     elif len(b) != M:
         raise ValueError("b must have length equal to the number of rows of A")
 
+    if (
+        hasattr(model, "_add_linear_constraints")
+        and isinstance(sense, ConstraintSense)
+        and all(isinstance(var, VariableIndex) for var in x)
+    ):
+        return _add_matrix_constraints_csr(model, A, x, sense, b)
+
     constraints = np.empty(M, dtype=object)
 
     if is_ndarray:
@@ -86,3 +100,68 @@ def add_matrix_constraints(model, A, x, sense, b):
             constraints[i] = con
 
     return constraints
+
+
+def _add_matrix_constraints_csr(model, A, x, sense, b):
+    """
+    pass A to the model as a CSR matrix in one call
+    """
+    import numpy as np
+    from scipy.sparse import csr_array
+
+    M = A.shape[0]
+    constraints = np.empty(M, dtype=object)
+    if M == 0:
+        return constraints
+
+    if not isinstance(A, csr_array):
+        A = csr_array(A)
+    if not A.has_canonical_format:
+        A = A.copy()
+        A.sum_duplicates()
+
+    if A.nnz > np.iinfo(np.int32).max:
+        raise ValueError("The number of nonzeros of A exceeds the range of int32")
+
+    # columns of A are positions in x, the model expects the indices of variables
+    x_indices = np.array([var.index for var in x], dtype=np.int32)
+    indptr = np.ascontiguousarray(A.indptr, dtype=np.int32)
+    variables = np.ascontiguousarray(x_indices[A.indices], dtype=np.int32)
+    coefficients = np.ascontiguousarray(A.data, dtype=np.float64)
+    rhs = np.ascontiguousarray(b, dtype=np.float64)
+
+    first_index = model._add_linear_constraints(
+        indptr, variables, coefficients, sense, rhs
+    ).index
+
+    constraints[:] = [
+        ConstraintIndex(ConstraintType.Linear, i)
+        for i in range(first_index, first_index + M)
+    ]
+    return constraints
+
+
+def load_mps(model, filename, n_threads=0):
+    """
+    Read a MPS file in C++ and load it into the model with the vectorized APIs of the solver
+
+    n_threads is the number of threads to parse the file, 0 means the number of hardware threads
+
+    Returns two dicts mapping the names in the file to the variables and constraints of the model
+    """
+    cache = CacheModel()
+    variable_names, constraint_names, quadratic_constraint_names = cache._read_mps(
+        filename, n_threads
+    )
+    first_var, first_con, first_qcon = model.load_cache_model(cache)
+
+    variables = {
+        name: VariableIndex(first_var + i) for i, name in enumerate(variable_names)
+    }
+    constraints = {
+        name: ConstraintIndex(ConstraintType.Linear, first_con + i)
+        for i, name in enumerate(constraint_names)
+    }
+    for i, name in enumerate(quadratic_constraint_names):
+        constraints[name] = ConstraintIndex(ConstraintType.Quadratic, first_qcon + i)
+    return variables, constraints
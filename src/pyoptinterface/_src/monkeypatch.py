@@ -8,6 +8,7 @@ from .core_ext import (
 from .comparison_constraint import ComparisonConstraint
 from .nlexpr_ext import (
     ExpressionHandle,
+    ParameterIndex,
     BinaryOperator,
     NaryOperator,
     UnaryOperator,
@@ -353,6 +354,36 @@ def patch_pow(cls):
     cls.__rpow__ = __rpow__
 
 
+def patch_parameterindex(cls):
+    # a parameter is converted to a node of the current graph and then behaves like an ExpressionHandle
+    def _forward(name):
+        def f(self, *args):
+            graph = ExpressionGraphContext.current_graph()
+            expr = graph.merge_parameterindex(self)
+            return getattr(expr, name)(*args)
+
+        return f
+
+    for name in [
+        "__add__",
+        "__radd__",
+        "__sub__",
+        "__rsub__",
+        "__mul__",
+        "__rmul__",
+        "__truediv__",
+        "__rtruediv__",
+        "__neg__",
+        "__pow__",
+        "__rpow__",
+        "__lt__",
+        "__le__",
+        "__gt__",
+        "__ge__",
+    ]:
+        setattr(cls, name, _forward(name))
+
+
 def _monkeypatch_all():
     patch_core_compararison_operator(VariableIndex)
     patch_core_compararison_operator(ScalarAffineFunction)
@@ -378,3 +409,4 @@ def _monkeypatch_all():
     patch_pow(ExprBuilder)
 
     patch_expressionhandle(ExpressionHandle)
+    patch_parameterindex(ParameterIndex)
@@ -29,7 +29,7 @@ from .solver_common import (
     _direct_set_entity_attribute,
 )
 from .aml import make_variable_tupledict, make_variable_ndarray
-from .matrix import add_matrix_constraints
+from .matrix import add_matrix_constraints, load_mps
 
 
 def detected_libraries():
@@ -577,3 +577,4 @@ class Model(RawModel):
     add_variables = make_variable_tupledict
     add_m_variables = make_variable_ndarray
     add_m_linear_constraints = add_matrix_constraints
+    load_mps = load_mps
@@ -1,6 +1,7 @@
 from .nlexpr_ext import (
     ExpressionGraph,
     ExpressionHandle,
+    ParameterIndex,
     UnaryOperator,
     BinaryOperator,
     TernaryOperator,
@@ -68,6 +69,8 @@ def convert_to_expressionhandle(graph, expr):
         return graph.add_constant(expr)
     elif isinstance(expr, VariableIndex):
         return graph.merge_variableindex(expr)
+    elif isinstance(expr, ParameterIndex):
+        return graph.merge_parameterindex(expr)
     elif isinstance(expr, ScalarAffineFunction):
         return graph.merge_scalaraffinefunction(expr)
     elif isinstance(expr, ScalarQuadraticFunction):
@@ -95,6 +98,8 @@ def to_nlexpr(expr):
         return graph.add_constant(expr)
     elif isinstance(expr, VariableIndex):
         return graph.merge_variableindex(expr)
+    elif isinstance(expr, ParameterIndex):
+        return graph.merge_parameterindex(expr)
     elif isinstance(expr, ScalarAffineFunction):
         return graph.merge_scalaraffinefunction(expr)
     elif isinstance(expr, ScalarQuadraticFunction):
@@ -24,7 +24,12 @@ if copt.is_library_loaded():
     nlp_model_dict["copt"] = copt.Model
 
 if knitro.is_library_loaded() and knitro.has_valid_license():
+
+    def knitro_llvm():
+        return knitro.Model(jit="LLVM")
+
     nlp_model_dict["knitro"] = knitro.Model
+    nlp_model_dict["knitro_llvm"] = knitro_llvm
 
 
 @pytest.fixture(params=nlp_model_dict.keys())
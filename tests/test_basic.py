@@ -69,6 +69,56 @@ def test_basic():
     assert sqf.affine_part.constant == approx(6.0)
 
 
+def test_exprbuilder_dense_affine():
+    N = 20000
+    vars = [poi.VariableIndex(i) for i in range(N)]
+
+    def build(accumulator):
+        t = poi.ExprBuilder()
+        if accumulator is not None:
+            t.set_affine_accumulator(accumulator)
+        for i in reversed(range(N)):
+            t += (i % 7 - 3.0) * vars[i]
+        t -= 0.5 * vars[3]
+        t += vars[2] * vars[5]
+        t *= 2.0
+        t += 1.0
+        return t
+
+    hash_t = build(poi.AffineAccumulator.Hash)
+    dense_t = build(poi.AffineAccumulator.Dense)
+    auto_t = build(None)
+    assert not hash_t.is_dense_affine()
+    assert dense_t.is_dense_affine()
+    assert auto_t.is_dense_affine()
+
+    expected = poi.ScalarQuadraticFunction(hash_t)
+    expected.canonicalize()
+    for t in [dense_t, auto_t]:
+        sqf = poi.ScalarQuadraticFunction(t)
+        assert list(sqf.affine_part.variables) == list(range(N))
+        sqf.canonicalize()
+        assert list(sqf.variable_1s) == list(expected.variable_1s)
+        assert list(sqf.affine_part.variables) == list(expected.affine_part.variables)
+        assert np.allclose(sqf.coefficients, expected.coefficients)
+        assert np.allclose(
+            sqf.affine_part.coefficients, expected.affine_part.coefficients
+        )
+        assert sqf.affine_part.constant == approx(1.0)
+
+    dense_t.clean_nearzero_terms()
+    assert poi.ScalarQuadraticFunction(dense_t).affine_part.size() == N - N // 7 + 1
+    dense_t.set_affine_accumulator(poi.AffineAccumulator.Hash)
+    assert not dense_t.is_dense_affine()
+    dense_t.clear()
+    assert dense_t.empty()
+
+    sparse_t = poi.ExprBuilder()
+    for i in range(N):
+        sparse_t += poi.VariableIndex(8 * i)
+    assert not sparse_t.is_dense_affine()
+
+
 def test_affineexpr_from_numpy():
     N = 25
     coefs = np.arange(N, dtype=np.float64)
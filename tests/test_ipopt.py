@@ -1,6 +1,10 @@
+import math
+from concurrent.futures import ThreadPoolExecutor
+
 import pytest
 import pyoptinterface as poi
 from pyoptinterface import ipopt, nl
+from pyoptinterface._src.nlexpr_ext import ParameterIndex
 
 pytestmark = pytest.mark.skipif(
     not ipopt.is_library_loaded(), reason="IPOPT library not available"
@@ -126,3 +130,398 @@ class TestDirtyAfterModificationRaises:
         assert obj == pytest.approx(0.25, abs=1e-6)
         primal = model.get_constraint_attribute(con, poi.ConstraintAttribute.Primal)
         assert primal == pytest.approx(0.5, abs=1e-6)
+
+
+def _solve_model(
+    build,
+    jit="LLVM",
+    jit_cache_dir=None,
+    jit_threads=None,
+    nl_eval_threads=1,
+    sorted_hessian_assembly=False,
+):
+    """Build a model by build(model) which returns its variables, solve it and return the model
+    and the values of variables"""
+    model = ipopt.Model(jit=jit, jit_cache_dir=jit_cache_dir)
+    if jit_threads is not None:
+        model.set_jit_threads(jit_threads)
+    model.set_nl_eval_threads(nl_eval_threads)
+    model.set_sorted_hessian_assembly(sorted_hessian_assembly)
+    x = build(model)
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+    return model, [model.get_value(xi) for xi in x]
+
+
+def _build_chain_model(model):
+    N = 200
+    x = [model.add_variable(lb=0.1, ub=10.0, start=1.0) for _ in range(N)]
+    for i in range(N - 1):
+        with nl.graph():
+            model.add_nl_constraint(x[i] * x[i + 1] + nl.exp(x[i]), poi.Geq, 2.0 + 0.01 * i)
+    model.set_objective(poi.quicksum(xi * xi for xi in x))
+    return x
+
+
+def test_parallel_nl_evaluation():
+    _, serial = _solve_model(_build_chain_model)
+    _, parallel = _solve_model(_build_chain_model, nl_eval_threads=4)
+    # the results are documented to be identical to the serial evaluation: the parallel path
+    # reduces the hessian in the same order as the serial path, so they are compared exactly
+    assert parallel == serial
+
+
+def test_sorted_hessian_assembly():
+    _, default = _solve_model(_build_chain_model)
+    _, sorted_serial = _solve_model(_build_chain_model, sorted_hessian_assembly=True)
+    _, sorted_parallel = _solve_model(
+        _build_chain_model, nl_eval_threads=4, sorted_hessian_assembly=True
+    )
+    # the order of hessian entries differs from the default assembly
+    assert sorted_serial == pytest.approx(default, abs=1e-6)
+    # identical regardless of the number of threads, as documented
+    assert sorted_parallel == sorted_serial
+
+
+def test_limited_memory_hessian():
+    model = ipopt.Model()
+    model.set_raw_parameter("hessian_approximation", "limited-memory")
+    assert model.is_limited_memory_hessian()
+    x = model.add_variable(lb=0.1, ub=10.0, start=1.0)
+    y = model.add_variable(lb=0.1, ub=10.0, start=1.0)
+    with nl.graph():
+        model.add_nl_constraint(x * y + nl.exp(x), poi.Geq, 3.0)
+        model.add_nl_objective(nl.exp(x) + y * y)
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+
+    assert model.get_model_attribute(
+        poi.ModelAttribute.TerminationStatus
+    ) == poi.TerminationStatusCode.LOCALLY_SOLVED
+    assert all(not s.has_hessian for s in model.nl_constraint_autodiff_structures)
+    assert all(not s.has_hessian for s in model.nl_objective_autodiff_structures)
+    x_value = model.get_value(x)
+    y_value = model.get_value(y)
+    assert x_value * y_value + math.exp(x_value) == pytest.approx(3.0, abs=1e-5)
+
+    # the nonlinear functions have been compiled without Hessian
+    model.set_raw_parameter("hessian_approximation", "exact")
+    with pytest.raises(RuntimeError, match="without Hessian"):
+        model.optimize()
+
+    # the Hessian analysis of the first solve is skipped in the second solve, and the parallel
+    # evaluation must not use the stale Hessian indices of groups
+    x = []
+
+    def build(model):
+        x.extend(_build_chain_model(model))
+        return x
+
+    model, exact = _solve_model(build, nl_eval_threads=4)
+    model.set_raw_parameter("hessian_approximation", "limited-memory")
+    model.optimize()
+    assert model.get_model_attribute(
+        poi.ModelAttribute.TerminationStatus
+    ) == poi.TerminationStatusCode.LOCALLY_SOLVED
+    assert [model.get_value(xi) for xi in x] == pytest.approx(exact, abs=1e-5)
+
+
+def test_profile():
+    model = ipopt.Model()
+    N = 20
+    x = [model.add_variable(lb=0.1, ub=10.0, start=1.0) for _ in range(N)]
+    for i in range(N - 1):
+        with nl.graph():
+            model.add_nl_constraint(x[i] * x[i + 1] + nl.exp(x[i]), poi.Geq, 2.0)
+    model.add_linear_constraint(poi.quicksum(x), poi.Leq, 100.0)
+    model.set_objective(poi.quicksum(xi * xi for xi in x))
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+
+    profile = model.profile
+    assert profile.ipopt_solve.calls == 1
+    assert profile.analyze_structure.calls == 1
+    assert profile.cppad_autodiff.calls == 1
+    assert profile.jit_compile.calls == 1
+    for callback in [profile.eval_f, profile.eval_g, profile.eval_jac_g, profile.eval_h]:
+        assert callback.total.calls > 0
+        parts = (
+            callback.linear_seconds
+            + callback.quadratic_seconds
+            + callback.nonlinear_seconds
+        )
+        assert parts <= callback.total.seconds
+    callbacks_seconds = sum(
+        callback.total.seconds
+        for callback in [
+            profile.eval_f,
+            profile.eval_grad_f,
+            profile.eval_g,
+            profile.eval_jac_g,
+            profile.eval_h,
+        ]
+    )
+    assert callbacks_seconds <= profile.ipopt_solve.seconds
+
+    # re-solving does not analyze the structure or compile again
+    n_eval_g = profile.eval_g.total.calls
+    model.optimize()
+    assert profile.ipopt_solve.calls == 2
+    assert profile.analyze_structure.calls == 1
+    assert profile.jit_compile.calls == 1
+    assert profile.eval_g.total.calls > n_eval_g
+
+    model.reset_profile()
+    assert profile.ipopt_solve.calls == 0
+    assert profile.eval_g.total.calls == 0
+
+
+def _build_cached_model(model):
+    x = model.add_variable(lb=0.1, ub=10.0, start=1.0)
+    y = model.add_variable(lb=0.1, ub=10.0, start=1.0)
+    with nl.graph():
+        model.add_nl_constraint(x * y + nl.exp(x), poi.Geq, 3.0)
+    with nl.graph():
+        model.add_nl_objective(nl.log(x + 1.0) + y * y)
+    return [x, y]
+
+
+@pytest.mark.parametrize("jit", ["LLVM", "C"])
+def test_jit_cache(jit, tmp_path):
+    _, uncached = _solve_model(_build_cached_model, jit=jit)
+
+    _, first = _solve_model(_build_cached_model, jit=jit, jit_cache_dir=str(tmp_path))
+    entries = list(tmp_path.glob("*.pkl"))
+    assert len(entries) == 1
+
+    # the second model reuses the cached evaluators without tracing the graphs
+    model, second = _solve_model(_build_cached_model, jit=jit, jit_cache_dir=str(tmp_path))
+    assert list(tmp_path.glob("*.pkl")) == entries
+    assert model.nl_constraint_cppad_autodiff_graphs == [None]
+    assert model.nl_objective_cppad_autodiff_graphs == [None]
+
+    assert first == pytest.approx(uncached, abs=1e-8)
+    assert second == pytest.approx(uncached, abs=1e-8)
+
+
+def test_commutative_graphs_share_group():
+    model = ipopt.Model()
+    N = 4
+    x = [model.add_variable(lb=0.1, ub=10.0, start=1.0) for _ in range(N)]
+    y = [model.add_variable(lb=0.1, ub=10.0, start=1.0) for _ in range(N)]
+    for i in range(N):
+        with nl.graph():
+            if i % 2 == 0:
+                model.add_nl_constraint(x[i] * nl.exp(y[i]) + 1.0, poi.Geq, 2.0)
+            else:
+                model.add_nl_constraint(1.0 + nl.exp(y[i]) * x[i], poi.Geq, 2.0)
+    model.set_objective(poi.quicksum(xi * xi for xi in x + y))
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+
+    assert model.nl_constraint_group_num == 1
+    for i in range(N):
+        assert model.get_value(x[i]) * math.exp(model.get_value(y[i])) == pytest.approx(
+            1.0, abs=1e-6
+        )
+
+
+def test_quadratic_terms_split_from_nl_constraints():
+    model = ipopt.Model()
+    N = 4
+    x = [model.add_variable(lb=0.0, ub=10.0, start=1.0) for _ in range(N)]
+    y = [model.add_variable(lb=-1.0, ub=1.0) for _ in range(N)]
+    cons = []
+    for i in range(N):
+        with nl.graph():
+            # the number of affine terms differs, but only exp(y) is compiled
+            lhs = (
+                poi.quicksum((j + 1) * x[j] for j in range(i + 1))
+                + x[i] * y[i]
+                + nl.exp(y[i])
+            )
+            cons.append(model.add_nl_constraint(lhs, poi.Geq, 2.0 * (i + 1)))
+    model.set_objective(poi.quicksum(xi * xi for xi in x + y))
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+
+    assert model.nl_constraint_group_num == 1
+    xv = [model.get_value(xi) for xi in x]
+    yv = [model.get_value(yi) for yi in y]
+    for i in range(N):
+        lhs = sum((j + 1) * xv[j] for j in range(i + 1)) + xv[i] * yv[i] + math.exp(yv[i])
+        primal = model.get_constraint_attribute(cons[i], poi.ConstraintAttribute.Primal)
+        assert primal == pytest.approx(lhs, abs=1e-6)
+        assert lhs >= 2.0 * (i + 1) - 1e-6
+
+
+def test_split_quadratic_part_of_shared_subexpressions():
+    model = ipopt.Model()
+    x = model.add_variable(lb=-10.0, ub=10.0)
+    p = model.add_parameter(0.5)
+    depth = 40
+    with nl.graph():
+        # every level uses the previous one twice, so the graph has 2^depth paths
+        e = nl.sin(p)
+        for _ in range(depth):
+            e = nl.sin(e) + nl.cos(e)
+        model.add_nl_objective(x * x - x + e)
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+
+    value = math.sin(0.5)
+    for _ in range(depth):
+        value = math.sin(value) + math.cos(value)
+    assert model.get_value(x) == pytest.approx(0.5, abs=1e-6)
+    obj_value = model.get_model_attribute(poi.ModelAttribute.ObjectiveValue)
+    assert obj_value == pytest.approx(value - 0.25, abs=1e-6)
+
+
+def _build_multi_group_model(model):
+    x = [model.add_variable(lb=0.1, ub=10.0, start=1.0) for _ in range(6)]
+    # the constraints have different structures, so each of them is a group
+    with nl.graph():
+        model.add_nl_constraint(x[0] * x[1] + nl.exp(x[0]), poi.Geq, 3.0)
+    with nl.graph():
+        model.add_nl_constraint(nl.sin(x[2]) * x[3], poi.Geq, 0.5)
+    with nl.graph():
+        model.add_nl_constraint(nl.log(x[4]) + x[5] ** 3, poi.Geq, 2.0)
+    with nl.graph():
+        model.add_nl_objective(nl.exp(x[1] - x[3]) + x[5] ** 4)
+    model.set_objective(poi.quicksum(xi * xi for xi in x))
+    return x
+
+
+def _solve_multi_group_model(jit, n_threads):
+    model, values = _solve_model(_build_multi_group_model, jit=jit, jit_threads=n_threads)
+    assert model.nl_constraint_group_num == 3
+    assert model.nl_objective_group_num == 1
+    # each module is compiled separately
+    assert len(model.jit_compiler.source_codes) == min(n_threads, 4)
+    return values
+
+
+@pytest.mark.parametrize("jit", ["LLVM", "C"])
+def test_jit_threads(jit):
+    serial = _solve_multi_group_model(jit, 1)
+    parallel = _solve_multi_group_model(jit, 3)
+    assert parallel == pytest.approx(serial, abs=1e-8)
+
+
+@pytest.mark.parametrize("jit", ["LLVM", "C"])
+def test_concurrent_solves(jit):
+    serial = _solve_multi_group_model(jit, 1)
+    # the models are built, compiled and solved on different threads at the same time
+    with ThreadPoolExecutor(max_workers=4) as executor:
+        futures = [executor.submit(_solve_multi_group_model, jit, 1) for _ in range(8)]
+        results = [future.result() for future in futures]
+    for result in results:
+        assert result == pytest.approx(serial, abs=1e-8)
+
+
+@pytest.mark.parametrize("jit", ["LLVM", "C"])
+def test_nl_parameter(jit):
+    model = ipopt.Model(jit=jit)
+    N = 3
+    x = [model.add_variable(lb=-10.0, ub=10.0) for _ in range(N)]
+    p = [model.add_parameter(1.0) for _ in range(N)]
+    for i in range(N):
+        with nl.graph():
+            model.add_nl_objective((x[i] - p[i]) ** 2 + p[i] * nl.exp(x[i] - 2.0))
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+
+    model.optimize()
+    n_compiled = len(model.jit_compiler.source_codes)
+    assert model.nl_objective_group_num == 1
+
+    for values in [[0.5, 1.0, 1.5], [2.0, 3.0, 4.0]]:
+        for pi, v in zip(p, values):
+            model.set_parameter(pi, v)
+        assert [model.get_parameter(pi) for pi in p] == values
+        model.optimize()
+        for xi, v in zip(x, values):
+            # stationary point of (x - p)^2 + p * exp(x - 2)
+            xv = model.get_value(xi)
+            assert 2.0 * (xv - v) + v * math.exp(xv - 2.0) == pytest.approx(0.0, abs=1e-6)
+
+    # changing parameters does not trigger compilation
+    assert len(model.jit_compiler.source_codes) == n_compiled
+
+    with pytest.raises(RuntimeError, match="Parameter does not exist"):
+        model.set_parameter(ParameterIndex(N), 1.0)
+    with pytest.raises(RuntimeError, match="Parameter does not exist"):
+        model.get_parameter(ParameterIndex(-1))
+
+
+def test_resolve_after_bound_and_start_change():
+    model, x, con = _build_simple_model()
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+    assert model.get_value(x) == pytest.approx(0.5, abs=1e-6)
+
+    # only the starting point changes, the previous structure is reused
+    model.set_variable_attribute(x, poi.VariableAttribute.PrimalStart, 3.0)
+    model.optimize()
+    assert model.get_value(x) == pytest.approx(0.5, abs=1e-6)
+
+    # the new bound must be respected although the structure is unchanged
+    model.set_variable_attribute(x, poi.VariableAttribute.LowerBound, 2.0)
+    model.optimize()
+    assert model.get_value(x) == pytest.approx(2.0, abs=1e-6)
+
+    # structural change after reusing the structure
+    y = model.add_variable(lb=0.0, ub=10.0)
+    model.add_linear_constraint(x + y, poi.Geq, 5.0)
+    model.set_objective(x * x + y * y)
+    model.optimize()
+    assert model.get_value(x) == pytest.approx(2.5, abs=1e-6)
+    assert model.get_value(y) == pytest.approx(2.5, abs=1e-6)
+
+
+def test_warm_start_duals():
+    model = ipopt.Model()
+    x = model.add_variable(lb=0.0, ub=10.0)
+    y = model.add_variable(lb=0.0, ub=10.0)
+    model.set_objective(x * x + y * y)
+    con = model.add_linear_constraint(x + y, poi.Geq, 2.0)
+    with nl.graph():
+        nl_con_1 = model.add_nl_constraint(nl.exp(x) <= 10.0)
+    with nl.graph():
+        nl_con_2 = model.add_nl_constraint(x * y >= 0.5)
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+
+    model.set_constraint_attribute(con, poi.ConstraintAttribute.DualStart, 1.5)
+    assert model.get_constraint_attribute(
+        con, poi.ConstraintAttribute.DualStart
+    ) == pytest.approx(1.5)
+    model.set_variable_bound_dual_start(x, 0.0, 0.0)
+
+    model.optimize()
+    model.load_current_solution()
+    for c in [con, nl_con_1, nl_con_2]:
+        dual = model.get_constraint_attribute(c, poi.ConstraintAttribute.Dual)
+        assert model.get_constraint_attribute(
+            c, poi.ConstraintAttribute.DualStart
+        ) == pytest.approx(dual)
+    dual = model.get_constraint_attribute(con, poi.ConstraintAttribute.Dual)
+    assert dual == pytest.approx(2.0, abs=1e-6)
+
+    # the duals of existing constraints are kept when a constraint is added
+    with nl.graph():
+        nl_con_3 = model.add_nl_constraint(nl.exp(y) <= 20.0)
+    assert model.get_constraint_attribute(
+        con, poi.ConstraintAttribute.DualStart
+    ) == pytest.approx(dual)
+    assert model.get_constraint_attribute(
+        nl_con_3, poi.ConstraintAttribute.DualStart
+    ) == pytest.approx(0.0)
+
+    model.set_raw_parameter("warm_start_init_point", "yes")
+    model.set_raw_parameter("warm_start_bound_push", 1e-9)
+    model.set_raw_parameter("warm_start_mult_bound_push", 1e-9)
+    model.optimize()
+    assert model.get_value(x) == pytest.approx(1.0, abs=1e-6)
+    assert model.get_value(y) == pytest.approx(1.0, abs=1e-6)
+    assert model.get_constraint_attribute(
+        con, poi.ConstraintAttribute.Dual
+    ) == pytest.approx(dual, abs=1e-6)
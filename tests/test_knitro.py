@@ -1,7 +1,7 @@
 import pytest
 from pytest import approx
 
-from pyoptinterface import knitro
+from pyoptinterface import knitro, nl
 import pyoptinterface as poi
 
 pytestmark = pytest.mark.skipif(
@@ -533,3 +533,52 @@ def test_constraint_attribute_primal_dual():
 
     dual = model.get_constraint_attribute(con, poi.ConstraintAttribute.Dual)
     assert isinstance(dual, float)
+
+
+def _solve_multi_group_nl_model(jit):
+    model = knitro.Model(jit=jit)
+    x = [model.add_variable(lb=0.1, ub=10.0, start=1.0) for _ in range(6)]
+    cons = []
+    # three structures of constraints, all of them are active at the optimum
+    for i in range(3):
+        with nl.graph():
+            cons.append(
+                model.add_nl_constraint(nl.exp(0.5 * x[i]) * x[i + 1], poi.Leq, 3.0)
+            )
+    for i in range(2):
+        with nl.graph():
+            cons.append(model.add_nl_constraint(nl.log(x[i + 3]) * x[i], poi.Leq, 1.0))
+    with nl.graph():
+        cons.append(model.add_nl_constraint(x[4] * x[5] * x[5], poi.Leq, 4.0))
+    for i in range(6):
+        with nl.graph():
+            model.add_nl_objective((x[i] - 2.0) ** 2)
+    model.set_model_attribute(poi.ModelAttribute.Silent, True)
+    model.optimize()
+
+    assert model.get_model_attribute(poi.ModelAttribute.TerminationStatus) in (
+        poi.TerminationStatusCode.LOCALLY_SOLVED,
+        poi.TerminationStatusCode.OPTIMAL,
+    )
+    return {
+        "x": [model.get_value(xi) for xi in x],
+        "dual": [
+            model.get_constraint_attribute(c, poi.ConstraintAttribute.Dual) for c in cons
+        ],
+        "obj": model.get_model_attribute(poi.ModelAttribute.ObjectiveValue),
+        "iterations": model.get_model_attribute(poi.ModelAttribute.BarrierIterations),
+    }
+
+
+def test_grouped_callbacks_match_cppad_callbacks():
+    """Grouped JIT callbacks give the same results as one CppAD callback per graph."""
+    baseline = _solve_multi_group_nl_model(None)
+    grouped = _solve_multi_group_nl_model("LLVM")
+
+    assert grouped["x"] == approx(baseline["x"], abs=1e-6)
+    assert grouped["obj"] == approx(baseline["obj"], abs=1e-6)
+    # the multipliers of active constraints are nonzero, so a constraint Hessian that
+    # gathers them for the wrong constraints changes both the duals and the iterations
+    assert any(abs(d) > 1e-3 for d in baseline["dual"])
+    assert grouped["dual"] == approx(baseline["dual"], abs=1e-6)
+    assert grouped["iterations"] == baseline["iterations"]
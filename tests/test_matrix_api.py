@@ -1,3 +1,4 @@
+import pytest
 import pyoptinterface as poi
 import numpy as np
 from scipy.sparse import coo_array
@@ -39,3 +40,238 @@ def test_quicksum_ndarray(model_interface_oneshot):
     model.optimize()
     obj_value = model.get_model_attribute(poi.ModelAttribute.ObjectiveValue)
     assert obj_value == approx(2 * N**2)
+
+
+def test_add_m_variables_array_bounds(model_interface_oneshot):
+    model = model_interface_oneshot
+
+    N = 6
+    lb = np.arange(N, dtype=np.float64)
+    x = model.add_m_variables((2, N), lb=lb, ub=lb + 1.0, name="x")
+    y = model.add_m_variables(3, domain=poi.VariableDomain.Binary)
+    assert x.shape == (2, N)
+    assert y.shape == (3,)
+
+    # the indices of batch-created variables follow the scalar ones
+    z = model.add_variable(lb=0.0, ub=1.0)
+    indices = [v.index for v in x.flat] + [v.index for v in y] + [z.index]
+    assert len(set(indices)) == len(indices)
+
+    obj = poi.quicksum(x)
+    obj -= poi.quicksum(y)
+    obj += z
+    model.set_objective(obj)
+    model.optimize()
+    x_values = np.array([[model.get_value(v) for v in row] for row in x])
+    assert x_values == approx(np.tile(lb, (2, 1)))
+    for v in y:
+        assert model.get_value(v) == approx(1.0)
+    obj_value = model.get_model_attribute(poi.ModelAttribute.ObjectiveValue)
+    assert obj_value == approx(2 * lb.sum() - 3)
+
+
+def test_matrix_constraints_csr(model_interface_oneshot):
+    model = model_interface_oneshot
+
+    N = 5
+    x = model.add_m_variables(N, lb=-10.0, ub=10.0)
+    y = x[::-1]
+
+    # the diagonal entries are split into duplicates that must be summed
+    rows = np.concatenate([np.arange(N), np.arange(N), np.arange(N - 1)])
+    cols = np.concatenate([np.arange(N), np.arange(N), np.arange(1, N)])
+    data = np.concatenate([np.ones(N), np.ones(N), -np.ones(N - 1)])
+    A = coo_array((data, (rows, cols)), shape=(N, N))
+    b = np.arange(1.0, N + 1.0)
+
+    cons = model.add_m_linear_constraints(A, y, poi.Eq, b)
+    con = model.add_linear_constraint(x[0], poi.Leq, 10.0)
+    assert cons.shape == (N,)
+    indices = [c.index for c in cons] + [con.index]
+    assert len(set(indices)) == len(indices)
+
+    model.set_objective(poi.quicksum(x))
+    model.optimize()
+    y_values = np.array([model.get_value(v) for v in y])
+    assert y_values == approx(np.linalg.solve(A.toarray(), b))
+
+
+def test_get_values(model_interface_oneshot):
+    model = model_interface_oneshot
+
+    N = 8
+    lb = np.arange(N, dtype=np.float64)
+    x = model.add_m_variables(N, lb=lb, ub=lb + 1.0)
+    model.set_objective(poi.quicksum(x))
+    model.optimize()
+
+    # the default integer dtype of numpy is int64
+    indices = np.array([v.index for v in x])
+    assert model.get_values(indices) == approx(lb)
+    assert model.get_values(indices.astype(np.int32)) == approx(lb)
+    assert model.get_values(indices[::-1].copy()) == approx(lb[::-1])
+    with pytest.raises(RuntimeError, match="int32 or int64"):
+        model.get_values(indices.astype(np.float64))
+    assert model.get_values(list(x)) == approx(lb)
+
+    exprs = [2.0 * x[0] + x[1] + 1.0, poi.ScalarAffineFunction(x[N - 1])]
+    assert model.get_values(exprs) == approx([2.0, N - 1.0])
+
+
+def test_batched_modification(model_interface):
+    model = model_interface
+
+    N = 6
+    x = list(model.add_m_variables(N, lb=0.0))
+    cons = [model.add_linear_constraint(x[i], poi.Leq, 10.0) for i in range(N)]
+    model.set_objective(-poi.quicksum(x))
+
+    rhs = np.arange(1, N + 1, dtype=np.float64)
+    con_indices = np.array([c.index for c in cons])
+    model.set_normalized_rhs(con_indices, rhs)
+    model.set_normalized_coefficients(cons, x, [2.0] * N)
+    model.optimize()
+    assert model.get_normalized_rhs(cons[1]) == approx(2.0)
+    assert model.get_values(x) == approx(rhs / 2)
+
+    var_indices = np.array([v.index for v in x])
+    model.set_objective_coefficients(var_indices, np.full(N, -2.0))
+    model.set_variable_bounds(x[:2], [0.0, 0.0], [0.25, 0.25])
+    model.optimize()
+    expected = np.concatenate([[0.25, 0.25], rhs[2:] / 2])
+    assert model.get_values(x) == approx(expected)
+    obj_value = model.get_model_attribute(poi.ModelAttribute.ObjectiveValue)
+    assert obj_value == approx(-2.0 * expected.sum())
+
+
+def test_load_cache_model(model_interface):
+    model = model_interface
+
+    cache = poi.CacheModel()
+    N = 6
+    x = cache._add_variables(N, lb=np.zeros(N), ub=np.full(N, 4.0)).index
+    with pytest.raises(RuntimeError, match="nonnegative"):
+        cache._add_variables(-1)
+    y = cache.add_variable(poi.VariableDomain.Integer, 0.0, 10.0)
+    x = [poi.VariableIndex(x + i) for i in range(N)]
+
+    A = coo_array(np.ones((2, N)))
+    A = A.tocsr()
+    cache._add_linear_constraints(
+        A.indptr.astype(np.int64),
+        A.indices.astype(np.int64),
+        A.data,
+        poi.Geq,
+        np.array([3.0, 2.0]),
+    )
+    cache.add_linear_constraint(poi.quicksum(x) - y, poi.Leq, 0.5)
+    cache.set_objective(poi.quicksum(x) + 2.0 * y + 1.0)
+    assert cache.get_num_variables() == N + 1
+    assert cache.get_num_linear_constraints() == 3
+
+    # the solver model already has a variable, so the cached ones are shifted
+    z = model.add_variable(lb=0.0, ub=1.0)
+    first_var, first_con, first_qcon = model.load_cache_model(cache)
+    assert first_var == z.index + 1
+    assert first_qcon == -1
+
+    model.optimize()
+    obj_value = model.get_model_attribute(poi.ModelAttribute.ObjectiveValue)
+    # sum(x) >= 3 and y >= sum(x) - 0.5 with y integer
+    assert obj_value == approx(3.0 + 2.0 * 3.0 + 1.0)
+    y_value = model.get_value(poi.VariableIndex(first_var + N))
+    assert y_value == approx(3.0)
+
+
+def test_cache_model_write(tmp_path):
+    cache = poi.CacheModel()
+    x = cache.add_variable(poi.VariableDomain.Continuous, 0.0, 2.0)
+    y = cache.add_variable(poi.VariableDomain.Integer, -np.inf, 5.0)
+    z = cache.add_variable(poi.VariableDomain.Binary, 0.0, 1.0)
+    cache.add_linear_constraint(x + 2.0 * y - 3.0 * z + 1.5, poi.Leq, 10.0)
+    cache.add_linear_constraint(x + y, poi.Eq, 3.0)
+    cache.add_quadratic_constraint(x * x + 2.0 * x * y, poi.Leq, 4.0)
+    cache.set_objective(x * x + y + 4.0, poi.ObjectiveSense.Maximize)
+
+    mps_file = tmp_path / "model.mps"
+    cache.write(str(mps_file))
+    mps = mps_file.read_text().splitlines()
+    assert mps[0].startswith("NAME")
+    assert mps[-1] == "ENDATA"
+    for line in ["OBJSENSE", " L  c0", " E  c1", " L  q0", "QUADOBJ", "QCMATRIX   q0"]:
+        assert line in mps
+    # the constant of constraint is moved to the right-hand side
+    assert "    rhs  c0  8.5" in mps
+    assert " MI bnd  x1" in mps
+    assert " BV bnd  x2" in mps
+
+    lp_file = tmp_path / "model.lp"
+    cache.write(str(lp_file))
+    lp = lp_file.read_text().splitlines()
+    assert lp[0] == "Maximize"
+    assert lp[-1] == "End"
+    assert " c1: 1 x0 + 1 x1 = 3" in lp
+    assert " q0: [ 1 x0 ^ 2 + 2 x0 * x1 ] <= 4" in lp
+    assert " -infinity <= x1 <= 5" in lp
+
+    with pytest.raises(RuntimeError):
+        cache.write(str(tmp_path / "model.txt"))
+
+
+def test_load_mps(model_interface, tmp_path):
+    model = model_interface
+
+    mps_file = tmp_path / "model.mps"
+    mps_file.write_text(
+        """NAME          example
+ROWS
+ N  cost
+ G  lim1
+ L  lim2
+ E  eq
+COLUMNS
+    x  cost  1  lim1  1
+    x  lim2  1
+    MARKER  'MARKER'  'INTORG'
+    y  cost  2  lim1  1
+    y  eq  -1
+    MARKER  'MARKER'  'INTEND'
+    z  cost  -1.5  eq  1
+RHS
+    rhs  cost  -0.5
+    rhs  lim1  2.5  lim2  4
+RANGES
+    rng  lim2  3
+BOUNDS
+ UP bnd  x  4
+ UP bnd  y  1
+ MI bnd  z
+ENDATA
+"""
+    )
+    variables, constraints = model.load_mps(str(mps_file))
+    assert list(variables.keys()) == ["x", "y", "z"]
+    # the ranged row is split into two constraints
+    assert list(constraints.keys()) == ["lim1", "lim2_lb", "lim2_ub", "eq"]
+
+    model.optimize()
+    obj_value = model.get_model_attribute(poi.ModelAttribute.ObjectiveValue)
+    # z = y, x + y >= 2.5 and 1 <= x <= 4, y is integer in [0, 1]
+    assert obj_value == approx(1.5 + 0.5 + 0.5)
+    x, y = variables["x"], variables["y"]
+    assert model.get_value(x) == approx(1.5)
+    assert model.get_value(y) == approx(1.0)
+
+    # fixed MPS format allows spaces in names, which the reader rejects
+    mps_file.write_text(
+        """NAME          example
+ROWS
+ N  cost
+ G  lim 1
+COLUMNS
+    x         cost      1         lim 1     1
+ENDATA
+"""
+    )
+    with pytest.raises(RuntimeError, match="names with spaces"):
+        model.load_mps(str(mps_file))
@@ -141,6 +141,29 @@ def test_operator():
                 assert value == approx(op(expr_values[i], expr_values[j]))
 
 
+def test_affine_merge():
+    vars = [VariableIndex(i) for i in range(40)]
+
+    # small sums are merged without ExprBuilder but keep its semantics
+    expr = (3 * vars[2] + vars[0] + 1.0) + (vars[2] - 2 * vars[5])
+    assert list(expr.variables) == [2, 0, 5]
+    assert list(expr.coefficients) == approx([4.0, 1.0, -2.0])
+    assert expr.constant == approx(1.0)
+
+    expr = (3 * vars[2] + vars[0]) - (3 * vars[2] - vars[7] + 2.0)
+    assert list(expr.variables) == [2, 0, 7]
+    assert list(expr.coefficients) == approx([0.0, 1.0, 1.0])
+    assert expr.constant == approx(-2.0)
+
+    a = quicksum(vars[:30], lambda v: 2.0 * v)
+    b = quicksum(vars[10:], lambda v: -1.0 * v)
+    expr = ScalarAffineFunction(a) + ScalarAffineFunction(b)
+    expr.canonicalize()
+    assert list(expr.variables) == list(range(40))
+    expected = [2.0] * 10 + [1.0] * 20 + [-1.0] * 10
+    assert list(expr.coefficients) == approx(expected)
+
+
 def test_quicksum():
     N = 6
     vars = [VariableIndex(i) for i in range(N)]
@@ -1300,6 +1300,8 @@ extern "C"
 	                  const double bndval[]);
 	int XPRSchgcoef(XPRSprob prob, int row, int col, double coef);
 	int XPRSchgcoltype(XPRSprob prob, int ncols, const int colind[], const char coltype[]);
+	int XPRSchgmcoef64(XPRSprob prob, XPRSint64 ncoefs, const int rowind[], const int colind[],
+	                   const double rowcoef[]);
 	int XPRSchgmqobj64(XPRSprob prob, XPRSint64 ncoefs, const int objqcol1[], const int objqcol2[],
 	                   const double objqcoef[]);
 	int XPRSchgobj(XPRSprob prob, int ncols, const int colind[], const double objcoef[]);